@@ -212,6 +212,8 @@ release_all_dbs(clixon_handle h,
             if (xmldb_copy(h, "running", db0) < 0)
                 goto done;
             xmldb_modified_set(de0, 0); /* reset dirty bit */
+            if (backend_config_change_notify(h, db0) < 0)
+                goto done;
         }
     }
     /* get all db:s */
@@ -374,6 +376,238 @@ do_lock(clixon_handle h,
     goto done;
 }
 
+/*! Check that an edit target is not locked by another client, and autolock it
+ *
+ * Also add system-only config to candidate cache
+ * @param[in]  h       Clixon handle
+ * @param[in]  myid    Session id of client
+ * @param[in]  de      Target datastore
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @retval     1       OK
+ * @retval     0       Locked by other client, error returned in cbret
+ * @retval    -1       Error
+ */
+static int
+edit_config_lock(clixon_handle h,
+                 uint32_t      myid,
+                 db_elmnt     *de,
+                 cbuf         *cbret)
+{
+    int      retval = -1;
+    char    *target = xmldb_name_get(de);
+    uint32_t iddb;
+    cbuf    *cbx = NULL;
+    int      ret;
+
+    /* Check if target locked by other client */
+    iddb = xmldb_islocked(h, target);
+    if (iddb && myid != iddb){
+        if ((cbx = cbuf_new()) == NULL){
+            clixon_err(OE_XML, errno, "cbuf_new");
+            goto done;
+        }
+        cprintf(cbx, "<session-id>%u</session-id>", iddb);
+        cprintf(cbx, "<db>%s</db>", target);
+        if (netconf_lock_denied(cbret, cbuf_get(cbx), "Operation failed, lock is already held") < 0)
+            goto done;
+        goto fail;
+    }
+    /* Here iddb is =0 (not locked) or locked by this process =myid */
+    if (iddb == 0 && clicon_option_bool(h, "CLICON_AUTOLOCK") &&
+        xmldb_candidate_get(de)){
+        if ((ret = do_lock(h, cbret, myid, de)) < 0)
+            goto done;
+        if (ret == 0)
+            goto fail;
+    }
+    if (xmldb_candidate_get(de)) {
+        /* Add system-only config to candidate cache */
+        if (clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")){
+            if (system_only_data_add(h, target) < 0)
+                goto done;
+        }
+    }
+    retval = 1;
+ done:
+    if (cbx)
+        cbuf_free(cbx);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Bind and check an incoming edit-config <config> tree before it is applied
+ *
+ * @param[in]  h       Clixon handle
+ * @param[in]  xc      Config tree: <config>
+ * @param[in]  yspec   Yang spec
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @retval     1       OK
+ * @retval     0       Check failed, error returned in cbret
+ * @retval    -1       Error
+ */
+static int
+edit_config_check(clixon_handle h,
+                  cxobj        *xc,
+                  yang_stmt    *yspec,
+                  cbuf         *cbret)
+{
+    int    retval = -1;
+    cxobj *xret = NULL;
+    int    non_config = 0;
+    int    ret;
+
+    /* <config> yang spec may be set to anyxml by ingress yang check,...*/
+    if (xml_spec(xc) != NULL)
+        xml_spec_set(xc, NULL);
+    /* Populate XML with Yang spec. Binding is done in from_client_msg only frm an RPC perspective,
+     * where <config> is ANYDATA
+     */
+    if ((ret = xml_bind_yang(h, xc, YB_MODULE, yspec, 0, &xret)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    /* (Mark all nodes that are not configure data and) set return */
+    if ((ret = xml_non_config_data(xc, &xret)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    if (non_config){
+        if (netconf_invalid_value(cbret, "protocol", "State data not allowed")< 0)
+            goto done;
+        goto fail;
+    }
+    /* Limited validation of incoming payload
+     */
+    if ((ret = xml_yang_validate_minmax(xc, 1, &xret)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    /* Must do before duplicate check,
+     * should probably be done before minmax check above */
+    if (xml_sort_recurse(xc) < 0)
+        goto done;
+    /* Disable duplicate check in NETCONF messages. */
+    if (clicon_option_bool(h, "CLICON_NETCONF_DUPLICATE_ALLOW")){
+        if ((ret = xml_duplicate_detect(xc, 1, NULL)) < 0)
+            goto done;
+    }
+    else {
+        if ((ret = xml_duplicate_detect(xc, 0, &xret)) < 0)
+            goto done;
+    }
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    /* xmldb_put (difflist handling) requires list keys */
+    if ((ret = xml_yang_validate_list_key_only(h, xc, &xret)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    retval = 1;
+ done:
+    if (xret)
+        xml_free(xret);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Commit an edited candidate, as requested by autocommit
+ *
+ * @param[in]  h       Clixon handle
+ * @param[in]  ce      Client entry
+ * @param[in]  de      Edited datastore
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @retval     1       OK, committed
+ * @retval     0       Commit failed, candidate discarded and error returned in cbret
+ * @retval    -1       Error
+ */
+static int
+edit_config_autocommit(clixon_handle h,
+                       client_entry *ce,
+                       db_elmnt     *de,
+                       cbuf         *cbret)
+{
+    int   retval = -1;
+    char *target = xmldb_name_get(de);
+    int   ret;
+
+    /* if this is from a restconf client ...
+     *      and, if there is an existing ephemeral commit, set is_valid_confirming_commit=1 such that
+     *          candidate_commit will apply the configuration per RFC 8040 1.4:
+     *              If a confirmed commit procedure is
+     *              in progress by any NETCONF client, then any new commit will act as
+     *              the confirming commit.
+     *      and, if there is an existing persistent commit, netconf_operation_failed with "in-use", so
+     *          that the restconf server will return "409 Conflict" per RFC 8040 1.4:
+     *              If the NETCONF server is expecting a
+     *              "persist-id" parameter to complete the confirmed commit procedure,
+     *              then the RESTCONF edit operation MUST fail with a "409 Conflict"
+     *              status-line.  The error-tag "in-use" is used in this case.
+     */
+    if (if_feature(h, "ietf-netconf", "confirmed-commit")) {
+        switch (confirmed_commit_state_get(h)){
+        case INACTIVE:
+            break;
+        case PERSISTENT:
+            if (netconf_in_use(cbret, "application", "Persistent commit is ongoing")< 0)
+                goto done;
+            goto fail;
+            break;
+        case EPHEMERAL:
+        case ROLLBACK:
+            cancel_confirmed_commit(h);
+            break;
+        }
+    }
+    if (clicon_option_bool(h, "CLICON_XMLDB_PRIVATE_CANDIDATE")) {
+        /* First step, rebase private candidate with running */
+        if ((ret = backend_update(h, ce->ce_id, de, cbret)) < 0)
+            goto done;
+        if (ret == 0)
+            goto fail;
+    }
+    if ((ret = candidate_commit(h, NULL, target, ce->ce_id, 0, cbret)) < 0){ /* Assume validation fail, nofatal */
+        if (clixon_plugin_report_err(h, cbret) < 0)
+            goto done;
+        xmldb_copy(h, "running", target);
+        goto fail;
+    }
+    if (ret == 0){ /* discard */
+        if (xmldb_copy(h, "running", target) < 0){
+            if (netconf_operation_failed(cbret, "application", "%s", clixon_err_reason())< 0)
+                goto done;
+            goto fail;
+        }
+        goto fail;
+    }
+    if (xmldb_post_commit(h, ce->ce_id) < 0)
+        goto done;
+    retval = 1;
+ done:
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
 /*! Loads all or part of a specified configuration to target configuration
  * 
  * @param[in]  h       Clixon handle 
@@ -402,16 +636,13 @@ from_client_edit_config(clixon_handle h,
     int                  retval = -1;
     client_entry        *ce = (client_entry *)arg;
     uint32_t             myid = ce->ce_id;
-    uint32_t             iddb;
     char                *target = NULL;
     cxobj               *xc;
     cxobj               *x;
     enum operation_type  operation = OP_MERGE;
-    int                  non_config = 0;
     yang_stmt           *yspec;
     cbuf                *cbx = NULL; /* Assist cbuf */
     char                *username;
-    cxobj               *xret = NULL;
     char                *attr;
     int                  autocommit = 0;
     char                *val = NULL;
@@ -434,30 +665,10 @@ from_client_edit_config(clixon_handle h,
         clixon_err(OE_XML, errno, "cbuf_new");
         goto done;
     }
-    /* Check if target locked by other client */
-    iddb = xmldb_islocked(h, target);
-    if (iddb && myid != iddb){
-        cprintf(cbx, "<session-id>%u</session-id>", iddb);
-        cprintf(cbx, "<db>%s</db>", target);
-        if (netconf_lock_denied(cbret, cbuf_get(cbx), "Operation failed, lock is already held") < 0)
-            goto done;
+    if ((ret = edit_config_lock(h, myid, de, cbret)) < 0)
+        goto done;
+    if (ret == 0)
         goto ok;
-    }
-    /* Here iddb is =0 (not locked) or locked by this process =myid */
-    if (iddb == 0 && clicon_option_bool(h, "CLICON_AUTOLOCK") &&
-        xmldb_candidate_get(de)){
-        if ((ret = do_lock(h, cbret, myid, de)) < 0)
-            goto done;
-        if (ret == 0)
-            goto ok;
-    }
-    if (xmldb_candidate_get(de)) {
-        /* Add system-only config to candidate cache */
-        if (clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")){
-            if (system_only_data_add(h, target) < 0)
-                goto done;
-        }
-    }
     if (xml_nsctx_node(xe, &nsc) < 0)
         goto done;
     /* Get prefix of netconf base namespace in the incoming message */
@@ -486,67 +697,13 @@ from_client_edit_config(clixon_handle h,
             goto done;
         goto ok;
     }
-    /* <config> yang spec may be set to anyxml by ingress yang check,...*/
-    if (xml_spec(xc) != NULL)
-        xml_spec_set(xc, NULL);
-    /* Populate XML with Yang spec. Binding is done in from_client_msg only frm an RPC perspective,
-     * where <config> is ANYDATA
-     */
-    if ((ret = xml_bind_yang(h, xc, YB_MODULE, yspec, 0, &xret)) < 0)
-        goto done;
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
-        goto ok;
-    }
-    /* (Mark all nodes that are not configure data and) set return */
-    if ((ret = xml_non_config_data(xc, &xret)) < 0)
-        goto done;
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
-        goto ok;
-    }
-    if (non_config){
-        if (netconf_invalid_value(cbret, "protocol", "State data not allowed")< 0)
-            goto done;
-        goto ok;
-    }
-    /* Limited validation of incoming payload
-     */
-    if ((ret = xml_yang_validate_minmax(xc, 1, &xret)) < 0)
-        goto done;
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
-        goto ok;
-    }
-    /* Must do before duplicate check,
-     * should probably be done before minmax check above */
-    if (xml_sort_recurse(xc) < 0)
+    if ((ret = edit_config_check(h, xc, yspec, cbret)) < 0)
         goto done;
-    /* Disable duplicate check in NETCONF messages. */
-    if (clicon_option_bool(h, "CLICON_NETCONF_DUPLICATE_ALLOW")){
-        if ((ret = xml_duplicate_detect(xc, 1, NULL)) < 0)
-            goto done;
-    }
-    else {
-        if ((ret = xml_duplicate_detect(xc, 0, &xret)) < 0)
-            goto done;
-    }
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
+    if (ret == 0)
         goto ok;
-    }
-    /* xmldb_put (difflist handling) requires list keys */
-    if ((ret = xml_yang_validate_list_key_only(h, xc, &xret)) < 0)
+    /* Keep confirmed-commit rollback point before running is modified without commit */
+    if (strcmp(target, "running") == 0 && commit_history_release(h) < 0)
         goto done;
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
-        goto ok;
-    }
     if ((ret = xmldb_put(h, target, operation, xc, username, cbret)) < 0){
         if (netconf_operation_failed(cbret, "protocol", "%s", clixon_err_reason())< 0)
             goto done;
@@ -555,63 +712,21 @@ from_client_edit_config(clixon_handle h,
     if (ret == 0)
         goto ok;
     xmldb_modified_set(de, 1); /* mark as dirty */
+    /* Running modified without commit, history no longer applies */
+    if (strcmp(target, "running") == 0 && commit_history_clear(h) < 0)
+        goto done;
+    if (backend_config_change_notify(h, target) < 0)
+        goto done;
     /* Clixon extension: autocommit */
     if ((attr = xml_find_value(xe, "autocommit")) != NULL &&
         strcmp(attr,"true") == 0)
         autocommit = 1;
     /* If autocommit option is set or requested by client */
     if (clicon_autocommit(h) || autocommit) {
-        /* if this is from a restconf client ...
-         *      and, if there is an existing ephemeral commit, set is_valid_confirming_commit=1 such that
-         *          candidate_commit will apply the configuration per RFC 8040 1.4:
-         *              If a confirmed commit procedure is
-         *              in progress by any NETCONF client, then any new commit will act as
-         *              the confirming commit.
-         *      and, if there is an existing persistent commit, netconf_operation_failed with "in-use", so
-         *          that the restconf server will return "409 Conflict" per RFC 8040 1.4:
-         *              If the NETCONF server is expecting a
-         *              "persist-id" parameter to complete the confirmed commit procedure,
-         *              then the RESTCONF edit operation MUST fail with a "409 Conflict"
-         *              status-line.  The error-tag "in-use" is used in this case.
-         */
-        if (if_feature(h, "ietf-netconf", "confirmed-commit")) {
-            switch (confirmed_commit_state_get(h)){
-            case INACTIVE:
-                break;
-            case PERSISTENT:
-                if (netconf_in_use(cbret, "application", "Persistent commit is ongoing")< 0)
-                    goto done;
-                goto ok;
-                break;
-            case EPHEMERAL:
-            case ROLLBACK:
-                cancel_confirmed_commit(h);
-                break;
-            }
-        }
-        if (clicon_option_bool(h, "CLICON_XMLDB_PRIVATE_CANDIDATE")) {
-            /* First step, rebase private candidate with running */
-            if ((ret = backend_update(h, ce->ce_id, de, cbret)) < 0)
-                goto done;
-            if (ret == 0)
-                goto ok;
-        }
-        if ((ret = candidate_commit(h, NULL, target, myid, 0, cbret)) < 0){ /* Assume validation fail, nofatal */
-            if (clixon_plugin_report_err(h, cbret) < 0)
-                goto done;
-            xmldb_copy(h, "running", target);
-            goto ok;
-        }
-        if (ret == 0){ /* discard */
-            if (xmldb_copy(h, "running", target) < 0){
-                if (netconf_operation_failed(cbret, "application", "%s", clixon_err_reason())< 0)
-                    goto done;
-                goto ok;
-            }
-            goto ok;
-        }
-        if (xmldb_post_commit(h, ce->ce_id) < 0)
+        if ((ret = edit_config_autocommit(h, ce, de, cbret)) < 0)
             goto done;
+        if (ret == 0)
+            goto ok;
     }
     /* Clixon extension: copy */
     if ((attr = xml_find_value(xe, "copystartup")) != NULL &&
@@ -648,14 +763,203 @@ from_client_edit_config(clixon_handle h,
  done:
     if (nsc)
         cvec_free(nsc);
-    if (xret)
-        xml_free(xret);
     if (cbx)
         cbuf_free(cbx);
     clixon_debug(CLIXON_DBG_BACKEND, "done cbret:%s", cbuf_get(cbret));
     return retval;
 } /* from_client_edit_config */
 
+/*! Apply several edit-config operations on a datastore in one pass
+ *
+ * Each edit is checked and applied independently, and the result of each edit
+ * is returned. The datastore is completed and written, and optionally committed,
+ * once for all edits.
+ * @param[in]  h       Clixon handle
+ * @param[in]  xe      Request: <rpc><xn></rpc>
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @param[in]  arg     client-entry
+ * @param[in]  regarg  User argument given at rpc_callback_register()
+ * @retval     0       OK
+ * @retval    -1       Error
+ * @see from_client_edit_config
+ */
+static int
+from_client_batch_edit(clixon_handle h,
+                       cxobj        *xe,
+                       cbuf         *cbret,
+                       void         *arg,
+                       void         *regarg)
+{
+    int                  retval = -1;
+    client_entry        *ce = (client_entry *)arg;
+    uint32_t             myid = ce->ce_id;
+    char                *target = NULL;
+    yang_stmt           *yspec;
+    db_elmnt            *de = NULL;
+    cxobj               *x;
+    cxobj               *xc;
+    cxobj               *xerr = NULL;
+    cxobj              **evec = NULL;   /* Edit elements */
+    cbuf               **cbvec = NULL;  /* Result per edit */
+    cxobj              **xvec = NULL;   /* Config of edits passing checks */
+    enum operation_type *opvec = NULL;
+    cbuf               **cbpvec = NULL; /* Result of edits passing checks */
+    size_t               elen = 0;
+    int                  plen = 0;
+    int                  applied = 0;
+    char                *attr;
+    char                *str;
+    int                  i;
+    int                  ret;
+
+    if ((yspec = clicon_dbspec_yang(h)) == NULL){
+        clixon_err(OE_YANG, ENOENT, "No yang spec");
+        goto done;
+    }
+    if ((ret = xmldb_netconf_name_find(h, xe, "target", ce, 1, &de, cbret)) < 0)
+        goto done;
+    if (ret == 0)
+        goto ok;
+    target = xmldb_name_get(de);
+    if ((ret = edit_config_lock(h, myid, de, cbret)) < 0)
+        goto done;
+    if (ret == 0)
+        goto ok;
+    if (xpath_vec(xe, NULL, "edit", &evec, &elen) < 0)
+        goto done;
+    if (elen){
+        if ((cbvec = calloc(elen, sizeof(cbuf *))) == NULL ||
+            (cbpvec = calloc(elen, sizeof(cbuf *))) == NULL ||
+            (xvec = calloc(elen, sizeof(cxobj *))) == NULL ||
+            (opvec = calloc(elen, sizeof(enum operation_type))) == NULL){
+            clixon_err(OE_UNIX, errno, "calloc");
+            goto done;
+        }
+    }
+    /* Check each edit, those passing are applied together */
+    for (i=0; i<elen; i++){
+        if ((cbvec[i] = cbuf_new()) == NULL){
+            clixon_err(OE_XML, errno, "cbuf_new");
+            goto done;
+        }
+        opvec[plen] = OP_MERGE;
+        if ((str = xml_find_body(evec[i], "default-operation")) != NULL &&
+            xml_operation(str, &opvec[plen]) < 0){
+            if (netconf_invalid_value(cbvec[i], "protocol", "Wrong operation")< 0)
+                goto done;
+            continue;
+        }
+        if ((xc = xml_find_type(evec[i], NULL, NETCONF_INPUT_CONFIG, CX_ELMNT)) == NULL){
+            if (netconf_missing_element(cbvec[i], "protocol", NETCONF_INPUT_CONFIG, NULL) < 0)
+                goto done;
+            continue;
+        }
+        if ((ret = edit_config_check(h, xc, yspec, cbvec[i])) < 0)
+            goto done;
+        if (ret == 0)
+            continue;
+        xvec[plen] = xc;
+        cbpvec[plen] = cbvec[i];
+        plen++;
+    }
+    /* Keep confirmed-commit rollback point before running is modified without commit */
+    if (strcmp(target, "running") == 0 && commit_history_release(h) < 0)
+        goto done;
+    if ((ret = xmldb_put_batch(h, target, opvec, xvec, plen, clicon_username_get(h), cbpvec)) < 0){
+        if (netconf_operation_failed(cbret, "protocol", "%s", clixon_err_reason())< 0)
+            goto done;
+        goto ok;
+    }
+    if (ret == 0){
+        cprintf(cbret, "%s", cbuf_get(cbpvec[0]));
+        goto ok;
+    }
+    for (i=0; i<plen; i++)
+        if (cbuf_len(cbpvec[i]) == 0)
+            applied++;
+    if (applied){
+        xmldb_modified_set(de, 1); /* mark as dirty */
+        /* Running modified without commit, history no longer applies */
+        if (strcmp(target, "running") == 0 && commit_history_clear(h) < 0)
+            goto done;
+        if (backend_config_change_notify(h, target) < 0)
+            goto done;
+        /* Clixon extension: autocommit, once for all edits */
+        if (clicon_autocommit(h) ||
+            ((attr = xml_find_value(xe, "autocommit")) != NULL && strcmp(attr, "true") == 0)){
+            if ((ret = edit_config_autocommit(h, ce, de, cbret)) < 0)
+                goto done;
+            if (ret == 0)
+                goto ok;
+        }
+    }
+    cprintf(cbret, "<rpc-reply xmlns=\"%s\">", NETCONF_BASE_NAMESPACE);
+    for (i=0; i<elen; i++){
+        cprintf(cbret, "<edit xmlns=\"%s\">", CLIXON_LIB_NS);
+        if ((str = xml_find_body(evec[i], "id")) != NULL){
+            cprintf(cbret, "<id>");
+            if (xml_chardata_cbuf_append(cbret, 0, str) < 0)
+                goto done;
+            cprintf(cbret, "</id>");
+        }
+        if (cbuf_len(cbvec[i]) == 0)
+            cprintf(cbret, "<ok/>");
+        else {
+            /* Move rpc-error:s from reply of edit */
+            if (clixon_xml_parse_string(cbuf_get(cbvec[i]), YB_NONE, NULL, &xerr, NULL) < 0)
+                goto done;
+            cprintf(cbret, "<error>");
+            x = NULL;
+            while ((x = xpath_first(xerr, NULL, "//rpc-error")) != NULL){
+                if (xml_rm(x) < 0)
+                    goto done;
+                if (xmlns_set(x, NULL, NETCONF_BASE_NAMESPACE) < 0)
+                    goto done;
+                if (clixon_xml2cbuf1(cbret, x, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0){
+                    xml_free(x);
+                    goto done;
+                }
+                xml_free(x);
+            }
+            cprintf(cbret, "</error>");
+            xml_free(xerr);
+            xerr = NULL;
+        }
+        cprintf(cbret, "</edit>");
+    }
+    cprintf(cbret, "</rpc-reply>");
+ ok:
+    /* Unwind auto-lock if no changes made, ie put deny */
+    if (de &&
+        xmldb_modified_get(de) == 0 &&
+        clicon_option_bool(h, "CLICON_AUTOLOCK") &&
+        xmldb_islocked(h, target) == myid){
+        xmldb_unlock(h, target);
+        /* user callback */
+        if (clixon_plugin_lockdb_all(h, target, 0, myid) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (xerr)
+        xml_free(xerr);
+    if (cbvec){
+        for (i=0; i<elen; i++)
+            if (cbvec[i])
+                cbuf_free(cbvec[i]);
+        free(cbvec);
+    }
+    if (cbpvec)
+        free(cbpvec);
+    if (xvec)
+        free(xvec);
+    if (opvec)
+        free(opvec);
+    if (evec)
+        free(evec);
+    return retval;
+}
+
 /*! Create or replace an entire config with another complete config db
  *
  * @param[in]  h       Clixon handle
@@ -720,6 +1024,9 @@ from_client_copy_config(clixon_handle h,
         if (ret == 0)
             goto ok;
     }
+    /* Keep confirmed-commit rollback point before running is modified without commit */
+    if (strcmp(target, "running") == 0 && commit_history_release(h) < 0)
+        goto done;
     if (xmldb_copy(h, source, target) < 0){
         if ((cbmsg = cbuf_new()) == NULL){
             clixon_err(OE_UNIX, errno, "cbuf_new");
@@ -730,6 +1037,11 @@ from_client_copy_config(clixon_handle h,
             goto done;
         goto ok;
     }
+    /* Running modified without commit, history no longer applies */
+    if (strcmp(target, "running") == 0 && commit_history_clear(h) < 0)
+        goto done;
+    if (backend_config_change_notify(h, target) < 0)
+        goto done;
     if (xmldb_candidate_get(detarget)){
         xmldb_modified_set(detarget, 1); /* mark as dirty */
         /* Add system-only config to candidate */
@@ -842,6 +1154,8 @@ from_client_delete_config(clixon_handle h,
         }
         xmldb_modified_set(de, 1); /* mark as dirty */
     }
+    if (backend_config_change_notify(h, target) < 0)
+        goto done;
     cprintf(cbret, "<rpc-reply xmlns=\"%s\"><ok/></rpc-reply>", NETCONF_BASE_NAMESPACE);
  ok:
     retval = 0;
@@ -1072,6 +1386,44 @@ from_client_kill_session(clixon_handle h,
     return retval;
 }
 
+/*! Notify subscribers that a datastore has been modified
+ *
+ * The config-change notification is sent on the CLIXON-CONFIG stream, which only exists
+ * if CLICON_CLI_EXPAND_CACHE is set. Nothing is done if there are no subscribers.
+ * If CLICON_XMLDB_SNAPSHOT is set and running is modified, a new running snapshot is
+ * also published. The modification itself has succeeded, so a failure is only logged.
+ * @param[in]  h     Clixon handle
+ * @param[in]  db    Name of modified datastore
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see CLIXON_CONFIG_CHANGE_STREAM
+ */
+int
+backend_config_change_notify(clixon_handle h,
+                             const char   *db)
+{
+    int             retval = -1;
+    event_stream_t *es;
+
+    if (strcmp(db, "running") == 0 &&
+        clicon_option_bool(h, "CLICON_XMLDB_SNAPSHOT") &&
+        xmldb_snapshot_write(h, db) < 0){
+        clixon_log(h, LOG_WARNING, "%s: snapshot of %s: %s", __func__, db, clixon_err_reason());
+        clixon_err_reset();
+    }
+    if ((es = stream_find(h, CLIXON_CONFIG_CHANGE_STREAM)) == NULL ||
+        es->es_subscription == NULL)
+        goto ok;
+    if (stream_notify(h, CLIXON_CONFIG_CHANGE_STREAM,
+                      "<config-change xmlns=\"%s\"><datastore>%s</datastore></config-change>",
+                      CLIXON_LIB_NS, db) < 0)
+        goto done;
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
 /*! Create a notification subscription
  *
  * @param[in]  h       Clixon handle
@@ -1604,8 +1956,12 @@ from_client_msg(clixon_handle h,
     cbuf                *cbce = NULL;
     int                  ix;
     int                  ret;
+    struct timespec      ts = {0,};
+    clixon_arena        *ca = NULL;
+    clixon_arena        *ca0;
 
     clixon_debug(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, "");
+    clixon_profile_start(&ts);
     yspec = clicon_dbspec_yang(h);
     /* Return netconf message. Should be filled in by the dispatch(sub) functions
      * as wither rpc-error or by positive response.
@@ -1616,8 +1972,14 @@ from_client_msg(clixon_handle h,
     }
     /* Decode msg from client -> xml top (ct) and session id 
      * Bind is a part of the decode function
+     * If CLICON_BACKEND_REQUEST_ARENA is set, the request tree is allocated from an arena
+     * which is reset when the request is done
      */
-    if ((ret = clixon_xml_parse_string(msg, YB_RPC, yspec, &xt, &xret)) < 0){
+    clicon_ptr_get(h, "request-arena", (void**)&ca);
+    ca0 = xml_arena_set(ca);
+    ret = clixon_xml_parse_string(msg, YB_RPC, yspec, &xt, &xret);
+    xml_arena_set(ca0);
+    if (ret < 0){
         if (netconf_malformed_message(cbret, "XML parse error") < 0)
             goto done;
         goto reply;
@@ -1867,6 +2229,9 @@ from_client_msg(clixon_handle h,
             goto done;
         }
     }
+    /* Per-RPC latency including parsing and reply */
+    if (clixon_profile_rpc_stop(rpc, &ts) < 0)
+        goto done;
     // ok:
     retval = 0;
   done:
@@ -1890,6 +2255,9 @@ from_client_msg(clixon_handle h,
     if (retval < 0 && clixon_err_category() < 0)
         clixon_log(h, LOG_NOTICE, "%s: Internal error: No clixon_err call on RPC error (message: %s)",
                    __func__, rpc?rpc:"");
+    /* Release request tree memory in one go */
+    if (ca)
+        clixon_arena_reset(ca);
     //    clixon_debug(CLIXON_DBG_BACKEND, "retval:%d", retval);
     return retval;// -1 here terminates backend
 }
@@ -2004,6 +2372,10 @@ backend_rpc_init(clixon_handle h)
     if (rpc_callback_register(h, from_client_compare, NULL,
                       NETCONF_COMPARE_NAMESPACE, "compare") < 0)
         goto done;
+    /* Clixon extension: batch edit */
+    if (rpc_callback_register(h, from_client_batch_edit, NULL,
+                      CLIXON_LIB_NS, "batch-edit") < 0)
+        goto done;
     retval =0;
  done:
     return retval;
@@ -43,5 +43,6 @@
 int backend_client_rm(clixon_handle h, client_entry *ce);
 int from_client(int fd, void *arg);
 int backend_rpc_init(clixon_handle h);
+int backend_config_change_notify(clixon_handle h, const char *db);
 
 #endif  /* _BACKEND_CLIENT_H_ */
@@ -73,6 +73,7 @@
 #include "backend_state.h"
 #include "clixon_backend_commit.h"
 #include "backend_clixon_lib.h"
+#include "backend_client.h"
 #include "banned.h"
 
 /*! Set debug level.
@@ -374,6 +375,9 @@ from_client_restart_plugin(clixon_handle h,
         if (ret == 0)
             goto ok; /* cbret set */
     }
+    /* Plugin reset and commit callbacks may have modified running */
+    if (veclen && backend_config_change_notify(h, "running") < 0)
+        goto done;
     cprintf(cbret, "<rpc-reply xmlns=\"%s\"><ok/></rpc-reply>", NETCONF_BASE_NAMESPACE);
  ok:
     retval = 0;
@@ -290,6 +290,25 @@ compute_diffs(clixon_handle       h,
     return retval;
 }
 
+/*! Log elapsed time of a startup phase and restart the timer
+ *
+ * @param[in]     phase  Name of phase
+ * @param[in,out] t0     Start time of phase, set to now
+ */
+static void
+startup_phase_debug(const char     *phase,
+                    struct timeval *t0)
+{
+    struct timeval t;
+    struct timeval td;
+
+    gettimeofday(&t, NULL);
+    timersub(&t, t0, &td);
+    clixon_debug(CLIXON_DBG_BACKEND, "Startup phase %s: %lu.%06lus",
+                 phase, (unsigned long)td.tv_sec, (unsigned long)td.tv_usec);
+    *t0 = t;
+}
+
 /*! Common startup validation
  *
  * Get db, upgrade it w potential transformed XML, populate it w yang spec,
@@ -324,9 +343,13 @@ startup_common(clixon_handle       h,
     cxobj              *xt = NULL;
     cxobj              *xret = NULL;
     cxobj              *xerr = NULL;
+    clixon_xvec        *xdefer = NULL;
+    struct timeval      t0;
+    int                 i;
     int                 ret;
 
     clixon_debug(CLIXON_DBG_BACKEND, "Reading initial config from %s", db);
+    gettimeofday(&t0, NULL);
     /* Add system-only config to running */
     if ((td->td_src = xml_new(DATASTORE_TOP_SYMBOL, NULL, CX_ELMNT)) == NULL)
         goto done;
@@ -369,6 +392,7 @@ startup_common(clixon_handle       h,
         goto done;
     }
     clixon_debug(CLIXON_DBG_BACKEND, "Reading startup config done");
+    startup_phase_debug("read+upgrade", &t0);
     /* Clear flags xpath for get */
     xml_apply0(xt, CX_ELMNT, (xml_applyfn_t*)xml_flag_reset,
                (void*)(XML_FLAG_MARK|XML_FLAG_CHANGE));
@@ -407,36 +431,31 @@ startup_common(clixon_handle       h,
         xt = NULL;
         goto ok;
     }
-    /* After upgrading, XML tree needs to be sorted and yang spec populated */
-    if ((ret = xml_bind_yang(h, xt, YB_MODULE, yspec, 0, &xret)) < 0)
+    /* After upgrading, XML tree needs to be sorted and yang spec populated.
+     * Bind yang, check no state data, sort and apply default values in one pass */
+    if ((xdefer = clixon_xvec_new()) == NULL)
         goto done;
-    if (ret == 0){
-        if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
-            goto done;
-        goto fail;
-    }
-    /* After upgrade check no state data */
-    if ((ret = xml_non_config_data(xt, &xret)) < 0)
+    if ((ret = xml_bind_yang_bulk(h, xt, yspec, xdefer, &xret)) < 0)
         goto done;
     if (ret == 0){
         if (clixon_xml2cbuf1(cbret, xret, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
             goto done;
         goto fail;
     }
-    /* Sort xml */
-    if (xml_sort_recurse(xt) < 0)
-        goto done;
     /* Add global defaults. */
     if (xml_global_defaults(h, xt, NULL, NULL, yspec, 0) < 0)
         goto done;
-    /* Apply default values (removed in clear function) */
-    if (xml_default_recurse(xt, 0, 0) < 0)
-        goto done;
+    /* Apply when-dependent default values on complete tree, parents first */
+    for (i=clixon_xvec_len(xdefer)-1; i>=0; i--)
+        if (xml_default_node(clixon_xvec_i(xdefer, i), 0, NULL) < 0)
+            goto done;
+    startup_phase_debug("bind+sort+default", &t0);
     /* Handcraft transition with with only add tree */
     td->td_target = xt;
     xt = NULL;
     if (compute_diffs(h, td) < 0)
         goto done;
+    startup_phase_debug("diff", &t0);
     /* 4. Call plugin transaction start callbacks */
     if (plugin_transaction_begin_all(h, td) < 0)
         goto done;
@@ -458,9 +477,12 @@ startup_common(clixon_handle       h,
     /* 7. Call plugin transaction complete callbacks */
     if (plugin_transaction_complete_all(h, td) < 0)
         goto done;
+    startup_phase_debug("validate", &t0);
  ok:
     retval = 1;
  done:
+    if (xdefer)
+        clixon_xvec_free(xdefer);
     if (xerr)
         xml_free(xerr);
     if (xret)
@@ -642,6 +664,7 @@ validate_common(clixon_handle       h,
     yang_stmt  *yspec;
     db_elmnt   *de;
     int         ret;
+    struct timespec ts = {0,};
 
     if ((yspec = clicon_dbspec_yang(h)) == NULL){
         clixon_err(OE_FATAL, 0, "No DB_SPEC");
@@ -680,26 +703,38 @@ validate_common(clixon_handle       h,
         goto done;
     if (ret == 0)
         goto fail;
+    clixon_profile_start(&ts);
     if (compute_diffs(h, td) < 0)
         goto done;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_DIFF, &ts) < 0)
+        goto done;
     /* 4. Call plugin transaction start callbacks */
+    clixon_profile_start(&ts);
     if (plugin_transaction_begin_all(h, td) < 0)
         goto done;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_PLUGIN, &ts) < 0)
+        goto done;
 
     /* 5. Make generic validation on all new or changed data.
        Note this is only call that uses 3-values */
+    clixon_profile_start(&ts);
     if ((ret = generic_validate(h, yspec, td, xret)) < 0)
         goto done;
     if (ret == 0)
         goto fail;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_VALIDATE, &ts) < 0)
+        goto done;
 
     /* 6. Call plugin transaction validate callbacks */
+    clixon_profile_start(&ts);
     if (plugin_transaction_validate_all(h, td) < 0)
         goto done;
 
     /* 7. Call plugin transaction complete callbacks */
     if (plugin_transaction_complete_all(h, td) < 0)
         goto done;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_PLUGIN, &ts) < 0)
+        goto done;
     retval = 1;
  done:
     return retval;
@@ -806,8 +841,11 @@ candidate_commit(clixon_handle  h,
     yang_stmt          *yspec;
     db_elmnt           *de;
     int                 ret;
+    struct timespec     ts0 = {0,};
+    struct timespec     ts = {0,};
 
     clixon_debug(CLIXON_DBG_DATASTORE, "db: %s", db);
+    clixon_profile_start(&ts0);
     /* 1. Start transaction */
     if ((td = transaction_new()) == NULL)
         goto done;
@@ -844,15 +882,23 @@ candidate_commit(clixon_handle  h,
         goto fail;
     }
     /* 7. Call plugin transaction commit callbacks */
+    clixon_profile_start(&ts);
     if (plugin_transaction_commit_all(h, td) < 0)
         goto done;
     /* After commit, make a post-commit call (sure that all plugins have committed) */
     if (plugin_transaction_commit_done_all(h, td) < 0)
         goto done;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_PLUGIN, &ts) < 0)
+        goto done;
+    /* Record inverse diff while the source tree is valid */
+    if (commit_history_prepare(h, td, myid, xe) < 0)
+        goto done;
     /* 8. Success: Copy candidate to running
      */
     if (xmldb_copy(h, db, "running") < 0)
         goto done;
+    if (commit_history_add(h) < 0)
+        goto done;
     /* Remove system-only-config data from destination cache */
     if (clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")){
         xmldb_clear(h, "running");
@@ -865,6 +911,8 @@ candidate_commit(clixon_handle  h,
         goto done;
     }
     xmldb_modified_set(de, 0); /* reset dirty bit */
+    if (backend_config_change_notify(h, "running") < 0)
+        goto done;
     /* Here pointers to old (source) tree are obsolete */
     if (td->td_dvec){
         td->td_dlen = 0;
@@ -876,7 +924,12 @@ candidate_commit(clixon_handle  h,
         td->td_scvec = NULL;
     }
     /* 9. Call plugin transaction end callbacks */
+    clixon_profile_start(&ts);
     plugin_transaction_end_all(h, td);
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT_PLUGIN, &ts) < 0)
+        goto done;
+    if (clixon_profile_stop(CLIXON_PROF_COMMIT, &ts0) < 0)
+        goto done;
     retval = 1;
  done:
     /* In case of failure (or error), call plugin transaction termination callbacks */
@@ -1186,6 +1239,8 @@ from_client_discard_changes(clixon_handle h,
         goto ok;
     }
     xmldb_modified_set(de, 0); /* reset dirty bit */
+    if (backend_config_change_notify(h, db) < 0)
+        goto done;
     if (clicon_option_bool(h, "CLICON_AUTOLOCK")){
         xmldb_unlock(h, db);
     }
@@ -1297,6 +1352,8 @@ from_client_update(clixon_handle h,
         goto done;
     if (ret == 0)
         goto ok;
+    if (backend_config_change_notify(h, xmldb_name_get(de)) < 0)
+        goto done;
     cprintf(cbret, "<rpc-reply xmlns=\"%s\"><ok/></rpc-reply>", NETCONF_BASE_NAMESPACE);
  ok:
     retval = 0;
@@ -1339,12 +1396,22 @@ load_failsafe(clixon_handle h,
     /* Copy original running to tmp as backup (restore if error) */
     if (xmldb_copy_file(h, "running", "tmp") < 0)
         goto done;
+    /* Keep confirmed-commit rollback point before running is reset */
+    if (commit_history_release(h) < 0)
+        goto done;
     if (xmldb_db_reset(h, "running") < 0)
         goto done;
+    /* History does not apply to the reset running */
+    if (commit_history_clear(h) < 0)
+        goto done;
     ret = candidate_commit(h, NULL, db, 0, 0, cbret);
-    if (ret != 1)
+    if (ret != 1){
         if (xmldb_copy(h, "tmp", "running") < 0)
             goto done;
+        /* Running was reset and restored without commit: update snapshot and caches */
+        if (backend_config_change_notify(h, "running") < 0)
+            goto done;
+    }
     if (ret < 0)
         goto done;
     if (ret == 0){
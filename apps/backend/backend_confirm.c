@@ -392,7 +392,7 @@ cancel_confirmed_commit(clixon_handle h)
     }
 
     confirmed_commit_state_set(h, INACTIVE);
-
+    commit_history_unpin(h);
     if (xmldb_delete(h, "rollback") < 0)
         clixon_err(OE_DB, 0, "Error deleting the rollback configuration");
     return 0;
@@ -583,8 +583,14 @@ handle_confirmed_commit(clixon_handle h,
          *
          */
 
-        db_exists = xmldb_exists(h, "rollback");
-        if (db_exists == -1) {
+        if (commit_history_enabled(h)) {
+            /* Keep the commits since t=0 in the commit history instead of copying running,
+             * the rollback database is written from the history by do_rollback()
+             */
+            if (commit_history_pin(h) < 0)
+                goto done;
+        }
+        else if ((db_exists = xmldb_exists(h, "rollback")) == -1) {
             clixon_err(OE_DAEMON, 0, "there was an error while checking existence of the rollback database");
             goto done;
         } else if (db_exists == 0) {
@@ -605,6 +611,7 @@ handle_confirmed_commit(clixon_handle h,
         /* There was no subsequent confirmed-commit, meaning this is the end of the confirmed/confirming sequence;
          * The new configuration is already committed to running and the rollback database can now be deleted
          */
+        commit_history_unpin(h);
         if (xmldb_delete(h, "rollback") < 0) {
             clixon_err(OE_DB, 0, "Error deleting the rollback configuration");
             goto done;
@@ -619,6 +626,7 @@ handle_confirmed_commit(clixon_handle h,
 /*! Do a rollback of the running configuration to the state prior to initiation of a confirmed-commit
  *
  * The "running" configuration prior to the first confirmed-commit was stored in another database named "rollback".
+ * If commit history is enabled, the rollback database is instead written here from the history.
  * Here, it is committed as if it is the candidate configuration.
  *
  * Execution has arrived here because do_rollback() was called by one of:
@@ -658,6 +666,23 @@ do_rollback(clixon_handle h,
         confirmed_commit_persist_id_set(h, NULL);
     }
     confirmed_commit_state_set(h, ROLLBACK);
+    /* Rollback point kept in commit history: write it to the rollback database */
+    if (commit_history_pinned(h)) {
+        if (commit_history_pin_db(h, "rollback") < 0) {
+            clixon_log(h, LOG_CRIT, "An error occurred writing the rollback database from commit history.");
+            errstate |= ROLLBACK_NOT_APPLIED;
+            cbuf_free(cbret);
+            goto done;
+        }
+        commit_history_unpin(h);
+    }
+    else if (xmldb_exists(h, "rollback") != 1) {
+        /* Committing a missing rollback database would empty running */
+        clixon_log(h, LOG_CRIT, "Rollback was not performed, no rollback database found.");
+        errstate |= ROLLBACK_NOT_APPLIED;
+        cbuf_free(cbret);
+        goto done;
+    }
     if (candidate_commit(h, NULL, "rollback", 0, 0, cbret) < 0) { /* Assume validation fail, nofatal */
         /* theoretically, this should never error, since the rollback database was previously active and therefore
          * had itself been previously and successfully committed.
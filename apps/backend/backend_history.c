@@ -0,0 +1,942 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+ 
+  Copyright (C) 2009-2016 Olof Hagsand and Benny Holmgren
+  Copyright (C) 2017-2019 Olof Hagsand
+  Copyright (C) 2020-2022 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2, 
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+  Commit history
+  Each successful commit is recorded as an inverse patch of the running datastore,
+  computed from the diff vectors of the commit transaction:
+   - remove:  key-only copies of nodes added by the commit (td_avec)
+   - restore: copies of deleted subtrees (td_dvec) and old values of changed leafs (td_scvec)
+  Applying the patches of the latest N commits to running, newest first, gives the
+  configuration as it was before those N commits.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdarg.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <syslog.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include <clixon/clixon.h>
+
+#include "clixon_backend_transaction.h"
+#include "clixon_backend_plugin.h"
+#include "clixon_backend_client.h"
+#include "backend_handle.h"
+#include "clixon_backend_commit.h"
+#include "backend_client.h"
+#include "banned.h"
+
+/*
+ * Local types
+ */
+/* One recorded commit
+ * In the patch trees, XML_FLAG_DEL marks a node to remove and XML_FLAG_CHANGE a node
+ * that replaces its counterpart in running. Other nodes are merged.
+ */
+struct commit_history_entry {
+    qelem_t         ch_qelem;     /* List header */
+    uint32_t        ch_id;        /* Commit id, increasing */
+    char           *ch_user;      /* User that made the commit (or NULL) */
+    struct timeval  ch_time;      /* Time of commit */
+    char           *ch_comment;   /* Commit comment (or NULL) */
+    cxobj          *ch_remove;    /* Nodes added by commit */
+    cxobj          *ch_restore;   /* Nodes deleted or changed by commit (old values) */
+};
+
+/* Commit history of running, stored in handle as "commit-history" */
+struct commit_history {
+    struct commit_history_entry *chs_list;    /* Newest first */
+    int                          chs_len;     /* Length of list */
+    uint32_t                     chs_id;      /* Last assigned commit id */
+    struct commit_history_entry *chs_pending; /* Prepared but not yet committed */
+    int                          chs_pinned;  /* Confirmed-commit rollback point is set */
+    uint32_t                     chs_pin;     /* Id of last commit before rollback point */
+};
+
+static struct commit_history *
+history_get(clixon_handle h)
+{
+    struct commit_history *chs = NULL;
+
+    if (clicon_ptr_get(h, "commit-history", (void**)&chs) < 0)
+        return NULL;
+    return chs;
+}
+
+static int
+history_entry_free(struct commit_history_entry *ch)
+{
+    if (ch->ch_user)
+        free(ch->ch_user);
+    if (ch->ch_comment)
+        free(ch->ch_comment);
+    if (ch->ch_remove)
+        xml_free(ch->ch_remove);
+    if (ch->ch_restore)
+        xml_free(ch->ch_restore);
+    free(ch);
+    return 0;
+}
+
+/*! Mark diff vector nodes with TRANSIENT and their ancestors with MARK
+ *
+ * @param[in]  vec   Vector of XML nodes
+ * @param[in]  len   Length of vector
+ * @param[in]  set   1: set flags, 0: reset flags
+ * @note Ancestors are shared between nodes, stop when an ancestor is already (re)set
+ */
+static void
+history_mark(cxobj **vec,
+             size_t  len,
+             int     set)
+{
+    cxobj *xp;
+    size_t i;
+
+    for (i=0; i<len; i++){
+        if (set)
+            xml_flag_set(vec[i], XML_FLAG_TRANSIENT);
+        else
+            xml_flag_reset(vec[i], XML_FLAG_TRANSIENT);
+        xp = vec[i];
+        while ((xp = xml_parent(xp)) != NULL &&
+               (xml_flag(xp, XML_FLAG_MARK) == 0) == set){
+            if (set)
+                xml_flag_set(xp, XML_FLAG_MARK);
+            else
+                xml_flag_reset(xp, XML_FLAG_MARK);
+        }
+    }
+}
+
+/*! Copy an XML node into a patch tree
+ *
+ * @param[in]  x0    Node to copy
+ * @param[in]  xp    Parent in patch tree
+ * @param[in]  full  If set copy complete subtree, otherwise node, attributes and list keys
+ * @param[out] x1p   New node in patch tree
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+history_copy(cxobj  *x0,
+             cxobj  *xp,
+             int     full,
+             cxobj **x1p)
+{
+    int        retval = -1;
+    cxobj     *x1;
+    cxobj     *x;
+    cxobj     *xc;
+    yang_stmt *y;
+    char      *prefix;
+    int        ix;
+    int        ret;
+
+    if ((x1 = xml_new(xml_name(x0), xp, CX_ELMNT)) == NULL)
+        goto done;
+    if (full){
+        if (xml_copy(x0, x1) < 0)
+            goto done;
+        goto ok;
+    }
+    y = xml_spec(x0);
+    xml_spec_set(x1, y);
+    if ((prefix = xml_prefix(x0)) != NULL)
+        if (xml_prefix_set(x1, prefix) < 0)
+            goto done;
+    ix = 0;
+    while ((x = xml_child_iter_attr(x0, &ix)) != NULL) {
+        if ((xc = xml_new(xml_name(x), x1, CX_ATTR)) == NULL)
+            goto done;
+        if (xml_copy(x, xc) < 0)
+            goto done;
+    }
+    if (y && yang_keyword_get(y) == Y_LIST){
+        ix = 0;
+        while ((x = xml_child_iter(x0, &ix, CX_ELMNT)) != NULL) {
+            if ((ret = yang_key_match(y, xml_name(x), NULL)) < 0)
+                goto done;
+            if (ret == 0)
+                continue;
+            if ((xc = xml_new(xml_name(x), x1, CX_ELMNT)) == NULL)
+                goto done;
+            if (xml_copy(x, xc) < 0)
+                goto done;
+        }
+    }
+ ok:
+    if (x1p)
+        *x1p = x1;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Check if a deleted child of x is in an ordered-by user list or leaf-list
+ *
+ * Restoring such entries one by one does not restore their original order
+ */
+static int
+history_user_ordered(cxobj *x)
+{
+    cxobj     *xc;
+    yang_stmt *yc;
+    int        ix = 0;
+
+    while ((xc = xml_child_iter(x, &ix, CX_ELMNT)) != NULL) {
+        if (xml_flag(xc, XML_FLAG_TRANSIENT) == 0 ||
+            (yc = xml_spec(xc)) == NULL)
+            continue;
+        if ((yang_keyword_get(yc) == Y_LIST || yang_keyword_get(yc) == Y_LEAF_LIST) &&
+            yang_find(yc, Y_ORDERED_BY, "user") != NULL)
+            return 1;
+    }
+    return 0;
+}
+
+/*! Build inverse patch from a marked XML tree
+ *
+ * @param[in]  x0       Marked source (restore) or target (remove) XML tree
+ * @param[in]  x1       Patch tree
+ * @param[in]  restore  1: copy marked nodes, 0: add key-only remove nodes
+ * @retval     0        OK
+ * @retval    -1        Error
+ * @see history_mark
+ */
+static int
+history_patch_build(cxobj *x0,
+                    cxobj *x1,
+                    int    restore)
+{
+    int        retval = -1;
+    cxobj     *x0c;
+    cxobj     *x1c;
+    yang_stmt *yc;
+    int        ix;
+
+    ix = 0;
+    while ((x0c = xml_child_iter(x0, &ix, CX_ELMNT)) != NULL) {
+        if (xml_flag(x0c, XML_FLAG_TRANSIENT)){
+            if (restore){
+                if (history_copy(x0c, x1, 1, NULL) < 0)
+                    goto done;
+            }
+            else {
+                /* Leaf-list entries are identified by value */
+                yc = xml_spec(x0c);
+                if (history_copy(x0c, x1, yc && yang_keyword_get(yc) == Y_LEAF_LIST, &x1c) < 0)
+                    goto done;
+                xml_flag_set(x1c, XML_FLAG_DEL);
+            }
+        }
+        else if (xml_flag(x0c, XML_FLAG_MARK)){
+            if (restore && history_user_ordered(x0c)){
+                if (history_copy(x0c, x1, 1, &x1c) < 0)
+                    goto done;
+                xml_flag_set(x1c, XML_FLAG_CHANGE);
+                continue;
+            }
+            if (history_copy(x0c, x1, 0, &x1c) < 0)
+                goto done;
+            if (history_patch_build(x0c, x1c, restore) < 0)
+                goto done;
+        }
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Apply one patch tree to an XML tree
+ *
+ * @param[in]  x0   XML tree, typically a datastore cache, sorted
+ * @param[in]  xp   Patch tree
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+history_patch_apply(cxobj *x0,
+                    cxobj *xp)
+{
+    int        retval = -1;
+    cxobj     *xpc;
+    cxobj     *x0c;
+    cxobj     *xn;
+    yang_stmt *yc;
+    int        ix;
+
+    ix = 0;
+    while ((xpc = xml_child_iter(xp, &ix, CX_ELMNT)) != NULL) {
+        yc = xml_spec(xpc);
+        x0c = NULL;
+        if (match_base_child(x0, xpc, yc, &x0c) < 0)
+            goto done;
+        if (xml_flag(xpc, XML_FLAG_DEL)){
+            if (x0c && xml_purge(x0c) < 0)
+                goto done;
+            continue;
+        }
+        if (x0c != NULL &&
+            (xml_flag(xpc, XML_FLAG_CHANGE) ||
+             (yc && yang_keyword_get(yc) == Y_LEAF))){
+            if (xml_purge(x0c) < 0)
+                goto done;
+            x0c = NULL;
+        }
+        if (x0c == NULL){
+            if ((xn = xml_dup(xpc)) == NULL)
+                goto done;
+            if (xml_insert(x0, xn, INS_LAST, NULL, NULL) < 0){
+                xml_free(xn);
+                goto done;
+            }
+        }
+        else if (history_patch_apply(x0c, xpc) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Apply the inverse patches of the newest commits to an XML tree
+ *
+ * @param[in]  chs  Commit history
+ * @param[in]  xt   XML tree, a copy of running
+ * @param[in]  nr   Number of commits to undo
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+history_apply(struct commit_history *chs,
+              cxobj                 *xt,
+              int                    nr)
+{
+    int                          retval = -1;
+    struct commit_history_entry *ch;
+    int                          i;
+
+    if (nr > chs->chs_len){
+        clixon_err(OE_CFG, EINVAL, "Commit history has only %d entries", chs->chs_len);
+        goto done;
+    }
+    ch = chs->chs_list;
+    for (i=0; i<nr; i++){
+        if (history_patch_apply(xt, ch->ch_remove) < 0)
+            goto done;
+        if (history_patch_apply(xt, ch->ch_restore) < 0)
+            goto done;
+        ch = NEXTQ(struct commit_history_entry *, ch);
+    }
+    if (xml_default_recurse(xt, 0, 0) < 0)
+        goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Check if commit history is enabled
+ *
+ * @param[in]  h   Clixon handle
+ * @retval     1   Enabled
+ * @retval     0   Not enabled
+ */
+int
+commit_history_enabled(clixon_handle h)
+{
+    return history_get(h) != NULL && clicon_option_int(h, "CLICON_COMMIT_HISTORY") > 0;
+}
+
+/*! Record the inverse patch of a commit before running is replaced
+ *
+ * Must be called while the source tree of the transaction is still valid, ie before
+ * the target is copied to running. The entry is added by commit_history_add().
+ * @param[in]  h     Clixon handle
+ * @param[in]  td    Transaction with computed diff
+ * @param[in]  myid  Session id of committing client, or 0
+ * @param[in]  xe    Commit request, may have comment attribute, or NULL
+ * @retval     0     OK
+ * @retval    -1    Error
+ */
+int
+commit_history_prepare(clixon_handle       h,
+                       transaction_data_t *td,
+                       uint32_t            myid,
+                       cxobj              *xe)
+{
+    int                          retval = -1;
+    struct commit_history       *chs;
+    struct commit_history_entry *ch = NULL;
+    client_entry                *ce;
+    char                        *str;
+
+    if (!commit_history_enabled(h))
+        goto ok;
+    chs = history_get(h);
+    if (chs->chs_pending){
+        history_entry_free(chs->chs_pending);
+        chs->chs_pending = NULL;
+    }
+    if ((ch = calloc(1, sizeof(*ch))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        goto done;
+    }
+    gettimeofday(&ch->ch_time, NULL);
+    if ((ce = backend_client_find(h, myid)) != NULL && ce->ce_username != NULL)
+        if ((ch->ch_user = strdup(ce->ce_username)) == NULL){
+            clixon_err(OE_UNIX, errno, "strdup");
+            goto done;
+        }
+    if (xe != NULL && (str = xml_find_value(xe, "comment")) != NULL)
+        if ((ch->ch_comment = strdup(str)) == NULL){
+            clixon_err(OE_UNIX, errno, "strdup");
+            goto done;
+        }
+    if ((ch->ch_remove = xml_new(NETCONF_INPUT_CONFIG, NULL, CX_ELMNT)) == NULL)
+        goto done;
+    if ((ch->ch_restore = xml_new(NETCONF_INPUT_CONFIG, NULL, CX_ELMNT)) == NULL)
+        goto done;
+    if (td->td_target){
+        history_mark(td->td_avec, td->td_alen, 1);
+        retval = history_patch_build(td->td_target, ch->ch_remove, 0);
+        history_mark(td->td_avec, td->td_alen, 0);
+        if (retval < 0)
+            goto done;
+        retval = -1;
+    }
+    if (td->td_src){
+        history_mark(td->td_dvec, td->td_dlen, 1);
+        history_mark(td->td_scvec, td->td_clen, 1);
+        retval = history_patch_build(td->td_src, ch->ch_restore, 1);
+        history_mark(td->td_dvec, td->td_dlen, 0);
+        history_mark(td->td_scvec, td->td_clen, 0);
+        if (retval < 0)
+            goto done;
+        retval = -1;
+    }
+    chs->chs_pending = ch;
+    ch = NULL;
+ ok:
+    retval = 0;
+ done:
+    if (ch)
+        history_entry_free(ch);
+    return retval;
+}
+
+/*! Add prepared commit to history after running has been replaced
+ *
+ * Drop the oldest entries above CLICON_COMMIT_HISTORY, but never those needed to
+ * reach an ongoing confirmed-commit rollback point.
+ * @param[in]  h     Clixon handle
+ * @retval     0     OK
+ * @retval    -1    Error
+ * @see commit_history_prepare
+ */
+int
+commit_history_add(clixon_handle h)
+{
+    struct commit_history       *chs;
+    struct commit_history_entry *ch;
+    int                          max;
+
+    if ((chs = history_get(h)) == NULL || (ch = chs->chs_pending) == NULL)
+        return 0;
+    chs->chs_pending = NULL;
+    ch->ch_id = ++chs->chs_id;
+    INSQ(ch, chs->chs_list);
+    chs->chs_len++;
+    max = clicon_option_int(h, "CLICON_COMMIT_HISTORY");
+    while (chs->chs_len > max){
+        ch = PREVQ(struct commit_history_entry *, chs->chs_list);
+        if (chs->chs_pinned && ch->ch_id > chs->chs_pin)
+            break;
+        DELQ(ch, chs->chs_list, struct commit_history_entry *);
+        history_entry_free(ch);
+        chs->chs_len--;
+    }
+    return 0;
+}
+
+/*! Release confirmed-commit rollback point before running is modified without a commit
+ *
+ * If a rollback point is set, it is written to the rollback datastore while running and
+ * the history still match, and do_rollback() then commits that datastore as usual.
+ * @param[in]  h     Clixon handle
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see commit_history_clear
+ */
+int
+commit_history_release(clixon_handle h)
+{
+    int retval = -1;
+
+    if (commit_history_pinned(h)){
+        if (commit_history_pin_db(h, "rollback") < 0)
+            goto done;
+        commit_history_unpin(h);
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Clear commit history, eg when running is modified without a commit
+ *
+ * @param[in]  h     Clixon handle
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @note Call commit_history_release() before running is modified, otherwise a rollback
+ *       point is written from the modified running
+ */
+int
+commit_history_clear(clixon_handle h)
+{
+    int                          retval = -1;
+    struct commit_history       *chs;
+    struct commit_history_entry *ch;
+
+    if ((chs = history_get(h)) == NULL)
+        goto ok;
+    if (commit_history_release(h) < 0)
+        goto done;
+    while ((ch = chs->chs_list) != NULL){
+        DELQ(ch, chs->chs_list, struct commit_history_entry *);
+        history_entry_free(ch);
+    }
+    chs->chs_len = 0;
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Write configuration as it was before the latest commits to a datastore
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  nr    Number of commits to undo, 0 is running
+ * @param[in]  db    Datastore to write to, eg candidate
+ * @retval     0     OK
+ * @retval    -1    Error
+ */
+int
+commit_history_db(clixon_handle h,
+                  int           nr,
+                  const char   *db)
+{
+    int                    retval = -1;
+    struct commit_history *chs;
+    db_elmnt              *de;
+    cxobj                 *xt = NULL;
+
+    if ((chs = history_get(h)) == NULL){
+        clixon_err(OE_CFG, 0, "Commit history not enabled");
+        goto done;
+    }
+    if (xmldb_copy(h, "running", db) < 0)
+        goto done;
+    if ((de = xmldb_find(h, db)) == NULL){
+        clixon_err(OE_DB, 0, "DB not found %s", db);
+        goto done;
+    }
+    if (xmldb_get_cache(h, db, &xt, NULL) < 0)
+        goto done;
+    if (xt == NULL){
+        clixon_err(OE_DB, 0, "DB cache not found %s", db);
+        goto done;
+    }
+    if (history_apply(chs, xt, nr) < 0)
+        goto done;
+    xmldb_modified_set(de, 1);
+    if (xmldb_cache_status_get(de) != XMLDB_CACHE_INMEM)
+        if (xmldb_write_cache2file(h, db) < 0)
+            goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Set confirmed-commit rollback point to current running
+ *
+ * Instead of copying running to the rollback datastore, the commits after this point
+ * are kept in the history until the rollback point is released
+ * @param[in]  h     Clixon handle
+ * @retval     0     OK
+ */
+int
+commit_history_pin(clixon_handle h)
+{
+    struct commit_history *chs;
+
+    if ((chs = history_get(h)) != NULL && chs->chs_pinned == 0){
+        chs->chs_pinned = 1;
+        chs->chs_pin = chs->chs_id;
+    }
+    return 0;
+}
+
+/*! Release confirmed-commit rollback point
+ *
+ * @param[in]  h     Clixon handle
+ * @retval     0     OK
+ */
+int
+commit_history_unpin(clixon_handle h)
+{
+    struct commit_history *chs;
+
+    if ((chs = history_get(h)) != NULL)
+        chs->chs_pinned = 0;
+    return 0;
+}
+
+/*! Check if a confirmed-commit rollback point is set
+ *
+ * @param[in]  h     Clixon handle
+ * @retval     1     Set
+ * @retval     0     Not set
+ */
+int
+commit_history_pinned(clixon_handle h)
+{
+    struct commit_history *chs;
+
+    if ((chs = history_get(h)) == NULL)
+        return 0;
+    return chs->chs_pinned;
+}
+
+/*! Write configuration at confirmed-commit rollback point to a datastore
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  db    Datastore, eg rollback
+ * @retval     0     OK
+ * @retval    -1    Error
+ */
+int
+commit_history_pin_db(clixon_handle h,
+                      const char   *db)
+{
+    int                          retval = -1;
+    struct commit_history       *chs;
+    struct commit_history_entry *ch;
+    int                          nr = 0;
+
+    if ((chs = history_get(h)) == NULL || chs->chs_pinned == 0){
+        clixon_err(OE_CFG, 0, "No commit history rollback point");
+        goto done;
+    }
+    if ((ch = chs->chs_list) != NULL){
+        do {
+            if (ch->ch_id <= chs->chs_pin)
+                break;
+            nr++;
+            ch = NEXTQ(struct commit_history_entry *, ch);
+        } while (ch != chs->chs_list);
+    }
+    if (commit_history_db(h, nr, db) < 0)
+        goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Get commit history and optionally configuration at one history point
+ *
+ * @param[in]  h       Clixon handle
+ * @param[in]  xe      Request: <rpc><xn></rpc>
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @param[in]  arg     client-entry
+ * @param[in]  regarg  User argument given at rpc_callback_register()
+ * @retval     0       OK
+ * @retval    -1       Error
+ */
+static int
+from_client_commit_history(clixon_handle h,
+                           cxobj        *xe,
+                           cbuf         *cbret,
+                           void         *arg,
+                           void         *regarg)
+{
+    int                          retval = -1;
+    struct commit_history       *chs;
+    struct commit_history_entry *ch;
+    char                        *str;
+    uint32_t                     index = 0;
+    cxobj                       *xrun = NULL;
+    cxobj                       *xt = NULL;
+    cxobj                       *xnacm;
+    char                         timestr[28];
+    int                          i;
+    int                          ret;
+
+    if ((chs = history_get(h)) == NULL){
+        if (netconf_operation_not_supported(cbret, "application", "Commit history not enabled") < 0)
+            goto done;
+        goto ok;
+    }
+    if ((str = xml_find_body(xe, "index")) != NULL){
+        if ((ret = netconf_parse_uint32("index", str, NULL, 0, cbret, &index)) < 0)
+            goto done;
+        if (ret == 0)
+            goto ok;
+        if (index > chs->chs_len){
+            if (netconf_invalid_value(cbret, "application", "Index beyond commit history") < 0)
+                goto done;
+            goto ok;
+        }
+    }
+    cprintf(cbret, "<rpc-reply xmlns=\"%s\">", NETCONF_BASE_NAMESPACE);
+    if ((ch = chs->chs_list) != NULL){
+        i = 1;
+        do {
+            cprintf(cbret, "<commit xmlns=\"%s\">", CLIXON_LIB_NS);
+            cprintf(cbret, "<index>%d</index>", i);
+            cprintf(cbret, "<id>%u</id>", ch->ch_id);
+            if (ch->ch_user){
+                cprintf(cbret, "<username>");
+                if (xml_chardata_cbuf_append(cbret, 0, ch->ch_user) < 0)
+                    goto done;
+                cprintf(cbret, "</username>");
+            }
+            if (time2str(&ch->ch_time, timestr, sizeof(timestr)) < 0){
+                clixon_err(OE_UNIX, errno, "time2str");
+                goto done;
+            }
+            cprintf(cbret, "<timestamp>%s</timestamp>", timestr);
+            if (ch->ch_comment){
+                cprintf(cbret, "<comment>");
+                if (xml_chardata_cbuf_append(cbret, 0, ch->ch_comment) < 0)
+                    goto done;
+                cprintf(cbret, "</comment>");
+            }
+            cprintf(cbret, "</commit>");
+            ch = NEXTQ(struct commit_history_entry *, ch);
+            i++;
+        } while (ch != chs->chs_list);
+    }
+    if (str != NULL){
+        if (xmldb_get_cache(h, "running", &xrun, NULL) < 0)
+            goto done;
+        if (xrun != NULL){
+            if ((xt = xml_dup(xrun)) == NULL)
+                goto done;
+            if (history_apply(chs, xt, index) < 0)
+                goto done;
+            /* NACM datanode read validation, same as get-config */
+            if ((xnacm = clicon_nacm_cache(h)) != NULL){
+                if (nacm_datanode_read1(h, xt, clicon_username_get(h), xnacm) < 0)
+                    goto done;
+                if (nacm_datanode_read_prune(h, xt) < 0)
+                    goto done;
+            }
+        }
+        cprintf(cbret, "<config xmlns=\"%s\">", CLIXON_LIB_NS);
+        if (xt && clixon_xml2cbuf1(cbret, xt, 0, 0, NULL, -1, 1, 0, WITHDEFAULTS_EXPLICIT) < 0)
+            goto done;
+        cprintf(cbret, "</config>");
+    }
+    cprintf(cbret, "</rpc-reply>");
+ ok:
+    retval = 0;
+ done:
+    if (xt)
+        xml_free(xt);
+    return retval;
+}
+
+/*! Load configuration before the latest commits into candidate
+ *
+ * The candidate is replaced, and is activated with a regular commit
+ * @param[in]  h       Clixon handle
+ * @param[in]  xe      Request: <rpc><xn></rpc>
+ * @param[out] cbret   Return xml tree, eg <rpc-reply>..., <rpc-error..
+ * @param[in]  arg     client-entry
+ * @param[in]  regarg  User argument given at rpc_callback_register()
+ * @retval     0       OK
+ * @retval    -1       Error
+ * @note NACM data node write access is checked on candidate, same as edit-config replace
+ */
+static int
+from_client_rollback(clixon_handle h,
+                     cxobj        *xe,
+                     cbuf         *cbret,
+                     void         *arg,
+                     void         *regarg)
+{
+    int                    retval = -1;
+    client_entry          *ce = (client_entry *)arg;
+    struct commit_history *chs;
+    cbuf                  *cbx = NULL;
+    char                  *str;
+    uint32_t               index = 0;
+    uint32_t               iddb;
+    db_elmnt              *de;
+    char                  *db;
+    cxobj                 *xrun = NULL;
+    cxobj                 *xt = NULL;
+    int                    ret;
+
+    if ((chs = history_get(h)) == NULL){
+        if (netconf_operation_not_supported(cbret, "application", "Commit history not enabled") < 0)
+            goto done;
+        goto ok;
+    }
+    if ((str = xml_find_body(xe, "index")) == NULL){
+        if (netconf_missing_element(cbret, "protocol", "index", NULL) < 0)
+            goto done;
+        goto ok;
+    }
+    if ((ret = netconf_parse_uint32("index", str, NULL, 0, cbret, &index)) < 0)
+        goto done;
+    if (ret == 0)
+        goto ok;
+    if (index > chs->chs_len){
+        if (netconf_invalid_value(cbret, "application", "Index beyond commit history") < 0)
+            goto done;
+        goto ok;
+    }
+    if (xmldb_find_create(h, "candidate", ce->ce_id, &de, &db) < 0)
+        goto done;
+    iddb = xmldb_islocked(h, db);
+    if (iddb && ce->ce_id != iddb){
+        if ((cbx = cbuf_new()) == NULL){
+            clixon_err(OE_XML, errno, "cbuf_new");
+            goto done;
+        }
+        cprintf(cbx, "<session-id>%u</session-id>", iddb);
+        cprintf(cbx, "<db>%s</db>", db);
+        if (netconf_lock_denied(cbret, cbuf_get(cbx), "Rollback failed, lock is already held") < 0)
+            goto done;
+        goto ok;
+    }
+    if (xmldb_get_cache(h, "running", &xrun, NULL) < 0)
+        goto done;
+    if (xrun != NULL)
+        xt = xml_dup(xrun);
+    else
+        xt = xml_new(NETCONF_INPUT_CONFIG, NULL, CX_ELMNT);
+    if (xt == NULL)
+        goto done;
+    if (history_apply(chs, xt, index) < 0)
+        goto done;
+    if (xml_name_set(xt, NETCONF_INPUT_CONFIG) < 0)
+        goto done;
+    /* Replace candidate as edit-config, ie with NACM data node write check */
+    if ((ret = xmldb_put(h, db, OP_REPLACE, xt, clicon_username_get(h), cbret)) < 0){
+        if (netconf_operation_failed(cbret, "application", "%s", clixon_err_reason())< 0)
+            goto done;
+        goto ok;
+    }
+    if (ret == 0)
+        goto ok;
+    xmldb_modified_set(de, 1); /* mark as dirty */
+    if (backend_config_change_notify(h, db) < 0)
+        goto done;
+    cprintf(cbret, "<rpc-reply xmlns=\"%s\"><ok/></rpc-reply>", NETCONF_BASE_NAMESPACE);
+ ok:
+    retval = 0;
+ done:
+    if (xt)
+        xml_free(xt);
+    if (cbx)
+        cbuf_free(cbx);
+    return retval;
+}
+
+/*! Initialize commit history if CLICON_COMMIT_HISTORY is set
+ *
+ * @param[in]  h   Clixon handle
+ * @retval     0   OK
+ * @retval    -1   Error
+ */
+int
+commit_history_init(clixon_handle h)
+{
+    int                    retval = -1;
+    struct commit_history *chs = NULL;
+
+    if (clicon_option_int(h, "CLICON_COMMIT_HISTORY") > 0){
+        if ((chs = calloc(1, sizeof(*chs))) == NULL){
+            clixon_err(OE_UNIX, errno, "calloc");
+            goto done;
+        }
+        if (clicon_ptr_set(h, "commit-history", chs) < 0)
+            goto done;
+    }
+    if (rpc_callback_register(h, from_client_commit_history, NULL,
+                              CLIXON_LIB_NS, "commit-history") < 0)
+        goto done;
+    if (rpc_callback_register(h, from_client_rollback, NULL,
+                              CLIXON_LIB_NS, "rollback") < 0)
+        goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Free commit history
+ *
+ * @param[in]  h  Clixon handle
+ * @retval     0  OK
+ */
+int
+commit_history_free(clixon_handle h)
+{
+    struct commit_history *chs;
+
+    if ((chs = history_get(h)) == NULL)
+        return 0;
+    commit_history_clear(h);
+    if (chs->chs_pending)
+        history_entry_free(chs->chs_pending);
+    free(chs);
+    clicon_ptr_del(h, "commit-history");
+    return 0;
+}
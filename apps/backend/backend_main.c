@@ -101,6 +101,7 @@ backend_terminate(clixon_handle h)
     struct stat st;
     int         ss;
     cvec       *nsctx;
+    clixon_arena *ca;
 
     clixon_debug(CLIXON_DBG_BACKEND, "");
     if ((ss = clicon_socket_get(h)) != -1)
@@ -123,6 +124,7 @@ backend_terminate(clixon_handle h)
     if ((x = clicon_conf_xml(h)) != NULL)
         xml_free(x);
     confirmed_commit_free(h);
+    commit_history_free(h);
     stream_publish_exit();
     /* Delete all plugins, RPC callbacks, and upgrade callbacks */
     clixon_plugin_module_exit(h);
@@ -130,7 +132,14 @@ backend_terminate(clixon_handle h)
     clixon_process_delete_all(h);
 
     xpath_optimize_exit();
+    clixon_profile_exit();
+    if (clicon_ptr_get(h, "request-arena", (void**)&ca) == 0){
+        clixon_arena_free(ca);
+        clicon_ptr_del(h, "request-arena");
+    }
     clixon_pagination_free(h);
+    clixon_statedata_free(h);
+    clixon_plugin_subtree_free(h);
     if (pidfile)
         unlink(pidfile);
     if (sockfamily==AF_UNIX && lstat(sockpath, &st) == 0)
@@ -138,6 +147,9 @@ backend_terminate(clixon_handle h)
     clixon_event_exit();
     clixon_debug(CLIXON_DBG_BACKEND, "done");
     stream_delete_all(h, 1);
+    /* Frontends should not read a snapshot without a backend */
+    if (clicon_option_bool(h, "CLICON_XMLDB_SNAPSHOT"))
+        xmldb_snapshot_delete(h, "running");
     xmldb_delete_pattern(h, "^candidate");
     xmldb_disconnect(h);
     clixon_err_exit();
@@ -467,6 +479,7 @@ main(int    argc,
     int           print_version = 0;
     int32_t       d;
     int           autocli_cache_clear = 1;
+    clixon_arena *ca;
 
     /* Initiate CLICON handle */
     if ((h = backend_handle_init()) == NULL)
@@ -859,6 +872,10 @@ main(int    argc,
     /* Set up standard netconf rpc callbacks */
     if (backend_rpc_init(h) < 0)
         goto done;
+    /* Datastore change stream for CLI completion caches */
+    if (clicon_option_bool(h, "CLICON_CLI_EXPAND_CACHE") &&
+        stream_add(h, CLIXON_CONFIG_CHANGE_STREAM, "Clixon datastore change notifications", 0, NULL) < 0)
+        goto done;
     /* Setup other rpc callbacks */
     if (backend_commit_init(h) < 0)
         goto done;
@@ -866,6 +883,8 @@ main(int    argc,
         goto done;
     if (backend_clixon_cache_init(h) < 0)
         goto done;
+    if (commit_history_init(h) < 0)
+        goto done;
 
     /* Must be after netconf_module_load, but before startup code */
     if (clicon_option_bool(h, "CLICON_XML_CHANGELOG"))
@@ -913,6 +932,10 @@ main(int    argc,
             startup_mode = SM_RUNNING;
     if (xmldb_delete_pattern(h, "^candidate") < 0)
         goto done;
+    /* Remove any stale snapshot from a previous backend, a new is published after startup */
+    if (clicon_option_bool(h, "CLICON_XMLDB_SNAPSHOT") &&
+        xmldb_snapshot_delete(h, "running") < 0)
+        goto done;
     /* If startup fails, lib functions report invalidation info in a cbuf */
     if ((cbret = cbuf_new()) == NULL){
         clixon_err(OE_XML, errno, "cbuf_new");
@@ -1014,6 +1037,10 @@ main(int    argc,
     /* Set startup status */
     if (clicon_startup_status_set(h, status) < 0)
         goto done;
+    /* Publish initial running snapshot for frontends */
+    if (clicon_option_bool(h, "CLICON_XMLDB_SNAPSHOT") &&
+        xmldb_snapshot_write(h, "running") < 0)
+        goto done;
 
     if (status == STARTUP_INVALID && cbuf_len(cbret))
         clixon_log(h, LOG_NOTICE, "%s: %u %s", __PROGRAM__, getpid(), cbuf_get(cbret));
@@ -1100,6 +1127,16 @@ main(int    argc,
     /* Just before event-loop, after socket bind/listen */
     if (netconf_monitoring_statistics_init(h) < 0)
         goto done;
+    /* Profiling of runtime, not of startup */
+    if (clicon_option_bool(h, "CLICON_BACKEND_PROFILE"))
+        clixon_profile_enable(1);
+    /* Arena for XML trees of incoming requests, see from_client_msg */
+    if (clicon_option_bool(h, "CLICON_BACKEND_REQUEST_ARENA")){
+        if ((ca = clixon_arena_new(0)) == NULL)
+            goto done;
+        if (clicon_ptr_set(h, "request-arena", ca) < 0)
+            goto done;
+    }
     clixon_log(h, LOG_NOTICE, "%s: %u Started", __PROGRAM__, getpid());
     if (clixon_event_loop(h) < 0)
         goto done;
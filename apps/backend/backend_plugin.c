@@ -43,6 +43,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <ctype.h>
+#include <time.h>
 #include <stdarg.h>
 #include <dlfcn.h>
 #include <unistd.h>
@@ -53,6 +55,9 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 #include <netinet/in.h>
+#ifdef HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
 
 /* cligen */
 #include <cligen/cligen.h>
@@ -66,6 +71,29 @@
 #include "clixon_backend_commit.h"
 #include "banned.h"
 
+/* Run validate/commit callbacks of plugins flagged with CLIXON_PLUGIN_TRANS_PARALLEL
+ * concurrently in worker threads
+ */
+#if defined(HAVE_LIBPTHREAD) && defined(PLUGIN_TRANS_PARALLEL_MAX)
+#define PLUGIN_TRANS_THREADS
+#endif
+
+#ifdef PLUGIN_TRANS_THREADS
+/*! A plugin callback call in a parallel batch
+ */
+struct plugin_worker {
+    clixon_handle       pw_h;
+    clixon_plugin_t    *pw_cp;      /* Plugin */
+    trans_cb_t         *pw_fn;      /* Validate or commit callback */
+    transaction_data_t *pw_td;      /* Transaction data, read-only */
+    int                 pw_nr;      /* Plugin number in list, starting with 1 */
+    pthread_t           pw_thread;
+    int                 pw_thread_ok; /* Callback called in worker thread */
+    int                 pw_rv;      /* Callback return value */
+    void               *pw_err;     /* Saved error state if pw_rv < 0 */
+};
+#endif
+
 /*! Request plugins to reset system state
  *
  * The system 'state' should be the same as the contents of running_db
@@ -319,10 +347,332 @@ clixon_plugin_statedata_one(clixon_plugin_t *cp,
     goto done;
 }
 
+/*! Path-scoped state data provider
+ *
+ * Registered with clixon_statedata_cb_register(). A provider is only called if the
+ * request xpath intersects its registered path. If sp_ttl is set, the bound state
+ * tree of the provider is cached and re-used for sp_ttl milliseconds.
+ */
+typedef struct {
+    qelem_t          sp_qelem;  /* List header */
+    plgstatedata_t  *sp_fn;     /* State data callback */
+    char            *sp_xpath;  /* Registered XPath using canonical prefixes */
+    char            *sp_path;   /* Registered XPath with predicates stripped */
+    uint32_t         sp_ttl;    /* Cache time-to-live in ms, 0: no cache */
+    cxobj           *sp_cache;  /* Cached bound state tree, or NULL */
+    struct timespec  sp_time;   /* When sp_cache was created */
+} statedata_provider_t;
+
+/*! Strip predicates from a simple location path
+ *
+ * A simple location path is an absolute path of child steps with optional predicates,
+ * eg /a:x/a:y[a:k='1']/a:z which is stripped to /a:x/a:y/a:z
+ * @param[in]  xpath  XPath
+ * @param[out] cb     Stripped path
+ * @retval     1      Simple path, stripped path in cb
+ * @retval     0      Not a simple path, eg // or | or functions
+ */
+static int
+statedata_path_strip(const char *xpath,
+                     cbuf       *cb)
+{
+    int  pred = 0;    /* Predicate nesting level */
+    char quote = 0;   /* Quote character inside predicate, or 0 */
+    char c;
+    int  i;
+
+    if (xpath == NULL || xpath[0] != '/')
+        return 0;
+    for (i=0; (c = xpath[i]) != '\0'; i++){
+        if (quote){
+            if (c == quote)
+                quote = 0;
+        }
+        else if (pred){
+            if (c == '\'' || c == '"')
+                quote = c;
+            else if (c == '[')
+                pred++;
+            else if (c == ']')
+                pred--;
+        }
+        else if (c == '[')
+            pred++;
+        else if (c == '/'){
+            if (xpath[i+1] == '/' || xpath[i+1] == '.')
+                return 0;
+            if (xpath[i+1] != '\0' || i == 0)
+                cbuf_append(cb, c);
+        }
+        else if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == ':')
+            cbuf_append(cb, c);
+        else
+            return 0;
+    }
+    if (pred || quote)
+        return 0;
+    return 1;
+}
+
+/*! Check if two stripped paths intersect, ie one is equal to or an ancestor of the other
+ *
+ * @param[in]  p0   Stripped path
+ * @param[in]  p1   Stripped path
+ * @retval     1    Paths intersect
+ * @retval     0    Paths are disjoint
+ */
+static int
+statedata_path_intersect(const char *p0,
+                         const char *p1)
+{
+    size_t len0 = strlen(p0);
+    size_t len1 = strlen(p1);
+
+    if (strcmp(p0, "/") == 0 || strcmp(p1, "/") == 0)
+        return 1;
+    if (len0 <= len1)
+        return strncmp(p0, p1, len0) == 0 && (p1[len0] == '\0' || p1[len0] == '/');
+    return strncmp(p0, p1, len1) == 0 && p0[len1] == '/';
+}
+
+/*! Register a path-scoped state data callback
+ *
+ * As ca_statedata, but the callback is only called if the request xpath intersects the
+ * registered xpath, ie the registered xpath is an ancestor or a descendant of the
+ * request xpath. Requests that are not simple location paths (eg // or |) call all
+ * providers.
+ * If ttl is set, the callback is called with the registered xpath (not the request xpath)
+ * and the state tree is cached for ttl milliseconds.
+ * @param[in]  h      Clixon handle
+ * @param[in]  fn     State data callback
+ * @param[in]  xpath  Registered XPath using canonical prefixes, eg /if:interfaces-state
+ * @param[in]  ttl    Cache time-to-live in milliseconds, 0 for no caching
+ * @retval     0      OK
+ * @retval    -1      Error
+ * @code
+ *   if (clixon_statedata_cb_register(h, my_counters, "/ex:counters", 500) < 0)
+ *      err;
+ * @endcode
+ * @see clixon_plugin_statedata_all
+ */
+int
+clixon_statedata_cb_register(clixon_handle   h,
+                             plgstatedata_t *fn,
+                             char           *xpath,
+                             uint32_t        ttl)
+{
+    int                   retval = -1;
+    statedata_provider_t *sp = NULL;
+    statedata_provider_t *splist = NULL;
+    cbuf                 *cb = NULL;
+
+    if (fn == NULL || xpath == NULL){
+        clixon_err(OE_PLUGIN, EINVAL, "fn or xpath is NULL");
+        goto done;
+    }
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    if (statedata_path_strip(xpath, cb) == 0){
+        clixon_err(OE_PLUGIN, EINVAL, "%s is not a simple location path", xpath);
+        goto done;
+    }
+    if ((sp = malloc(sizeof(*sp))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    memset(sp, 0, sizeof(*sp));
+    sp->sp_fn = fn;
+    sp->sp_ttl = ttl;
+    if ((sp->sp_xpath = strdup(xpath)) == NULL ||
+        (sp->sp_path = strdup(cbuf_get(cb))) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        goto done;
+    }
+    clicon_ptr_get(h, "statedata-providers", (void**)&splist);
+    ADDQ(sp, splist);
+    if (clicon_ptr_set(h, "statedata-providers", splist) < 0)
+        goto done;
+    sp = NULL;
+    retval = 0;
+ done:
+    if (sp){
+        if (sp->sp_xpath)
+            free(sp->sp_xpath);
+        if (sp->sp_path)
+            free(sp->sp_path);
+        free(sp);
+    }
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Free all path-scoped state data callbacks and their caches
+ *
+ * @param[in]  h      Clixon handle
+ */
+int
+clixon_statedata_free(clixon_handle h)
+{
+    statedata_provider_t *splist = NULL;
+    statedata_provider_t *sp;
+
+    clicon_ptr_get(h, "statedata-providers", (void**)&splist);
+    while ((sp = splist) != NULL) {
+        DELQ(sp, splist, statedata_provider_t *);
+        if (sp->sp_xpath)
+            free(sp->sp_xpath);
+        if (sp->sp_path)
+            free(sp->sp_path);
+        if (sp->sp_cache)
+            xml_free(sp->sp_cache);
+        free(sp);
+    }
+    clicon_ptr_del(h, "statedata-providers");
+    return 0;
+}
+
+/*! Call a path-scoped state data callback, or get its state tree from the cache
+ *
+ * @param[in]  h       Clixon handle
+ * @param[in]  yspec   Yang spec
+ * @param[in]  sp      State data provider
+ * @param[in]  nsc     Namespace context of request xpath
+ * @param[in]  xpath   Request xpath
+ * @param[out] xp      State tree, bound if *bound is set
+ * @param[out] bound   State tree is from cache and already bound and sorted
+ * @retval     1       OK
+ * @retval     0       Statedata callback failed. no XML tree returned
+ * @retval    -1       Fatal error
+ */
+static int
+statedata_provider_call(clixon_handle         h,
+                        yang_stmt            *yspec,
+                        statedata_provider_t *sp,
+                        cvec                 *nsc,
+                        char                 *xpath,
+                        cxobj               **xp,
+                        int                  *bound)
+{
+    int             retval = -1;
+    cxobj          *x = NULL;
+    cvec           *nsc1 = NULL;
+    void           *wh = NULL;
+    struct timespec now;
+    int64_t         ms;
+    int             ret;
+
+    if (sp->sp_ttl && sp->sp_cache){
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ms = (int64_t)(now.tv_sec - sp->sp_time.tv_sec)*1000 +
+            (now.tv_nsec - sp->sp_time.tv_nsec)/1000000;
+        if (ms >= 0 && ms < sp->sp_ttl){
+            if ((*xp = xml_dup(sp->sp_cache)) == NULL)
+                goto done;
+            *bound = 1;
+            goto ok;
+        }
+        xml_free(sp->sp_cache);
+        sp->sp_cache = NULL;
+    }
+    if ((x = xml_new(DATASTORE_TOP_SYMBOL, NULL, CX_ELMNT)) == NULL)
+        goto done;
+    if (sp->sp_ttl){
+        /* Cached tree must be independent of the request: use the registered xpath */
+        if (xml_nsctx_yangspec(yspec, &nsc1) < 0)
+            goto done;
+        nsc = nsc1;
+        xpath = sp->sp_xpath;
+    }
+    if (clixon_resource_check(h, &wh, sp->sp_xpath, __func__) < 0)
+        goto done;
+    if ((ret = sp->sp_fn(h, nsc, xpath, x)) < 0){
+        if (clixon_resource_check(h, &wh, sp->sp_xpath, __func__) < 0)
+            goto done;
+        if (clixon_err_category() < 0 && !clixon_plugin_rpc_err_set(h))
+            clixon_log(h, LOG_WARNING, "%s: Internal error: State callback for %s returned -1 but did not make a clixon_err call",
+                       __func__, sp->sp_xpath);
+        goto fail;
+    }
+    if (clixon_resource_check(h, &wh, sp->sp_xpath, __func__) < 0)
+        goto done;
+    *xp = x;
+    x = NULL;
+    *bound = 0;
+ ok:
+    retval = 1;
+ done:
+    if (nsc1)
+        xml_nsctx_free(nsc1);
+    if (x)
+        xml_free(x);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Bind a state tree from a callback to yang, sort it and remove defaults
+ *
+ * @param[in]     h       Clixon handle
+ * @param[in]     yspec   Yang spec
+ * @param[in]     name    Name of plugin or registered xpath, for errors
+ * @param[in]     x       State tree from callback
+ * @param[in,out] xret    State XML tree, replaced with netconf-error if invalid
+ * @retval        1       OK
+ * @retval        0       Invalid state tree (xret set with netconf-error)
+ * @retval       -1       Error
+ */
+static int
+statedata_bind(clixon_handle h,
+               yang_stmt    *yspec,
+               const char   *name,
+               cxobj        *x,
+               cxobj       **xret)
+{
+    int    retval = -1;
+    cxobj *xerr = NULL;
+    int    ret;
+
+    clixon_debug_xml(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, x, "%s STATE:", name);
+    /* XXX: ret == 0 invalid yang binding should be handled as internal error */
+    if ((ret = xml_bind_yang(h, x, YB_MODULE, yspec, 0, &xerr)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_netconf_internal_error(xerr,
+                                          ". Internal error, state callback returned invalid XML from plugin: ",
+                                          name) < 0)
+            goto done;
+        xml_free(*xret);
+        *xret = xerr;
+        xerr = NULL;
+        goto fail;
+    }
+    if (xml_sort_recurse(x) < 0)
+        goto done;
+    /* Remove global defaults and empty non-presence containers */
+    /* XXX: only for state data and according to with-defaults setting */
+    if (xml_default_nopresence(x, 2, 0) < 0)
+        goto done;
+    retval = 1;
+ done:
+    if (xerr)
+        xml_free(xerr);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
 /*! Go through all backend statedata callbacks and collect state data
  *
  * This is internal system call, plugin is invoked (does not call) this function
- * Backend plugins can register 
+ * Backend plugins can register state callbacks in two ways:
+ * - ca_statedata in the plugin API, called on every request
+ * - clixon_statedata_cb_register(), called only if the request xpath intersects the
+ *   registered xpath, optionally cached
  * @param[in]     h       clicon handle
  * @param[in]     yspec   Yang spec
  * @param[in]     nsc     Namespace context
@@ -340,11 +690,18 @@ clixon_plugin_statedata_all(clixon_handle h,
                             char         *xpath,
                             cxobj       **xret)
 {
-    int              retval = -1;
-    cxobj           *x = NULL;
-    clixon_plugin_t *cp = NULL;
-    cxobj           *xerr = NULL;
-    int              ret;
+    int                   retval = -1;
+    cxobj                *x = NULL;
+    clixon_plugin_t      *cp = NULL;
+    cxobj                *xerr = NULL;
+    statedata_provider_t *splist = NULL;
+    statedata_provider_t *sp;
+    char                 *xpath1 = NULL;
+    cbuf                 *cbreason = NULL;
+    cbuf                 *cbpath = NULL;
+    char                 *reqpath = NULL;
+    int                   bound = 0;
+    int                   ret;
 
     clixon_debug(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, "");
     while ((cp = clixon_plugin_each(h, cp)) != NULL) {
@@ -368,26 +725,10 @@ clixon_plugin_statedata_all(clixon_handle h,
             x = NULL;
             continue;
         }
-        clixon_debug_xml(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, x, "%s STATE:", clixon_plugin_name_get(cp));
-        /* XXX: ret == 0 invalid yang binding should be handled as internal error */
-        if ((ret = xml_bind_yang(h, x, YB_MODULE, yspec, 0, &xerr)) < 0)
+        if ((ret = statedata_bind(h, yspec, clixon_plugin_name_get(cp), x, xret)) < 0)
             goto done;
-        if (ret == 0){
-            if (clixon_netconf_internal_error(xerr,
-                                              ". Internal error, state callback returned invalid XML from plugin: ",
-                                              clixon_plugin_name_get(cp)) < 0)
-                goto done;
-            xml_free(*xret);
-            *xret = xerr;
-            xerr = NULL;
+        if (ret == 0)
             goto fail;
-        }
-        if (xml_sort_recurse(x) < 0)
-            goto done;
-        /* Remove global defaults and empty non-presence containers */
-        /* XXX: only for state data and according to with-defaults setting */
-        if (xml_default_nopresence(x, 2, 0) < 0)
-            goto done;
         if (xpath_first(x, nsc, "%s", xpath) != NULL){
             if ((ret = netconf_trymerge(x, yspec, xret)) < 0)
                 goto done;
@@ -399,8 +740,70 @@ clixon_plugin_statedata_all(clixon_handle h,
             x = NULL;
         }
     } /* while plugin */
+    clicon_ptr_get(h, "statedata-providers", (void**)&splist);
+    if ((sp = splist) != NULL){
+        /* Canonical request path with predicates stripped, NULL means all providers */
+        if (xpath && strcmp(xpath, "/") != 0){
+            if ((ret = xpath2canonical(xpath, nsc, yspec, &xpath1, NULL, &cbreason)) < 0)
+                goto done;
+            if ((cbpath = cbuf_new()) == NULL){
+                clixon_err(OE_UNIX, errno, "cbuf_new");
+                goto done;
+            }
+            if (ret == 1 && statedata_path_strip(xpath1, cbpath) == 1)
+                reqpath = cbuf_get(cbpath);
+        }
+        do {
+            if (reqpath && !statedata_path_intersect(reqpath, sp->sp_path)){
+                sp = NEXTQ(statedata_provider_t *, sp);
+                continue;
+            }
+            if ((ret = statedata_provider_call(h, yspec, sp, nsc, xpath, &x, &bound)) < 0)
+                goto done;
+            if (ret == 0){
+                if (clixon_plugin_report_err_xml(h, &xerr,
+                                                 "Internal error, state callback for %s returned invalid XML: %s",
+                                                 sp->sp_xpath, clixon_err_reason()) < 0)
+                    goto done;
+                xml_free(*xret);
+                *xret = xerr;
+                xerr = NULL;
+                goto fail;
+            }
+            if (!bound && xml_child_nr(x) != 0){
+                if ((ret = statedata_bind(h, yspec, sp->sp_xpath, x, xret)) < 0)
+                    goto done;
+                if (ret == 0)
+                    goto fail;
+            }
+            if (sp->sp_ttl && !bound){
+                /* Cache a copy since merge moves nodes from x */
+                if ((sp->sp_cache = xml_dup(x)) == NULL)
+                    goto done;
+                clock_gettime(CLOCK_MONOTONIC, &sp->sp_time);
+            }
+            if (xml_child_nr(x) != 0 &&
+                xpath_first(x, nsc, "%s", xpath) != NULL){
+                if ((ret = netconf_trymerge(x, yspec, xret)) < 0)
+                    goto done;
+                if (ret == 0)
+                    goto fail;
+            }
+            if (x){
+                xml_free(x);
+                x = NULL;
+            }
+            sp = NEXTQ(statedata_provider_t *, sp);
+        } while (sp && sp != splist);
+    }
     retval = 1;
  done:
+    if (cbpath)
+        cbuf_free(cbpath);
+    if (cbreason)
+        cbuf_free(cbreason);
+    if (xpath1)
+        free(xpath1);
     if (xerr)
         xml_free(xerr);
     if (x)
@@ -521,6 +924,418 @@ clixon_pagination_free(clixon_handle h)
     return 0;
 }
 
+/*! Plugin subtree of interest in transactions
+ *
+ * Registered with clixon_plugin_subtree_register(). A plugin with registered subtrees
+ * only sees the part of the transaction diff that is in its subtrees, and its transaction
+ * callbacks are not called if none of its subtrees are changed.
+ */
+typedef struct {
+    qelem_t     ps_qelem;   /* List header */
+    char       *ps_name;    /* Plugin name, ie ca_name of plugin api */
+    char       *ps_path;    /* Schema node identifier, eg /ex:x/ex:y */
+    yang_stmt  *ps_ys;      /* Resolved yang node, or NULL if not resolved */
+    yang_stmt **ps_anc;     /* Yang ancestors of ps_ys */
+    int         ps_nanc;    /* Length of ps_anc */
+    int         ps_view;    /* Index of plugin view, or -1 if plugin not loaded */
+} plugin_subtree_t;
+
+/*! Transaction data of one plugin, restricted to its registered subtrees
+ */
+struct transaction_view {
+    clixon_plugin_t   *tv_cp;    /* Plugin */
+    int                tv_empty; /* No changes in plugin subtrees, skip plugin */
+    transaction_data_t tv_td;    /* Transaction data with diff vectors in plugin subtrees */
+};
+
+/*! Register a subtree of interest for a backend plugin
+ *
+ * The transaction callbacks of the plugin get a transaction where the diff vectors
+ * (dvec, avec, scvec/tcvec) only contain nodes in or above its registered subtrees, and
+ * are not called at all if none of its subtrees are changed.
+ * The source and target trees are the complete trees.
+ * A plugin may register several subtrees. A plugin with no registered subtree sees all changes.
+ * Typically called in clixon_plugin_init()
+ * @param[in]  h      Clixon handle
+ * @param[in]  name   Plugin name, ie the name given in the plugin api struct
+ * @param[in]  path   Absolute schema node identifier using module prefixes, eg /ex:x/ex:y
+ * @retval     0      OK
+ * @retval    -1      Error
+ * @code
+ *   if (clixon_plugin_subtree_register(h, "example", "/ex:table") < 0)
+ *      err;
+ * @endcode
+ */
+int
+clixon_plugin_subtree_register(clixon_handle h,
+                               const char   *name,
+                               const char   *path)
+{
+    int               retval = -1;
+    plugin_subtree_t *ps = NULL;
+    plugin_subtree_t *pslist = NULL;
+
+    if (name == NULL || path == NULL || path[0] != '/'){
+        clixon_err(OE_PLUGIN, EINVAL, "name is NULL or path is not absolute");
+        goto done;
+    }
+    if ((ps = malloc(sizeof(*ps))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    memset(ps, 0, sizeof(*ps));
+    if ((ps->ps_name = strdup(name)) == NULL ||
+        (ps->ps_path = strdup(path)) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        goto done;
+    }
+    clicon_ptr_get(h, "plugin-subtrees", (void**)&pslist);
+    ADDQ(ps, pslist);
+    if (clicon_ptr_set(h, "plugin-subtrees", pslist) < 0)
+        goto done;
+    ps = NULL;
+    retval = 0;
+ done:
+    if (ps){
+        if (ps->ps_name)
+            free(ps->ps_name);
+        if (ps->ps_path)
+            free(ps->ps_path);
+        free(ps);
+    }
+    return retval;
+}
+
+/*! Free all plugin subtree registrations
+ *
+ * @param[in]  h      Clixon handle
+ */
+int
+clixon_plugin_subtree_free(clixon_handle h)
+{
+    plugin_subtree_t *pslist = NULL;
+    plugin_subtree_t *ps;
+
+    clicon_ptr_get(h, "plugin-subtrees", (void**)&pslist);
+    while ((ps = pslist) != NULL) {
+        DELQ(ps, pslist, plugin_subtree_t *);
+        if (ps->ps_name)
+            free(ps->ps_name);
+        if (ps->ps_path)
+            free(ps->ps_path);
+        if (ps->ps_anc)
+            free(ps->ps_anc);
+        free(ps);
+    }
+    clicon_ptr_del(h, "plugin-subtrees");
+    return 0;
+}
+
+/*! Resolve the yang node of a plugin subtree and its ancestors
+ *
+ * @param[in]  h      Clixon handle
+ * @param[in]  ps     Plugin subtree
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+static int
+plugin_subtree_resolve(clixon_handle     h,
+                       plugin_subtree_t *ps)
+{
+    int        retval = -1;
+    yang_stmt *yspec;
+    yang_stmt *yp;
+    int        n = 0;
+
+    if ((yspec = clicon_dbspec_yang(h)) == NULL){
+        clixon_err(OE_YANG, ENOENT, "No yang spec");
+        goto done;
+    }
+    if (yang_abs_schema_nodeid(yspec, ps->ps_path, &ps->ps_ys) < 0)
+        goto done;
+    if (ps->ps_ys == NULL){
+        clixon_err(OE_PLUGIN, ENOENT, "Plugin %s subtree %s not found", ps->ps_name, ps->ps_path);
+        goto done;
+    }
+    for (yp = yang_parent_get(ps->ps_ys); yp && yang_schemanode(yp); yp = yang_parent_get(yp))
+        n++;
+    if (n && (ps->ps_anc = calloc(n, sizeof(yang_stmt *))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        goto done;
+    }
+    for (yp = yang_parent_get(ps->ps_ys); yp && yang_schemanode(yp); yp = yang_parent_get(yp))
+        ps->ps_anc[ps->ps_nanc++] = yp;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Check if a yang node is a strict ancestor of a plugin subtree
+ *
+ * @param[in]  ps  Plugin subtree
+ * @param[in]  ys  Yang node
+ * @retval     1   Yes
+ * @retval     0   No
+ */
+static int
+plugin_subtree_ancestor(plugin_subtree_t *ps,
+                        yang_stmt        *ys)
+{
+    int i;
+
+    for (i=0; i<ps->ps_nanc; i++)
+        if (ps->ps_anc[i] == ys)
+            return 1;
+    return 0;
+}
+
+/*! Check if an XML node contains an instance of a plugin subtree
+ *
+ * @param[in]  x   XML node whose yang is an ancestor of the plugin subtree
+ * @param[in]  ps  Plugin subtree
+ * @retval     1   Yes
+ * @retval     0   No
+ */
+static int
+plugin_subtree_contains(cxobj            *x,
+                        plugin_subtree_t *ps)
+{
+    cxobj     *xc;
+    yang_stmt *yc;
+    int        ix = 0;
+
+    while ((xc = xml_child_iter(x, &ix, CX_ELMNT)) != NULL) {
+        if ((yc = xml_spec(xc)) == NULL)
+            continue;
+        if (yc == ps->ps_ys)
+            return 1;
+        if (plugin_subtree_ancestor(ps, yc) && plugin_subtree_contains(xc, ps))
+            return 1;
+    }
+    return 0;
+}
+
+/*! Check if an XML diff node is in, or contains, a plugin subtree
+ *
+ * @param[in]  x   XML diff node
+ * @param[in]  ps  Plugin subtree
+ * @retval     1   Yes
+ * @retval     0   No
+ */
+static int
+plugin_subtree_match(cxobj            *x,
+                     plugin_subtree_t *ps)
+{
+    yang_stmt *ys;
+    yang_stmt *yp;
+
+    if ((ys = xml_spec(x)) == NULL)
+        return 0;
+    for (yp = ys; yp && yang_schemanode(yp); yp = yang_parent_get(yp))
+        if (yp == ps->ps_ys)
+            return 1;
+    if (plugin_subtree_ancestor(ps, ys))
+        return plugin_subtree_contains(x, ps);
+    return 0;
+}
+
+/*! Free plugin subtree views of a transaction
+ *
+ * @param[in]  td   Transaction data
+ */
+static int
+transaction_views_free(transaction_data_t *td)
+{
+    transaction_data_t *tv;
+    int                 i;
+
+    if (td->td_views){
+        for (i=0; i<td->td_nviews; i++){
+            tv = &td->td_views[i].tv_td;
+            if (tv->td_dvec)
+                free(tv->td_dvec);
+            if (tv->td_avec)
+                free(tv->td_avec);
+            if (tv->td_scvec)
+                free(tv->td_scvec);
+            if (tv->td_tcvec)
+                free(tv->td_tcvec);
+        }
+        free(td->td_views);
+        td->td_views = NULL;
+    }
+    td->td_nviews = 0;
+    td->td_viewed = 0;
+    return 0;
+}
+
+/*! Add a diff node to the views of all plugins with a matching subtree
+ *
+ * A node is added at most once to a view, also if it matches several subtrees of a plugin
+ * @param[in]  td      Transaction data
+ * @param[in]  pslist  Plugin subtree list
+ * @param[in]  vec     0: dvec, 1: avec, 2: scvec/tcvec
+ * @param[in]  i       Index of diff node in vector
+ */
+static void
+transaction_views_add(transaction_data_t *td,
+                      plugin_subtree_t   *pslist,
+                      int                 vec,
+                      int                 i)
+{
+    plugin_subtree_t   *ps = pslist;
+    transaction_data_t *tv;
+    cxobj              *x;
+
+    x = vec==0 ? td->td_dvec[i] : vec==1 ? td->td_avec[i] : td->td_tcvec[i];
+    do {
+        if (ps->ps_view >= 0 && plugin_subtree_match(x, ps)){
+            tv = &td->td_views[ps->ps_view].tv_td;
+            switch (vec){
+            case 0:
+                if (tv->td_dlen == 0 || tv->td_dvec[tv->td_dlen-1] != x)
+                    tv->td_dvec[tv->td_dlen++] = x;
+                break;
+            case 1:
+                if (tv->td_alen == 0 || tv->td_avec[tv->td_alen-1] != x)
+                    tv->td_avec[tv->td_alen++] = x;
+                break;
+            default:
+                if (tv->td_clen == 0 || tv->td_tcvec[tv->td_clen-1] != x){
+                    tv->td_scvec[tv->td_clen] = td->td_scvec[i];
+                    tv->td_tcvec[tv->td_clen++] = x;
+                }
+                break;
+            }
+        }
+        ps = NEXTQ(plugin_subtree_t *, ps);
+    } while (ps && ps != pslist);
+}
+
+/*! Partition the diff vectors of a transaction into per-plugin views
+ *
+ * Made once per transaction. Each diff node is matched against the registered subtrees
+ * using YANG ancestry, and added to the view of each plugin with a matching subtree.
+ * @param[in]  h    Clixon handle
+ * @param[in]  td   Transaction data
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+transaction_views_build(clixon_handle       h,
+                        transaction_data_t *td)
+{
+    int                 retval = -1;
+    plugin_subtree_t   *pslist = NULL;
+    plugin_subtree_t   *ps;
+    clixon_plugin_t    *cp = NULL;
+    transaction_data_t *tv;
+    int                 found;
+    int                 i;
+
+    td->td_viewed = 1;
+    clicon_ptr_get(h, "plugin-subtrees", (void**)&pslist);
+    if ((ps = pslist) == NULL)
+        goto ok;
+    do {
+        if (ps->ps_ys == NULL && plugin_subtree_resolve(h, ps) < 0)
+            goto done;
+        ps->ps_view = -1;
+        ps = NEXTQ(plugin_subtree_t *, ps);
+    } while (ps && ps != pslist);
+    /* One view per loaded plugin with registered subtrees */
+    while ((cp = clixon_plugin_each(h, cp)) != NULL) {
+        found = 0;
+        ps = pslist;
+        do {
+            if (strcmp(ps->ps_name, clixon_plugin_api_get(cp)->ca_name) == 0){
+                ps->ps_view = td->td_nviews;
+                found++;
+            }
+            ps = NEXTQ(plugin_subtree_t *, ps);
+        } while (ps && ps != pslist);
+        if (found == 0)
+            continue;
+        if ((td->td_views = realloc(td->td_views, (td->td_nviews+1)*sizeof(*td->td_views))) == NULL){
+            clixon_err(OE_UNIX, errno, "realloc");
+            goto done;
+        }
+        memset(&td->td_views[td->td_nviews], 0, sizeof(*td->td_views));
+        td->td_views[td->td_nviews].tv_cp = cp;
+        tv = &td->td_views[td->td_nviews++].tv_td;
+        tv->td_id = td->td_id;
+        tv->td_src = td->td_src;
+        tv->td_target = td->td_target;
+        if ((td->td_dlen && (tv->td_dvec = calloc(td->td_dlen, sizeof(cxobj *))) == NULL) ||
+            (td->td_alen && (tv->td_avec = calloc(td->td_alen, sizeof(cxobj *))) == NULL) ||
+            (td->td_clen && (tv->td_scvec = calloc(td->td_clen, sizeof(cxobj *))) == NULL) ||
+            (td->td_clen && (tv->td_tcvec = calloc(td->td_clen, sizeof(cxobj *))) == NULL)){
+            clixon_err(OE_UNIX, errno, "calloc");
+            goto done;
+        }
+    }
+    if (td->td_nviews == 0)
+        goto ok;
+    for (i=0; i<td->td_dlen; i++)
+        transaction_views_add(td, pslist, 0, i);
+    for (i=0; i<td->td_alen; i++)
+        transaction_views_add(td, pslist, 1, i);
+    for (i=0; i<td->td_clen; i++)
+        transaction_views_add(td, pslist, 2, i);
+    for (i=0; i<td->td_nviews; i++){
+        tv = &td->td_views[i].tv_td;
+        td->td_views[i].tv_empty = (tv->td_dlen == 0 && tv->td_alen == 0 && tv->td_clen == 0);
+    }
+    clixon_debug(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, "%d plugin views", td->td_nviews);
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Get the transaction data of a plugin, restricted to its registered subtrees
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  cp    Plugin handle
+ * @param[in]  td    Transaction data
+ * @param[out] tdp   Plugin view, or td itself if the plugin has no registered subtrees
+ * @retval     1     OK, transaction data in tdp
+ * @retval     0     None of the plugin subtrees are changed, skip the plugin
+ * @retval    -1     Error
+ * @see clixon_plugin_subtree_register
+ */
+static int
+transaction_view_get(clixon_handle        h,
+                     clixon_plugin_t     *cp,
+                     transaction_data_t  *td,
+                     transaction_data_t **tdp)
+{
+    transaction_data_t *tv;
+    int                 i;
+
+    if (!td->td_viewed && transaction_views_build(h, td) < 0)
+        return -1;
+    for (i=0; i<td->td_nviews; i++){
+        if (td->td_views[i].tv_cp != cp)
+            continue;
+        if (td->td_views[i].tv_empty)
+            return 0;
+        tv = &td->td_views[i].tv_td;
+        /* Pointers to the source tree are obsolete after commit, see candidate_commit */
+        if (td->td_dvec == NULL)
+            tv->td_dlen = 0;
+        if (td->td_scvec == NULL && tv->td_scvec){
+            free(tv->td_scvec);
+            tv->td_scvec = NULL;
+        }
+        tv->td_arg = td->td_arg;
+        *tdp = tv;
+        return 1;
+    }
+    *tdp = td;
+    return 1;
+}
+
 /*! Create and initialize a validate/commit transaction 
  *
  * @retval  td     New alloced transaction, 
@@ -583,6 +1398,7 @@ transaction_free1(transaction_data_t *td,
         free(td->td_scvec);
     if (td->td_tcvec)
         free(td->td_tcvec);
+    transaction_views_free(td);
     free(td);
     return 0;
 }
@@ -594,14 +1410,21 @@ plugin_transaction_call_one(clixon_handle       h,
 			    const char         *fnname,
 			    transaction_data_t *td)
 {
-    int  retval = -1;
-    int  rv;
-    void *wh = NULL;
+    int                 retval = -1;
+    int                 rv;
+    void               *wh = NULL;
+    transaction_data_t *tv = NULL;
+    int                 ret;
 
+    if ((ret = transaction_view_get(h, cp, td, &tv)) < 0)
+        goto done;
+    if (ret == 0)
+        goto ok;
     wh = NULL;
     if (clixon_resource_check(h, &wh, clixon_plugin_name_get(cp), fnname) < 0)
         goto done;
-    rv = fn(h, (transaction_data)td);
+    rv = fn(h, (transaction_data)tv);
+    td->td_arg = tv->td_arg;
     if (clixon_resource_check(h, &wh, clixon_plugin_name_get(cp), fnname) < 0)
         goto done;
     if (rv < 0) {
@@ -611,6 +1434,7 @@ plugin_transaction_call_one(clixon_handle       h,
                        fnname, clixon_plugin_name_get(cp));
         goto done;
     }
+ ok:
     retval = 0;
  done:
     return retval;
@@ -682,6 +1506,265 @@ plugin_transaction_validate_one(clixon_plugin_t    *cp,
     return 0;
 }
 
+/*! Revert a commit in a single plugin
+ *
+ * @param[in]  cp      Plugin handle
+ * @param[in]  h       Clixon handle
+ * @param[in]  td      Transaction data
+ * @retval     0       OK
+ * @retval    -1       Error
+ */
+static int
+plugin_transaction_revert_one(clixon_plugin_t    *cp,
+                              clixon_handle       h,
+                              transaction_data_t *td)
+{
+    int                 retval = 0;
+    trans_cb_t         *fn;
+    transaction_data_t *tv = NULL;
+
+    if ((fn = clixon_plugin_api_get(cp)->ca_trans_revert) == NULL)
+        return 0;
+    if ((retval = transaction_view_get(h, cp, td, &tv)) <= 0)
+        return retval;
+    if ((retval = fn(h, (transaction_data)tv)) < 0)
+        clixon_log(h, LOG_NOTICE, "%s: Plugin '%s' trans_revert callback failed",
+                   __func__, clixon_plugin_name_get(cp));
+    td->td_arg = tv->td_arg;
+    return retval;
+}
+
+/*! Revert a commit
+ *
+ * @param[in]  h   CLICON handle
+ * @param[in]  td  Transaction data
+ * @param[in]  nr  The plugin where an error occured. 
+ * @retval     0       OK
+ * @retval    -1       Error
+ * The revert is made in plugin before this one. Eg if error occurred in
+ * plugin 2, then the revert will be made in plugins 1 and 0.
+ */
+static int
+plugin_transaction_revert_all(clixon_handle       h,
+                              transaction_data_t *td,
+                              int                 nr)
+{
+    int              retval = 0;
+    clixon_plugin_t *cp = NULL;
+
+    while ((cp = clixon_plugin_each_revert(h, cp, nr)) != NULL) {
+        if ((retval = plugin_transaction_revert_one(cp, h, td)) < 0)
+            break;
+    }
+    return retval; /* ignore errors */
+}
+
+/*! Revert a commit for failed plugin
+ * The commit failed is called for only failed plugin before revert all cb.
+ */
+static int
+plugin_transaction_commit_failed(clixon_plugin_t    *cp,
+                                 clixon_handle       h,
+                                 transaction_data_t *td)
+{
+    trans_cb_t *fn;
+
+    if ((fn = clixon_plugin_api_get(cp)->ca_trans_commit_failed) != NULL)
+        return plugin_transaction_call_one(h, cp, fn, __func__, td);
+    return 0;
+}
+
+#ifdef PLUGIN_TRANS_THREADS
+/*! Call a plugin callback and save its error state
+ *
+ * @param[in]  pw   Plugin worker
+ */
+static void
+plugin_worker_call(struct plugin_worker *pw)
+{
+    if ((pw->pw_rv = pw->pw_fn(pw->pw_h, (transaction_data)pw->pw_td)) < 0)
+        pw->pw_err = clixon_err_save();
+}
+
+/*! Worker thread start function
+ *
+ * @param[in]  arg  Plugin worker
+ */
+static void *
+plugin_worker_thread(void *arg)
+{
+    plugin_worker_call((struct plugin_worker *)arg);
+    clixon_err_thread_exit();
+    return NULL;
+}
+
+/*! Run a batch of parallel plugin callbacks and check the results in plugin order
+ *
+ * All callbacks in the batch are run to completion, then the first failing plugin in
+ * plugin order sets the error, as if the callbacks had been called sequentially.
+ * On commit failure, commit_failed is called in the failing plugins, and revert in the
+ * succeeded plugins of the batch and all plugins before the batch, in reverse plugin order.
+ * @param[in]     h       Clixon handle
+ * @param[in]     td      Transaction data
+ * @param[in]     pwvec   Plugin workers in plugin order
+ * @param[in,out] pwlen   Length of pwvec, reset to 0
+ * @param[in]     commit  0: validate, 1: commit
+ * @param[in]     fnname  Callback name for logging
+ * @retval        0       OK, all callbacks succeeded
+ * @retval       -1       Error: one of the plugin callbacks returned error
+ */
+static int
+plugin_transaction_batch(clixon_handle         h,
+                         transaction_data_t   *td,
+                         struct plugin_worker *pwvec,
+                         int                  *pwlen,
+                         int                   commit,
+                         const char           *fnname)
+{
+    int                   retval = -1;
+    struct plugin_worker *pw;
+    struct plugin_worker *pwfail = NULL;
+    void                 *wh = NULL;
+    int                   i;
+
+    if (*pwlen == 0)
+        return 0;
+    clixon_debug(CLIXON_DBG_BACKEND | CLIXON_DBG_DETAIL, "%s: %d plugins", fnname, *pwlen);
+    if (clixon_resource_check(h, &wh, "parallel", fnname) < 0)
+        goto done;
+    /* Searches in the shared transaction trees must not set cv or namespace caches */
+    xml_cv_cache_readonly(1);
+    xml_nscache_readonly(1);
+#ifdef XML_LIST_KEY_INDEX
+    /* Searches in the shared transaction trees must not build list key indexes */
+    xml_key_index_readonly(1);
+#endif
+    for (i=0; i<*pwlen; i++){
+        pw = &pwvec[i];
+        pw->pw_thread_ok = (pthread_create(&pw->pw_thread, NULL, plugin_worker_thread, pw) == 0);
+        if (!pw->pw_thread_ok) /* Fall back to calling it in this thread */
+            plugin_worker_call(pw);
+    }
+    for (i=0; i<*pwlen; i++){
+        pw = &pwvec[i];
+        if (pw->pw_thread_ok)
+            pthread_join(pw->pw_thread, NULL);
+        if (pw->pw_rv < 0 && pwfail == NULL)
+            pwfail = pw;
+    }
+#ifdef XML_LIST_KEY_INDEX
+    xml_key_index_readonly(0);
+#endif
+    xml_nscache_readonly(0);
+    xml_cv_cache_readonly(0);
+    /* Restore (and free) error states in reverse order so that the first failure is kept */
+    for (i=*pwlen-1; i>=0; i--){
+        pw = &pwvec[i];
+        if (pw->pw_err){
+            clixon_err_restore(pw->pw_err);
+            pw->pw_err = NULL;
+        }
+    }
+    if (clixon_resource_check(h, &wh, "parallel", fnname) < 0)
+        goto done;
+    if (pwfail == NULL){
+        retval = 0;
+        goto done;
+    }
+    if (!clixon_err_category())
+        /* sanity: log if err is not called ! */
+        clixon_log(h, LOG_NOTICE, "%s: Plugin '%s' callback does not make clixon_err call on error",
+                   fnname, clixon_plugin_name_get(pwfail->pw_cp));
+    if (commit){
+        for (i=0; i<*pwlen; i++){
+            pw = &pwvec[i];
+            if (pw->pw_rv < 0)
+                plugin_transaction_commit_failed(pw->pw_cp, h, td);
+        }
+        for (i=*pwlen-1; i>=0; i--){
+            pw = &pwvec[i];
+            if (pw->pw_rv == 0 &&
+                plugin_transaction_revert_one(pw->pw_cp, h, td) < 0)
+                break;
+        }
+        if (i < 0)
+            plugin_transaction_revert_all(h, td, pwvec[0].pw_nr - 1);
+    }
+ done:
+    *pwlen = 0;
+    return retval;
+}
+
+/*! Call validate or commit callbacks in all plugins, with flagged plugins in parallel
+ *
+ * Consecutive plugins flagged with CLIXON_PLUGIN_TRANS_PARALLEL are run as a batch in
+ * worker threads, at most PLUGIN_TRANS_PARALLEL_MAX at a time. A plugin without the flag
+ * is called in the main thread after the batch before it has completed.
+ * @param[in]  h       Clixon handle
+ * @param[in]  td      Transaction data
+ * @param[in]  commit  0: validate, 1: commit
+ * @retval     0       OK
+ * @retval    -1       Error: one of the plugin callbacks returned error
+ * @see plugin_transaction_batch
+ */
+static int
+plugin_transaction_parallel(clixon_handle       h,
+                            transaction_data_t *td,
+                            int                 commit)
+{
+    int                  retval = -1;
+    clixon_plugin_t     *cp = NULL;
+    clixon_plugin_api   *api;
+    trans_cb_t          *fn;
+    struct plugin_worker pwvec[PLUGIN_TRANS_PARALLEL_MAX];
+    struct plugin_worker *pw;
+    int                  pwlen = 0;
+    int                  nr = 0;
+    const char          *fnname;
+    transaction_data_t  *tv;
+    int                  ret;
+
+    fnname = commit ? "plugin_transaction_commit_one" : "plugin_transaction_validate_one";
+    while ((cp = clixon_plugin_each(h, cp)) != NULL) {
+        nr++;
+        api = clixon_plugin_api_get(cp);
+        if ((fn = commit ? api->ca_trans_commit : api->ca_trans_validate) == NULL)
+            continue;
+        if ((api->ca_trans_flags & CLIXON_PLUGIN_TRANS_PARALLEL) == 0){
+            if (plugin_transaction_batch(h, td, pwvec, &pwlen, commit, fnname) < 0)
+                goto done;
+            if (plugin_transaction_call_one(h, cp, fn, fnname, td) < 0){
+                if (commit){
+                    plugin_transaction_commit_failed(cp, h, td);
+                    plugin_transaction_revert_all(h, td, nr-1);
+                }
+                goto done;
+            }
+            continue;
+        }
+        if ((ret = transaction_view_get(h, cp, td, &tv)) < 0)
+            goto done;
+        if (ret == 0)
+            continue;
+        pw = &pwvec[pwlen++];
+        memset(pw, 0, sizeof(*pw));
+        pw->pw_h = h;
+        pw->pw_cp = cp;
+        pw->pw_fn = fn;
+        pw->pw_td = tv;
+        pw->pw_nr = nr;
+        if (pwlen == PLUGIN_TRANS_PARALLEL_MAX &&
+            plugin_transaction_batch(h, td, pwvec, &pwlen, commit, fnname) < 0)
+            goto done;
+    }
+    if (plugin_transaction_batch(h, td, pwvec, &pwlen, commit, fnname) < 0)
+        goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+#endif /* PLUGIN_TRANS_THREADS */
+
 /*! Call transaction_validate callbacks in all backend plugins
  *
  * @param[in]  h       Clixon handle
@@ -693,6 +1776,9 @@ int
 plugin_transaction_validate_all(clixon_handle       h,
                                 transaction_data_t *td)
 {
+#ifdef PLUGIN_TRANS_THREADS
+    return plugin_transaction_parallel(h, td, 0);
+#else
     int            retval = -1;
     clixon_plugin_t *cp = NULL;
 
@@ -703,6 +1789,7 @@ plugin_transaction_validate_all(clixon_handle       h,
     retval = 0;
  done:
     return retval;
+#endif
 }
 
 /*! Call single plugin transaction_complete() in a validate/commit transaction
@@ -751,53 +1838,6 @@ plugin_transaction_complete_all(clixon_handle       h,
     return retval;
 }
 
-/*! Revert a commit
- *
- * @param[in]  h   CLICON handle
- * @param[in]  td  Transaction data
- * @param[in]  nr  The plugin where an error occured. 
- * @retval     0       OK
- * @retval    -1       Error
- * The revert is made in plugin before this one. Eg if error occurred in
- * plugin 2, then the revert will be made in plugins 1 and 0.
- */
-static int
-plugin_transaction_revert_all(clixon_handle       h,
-                              transaction_data_t *td,
-                              int                 nr)
-{
-    int              retval = 0;
-    clixon_plugin_t *cp = NULL;
-    trans_cb_t      *fn;
-
-    while ((cp = clixon_plugin_each_revert(h, cp, nr)) != NULL) {
-        if ((fn = clixon_plugin_api_get(cp)->ca_trans_revert) == NULL)
-            continue;
-
-        if ((retval = fn(h, (transaction_data)td)) < 0){
-            clixon_log(h, LOG_NOTICE, "%s: Plugin '%s' trans_revert callback failed",
-                           __func__, clixon_plugin_name_get(cp));
-                break;
-        }
-    }
-    return retval; /* ignore errors */
-}
-
-/*! Revert a commit for failed plugin
- * The commit failed is called for only failed plugin before revert all cb.
- */
-static int
-plugin_transaction_commit_failed(clixon_plugin_t    *cp,
-                                 clixon_handle       h,
-                                 transaction_data_t *td)
-{
-    trans_cb_t *fn;
-
-    if ((fn = clixon_plugin_api_get(cp)->ca_trans_commit_failed) != NULL)
-        return plugin_transaction_call_one(h, cp, fn, __func__, td);
-    return 0;
-}
-
 /*! Call single plugin transaction_commit() in a commit transaction
  *
  * @param[in]  cp      Plugin handle
@@ -832,6 +1872,9 @@ int
 plugin_transaction_commit_all(clixon_handle       h,
                               transaction_data_t *td)
 {
+#ifdef PLUGIN_TRANS_THREADS
+    return plugin_transaction_parallel(h, td, 1);
+#else
     int            retval = -1;
     clixon_plugin_t *cp = NULL;
     int            i=0;
@@ -849,6 +1892,7 @@ plugin_transaction_commit_all(clixon_handle       h,
     retval = 0;
  done:
     return retval;
+#endif
 }
 
 /*! Call single plugin transaction_commit_done() in a commit transaction
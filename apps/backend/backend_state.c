@@ -550,7 +550,7 @@ clixon_stats_yang_get(clixon_handle h,
     return retval;
 }
 
-/*! Collect clixon mem statistics
+/*! Collect clixon mem statistics, and profiling data if enabled
  *
  * @param[in]     h         Clixon handle
  * @param[in]     modules   If 1, also include per-module stats, otherwise only global and datastore stats
@@ -624,6 +624,12 @@ clixon_backend_stats(clixon_handle  h,
         }
     }
     cprintf(cbret, "</module-sets>");
+    if (clixon_profile_enabled()){
+        cprintf(cbret, "<profile xmlns=\"%s\">", CLIXON_LIB_NS);
+        if (clixon_profile_print(cbret) < 0)
+            goto done;
+        cprintf(cbret, "</profile>");
+    }
     retval = 0;
  done:
     if (keys)
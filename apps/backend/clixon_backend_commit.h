@@ -66,6 +66,20 @@ int do_rollback(clixon_handle h, uint8_t *errs);
 int from_client_cancel_commit(clixon_handle h,  cxobj *xe, cbuf *cbret, void *arg, void *regarg);
 int from_client_confirmed_commit(clixon_handle h, cxobj *xe, uint32_t myid, cbuf *cbret);
 
+/* backend_history.c */
+int commit_history_init(clixon_handle h);
+int commit_history_free(clixon_handle h);
+int commit_history_enabled(clixon_handle h);
+int commit_history_prepare(clixon_handle h, transaction_data_t *td, uint32_t myid, cxobj *xe);
+int commit_history_add(clixon_handle h);
+int commit_history_release(clixon_handle h);
+int commit_history_clear(clixon_handle h);
+int commit_history_db(clixon_handle h, int nr, const char *db);
+int commit_history_pin(clixon_handle h);
+int commit_history_unpin(clixon_handle h);
+int commit_history_pinned(clixon_handle h);
+int commit_history_pin_db(clixon_handle h, const char *db);
+
 /* backend_commit.c */
 int generic_validate(clixon_handle h, yang_stmt *yspec, transaction_data_t *td, cxobj **xret);
 int startup_validate(clixon_handle h, char *db, cxobj **xtr, cbuf *cbret);
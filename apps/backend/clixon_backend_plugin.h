@@ -66,6 +66,9 @@ typedef struct {
     cxobj    **td_scvec;    /* Source changed xml vector */
     cxobj    **td_tcvec;    /* Target changed xml vector */
     size_t     td_clen;     /* Changed xml vector length */
+    int        td_viewed;   /* Plugin subtree views are computed */
+    struct transaction_view *td_views; /* Plugin subtree views */
+    int        td_nviews;   /* Length of td_views */
 } transaction_data_t;
 
 /*! Pagination userdata 
@@ -109,6 +112,12 @@ int clixon_plugin_lockdb_all(clixon_handle h, char *db, int lock, int id);
 int clixon_pagination_cb_register(clixon_handle h, handler_function fn, char *path, void *arg);
 int clixon_pagination_free(clixon_handle h);
 
+int clixon_statedata_cb_register(clixon_handle h, plgstatedata_t *fn, char *xpath, uint32_t ttl);
+int clixon_statedata_free(clixon_handle h);
+
+int clixon_plugin_subtree_register(clixon_handle h, const char *name, const char *path);
+int clixon_plugin_subtree_free(clixon_handle h);
+
 transaction_data_t * transaction_new(void);
 int transaction_free(transaction_data_t *);
 int transaction_free1(transaction_data_t *, int copy);
@@ -1906,6 +1906,247 @@ cli_ping(clixon_handle h,
     return retval;
 }
 
+/*! Send commit-history rpc to backend
+ *
+ * @param[in]  h      Clixon handle
+ * @param[in]  config If set, also get configuration before the latest index commits
+ * @param[in]  index  Number of commits to undo
+ * @param[out] xret   Reply, free with xml_free
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+static int
+cli_commit_history_rpc(clixon_handle h,
+                       int           config,
+                       uint32_t      index,
+                       cxobj       **xret)
+{
+    int    retval = -1;
+    cbuf  *cb = NULL;
+    cxobj *xerr;
+
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    cprintf(cb, "<rpc xmlns=\"%s\" username=\"%s\" %s>",
+            NETCONF_BASE_NAMESPACE,
+            clicon_username_get(h),
+            NETCONF_MESSAGE_ID_ATTR);
+    cprintf(cb, "<commit-history xmlns=\"%s\">", CLIXON_LIB_NS);
+    if (config)
+        cprintf(cb, "<index>%u</index>", index);
+    cprintf(cb, "</commit-history>");
+    cprintf(cb, "</rpc>");
+    if (clicon_rpc_netconf(h, cbuf_get(cb), xret, NULL) < 0)
+        goto done;
+    if ((xerr = xpath_first(*xret, NULL, "//rpc-error")) != NULL){
+        clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Commit history");
+        goto done;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Show backend commit history, newest first
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  cvv   Vector of command variables
+ * @param[in]  argv  No arguments expected
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see CLICON_COMMIT_HISTORY
+ */
+int
+cli_commit_history(clixon_handle h,
+                   cvec         *cvv,
+                   cvec         *argv)
+{
+    int    retval = -1;
+    cxobj *xret = NULL;
+    cxobj *xr;
+    cxobj *x;
+    char  *str;
+
+    if (cli_commit_history_rpc(h, 0, 0, &xret) < 0)
+        goto done;
+    if ((xr = xpath_first(xret, NULL, "rpc-reply")) == NULL)
+        goto ok;
+    x = NULL;
+    while ((x = xml_child_each(xr, x, CX_ELMNT)) != NULL) {
+        if (strcmp(xml_name(x), "commit") != 0)
+            continue;
+        cligen_output(stdout, "%-4s %-6s %-12s %s",
+                      xml_find_body(x, "index"),
+                      xml_find_body(x, "id"),
+                      (str = xml_find_body(x, "username")) ? str : "",
+                      xml_find_body(x, "timestamp"));
+        if ((str = xml_find_body(x, "comment")) != NULL)
+            cligen_output(stdout, " %s", str);
+        cligen_output(stdout, "\n");
+    }
+ ok:
+    retval = 0;
+ done:
+    if (xret)
+        xml_free(xret);
+    return retval;
+}
+
+/*! Load configuration before the latest commits into candidate
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  cvv   Vector of command variables
+ * @param[in]  argv  <varname> Name of uint32 variable in cvv with number of commits to undo
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @code
+ *   rollback <index:uint32>, cli_rollback("index");
+ * @endcode
+ */
+int
+cli_rollback(clixon_handle h,
+             cvec         *cvv,
+             cvec         *argv)
+{
+    int     retval = -1;
+    cbuf   *cb = NULL;
+    cxobj  *xret = NULL;
+    cxobj  *xerr;
+    cg_var *cv;
+    char   *varstr;
+
+    if (cvec_len(argv) != 1){
+        clixon_err(OE_PLUGIN, EINVAL, "Expected arguments: <varname>");
+        goto done;
+    }
+    varstr = cv_string_get(cvec_i(argv, 0));
+    if ((cv = cvec_find(cvv, varstr)) == NULL){
+        clixon_err(OE_PLUGIN, 0, "No such var name: %s", varstr);
+        goto done;
+    }
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    cprintf(cb, "<rpc xmlns=\"%s\" username=\"%s\" %s>",
+            NETCONF_BASE_NAMESPACE,
+            clicon_username_get(h),
+            NETCONF_MESSAGE_ID_ATTR);
+    cprintf(cb, "<rollback xmlns=\"%s\">", CLIXON_LIB_NS);
+    cprintf(cb, "<index>%u</index>", cv_uint32_get(cv));
+    cprintf(cb, "</rollback>");
+    cprintf(cb, "</rpc>");
+    if (clicon_rpc_netconf(h, cbuf_get(cb), &xret, NULL) < 0)
+        goto done;
+    if ((xerr = xpath_first(xret, NULL, "//rpc-error")) != NULL){
+        clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Rollback");
+        goto done;
+    }
+    retval = 0;
+ done:
+    if (xret)
+        xml_free(xret);
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Compare configuration before the latest commits with running
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  cvv   Vector of command variables
+ * @param[in]  argv  <varname> [<format>]
+ *   <varname> Name of uint32 variable in cvv with number of commits to undo
+ *   <format>  "xml"|"text"
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+int
+cli_rollback_compare(clixon_handle h,
+                     cvec         *cvv,
+                     cvec         *argv)
+{
+    int              retval = -1;
+    cxobj           *xret = NULL;
+    cxobj           *xc1 = NULL;
+    cxobj           *xc2 = NULL;
+    cxobj           *xerr = NULL;
+    cxobj           *x;
+    cbuf            *cb = NULL;
+    cg_var          *cv;
+    char            *varstr;
+    enum format_enum format = FORMAT_TEXT;
+    yang_stmt       *yspec;
+    int              ret;
+
+    if (cvec_len(argv) != 1 && cvec_len(argv) != 2){
+        clixon_err(OE_PLUGIN, EINVAL, "Expected arguments: <varname> [<format>]");
+        goto done;
+    }
+    varstr = cv_string_get(cvec_i(argv, 0));
+    if ((cv = cvec_find(cvv, varstr)) == NULL){
+        clixon_err(OE_PLUGIN, 0, "No such var name: %s", varstr);
+        goto done;
+    }
+    if (cvec_len(argv) == 2 &&
+        (format = format_str2int(cv_string_get(cvec_i(argv, 1)))) == -1){
+        clixon_err(OE_PLUGIN, 0, "Not valid format: %s", cv_string_get(cvec_i(argv, 1)));
+        goto done;
+    }
+    if ((yspec = clicon_dbspec_yang(h)) == NULL){
+        clixon_err(OE_FATAL, 0, "No DB_SPEC");
+        goto done;
+    }
+    if (cli_commit_history_rpc(h, 1, cv_uint32_get(cv), &xret) < 0)
+        goto done;
+    if ((xc1 = xpath_first(xret, NULL, "rpc-reply/config")) == NULL){
+        clixon_err(OE_XML, ENOENT, "No config in commit-history reply");
+        goto done;
+    }
+    if (xml_rm(xc1) < 0)
+        goto done;
+    if ((ret = xml_bind_yang(h, xc1, YB_MODULE, yspec, 0, &xerr)) < 0)
+        goto done;
+    if (ret == 0){
+        clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Commit history");
+        goto done;
+    }
+    if (clicon_rpc_get_config(h, NULL, "running", "/", NULL, NULL, &xc2) < 0)
+        goto done;
+    if ((x = xpath_first(xc2, NULL, "/rpc-error")) != NULL){
+        clixon_err_netconf(h, OE_NETCONF, 0, x, "Get configuration");
+        goto done;
+    }
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    if (format == FORMAT_XML){
+        if (clixon_xml_diff2cbuf(cb, xc2, xc1) < 0)
+            goto done;
+    }
+    else if (clixon_text_diff2cbuf(cb, xc2, xc1) < 0)
+        goto done;
+    cligen_output(stdout, "%s", cbuf_get(cb));
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    if (xerr)
+        xml_free(xerr);
+    if (xc1)
+        xml_free(xc1);
+    if (xc2)
+        xml_free(xc2);
+    if (xret)
+        xml_free(xret);
+    return retval;
+}
+
 /*! Alias function
  *
  * @param[in]  h     Clixon handle
@@ -44,6 +44,7 @@ void  cli_signal_unblock(clixon_handle h);
 int   mtpoint_paths(clixon_handle h, yang_stmt *yspec0, const char *domain, const char *spec,
                     const char *api_path_fmt1, char **api_path_fmt01);
 cvec *cvec_append(cvec *cvv0, cvec *cvv1);
+int   cli_expand_cache_free(clixon_handle h);
 
 /* If you do not find a function here it may be in clixon_cli_api.h which is 
    the external API */
@@ -566,6 +566,7 @@ yang2cli_grouping_wrap_local(clixon_handle h,
                              const char   *domain,
                              const char   *spec,
                              const char   *module,
+                             const char   *keyword,
                              const char   *argument,
                              cbuf         *cb)
 {
@@ -591,6 +592,10 @@ yang2cli_grouping_wrap_local(clixon_handle h,
         clixon_err(OE_YANG, 0, "yang2cli cmd label no module %s", module);
         goto done;
     }
+    if (strcmp(keyword, "grouping") != 0){ /* Lazy container or list body */
+        retval = yang2cli_lazy(h, ymod, keyword, argument, cb);
+        goto done;
+    }
     if ((ys = yang_find(ymod, Y_GROUPING, argument)) == NULL)
         goto skip;
     inext = 0;
@@ -620,6 +625,7 @@ yang2cli_grouping_wrap_local(clixon_handle h,
  * @retval    -1     Error
  * @see yang2cli_container  where @mountpoint is added as a generic treeref causing this call
  * @see yang2cli_yspec      which is the other place where clispecs are generated
+ * @note Also resolves lazy container and list bodies, see yang2cli_lazy
  */
 int
 yang2cli_grouping_wrap(cligen_handle ch,
@@ -655,7 +661,10 @@ yang2cli_grouping_wrap(cligen_handle ch,
                                 &keyword,
                                 &argument) < 0)
         goto done;
-    if (keyword == NULL || strcmp(keyword, "grouping") != 0)
+    if (keyword == NULL ||
+        (strcmp(keyword, "grouping") != 0 &&
+         strcmp(keyword, "container") != 0 &&
+         strcmp(keyword, "list") != 0))
         goto ok;
     if (cligen_ph_find(ch, treename) != NULL){
         if ((*namep = strdup(treename)) == NULL){
@@ -672,7 +681,7 @@ yang2cli_grouping_wrap(cligen_handle ch,
     }
     switch (cache){
         case AUTOCLI_CACHE_DISABLED: /* Generate locally */
-            if ((ret = yang2cli_grouping_wrap_local(h, domain, spec, module, argument, cb)) < 0)
+            if ((ret = yang2cli_grouping_wrap_local(h, domain, spec, module, keyword, argument, cb)) < 0)
                 goto done;
             if (ret == 0)
                 goto ok;
@@ -685,7 +694,13 @@ yang2cli_grouping_wrap(cligen_handle ch,
             }
             break;
     }
-    if (yang2cli_client(h, cbuf_get(cb), module, keyword, argument, &pt) < 0)
+    if (cbuf_len(cb) == 0){ /* Eg lazy body without children */
+        if ((pt = pt_new()) == NULL){
+            clixon_err(OE_UNIX, errno, "pt_new");
+            goto done;
+        }
+    }
+    else if (yang2cli_client(h, cbuf_get(cb), module, keyword, argument, &pt) < 0)
         goto done;
     if (cligen_expand_str2fn(pt, (expand_str2fn_t*)clixon_str2fn, NULL) < 0)
         goto done;
@@ -726,6 +741,8 @@ yang2cli_grouping_wrap(cligen_handle ch,
  * Initialize CLIgen generation from YANG models.
  * Some logic around grouping-treeref: if enabled, then groupings are separate trees with lazy
  * evaluation.  Only expanded when referenced, but need a callback. If one is not already installed.
+ * The same callback generates container and list bodies on first use if CLICON_AUTOCLI_LAZY
+ * is set.
  * @param[in]  h      Clixon handle
  */
 int
@@ -733,11 +750,14 @@ yang2cli_init(clixon_handle h)
 {
     int                             retval = -1;
     int                             grouping_treeref = 0;
+    int                             lazy = 0;
     cligen_tree_resolve_wrapper_fn *fn = NULL;
 
     if (autocli_grouping_treeref(h, &grouping_treeref) < 0)
         goto done;
-    if (grouping_treeref) {
+    if (autocli_lazy(h, &lazy) < 0)
+        goto done;
+    if (grouping_treeref || lazy) {
         cligen_tree_resolve_wrapper_get(cli_cligen(h), &fn, NULL);
         if (fn == NULL)
             cligen_tree_resolve_wrapper_set(cli_cligen(h), yang2cli_grouping_wrap, NULL);
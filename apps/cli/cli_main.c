@@ -180,7 +180,9 @@ cli_terminate(clixon_handle h)
         clixon_exit_set(1);
     if (clicon_data_get(h, "session-transport", NULL) == 0)
         clicon_rpc_close_session(h);
+    cli_expand_cache_free(h);
     xml_exit(h);
+    xmldb_snapshot_exit(h);
     yang_exit(h);
     if ((nsctx = clicon_nsctx_global_get(h)) != NULL)
         cvec_free(nsctx);
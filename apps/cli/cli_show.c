@@ -52,6 +52,7 @@
 #include <syslog.h>
 #include <pwd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <inttypes.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
@@ -178,6 +179,248 @@ expand_dbvar_insert(clixon_handle h,
     return retval;
 }
 
+/* Max number of cached expand_dbvar results, see CLICON_CLI_EXPAND_CACHE */
+#define EXPAND_CACHE_MAX 32
+
+/*! Configuration fetched by expand_dbvar for one datastore and api-path
+ */
+struct expand_cache_entry {
+    qelem_t  ec_qelem;   /* List header, most recently used first */
+    char    *ec_key;     /* Datastore, api-path and leafref-refer */
+    char    *ec_xpath;   /* XPath of api-path */
+    cvec    *ec_nsc;     /* Namespace context of xpath */
+    cxobj   *ec_xt;      /* Configuration tree bound to YANG */
+};
+
+/*! CLI expand cache, handle data pointer "cli-expand-cache"
+ *
+ * Cleared on every clixon-lib config-change notification from the backend
+ */
+struct expand_cache {
+    struct expand_cache_entry *ecs_list;     /* Entries, most recently used first */
+    int                        ecs_len;      /* Number of entries */
+    int                        ecs_s;        /* Subscription socket, or -1 */
+    int                        ecs_disabled; /* Subscription failed, do not cache */
+};
+
+static void
+expand_cache_entry_free(struct expand_cache_entry *ec)
+{
+    if (ec->ec_key)
+        free(ec->ec_key);
+    if (ec->ec_xpath)
+        free(ec->ec_xpath);
+    if (ec->ec_nsc)
+        xml_nsctx_free(ec->ec_nsc);
+    if (ec->ec_xt)
+        xml_free(ec->ec_xt);
+    free(ec);
+}
+
+/*! Remove all cached entries
+ */
+static void
+expand_cache_flush(struct expand_cache *ecs)
+{
+    struct expand_cache_entry *ec;
+
+    while ((ec = ecs->ecs_list) != NULL){
+        DELQ(ec, ecs->ecs_list, struct expand_cache_entry *);
+        expand_cache_entry_free(ec);
+    }
+    ecs->ecs_len = 0;
+}
+
+/*! Read a config-change notification from the backend and clear the cache
+ *
+ * Registered with cligen_regfd, so that notifications are consumed also when idle.
+ * The notification contents is not inspected: any datastore change clears the cache
+ * @param[in]  s    Subscription socket
+ * @param[in]  arg  Expand cache
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+expand_cache_event(int   s,
+                   void *arg)
+{
+    int                  retval = -1;
+    struct expand_cache *ecs = (struct expand_cache *)arg;
+    cbuf                *cb = NULL;
+    int                  eof = 0;
+
+    expand_cache_flush(ecs);
+    if (clixon_msg_rcv11(s, NULL, 0, &cb, &eof) < 0)
+        goto done;
+    if (eof){ /* Backend closed, subscribe again on next expand */
+        cligen_unregfd(s);
+        close(s);
+        ecs->ecs_s = -1;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Get expand cache with pending config-change notifications processed
+ *
+ * The backend sends the config-change notification before replying to the modifying
+ * request, so polling the socket here also catches changes made by this CLI session.
+ * @param[in]  h     Clixon handle
+ * @param[out] ecsp  Expand cache, or NULL if not enabled
+ * @retval     0     OK
+ * @retval    -1    Error
+ */
+static int
+expand_cache_get(clixon_handle         h,
+                 struct expand_cache **ecsp)
+{
+    int                  retval = -1;
+    struct expand_cache *ecs = NULL;
+    struct pollfd        pfd;
+    int                  s;
+
+    *ecsp = NULL;
+    if (!clicon_option_bool(h, "CLICON_CLI_EXPAND_CACHE"))
+        goto ok;
+    if (clicon_ptr_get(h, "cli-expand-cache", (void**)&ecs) < 0 || ecs == NULL){
+        if ((ecs = malloc(sizeof(*ecs))) == NULL){
+            clixon_err(OE_UNIX, errno, "malloc");
+            goto done;
+        }
+        memset(ecs, 0, sizeof(*ecs));
+        ecs->ecs_s = -1;
+        if (clicon_ptr_set(h, "cli-expand-cache", ecs) < 0){
+            free(ecs);
+            goto done;
+        }
+    }
+    if (ecs->ecs_disabled)
+        goto ok;
+    if (ecs->ecs_s == -1){
+        expand_cache_flush(ecs);
+        if (clicon_rpc_create_subscription(h, CLIXON_CONFIG_CHANGE_STREAM, NULL, &s) < 0){
+            clixon_log(h, LOG_WARNING, "%s: No %s stream in backend, expand cache disabled",
+                       __func__, CLIXON_CONFIG_CHANGE_STREAM);
+            ecs->ecs_disabled = 1;
+            goto ok;
+        }
+        if (cligen_regfd(s, expand_cache_event, ecs) < 0){
+            close(s);
+            goto done;
+        }
+        ecs->ecs_s = s;
+    }
+    while (ecs->ecs_s != -1){
+        pfd.fd = ecs->ecs_s;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, 0) <= 0 || (pfd.revents & (POLLIN|POLLHUP)) == 0)
+            break;
+        if (expand_cache_event(ecs->ecs_s, ecs) < 0)
+            goto done;
+    }
+    if (ecs->ecs_s != -1)
+        *ecsp = ecs;
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Find cached entry and mark it as most recently used
+ */
+static struct expand_cache_entry *
+expand_cache_find(struct expand_cache *ecs,
+                  const char          *key)
+{
+    struct expand_cache_entry *ec;
+
+    if ((ec = ecs->ecs_list) != NULL)
+        do {
+            if (strcmp(ec->ec_key, key) == 0){
+                if (ec != ecs->ecs_list){
+                    DELQ(ec, ecs->ecs_list, struct expand_cache_entry *);
+                    INSQ(ec, ecs->ecs_list);
+                }
+                return ec;
+            }
+            ec = NEXTQ(struct expand_cache_entry *, ec);
+        } while (ec != ecs->ecs_list);
+    return NULL;
+}
+
+/*! Add entry to cache, evicting the least recently used if full
+ *
+ * @param[in]     ecs    Expand cache
+ * @param[in]     key    Datastore, api-path and leafref-refer
+ * @param[in]     xpath  XPath of api-path
+ * @param[in,out] nsc    Namespace context, consumed and set to NULL
+ * @param[in,out] xt     Configuration tree, consumed and set to NULL
+ * @retval        0      OK
+ * @retval       -1      Error
+ */
+static int
+expand_cache_add(struct expand_cache *ecs,
+                 const char          *key,
+                 const char          *xpath,
+                 cvec               **nsc,
+                 cxobj              **xt)
+{
+    int                        retval = -1;
+    struct expand_cache_entry *ec;
+
+    if ((ec = malloc(sizeof(*ec))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    memset(ec, 0, sizeof(*ec));
+    if ((ec->ec_key = strdup(key)) == NULL ||
+        (ec->ec_xpath = strdup(xpath)) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        expand_cache_entry_free(ec);
+        goto done;
+    }
+    ec->ec_nsc = *nsc;
+    *nsc = NULL;
+    ec->ec_xt = *xt;
+    *xt = NULL;
+    INSQ(ec, ecs->ecs_list);
+    if (++ecs->ecs_len > EXPAND_CACHE_MAX){
+        ec = PREVQ(struct expand_cache_entry *, ecs->ecs_list);
+        DELQ(ec, ecs->ecs_list, struct expand_cache_entry *);
+        expand_cache_entry_free(ec);
+        ecs->ecs_len--;
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Free CLI expand cache and close its subscription
+ *
+ * @param[in]  h    Clixon handle
+ * @retval     0    OK
+ */
+int
+cli_expand_cache_free(clixon_handle h)
+{
+    struct expand_cache *ecs = NULL;
+
+    if (clicon_ptr_get(h, "cli-expand-cache", (void**)&ecs) == 0 && ecs != NULL){
+        expand_cache_flush(ecs);
+        if (ecs->ecs_s != -1){
+            cligen_unregfd(ecs->ecs_s);
+            close(ecs->ecs_s);
+        }
+        free(ecs);
+        clicon_ptr_del(h, "cli-expand-cache");
+    }
+    return 0;
+}
+
 /*! Completion callback of variable for configured data and automatically generated data model
  *
  * Returns an expand-type list of commands as used by cligen 'expand'
@@ -237,6 +480,9 @@ expand_dbvar(clixon_handle h,
     cvec            *cvv2 = NULL;
     int              ret;
     int              leafref_refer = 0;
+    struct expand_cache       *ecs = NULL;
+    struct expand_cache_entry *ec;
+    cbuf                      *cbkey = NULL;
 
     if (argv == NULL || cvec_len(argv) < 2){
         clixon_err(OE_PLUGIN, EINVAL, "requires arguments: <db> <apipathfmt> [\"leafref-refer\"] [<mountpt>]");
@@ -304,6 +550,23 @@ expand_dbvar(clixon_handle h,
     }
     if (api_path == NULL)
         goto ok;
+    /* Serve from CLI-local cache if enabled and no datastore change since fetched */
+    if (expand_cache_get(h, &ecs) < 0)
+        goto done;
+    if (ecs != NULL){
+        if ((cbkey = cbuf_new()) == NULL){
+            clixon_err(OE_UNIX, errno, "cbuf_new");
+            goto done;
+        }
+        cprintf(cbkey, "%s %d %s", dbstr, leafref_refer, api_path);
+        if ((ec = expand_cache_find(ecs, cbuf_get(cbkey))) != NULL){
+            if (xpath_vec(ec->ec_xt, ec->ec_nsc, "%s", &xvec, &xlen, ec->ec_xpath) < 0)
+                goto done;
+            if (expand_dbvar_insert(h, co, xvec, xlen, commands) < 0)
+                goto done;
+            goto ok;
+        }
+    }
     if ((cbxpath = cbuf_new()) == NULL){
         clixon_err(OE_UNIX, errno, "cbuf_new");
         goto done;
@@ -354,6 +617,10 @@ expand_dbvar(clixon_handle h,
     /* Loop for inserting into commands cvec. */
     if (expand_dbvar_insert(h, co, xvec, xlen, commands) < 0)
         goto done;
+    /* Cache takes over xt and nsc */
+    if (ecs != NULL &&
+        expand_cache_add(ecs, cbuf_get(cbkey), cbuf_get(cbxpath), &nsc, &xt) < 0)
+        goto done;
  ok:
     retval = 0;
  done:
@@ -371,6 +638,8 @@ expand_dbvar(clixon_handle h,
         free(api_path_fmt01);
     if (cbxpath)
         cbuf_free(cbxpath);
+    if (cbkey)
+        cbuf_free(cbkey);
     if (xerr)
         xml_free(xerr);
     if (nsc)
@@ -1706,6 +1975,44 @@ stats_print_header(const char *label,
     cligen_output(stdout, "\n");
 }
 
+/*! Print profiling counters and latency histograms of the backend
+ *
+ * One row per timer and RPC with number of samples, average and max latency in us.
+ * @param[in]  xp  <profile> XML node of stats reply
+ */
+static void
+stats_print_profile(cxobj *xp)
+{
+    cxobj   *x;
+    int      ix;
+    char    *name;
+    uint64_t count;
+    uint64_t total;
+    uint64_t max;
+
+    cligen_output(stdout, "\n%-24s\n", "Profile");
+    if ((name = xml_find_body(xp, "xpath-eval")) != NULL)
+        cligen_output(stdout, "%-24s %12s\n", "xpath-eval", name);
+    if ((name = xml_find_body(xp, "yang-find")) != NULL)
+        cligen_output(stdout, "%-24s %12s\n", "yang-find", name);
+    cligen_output(stdout, "%-24s %12s %12s %12s\n", "Latency", "Count", "Avg(us)", "Max(us)");
+    ix = 0;
+    while ((x = xml_child_iter(xp, &ix, CX_ELMNT)) != NULL) {
+        if (strcmp(xml_name(x), "timer") != 0 && strcmp(xml_name(x), "rpc") != 0)
+            continue;
+        if ((name = xml_find_body(x, "name")) == NULL)
+            continue;
+        count = total = max = 0;
+        parse_uint64(xml_find_body(x, "count"), &count, NULL);
+        parse_uint64(xml_find_body(x, "total-usec"), &total, NULL);
+        parse_uint64(xml_find_body(x, "max-usec"), &max, NULL);
+        cligen_output(stdout, "%s%-*s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+                      strcmp(xml_name(x), "rpc") == 0 ? "rpc:" : "",
+                      strcmp(xml_name(x), "rpc") == 0 ? 20 : 24,
+                      name, count, count ? total/count : 0, max);
+    }
+}
+
 /*! CLI callback show memory statistics (and numbers)
  *
  * mempry in KiB
@@ -2051,6 +2358,9 @@ cli_show_statistics(clixon_handle h,
             cligen_output(stdout, "%-24s %" PRIu64 "%-10s\n", "YANG Total", u64, unit);
             translatenumber(tsz0+tsz, &u64, &unit);
             cligen_output(stdout, "%-24s %" PRIu64 "%-10s\n", "Mem Total", u64, unit);
+            /* --- Profile section, if enabled in backend --- */
+            if ((xp = xml_find_type(xret_all, NULL, "profile", CX_ELMNT)) != NULL)
+                stats_print_profile(xp);
             if (xret_all){
                 xml_free(xret_all);
                 xret_all = NULL;
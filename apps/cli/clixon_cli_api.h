@@ -101,6 +101,9 @@ int   cvec_concat_cb(cvec *cvv, cbuf *cb);
 int cli_process_control(clixon_handle h, cvec *vars, cvec *argv);
 int cli_alias_cb(clixon_handle h, cvec *cvv, cvec *argv);
 int cli_cache_clear(clixon_handle h, cvec *cvv, cvec *argv);
+int cli_commit_history(clixon_handle h, cvec *cvv, cvec *argv);
+int cli_rollback(clixon_handle h, cvec *cvv, cvec *argv);
+int cli_rollback_compare(clixon_handle h, cvec *cvv, cvec *argv);
 
 /* In cli_show.c */
 int expand_dbvar(void *h, char *name, cvec *cvv, cvec *argv,
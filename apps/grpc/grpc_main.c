@@ -75,6 +75,7 @@ grpc_terminate(clixon_handle h)
     clicon_rpc_close_session(h);
     grpc_conns_free_all();
     xml_exit(h);
+    xmldb_snapshot_exit(h);
     yang_exit(h);
     if ((nsctx = clicon_nsctx_global_get(h)) != NULL)
         cvec_free(nsctx);
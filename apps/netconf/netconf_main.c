@@ -599,6 +599,7 @@ netconf_terminate(clixon_handle h)
     clixon_plugin_module_exit(h);
     clicon_rpc_close_session(h);
     xml_exit(h);
+    xmldb_snapshot_exit(h);
     yang_exit(h);
     if ((nsctx = clicon_nsctx_global_get(h)) != NULL)
         cvec_free(nsctx);
@@ -41,6 +41,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <unistd.h>
 #include <errno.h>
 #include <signal.h>
@@ -190,9 +191,9 @@ path_within_prefix(const char *prefix,
  * @param[in]      req     Generic Www handle (can be part of clixon handle)
  * @param[in]      prefix  Prefix of path0, where to start file check
  * @param[in,out]  cbpath  Filepath as cbuf, internal redirection may change it
- * @param[out]     fp      Open file, if retval = 1
- * @param[out]     fsz     Size of file, if retval = 1
- * @retval         1       OK, fp,fsz set
+ * @param[out]     resolved Canonical path of file, buffer of size PATH_MAX, if retval = 1
+ * @param[out]     st      Status of file (from lstat), if retval = 1
+ * @retval         1       OK, resolved and st set
  * @retval         0       Invalid
  * @retval        -1       Error
  */
@@ -201,20 +202,18 @@ http_data_check_file_path(clixon_handle h,
                           void         *req,
                           char         *prefix,
                           cbuf         *cbpath,
-                          FILE        **fp,
-                          off_t        *fsz)
+                          char         *resolved,
+                          struct stat  *st)
 {
     int         retval = -1;
     struct stat fstat;
     char       *p;
     int         i;
     int         code = 0;
-    FILE       *f;
-    char        resolved[PATH_MAX];
     char        resolved_prefix[PATH_MAX];
 
-    if (prefix == NULL || cbpath == NULL || fp == NULL){
-        clixon_err(OE_UNIX, EINVAL, "prefix, cbpath0 or fp is NULL");
+    if (prefix == NULL || cbpath == NULL || resolved == NULL || st == NULL){
+        clixon_err(OE_UNIX, EINVAL, "prefix, cbpath0, resolved or st is NULL");
         goto done;
     }
     /* Canonicalize the prefix once so the later comparison works even if
@@ -298,13 +297,7 @@ http_data_check_file_path(clixon_handle h,
         code = 403;
         goto invalid;
     }
-    *fsz = fstat.st_size;
-    if ((f = fopen(resolved, "rb")) == NULL){
-        clixon_debug(CLIXON_DBG_RESTCONF, "Error fopen(%s) %s", resolved, strerror(errno));
-        code = 403;
-        goto invalid;
-    }
-    *fp = f;
+    *st = fstat;
     retval = 1; /* OK */
  done:
     return retval;
@@ -315,16 +308,256 @@ http_data_check_file_path(clixon_handle h,
     goto done;
 }
 
+#ifdef HTTP_DATA_FILE_CACHE_SIZE
+/* Cached open file and its metadata
+ * @see http_data_file_open
+ */
+typedef struct {
+    char       *hf_path;  /* Canonical path, NULL if slot is free */
+    int         hf_fd;    /* Open file */
+    struct stat hf_st;    /* Status of open file (from fstat) */
+} http_data_file;
+
+static http_data_file _http_data_files[HTTP_DATA_FILE_CACHE_SIZE] = {{0,},};
+static int            _http_data_file_next = 0; /* Next slot to replace if all are used */
+#endif /* HTTP_DATA_FILE_CACHE_SIZE */
+
+/*! Open a checked file, or get it from the open file cache
+ *
+ * A cached file is used if the inode, size and modification time of the file given by
+ * st (from lstat) match the cached file. Otherwise the file is opened and cached.
+ * @param[in]     path   Canonical path of regular file
+ * @param[in,out] st     Status of file (from lstat), replaced with status of open file
+ * @param[out]    fdp    Open file, close with close(2)
+ * @retval        1      OK, fdp set
+ * @retval        0      File could not be opened or has changed since checked
+ * @retval       -1      Error
+ * @see HTTP_DATA_FILE_CACHE_SIZE
+ */
+static int
+http_data_file_open(const char  *path,
+                    struct stat *st,
+                    int         *fdp)
+{
+    int             retval = -1;
+    int             fd = -1;
+    struct stat     st1;
+#ifdef HTTP_DATA_FILE_CACHE_SIZE
+    http_data_file *hf;
+    int             i;
+
+    for (i=0; i<HTTP_DATA_FILE_CACHE_SIZE; i++){
+        hf = &_http_data_files[i];
+        if (hf->hf_path == NULL || strcmp(hf->hf_path, path) != 0)
+            continue;
+        if (hf->hf_st.st_dev == st->st_dev &&
+            hf->hf_st.st_ino == st->st_ino &&
+            hf->hf_st.st_size == st->st_size &&
+            hf->hf_st.st_mtime == st->st_mtime){
+            if ((fd = dup(hf->hf_fd)) < 0){
+                clixon_err(OE_UNIX, errno, "dup");
+                goto done;
+            }
+            *st = hf->hf_st;
+            *fdp = fd;
+            goto ok;
+        }
+        /* File has changed, remove from cache */
+        close(hf->hf_fd);
+        free(hf->hf_path);
+        hf->hf_path = NULL;
+        break;
+    }
+#endif /* HTTP_DATA_FILE_CACHE_SIZE */
+    if ((fd = open(path, O_RDONLY|O_CLOEXEC)) < 0){
+        clixon_debug(CLIXON_DBG_RESTCONF, "Error open(%s) %s", path, strerror(errno));
+        goto fail;
+    }
+    if (fstat(fd, &st1) < 0){
+        clixon_err(OE_UNIX, errno, "fstat(%s)", path);
+        goto done;
+    }
+    /* Sanity check: same file as checked */
+    if (!S_ISREG(st1.st_mode) ||
+        st1.st_dev != st->st_dev ||
+        st1.st_ino != st->st_ino){
+        clixon_debug(CLIXON_DBG_RESTCONF, "Error open(%s): file changed", path);
+        goto fail;
+    }
+    *st = st1;
+#ifdef HTTP_DATA_FILE_CACHE_SIZE
+    for (i=0; i<HTTP_DATA_FILE_CACHE_SIZE; i++)
+        if (_http_data_files[i].hf_path == NULL)
+            break;
+    if (i == HTTP_DATA_FILE_CACHE_SIZE){ /* Replace round-robin */
+        i = _http_data_file_next;
+        _http_data_file_next = (i + 1) % HTTP_DATA_FILE_CACHE_SIZE;
+    }
+    hf = &_http_data_files[i];
+    if (hf->hf_path){
+        close(hf->hf_fd);
+        free(hf->hf_path);
+        hf->hf_path = NULL;
+    }
+    if ((hf->hf_path = strdup(path)) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        goto done;
+    }
+    hf->hf_fd = fd;
+    hf->hf_st = st1;
+    if ((fd = dup(fd)) < 0){
+        clixon_err(OE_UNIX, errno, "dup");
+        goto done;
+    }
+#endif /* HTTP_DATA_FILE_CACHE_SIZE */
+    *fdp = fd;
+    fd = -1;
+ ok:
+    retval = 1;
+ done:
+    if (retval != 1 && fd != -1)
+        close(fd);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Close and free all cached open files
+ *
+ * @retval     0         OK
+ * @see http_data_file_open
+ */
+int
+api_http_data_exit(void)
+{
+#ifdef HTTP_DATA_FILE_CACHE_SIZE
+    http_data_file *hf;
+    int             i;
+
+    for (i=0; i<HTTP_DATA_FILE_CACHE_SIZE; i++){
+        hf = &_http_data_files[i];
+        if (hf->hf_path){
+            close(hf->hf_fd);
+            free(hf->hf_path);
+            hf->hf_path = NULL;
+        }
+    }
+#endif
+    return 0;
+}
+
+/*! Check if an entity-tag matches an If-None-Match header value
+ *
+ * Weak comparison according to RFC 9110 Sec 13.1.2
+ * @param[in]  list   If-None-Match value: "*" or list of entity-tags
+ * @param[in]  etag   Entity-tag of file, with quotes
+ * @retval     1      Match
+ * @retval     0      No match
+ */
+static int
+http_data_etag_match(const char *list,
+                     const char *etag)
+{
+    const char *p = list;
+    const char *q;
+    size_t      len = strlen(etag);
+
+    while (*p != '\0'){
+        while (*p == ' ' || *p == '\t' || *p == ',')
+            p++;
+        if (*p == '*')
+            return 1;
+        if (strncmp(p, "W/", 2) == 0)
+            p += 2;
+        if (*p != '"' || (q = index(p+1, '"')) == NULL)
+            break;
+        if (q-p+1 == len && strncmp(p, etag, len) == 0)
+            return 1;
+        p = q+1;
+    }
+    return 0;
+}
+
+/*! Parse the value of a Range header for a file
+ *
+ * Only a single byte range is supported, as allowed by RFC 9110 Sec 14.2.
+ * Invalid ranges and multiple ranges are ignored, ie the whole file is returned.
+ * @param[in]  range  Range header value, eg bytes=0-499, bytes=500- or bytes=-500
+ * @param[in]  size   Size of file
+ * @param[out] start  Start of range
+ * @param[out] len    Length of range
+ * @retval     1      OK, start and len set, whole file if range is ignored
+ * @retval     0      Range not satisfiable
+ */
+static int
+http_data_range(const char *range,
+                off_t       size,
+                off_t      *start,
+                off_t      *len)
+{
+    const char        *p;
+    char              *ep;
+    unsigned long long first;
+    unsigned long long last;
+
+    *start = 0;
+    *len = size;
+    if (strncmp(range, "bytes=", strlen("bytes=")) != 0 || index(range, ',') != NULL)
+        return 1;
+    p = range + strlen("bytes=");
+    if (*p == '-'){ /* Suffix range: last bytes */
+        if (!isdigit(p[1]))
+            return 1;
+        last = strtoull(p+1, &ep, 10);
+        if (*ep != '\0')
+            return 1;
+        if (last == 0)
+            return 0;
+        if (last < size){
+            *start = size - last;
+            *len = last;
+        }
+        return 1;
+    }
+    if (!isdigit(*p))
+        return 1;
+    first = strtoull(p, &ep, 10);
+    if (*ep != '-')
+        return 1;
+    p = ep + 1;
+    if (*p == '\0')
+        last = size - 1;
+    else {
+        if (!isdigit(*p))
+            return 1;
+        last = strtoull(p, &ep, 10);
+        if (*ep != '\0' || last < first)
+            return 1;
+        if (last >= size)
+            last = size - 1;
+    }
+    if (first >= size)
+        return 0;
+    *start = first;
+    *len = last - first + 1;
+    return 1;
+}
+
 /*! Read file data request
  *
+ * The file is not read into memory, the reply body is sent from the open file, see
+ * restconf_reply_send_file. Open files are cached, see HTTP_DATA_FILE_CACHE_SIZE
+ * Conditional and range requests:
+ * - ETag and Last-Modified are returned
+ * - 304 Not Modified if If-None-Match matches the ETag
+ * - 206 Partial Content on a single byte range in Range (unless If-Range does not match)
  * @param[in]  h         Clixon handle
  * @param[in]  req       Generic Www handle (can be part of clixon handle)
  * @param[in]  pathname  With stripped prefix (eg /data), ultimately a filename
  * @param[in]  head      HEAD not GET
  * @retval     0         OK
  * @retval    -1         Error
- * @note: primitive file handling, just check if file exists and read it all
- * XXX 1: Buffer copying once too many, see #if 0 below
  */
 static int
 api_http_data_file(clixon_handle h,
@@ -332,20 +565,25 @@ api_http_data_file(clixon_handle h,
                    char         *pathname,
                    int           head)
 {
-    int    retval = -1;
-    cbuf  *cbfile = NULL;
-    char  *filename = NULL;
-    cbuf  *cbdata = NULL;
-    FILE  *f = NULL;
-    off_t  fsz = 0;
-    long   fsize;
-    char  *www_data_root = NULL;
-    char  *suffix;
+    int         retval = -1;
+    cbuf       *cbfile = NULL;
+    char       *filename = NULL;
+    char       *www_data_root = NULL;
+    char       *suffix;
     const char *media;
-    char  *buf = NULL;
-    size_t sz;
-    char  *media_list = NULL;
-    int    ret;
+    char       *media_list = NULL;
+    char        resolved[PATH_MAX];
+    struct stat st;
+    int         fd = -1;
+    char        etag[64];
+    char        lastmod[64];
+    struct tm   tm;
+    char       *str;
+    char       *ifrange;
+    off_t       start = 0;
+    off_t       len;
+    int         code = 200;
+    int         ret;
 
     clixon_debug(CLIXON_DBG_RESTCONF, "");
     if ((cbfile = cbuf_new()) == NULL){
@@ -367,7 +605,7 @@ api_http_data_file(clixon_handle h,
         }
         cprintf(cbfile, "%s", pathname); /* Assume pathname starts with '/' */
     }
-    if ((ret = http_data_check_file_path(h, req, www_data_root, cbfile, &f, &fsz)) < 0)
+    if ((ret = http_data_check_file_path(h, req, www_data_root, cbfile, resolved, &st)) < 0)
         goto done;
     if (ret == 0) /* Invalid, return code set */
         goto ok;
@@ -394,65 +632,67 @@ api_http_data_file(clixon_handle h,
             goto ok;
         }
     }
-    /* Size could have been taken from stat() but this reduces the race condition interval 
-     * There is still one without flock
-     */
-    fseek(f, 0, SEEK_END);
-    fsize = ftell(f);
-    /* Extra sanity check, had some problems with wrong file types */
-    if (fsz != fsize){
-        clixon_debug(CLIXON_DBG_RESTCONF, "Error file %s size mismatch sz:%zu vs %li",
-                     filename, (size_t)fsz, fsize);
-        if (api_http_data_err(h, req, 500) < 0) /* Internal error? */
+    /* Status is from the open file, which reduces the race condition interval */
+    if ((ret = http_data_file_open(resolved, &st, &fd)) < 0)
+        goto done;
+    if (ret == 0){
+        if (api_http_data_err(h, req, 403) < 0)
             goto done;
         goto ok;
     }
-    fseek(f, 0, SEEK_SET);  /* same as rewind(f); */
-    if ((cbdata = cbuf_new_alloc(fsize+1)) == NULL){
-        clixon_err(OE_UNIX, errno, "cbuf_new_alloc");
+    /* Validators */
+    snprintf(etag, sizeof(etag), "\"%lx-%lx-%lx\"",
+             (unsigned long)st.st_ino, (unsigned long)st.st_mtime, (unsigned long)st.st_size);
+    gmtime_r(&st.st_mtime, &tm);
+    strftime(lastmod, sizeof(lastmod), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    if (restconf_reply_header(req, "ETag", "%s", etag) < 0)
         goto done;
-    }
-    /* Unoptimized, no direct read but requires an extra copy,
-     * the cligen buf API should have some mechanism for this case without the extra copy.
-     */
-    if ((buf = malloc(fsize)) == NULL){
-        clixon_err(OE_UNIX, errno, "malloc");
+    if (restconf_reply_header(req, "Last-Modified", "%s", lastmod) < 0)
         goto done;
-    }
-    if ((sz = fread(buf, fsize, 1, f)) == 0){
-        clixon_debug(CLIXON_DBG_RESTCONF, "Error fread(%s) err:%d", filename, ferror(f));
-        if (api_http_data_err(h, req, 500) < 0) /* Internal error? */
+    if ((str = restconf_param_get(h, "HTTP_IF_NONE_MATCH")) != NULL &&
+        http_data_etag_match(str, etag) == 1){
+        if (restconf_reply_send(req, 304, NULL, 0) < 0)
             goto done;
+        clixon_debug(CLIXON_DBG_RESTCONF, "%s not modified", filename);
         goto ok;
     }
-    if (sz != 1){
-        clixon_debug(CLIXON_DBG_RESTCONF, "Error fread(%s) sz:%zu", filename, sz);
-        if (api_http_data_err(h, req, 500) < 0) /* Internal error? */
-            goto done;
-        goto ok;
-    }
-    if (cbuf_append_buf(cbdata, buf, fsize) < 0){
-        clixon_err(OE_UNIX, errno, "cbuf_append_str");
+    if (restconf_reply_header(req, "Accept-Ranges", "bytes") < 0)
         goto done;
+    len = st.st_size;
+    /* Range is ignored if If-Range does not match, ie the whole file is returned */
+    if ((str = restconf_param_get(h, "HTTP_RANGE")) != NULL &&
+        ((ifrange = restconf_param_get(h, "HTTP_IF_RANGE")) == NULL ||
+         strcmp(ifrange, etag) == 0 ||
+         strcmp(ifrange, lastmod) == 0)){
+        if (http_data_range(str, st.st_size, &start, &len) == 0){
+            if (restconf_reply_header(req, "Content-Range", "bytes */%zu", (size_t)st.st_size) < 0)
+                goto done;
+            if (api_http_data_err(h, req, 416) < 0)
+                goto done;
+            goto ok;
+        }
+        if (start != 0 || len != st.st_size){
+            if (restconf_reply_header(req, "Content-Range", "bytes %zu-%zu/%zu",
+                                      (size_t)start, (size_t)(start+len-1), (size_t)st.st_size) < 0)
+                goto done;
+            code = 206;
+        }
     }
     if (restconf_reply_header(req, "Content-Type", "%s", media) < 0)
         goto done;
-    if (restconf_reply_send(req, 200, cbdata, head) < 0)
+    ret = restconf_reply_send_file(req, code, fd, start, len, head);
+    fd = -1; /* consumed by reply-send */
+    if (ret < 0)
         goto done;
-    cbdata = NULL; /* consumed by reply-send */
     clixon_debug(CLIXON_DBG_RESTCONF, "Read %s OK", filename);
  ok:
     retval = 0;
  done:
-    if (buf)
-        free(buf);
-    if (f)
-        fclose(f);
+    if (fd != -1)
+        close(fd);
     if (cbfile)
         cbuf_free(cbfile);
-    if (cbdata)
-        cbuf_free(cbdata);
- return retval;
+    return retval;
 }
 
 /*! Get data request
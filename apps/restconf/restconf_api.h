@@ -38,6 +38,12 @@
 #ifndef _RESTCONF_API_H_
 #define _RESTCONF_API_H_
 
+/*
+ * Constants
+ */
+/* Read size when a file body is copied to the connection, eg with TLS */
+#define RESTCONF_FILE_CHUNK_SIZE 65536
+
 /*
  * Prototypes
  */
@@ -46,6 +52,9 @@ int restconf_reply_header(void *req, const char *name, const char *vfmt, ...)  _
 /* note cb is consumed dont free */
 int restconf_reply_send(void *req, int code, cbuf *cb, int head);
 
+/* note fd is consumed dont close */
+int restconf_reply_send_file(void *req, int code, int fd, off_t offset, size_t len, int head);
+
 cbuf *restconf_get_indata(void *req);
 
 #endif /* _RESTCONF_API_H_ */
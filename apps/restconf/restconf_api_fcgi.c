@@ -230,6 +230,76 @@ restconf_reply_send(void  *req0,
     return retval;
 }
 
+/*! HTTP reply with a file region as message body
+ *
+ * @param[in]  req     Fastcgi request handle
+ * @param[in]  code    Status code
+ * @param[in]  fd      Open file descriptor. Note: is consumed
+ * @param[in]  offset  Start of body in file
+ * @param[in]  len     Length of body
+ * @param[in]  head    Only send headers, dont send body.
+ * @retval     0       OK
+ * @retval    -1       Error
+ * @note The file is copied to the fastcgi stream in chunks, there is no sendfile
+ */
+int
+restconf_reply_send_file(void  *req0,
+                         int    code,
+                         int    fd,
+                         off_t  offset,
+                         size_t len,
+                         int    head)
+{
+    FCGX_Request *req = (FCGX_Request *)req0;
+    int           retval = -1;
+    const char   *reason_phrase;
+    char         *buf = NULL;
+    size_t        totlen = 0;
+    size_t        sz;
+    ssize_t       n;
+
+    FCGX_SetExitStatus(code, req->out);
+    if ((reason_phrase = restconf_code2reason(code)) == NULL)
+        reason_phrase="";
+    if (restconf_reply_header(req, "Status", "%d %s", code, reason_phrase) < 0)
+        goto done;
+    if (len && restconf_reply_header(req, "Content-Length", "%zu", len) < 0)
+        goto done;
+    FCGX_FPrintF(req->out, "\r\n");
+    if (!head && len){
+        if ((buf = malloc(RESTCONF_FILE_CHUNK_SIZE)) == NULL){
+            clixon_err(OE_UNIX, errno, "malloc");
+            goto done;
+        }
+        while (totlen < len){
+            sz = len - totlen;
+            if (sz > RESTCONF_FILE_CHUNK_SIZE)
+                sz = RESTCONF_FILE_CHUNK_SIZE;
+            if ((n = pread(fd, buf, sz, offset)) < 0){
+                clixon_err(OE_UNIX, errno, "pread");
+                goto done;
+            }
+            if (n == 0){
+                clixon_err(OE_UNIX, 0, "pread: unexpected end of file");
+                goto done;
+            }
+            if (FCGX_PutStr(buf, n, req->out) < 0){
+                clixon_err(OE_RESTCONF, 0, "FCGX_PutStr");
+                goto done;
+            }
+            offset += n;
+            totlen += n;
+        }
+    }
+    FCGX_FFlush(req->out);
+    retval = 0;
+ done:
+    if (buf)
+        free(buf);
+    close(fd);
+    return retval;
+}
+
 /*! Get input data from http request, eg such as curl -X PUT http://... <indata>
  *
  * @param[in]  req        Fastcgi request handle
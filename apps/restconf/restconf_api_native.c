@@ -186,6 +186,55 @@ restconf_reply_send(void  *req0,
     return retval;
 }
 
+/*! Assign values to HTTP reply with a file region as message body
+ *
+ * As restconf_reply_send but the body is not copied to a buffer. It is written directly
+ * from the file when the reply is sent, using sendfile() if possible.
+ * @param[in]  req     http request handle
+ * @param[in]  code    Status code
+ * @param[in]  fd      Open file descriptor. Note: is consumed
+ * @param[in]  offset  Start of body in file
+ * @param[in]  len     Length of body, ie Content-Length
+ * @param[in]  head    Only send headers, dont send body.
+ * @retval     0       OK
+ * @retval    -1       Error
+ * @see restconf_reply_send
+ */
+int
+restconf_reply_send_file(void  *req0,
+                         int    code,
+                         int    fd,
+                         off_t  offset,
+                         size_t len,
+                         int    head)
+{
+    int                   retval = -1;
+    restconf_stream_data *sd = (restconf_stream_data *)req0;
+
+    clixon_debug(CLIXON_DBG_RESTCONF, "code:%d len:%zu", code, len);
+    if (sd == NULL){
+        clixon_err(OE_CFG, EINVAL, "sd is NULL");
+        goto done;
+    }
+    sd->sd_code = code;
+    sd->sd_body_len = len;
+    if (head || len == 0)
+        close(fd);
+    else {
+        if (sd->sd_fd != -1)
+            close(sd->sd_fd);
+        sd->sd_fd = fd;
+        sd->sd_fd_offset = offset;
+        sd->sd_body_offset = 0;
+    }
+    fd = -1;
+    retval = 0;
+ done:
+    if (fd != -1)
+        close(fd);
+    return retval;
+}
+
 /*! Get input data from http request, eg such as curl -X PUT http://... <indata>
  *
  * @param[in]  req        Request handle
@@ -345,7 +345,7 @@ restconf_http1_reply(restconf_conn        *rc,
      * (Successful) response to a CONNECT request (Section 4.3.6 of
      * [RFC7231]).
      */
-    if (sd->sd_code != 204 && sd->sd_code > 199 && !rc->rc_event_stream)
+    if (sd->sd_code != 204 && sd->sd_code != 304 && sd->sd_code > 199 && !rc->rc_event_stream)
         if (restconf_reply_header(sd, "Content-Length", "%zu", sd->sd_body_len) < 0)
             goto done;
     /* Create reply and write headers */
@@ -364,7 +364,7 @@ restconf_http1_reply(restconf_conn        *rc,
     while ((cv = cvec_each(sd->sd_outp_hdrs, cv)) != NULL)
         cprintf(sd->sd_outp_buf, "%s: %s\r\n", cv_name_get(cv), cv_string_get(cv));
     cprintf(sd->sd_outp_buf, "\r\n");
-    /* Write a body */
+    /* Write a body, a file body is written after the headers, see native_file_write */
     if (sd->sd_body){
         if (cbuf_append_buf(sd->sd_outp_buf, cbuf_get(sd->sd_body), cbuf_len(sd->sd_body)) < 0){
             clixon_err(OE_RESTCONF, errno, "cbuf_append_buf");
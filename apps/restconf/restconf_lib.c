@@ -442,6 +442,7 @@ restconf_terminate(clixon_handle h)
         clicon_username_set(h, pw->pw_name);
     clicon_rpc_close_session(h);
     xml_exit(h);
+    xmldb_snapshot_exit(h);
     yang_exit(h);
     if ((nsctx = clicon_nsctx_global_get(h)) != NULL)
         cvec_free(nsctx);
@@ -86,6 +86,7 @@
 #include "restconf_methods_get.h"
 #include "restconf_methods_post.h"
 #include "restconf_stream.h"
+#include "clixon_http_data.h"
 #include "banned.h"
 
 /* Command line options to be passed to getopt(3) */
@@ -741,6 +742,7 @@ main(int    argc,
         stream_child_freeall(h);
         clixon_log_init(h, __PROGRAM__, LOG_INFO, 0); /* Log on syslog no stderr */
         clixon_log(h, LOG_NOTICE, "%s: %u Terminated", __PROGRAM__, getpid());
+        api_http_data_exit();
         restconf_terminate(h);
     }
     return retval;
@@ -157,6 +157,7 @@
 #ifdef HAVE_HTTP1
 #include "restconf_http1.h"
 #endif
+#include "clixon_http_data.h"
 
 #ifndef SOCK_NONBLOCK
 #include <fcntl.h>
@@ -1423,6 +1424,7 @@ main(int    argc,
     if (h){
         clixon_log_init(h, __PROGRAM__, LOG_INFO, 0); /* Log on syslog no stderr */
         clixon_log(h, LOG_NOTICE, "%s: %u Terminated", __PROGRAM__, getpid());
+        api_http_data_exit();
         restconf_native_terminate(h);
         restconf_terminate(h);
     }
@@ -49,6 +49,9 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <sys/resource.h>
+#ifdef HAVE_SYS_SENDFILE_H
+#include <sys/sendfile.h>
+#endif
 
 #include <openssl/ssl.h>
 #include <openssl/rand.h>
@@ -67,6 +70,7 @@
 /* restconf */
 #include "restconf_lib.h"       /* generic shared with plugins */
 #include "restconf_handle.h"
+#include "restconf_api.h"       /* Virtual api */
 #include "restconf_err.h"
 #include "restconf_native.h"    /* Restconf-openssl mode specific headers*/
 #ifdef HAVE_LIBNGHTTP2
@@ -494,6 +498,108 @@ native_buf_write(clixon_handle    h,
     goto done;
 }
 
+/*! Write a region of a file to socket
+ *
+ * Uses sendfile() on plain sockets where available, so that file data is not copied
+ * to user space. Otherwise, eg with SSL, the file is read in chunks with pread()
+ * and written with native_buf_write.
+ * @param[in]  h        Clixon handle
+ * @param[in]  fd       Open file
+ * @param[in]  offset   Start of region in file
+ * @param[in]  len      Length of region
+ * @param[in]  rc       Connection struct
+ * @param[in]  callfn   For debug
+ * @retval  1  OK
+ * @retval  0  OK, but socket write returned error, caller should close rc
+ * @retval -1  Error
+ * @see native_buf_write
+ */
+int
+native_file_write(clixon_handle    h,
+                  int              fd,
+                  off_t            offset,
+                  size_t           len,
+                  restconf_conn   *rc,
+                  const char      *callfn)
+{
+    int     retval = -1;
+    char   *buf = NULL;
+    ssize_t n;
+    size_t  totlen = 0;
+    size_t  sz;
+    int     ret;
+
+    if (rc == NULL){
+        clixon_err(OE_RESTCONF, EINVAL, "rc is NULL");
+        goto done;
+    }
+    clixon_debug(CLIXON_DBG_RESTCONF, "%s offset:%zu len:%zu", callfn, (size_t)offset, len);
+#ifdef HAVE_SYS_SENDFILE_H
+    if (rc->rc_ssl == NULL){
+        while (totlen < len){
+            if ((n = sendfile(rc->rc_s, fd, &offset, len-totlen)) < 0){
+                switch (errno){
+                case EAGAIN:     /* Operation would block */
+                    clixon_debug(CLIXON_DBG_RESTCONF, "sendfile EAGAIN");
+                    usleep(10000);
+                    continue;
+                    break;
+                case ECONNRESET: /* Connection reset by peer */
+                case EPIPE:   /* Broken pipe */
+                    goto closed; /* Close socket and ssl */
+                    break;
+                default:
+                    clixon_err(OE_UNIX, errno, "sendfile");
+                    goto done;
+                    break;
+                }
+            }
+            if (n == 0){ /* File truncated after headers were sent: close */
+                clixon_log(h, LOG_WARNING, "%s: sendfile: unexpected end of file", __func__);
+                goto closed;
+            }
+            totlen += n;
+        }
+        retval = 1;
+        goto done;
+    }
+#endif /* HAVE_SYS_SENDFILE_H */
+    if ((buf = malloc(RESTCONF_FILE_CHUNK_SIZE)) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    while (totlen < len){
+        sz = len - totlen;
+        if (sz > RESTCONF_FILE_CHUNK_SIZE)
+            sz = RESTCONF_FILE_CHUNK_SIZE;
+        if ((n = pread(fd, buf, sz, offset)) < 0){
+            if (errno == EINTR)
+                continue;
+            clixon_err(OE_UNIX, errno, "pread");
+            goto done;
+        }
+        if (n == 0){ /* File truncated after headers were sent: close */
+            clixon_log(h, LOG_WARNING, "%s: pread: unexpected end of file", __func__);
+            goto closed;
+        }
+        if ((ret = native_buf_write(h, buf, n, rc, callfn)) < 0)
+            goto done;
+        if (ret == 0)
+            goto closed;
+        offset += n;
+        totlen += n;
+    }
+    retval = 1;
+ done:
+    if (buf)
+        free(buf);
+    clixon_debug(CLIXON_DBG_RESTCONF, "retval:%d", retval);
+    return retval;
+ closed:
+    retval = 0;
+    goto done;
+}
+
 /*! Send early handcoded bad request reply before actual packet received, just after accept
  *
  * @param[in]  h    Clixon handle
@@ -859,6 +965,15 @@ restconf_http1_process(restconf_conn *rc,
     if ((ret = native_buf_write(h, cbuf_get(sd->sd_outp_buf), cbuf_len(sd->sd_outp_buf),
                                 rc, __func__)) < 0)
         goto done;
+    /* File body, see restconf_reply_send_file */
+    if (sd->sd_fd != -1){
+        if (ret == 1 &&
+            (ret = native_file_write(h, sd->sd_fd, sd->sd_fd_offset, sd->sd_body_len,
+                                     rc, __func__)) < 0)
+            goto done;
+        close(sd->sd_fd);
+        sd->sd_fd = -1;
+    }
     cvec_reset(sd->sd_outp_hdrs); /* Can be done in native_send_reply */
     cbuf_reset(sd->sd_outp_buf);
     cbuf_reset(sd->sd_inbuf);
@@ -85,7 +85,8 @@ struct restconf_conn;
 typedef struct  {
     qelem_t               sd_qelem;     /* List header */
     int32_t               sd_stream_id;
-    int                   sd_fd;        /* XXX Is this used? */
+    int                   sd_fd;        /* File body, or -1, see restconf_reply_send_file */
+    off_t                 sd_fd_offset; /* Start of file body in sd_fd */
     cvec                 *sd_outp_hdrs; /* List of output headers */
     cbuf                 *sd_outp_buf;  /* Output buffer */
     cbuf                 *sd_body;      /* http output body as cbuf terminated with \r\n */
@@ -191,6 +192,7 @@ int               ssl_x509_name_oneline(SSL *ssl, char **oneline);
 int               restconf_close_ssl_socket(restconf_conn *rc, const char *callfn, int sslerr0);
 int               restconf_connection_sanity(clixon_handle h, restconf_conn *rc, restconf_stream_data *sd);
 int               native_buf_write(clixon_handle h, char *buf, size_t buflen, restconf_conn *rc, const char *callfn);
+int               native_file_write(clixon_handle h, int fd, off_t offset, size_t len, restconf_conn *rc, const char *callfn);
 restconf_native_handle *restconf_native_handle_get(clixon_handle h);
 int               restconf_connection(int s, void *arg);
 int               restconf_ssl_accept_client(clixon_handle h, int s, restconf_socket *rsock, restconf_conn  **rcp);
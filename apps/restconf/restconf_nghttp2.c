@@ -403,8 +403,28 @@ restconf_sd_read(nghttp2_session     *session,
     cbuf                 *cb;
     size_t                len = 0;
     size_t                remain;
+    ssize_t               n;
 
     clixon_debug(CLIXON_DBG_RESTCONF, "");
+    if (sd->sd_fd != -1){ /* File body, see restconf_reply_send_file */
+        remain = sd->sd_body_len - sd->sd_body_offset;
+        if (remain <= length)
+            len = remain;
+        else
+            len = length;
+        if ((n = pread(sd->sd_fd, buf, len, sd->sd_fd_offset + sd->sd_body_offset)) < 0){
+            clixon_debug(CLIXON_DBG_RESTCONF, "pread: %s", strerror(errno));
+            return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+        }
+        if (n == 0){ /* File truncated */
+            clixon_debug(CLIXON_DBG_RESTCONF, "pread: unexpected end of file");
+            return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+        }
+        sd->sd_body_offset += n;
+        if (sd->sd_body_offset == sd->sd_body_len)
+            *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+        return n;
+    }
     if ((cb = sd->sd_body) == NULL){ /* shouldnt happen */
         if (rc->rc_event_stream && rc->rc_exit == 0) {
             return NGHTTP2_ERR_DEFERRED;
@@ -61,10 +61,42 @@
 #include "snmp_handler.h"
 #include "banned.h"
 
-struct snmp_getnext_cache {
-    cxobj         *sg_xml;
-    char          *sg_xpath;
-    struct timeval sg_timer;
+/* Initial number of entries allocated in a table snapshot */
+#define SNMP_TABLE_SNAPSHOT_START 64
+
+/* Column of a table with its OID, computed once per snapshot
+ */
+struct snmp_table_column {
+    yang_stmt *tc_yang;
+    oid        tc_oid[MAX_OID_LEN];
+    size_t     tc_oidlen;
+};
+
+/* Entry of a table snapshot: one column of one row
+ */
+struct snmp_table_entry {
+    oid       *te_oid;    /* Column + index OID, points into ts_oids */
+    size_t     te_oidoff; /* Offset of OID in ts_oids */
+    size_t     te_oidlen; /* Length of OID */
+    cxobj     *te_xml;    /* Column leaf in ts_xml */
+    yang_stmt *te_yang;   /* Yang of column leaf */
+};
+
+/* Snapshot of a table, entries sorted in OID order for GETNEXT
+ * @see snmp_table_snapshot_get
+ */
+struct snmp_table_snapshot {
+    qelem_t                  ts_qelem;  /* List header */
+    yang_stmt               *ts_ylist;  /* Yang of table (of list type) */
+    int                      ts_valid;  /* Snapshot is valid, else rebuild on next use */
+    struct timeval           ts_time;   /* Time of snapshot */
+    cxobj                   *ts_xml;    /* Table XML as read from backend */
+    struct snmp_table_entry *ts_vec;    /* Entries sorted in OID order */
+    size_t                   ts_len;    /* Number of entries */
+    size_t                   ts_vlen;   /* Allocated entries */
+    oid                     *ts_oids;   /* All entry OIDs */
+    size_t                   ts_olen;   /* Allocated OIDs */
+    size_t                   ts_cursor; /* Entry last returned by GETNEXT */
 };
 
 /*! Common code for handling incoming SNMP request
@@ -756,6 +788,8 @@ clixon_snmp_scalar_handler1(netsnmp_mib_handler          *handler,
     case MODE_SET_COMMIT:   /* 3 */
         if ((ret = clicon_rpc_commit(sh->sh_h, 0, 0, 0, NULL, NULL)) < 0)
             goto done;
+        if (clixon_snmp_table_snapshot_invalidate(sh->sh_h) < 0)
+            goto done;
         if (ret == 0){
             /* Note that error given in commit is not propagated to the snmp client,
              * therefore validation is in the ACTION instead
@@ -1144,86 +1178,261 @@ snmp_table_set(clixon_handle               h,
     goto done;
 }
 
-/*! Use a cache for getnext tables instead of an RPC to the backend every time
+/*! Compare two snapshot entries in OID order, qsort callback
+ */
+static int
+snmp_table_entry_cmp(const void *a,
+                     const void *b)
+{
+    const struct snmp_table_entry *te0 = (const struct snmp_table_entry *)a;
+    const struct snmp_table_entry *te1 = (const struct snmp_table_entry *)b;
+
+    return snmp_oid_compare(te0->te_oid, te0->te_oidlen, te1->te_oid, te1->te_oidlen);
+}
+
+/*! Clear contents of a table snapshot
+ *
+ * The entry and OID vectors are kept allocated for the next rebuild
+ * @param[in]  ts     Table snapshot
+ */
+static int
+snmp_table_snapshot_clear(struct snmp_table_snapshot *ts)
+{
+    if (ts->ts_xml){
+        xml_free(ts->ts_xml);
+        ts->ts_xml = NULL;
+    }
+    ts->ts_len = 0;
+    ts->ts_cursor = 0;
+    ts->ts_valid = 0;
+    return 0;
+}
+
+/*! Build a table snapshot from the backend, with one entry per column and row
+ *
+ * The table is read with one get RPC. Column OIDs are computed once per column
+ * and index OIDs once per row. All OIDs are stored in a single vector and the
+ * entries are then sorted in OID order.
+ * @param[in]  h      Clixon handle
+ * @param[in]  ts     Table snapshot, cleared on entry
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+static int
+snmp_table_snapshot_build(clixon_handle               h,
+                          struct snmp_table_snapshot *ts)
+{
+    int                      retval = -1;
+    yang_stmt               *ylist = ts->ts_ylist;
+    yang_stmt               *ys;
+    yang_stmt               *yc;
+    yang_stmt               *ycol;
+    cvec                    *nsc = NULL;
+    char                    *xpath = NULL;
+    cxobj                   *xt = NULL;
+    cxobj                   *xerr;
+    cxobj                   *xtable;
+    cxobj                   *xrow;
+    cxobj                   *xcol;
+    cvec                    *cvk_name;
+    struct snmp_table_column *cols = NULL;
+    int                      ncols = 0;
+    int                      inext;
+    int                      ixrow;
+    int                      ixcol;
+    int                      i;
+    oid                      oidk[MAX_OID_LEN] = {0,}; /* Key oid */
+    size_t                   oidklen = MAX_OID_LEN;
+    size_t                   oidlen;
+    size_t                   nentries = 0;
+    size_t                   j;
+    size_t                   noids = 0;
+    size_t                   len;
+    struct snmp_table_entry *te;
+    oid                     *o;
+    int                      ret;
+
+    clixon_debug(CLIXON_DBG_SNMP, "%s", yang_argument_get(ylist));
+    snmp_table_snapshot_clear(ts);
+    if ((ys = yang_parent_get(ylist)) == NULL ||
+        yang_keyword_get(ys) != Y_CONTAINER){
+        clixon_err(OE_YANG, EINVAL, "ylist parent is not list");
+        goto done;
+    }
+    if ((cvk_name = yang_cvec_get(ylist)) == NULL){
+        clixon_err(OE_YANG, 0, "No keys");
+        goto done;
+    }
+    /* Column OIDs, once per table */
+    if ((cols = calloc(yang_len_get(ylist), sizeof(*cols))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        goto done;
+    }
+    inext = 0;
+    while ((yc = yn_iter(ylist, &inext)) != NULL) {
+        if (yang_keyword_get(yc) != Y_LEAF)
+            continue;
+        cols[ncols].tc_oidlen = MAX_OID_LEN;
+        if ((ret = yangext_oid_get(yc, cols[ncols].tc_oid, &cols[ncols].tc_oidlen, NULL)) < 0)
+            goto done;
+        if (ret == 0)
+            continue;
+        cols[ncols++].tc_yang = yc;
+    }
+    if (xml_nsctx_yang(ys, &nsc) < 0)
+        goto done;
+    if (snmp_yang2xpath(ys, NULL, &xpath) < 0)
+        goto done;
+    if (clicon_rpc_get(h, xpath, nsc, CONTENT_ALL, -1, NULL, &xt) < 0)
+        goto done;
+    if ((xerr = xpath_first(xt, NULL, "/rpc-error")) != NULL){
+        clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Get configuration");
+        goto done;
+    }
+    if ((xtable = xpath_first(xt, nsc, "%s", xpath)) != NULL) {
+        ixrow = 0;
+        while ((xrow = xml_child_iter(xtable, &ixrow, CX_ELMNT)) != NULL) {
+            if ((ret = snmp_xmlkey2val_oid(xrow, cvk_name, NULL, oidk, &oidklen)) < 0)
+                goto done;
+            if (ret == 0)
+                continue; /* skip row, not all indexes */
+            ixcol = 0;
+            while ((xcol = xml_child_iter(xrow, &ixcol, CX_ELMNT)) != NULL) {
+                if ((ycol = xml_spec(xcol)) == NULL)
+                    continue;
+                for (i=0; i<ncols; i++)
+                    if (cols[i].tc_yang == ycol)
+                        break;
+                if (i == ncols)
+                    continue;
+                oidlen = cols[i].tc_oidlen + oidklen;
+                if (oidlen > MAX_OID_LEN){
+                    clixon_err(OE_UNIX, EOVERFLOW, "OID length %zu exceeds MAX_OID_LEN %d",
+                               oidlen, MAX_OID_LEN);
+                    goto done;
+                }
+                if (nentries >= ts->ts_vlen){
+                    len = ts->ts_vlen ? 2*ts->ts_vlen : SNMP_TABLE_SNAPSHOT_START;
+                    if ((te = realloc(ts->ts_vec, len*sizeof(*te))) == NULL){
+                        clixon_err(OE_UNIX, errno, "realloc");
+                        goto done;
+                    }
+                    ts->ts_vec = te;
+                    ts->ts_vlen = len;
+                }
+                if (noids + oidlen > ts->ts_olen){
+                    len = ts->ts_olen ? 2*ts->ts_olen : SNMP_TABLE_SNAPSHOT_START*MAX_OID_LEN;
+                    while (noids + oidlen > len)
+                        len *= 2;
+                    if ((o = realloc(ts->ts_oids, len*sizeof(*o))) == NULL){
+                        clixon_err(OE_UNIX, errno, "realloc");
+                        goto done;
+                    }
+                    ts->ts_oids = o;
+                    ts->ts_olen = len;
+                }
+                o = ts->ts_oids + noids;
+                memcpy(o, cols[i].tc_oid, cols[i].tc_oidlen*sizeof(*o));
+                memcpy(o + cols[i].tc_oidlen, oidk, oidklen*sizeof(*o));
+                te = &ts->ts_vec[nentries++];
+                te->te_oid = NULL;      /* Set below when oid vector is final */
+                te->te_oidoff = noids;
+                te->te_oidlen = oidlen;
+                te->te_xml = xcol;
+                te->te_yang = ycol;
+                noids += oidlen;
+            } /* while xcol */
+        } /* while xrow */
+    }
+    for (j=0; j<nentries; j++)
+        ts->ts_vec[j].te_oid = ts->ts_oids + ts->ts_vec[j].te_oidoff;
+    if (nentries > 1)
+        qsort(ts->ts_vec, nentries, sizeof(*ts->ts_vec), snmp_table_entry_cmp);
+    ts->ts_len = nentries;
+    ts->ts_xml = xt;
+    xt = NULL;
+    ts->ts_valid = 1;
+    gettimeofday(&ts->ts_time, NULL);
+    clixon_debug(CLIXON_DBG_SNMP, "%s: %zu entries", yang_argument_get(ylist), nentries);
+    retval = 0;
+ done:
+    if (retval < 0)
+        snmp_table_snapshot_clear(ts);
+    if (cols)
+        free(cols);
+    if (xpath)
+        free(xpath);
+    if (xt)
+        xml_free(xt);
+    if (nsc)
+        xml_nsctx_free(nsc);
+    return retval;
+}
+
+/*! Get a valid snapshot of a table, rebuild it if invalidated or expired
  *
- * The cache works as follows:
- * It has three parts:
- * - xpath     Of the requested YANG
- * - xml tree  Saved from previous rpc to this xpath
- * - timestamp Time of last rpc call for this xpath
- * On a new call, the cache is used if:
- * - the cache exist, and
- * - the xpath is the same as the requested xpath, and
- * - the age of the cache entry is less than a threshold
+ * There is one snapshot per table. A snapshot is valid until:
+ * - it is invalidated by clixon_snmp_table_snapshot_invalidate, eg on commit or on a
+ *   notification from the backend, or
+ * - it is older than CLICON_SNMP_TABLE_SNAPSHOT_TTL milliseconds, if non-zero
  * @param[in]  h      Clixon handle
- * @param[in]  xpath  XPath of requetsed YANG
- * @param[in]  nsc    Namespace context
- * @param[out] xt     XML, either cached or new, dont free
+ * @param[in]  ylist  Yang of table (of list type)
+ * @param[out] tsp    Table snapshot, dont free
  * @retval     0      OK
  * @retval    -1      Error
  */
-#define GETNEXT_THRESHOLD_US 1000000
 static int
-table_getnext_cache(clixon_handle h,
-                    char         *xpath,
-                    cvec         *nsc,
-                    cxobj       **xtp)
+snmp_table_snapshot_get(clixon_handle                h,
+                        yang_stmt                   *ylist,
+                        struct snmp_table_snapshot **tsp)
 {
-    int                        retval = -1;
-    cxobj                     *xerr;
-    cxobj                     *xt = NULL;
-    int64_t                    tdiff_us = 0;
-    struct timeval             now;
-    struct timeval             td;
-    struct snmp_getnext_cache *sg = NULL;
+    int                         retval = -1;
+    struct snmp_table_snapshot *tslist = NULL;
+    struct snmp_table_snapshot *ts;
+    struct timeval              now;
+    struct timeval              td;
+    int                         ttl;
 
-    clicon_ptr_get(h, "snmp-getnext-cache", (void**)&sg);
-    if (sg == NULL){
-        if ((sg = calloc(1, sizeof(*sg))) == NULL){
+    clicon_ptr_get(h, "snmp-table-snapshots", (void**)&tslist);
+    if ((ts = tslist) != NULL){
+        do {
+            if (ts->ts_ylist == ylist)
+                break;
+            ts = NEXTQ(struct snmp_table_snapshot *, ts);
+        } while (ts != tslist);
+        if (ts->ts_ylist != ylist)
+            ts = NULL;
+    }
+    if (ts == NULL){
+        if ((ts = calloc(1, sizeof(*ts))) == NULL){
             clixon_err(OE_UNIX, errno, "calloc");
             goto done;
         }
-        clicon_ptr_set(h, "snmp-getnext-cache", sg);
+        ts->ts_ylist = ylist;
+        ADDQ(ts, tslist);
+        clicon_ptr_set(h, "snmp-table-snapshots", tslist);
     }
-    if (timerisset(&sg->sg_timer)){
+    if (ts->ts_valid &&
+        (ttl = clicon_option_int(h, "CLICON_SNMP_TABLE_SNAPSHOT_TTL")) > 0){
         gettimeofday(&now, NULL);
-        timersub(&now, &sg->sg_timer, &td);
-        tdiff_us = 1000000*td.tv_sec + td.tv_usec;
-    }
-    if (sg->sg_xml == NULL || sg->sg_xpath == NULL ||
-        strcmp(xpath, sg->sg_xpath) != 0 || tdiff_us > 1000000){ // gettime
-        if (sg->sg_xml){
-            xml_free(sg->sg_xml);
-            sg->sg_xml = NULL;
-        }
-        if (sg->sg_xpath){
-            free(sg->sg_xpath);
-            sg->sg_xpath = NULL;
-        }
-        if (clicon_rpc_get(h, xpath, nsc, CONTENT_ALL, -1, NULL, &xt) < 0)
-            goto done;
-        if ((xerr = xpath_first(xt, NULL, "/rpc-error")) != NULL){
-            clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Get configuration");
-            goto done;
-        }
-        gettimeofday(&sg->sg_timer, NULL);
-        if ((sg->sg_xpath = strdup(xpath)) == NULL){
-            clixon_err(OE_UNIX, errno, "strdup");
-            goto done;
-        }
-        sg->sg_xml = xt;
-        xt = NULL;
+        timersub(&now, &ts->ts_time, &td);
+        if (td.tv_sec*1000 + td.tv_usec/1000 >= ttl)
+            ts->ts_valid = 0;
     }
-    *xtp = sg->sg_xml;
+    if (!ts->ts_valid &&
+        snmp_table_snapshot_build(h, ts) < 0)
+        goto done;
+    *tsp = ts;
     retval = 0;
  done:
-    if (xt)
-        xml_free(xt);
     return retval;
 }
 
-/*! Find "next" object from oids minus key and return that.
+/*! Find "next" object from oids using the table snapshot and return that.
  *
+ * The snapshot is sorted in OID order. A walk (eg GETBULK) asks for the successor
+ * of the previously returned OID, which is checked first. Otherwise a binary
+ * search is made for the first entry larger than the requested OID.
  * @param[in]  h        Clixon handle
  * @param[in]  ylist    Yang of table (of list type)
  * @param[in]  oids     OID of ultimate scalar value
@@ -1233,7 +1442,6 @@ table_getnext_cache(clixon_handle h,
  * @retval     1        OK
  * @retval     0        Failed
  * @retval    -1        Error
- * XXX: merge with cache
  */
 static int
 snmp_table_getnext(clixon_handle               h,
@@ -1243,100 +1451,56 @@ snmp_table_getnext(clixon_handle               h,
                    netsnmp_agent_request_info *reqinfo,
                    netsnmp_request_info       *request)
 {
-    int        retval = -1;
-    cvec      *nsc = NULL;
-    char      *xpath = NULL;
-    cxobj     *xt = NULL;
-    cxobj     *xtable;
-    cxobj     *xrow;
-    cxobj     *xcol;
-    yang_stmt *ycol;
-    yang_stmt *ys;
-    cvec      *cvk_name;
-    int        ixrow;
-    int        ixcol;
-    oid        oidc[MAX_OID_LEN] = {0,}; /* Table / list oid */
-    size_t     oidclen = MAX_OID_LEN;
-    oid        oidk[MAX_OID_LEN] = {0,}; /* Key oid */
-    size_t     oidklen = MAX_OID_LEN;
-    oid        oidnext[MAX_OID_LEN] = {0x7fffffff,}; /* Next oid: start with high value */
-    size_t     oidnextlen = MAX_OID_LEN;
-    int        found = 0;
-    cxobj     *xnext = NULL;
-    yang_stmt *ynext = NULL;
-    cbuf      *cb = NULL;
-    int        ret;
+    int                         retval = -1;
+    struct snmp_table_snapshot *ts = NULL;
+    struct snmp_table_entry    *te;
+    size_t                      lo;
+    size_t                      hi;
+    size_t                      mid;
+    cbuf                       *cb = NULL;
 
     clixon_debug(CLIXON_DBG_SNMP, "");
-    if ((ys = yang_parent_get(ylist)) == NULL ||
-        yang_keyword_get(ys) != Y_CONTAINER){
-        clixon_err(OE_YANG, EINVAL, "ylist parent is not list");
+    if (snmp_table_snapshot_get(h, ylist, &ts) < 0)
         goto done;
-    }
-    if (xml_nsctx_yang(ys, &nsc) < 0)
-        goto done;
-    if (snmp_yang2xpath(ys, NULL, &xpath) < 0)
-        goto done;
-    /* Get next via cache */
-    if (table_getnext_cache(h, xpath, nsc, &xt) < 0)
-        goto done;
-    if ((xtable = xpath_first(xt, nsc, "%s", xpath)) != NULL) {
-        /* Make a clone of key-list, but replace names with values */
-        if ((cvk_name = yang_cvec_get(ylist)) == NULL){
-            clixon_err(OE_YANG, 0, "No keys");
-            goto done;
+    te = ts->ts_vec + ts->ts_cursor;
+    if (ts->ts_cursor < ts->ts_len &&
+        snmp_oid_compare(te->te_oid, te->te_oidlen, oids, oidslen) == 0)
+        lo = ts->ts_cursor + 1;
+    else {
+        /* First entry greater than oids */
+        lo = 0;
+        hi = ts->ts_len;
+        while (lo < hi){
+            mid = lo + (hi - lo)/2;
+            te = ts->ts_vec + mid;
+            if (snmp_oid_compare(te->te_oid, te->te_oidlen, oids, oidslen) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
         }
-        ixrow = 0;
-        while ((xrow = xml_child_iter(xtable, &ixrow, CX_ELMNT)) != NULL) {
-            /* Get key part of OID from XML list entry */
-            if ((ret = snmp_xmlkey2val_oid(xrow, cvk_name, NULL, /*&cvk_oid,*/ oidk, &oidklen)) < 0)
-                goto done;
-            if (ret == 0)
-                continue; /* skip row, not all indexes */
-            ixcol = 0;
-            while ((xcol = xml_child_iter(xrow, &ixcol, CX_ELMNT)) != NULL) {
-                if ((ycol = xml_spec(xcol)) == NULL)
-                    continue;
-                if (yang_keyword_get(ycol) != Y_LEAF)
-                    continue;
-                if ((ret = yangext_oid_get(ycol, oidc, &oidclen, NULL)) < 0)
-                    goto done;
-                if (ret == 0)
-                    continue;
-                /* Append key oid */
-                if (oid_append(oidc, &oidclen, oidk, oidklen) < 0)
-                    goto done;
-                /* Get smallest larger */
-                if (oid_eq(oidc, oidclen, oids, oidslen) > 0 &&
-                    oid_eq(oidc, oidclen, oidnext, oidnextlen) < 0){
-                    memcpy(oidnext, oidc, oidclen*sizeof(*oidnext));
-                    oidnextlen = oidclen;
-                    xnext = xcol;
-                    ynext = ycol;
-                    found++;
-                }
-            } /* while xcol */
-        } /* while xrow */
     }
-    if (found){
-        if (snmp_scalar_return(xnext, ynext, oidnext, oidnextlen, reqinfo, request) < 0)
-            goto done;
+    if (lo >= ts->ts_len)
+        goto fail;
+    te = ts->ts_vec + lo;
+    ts->ts_cursor = lo;
+    if (snmp_scalar_return(te->te_xml, te->te_yang, te->te_oid, te->te_oidlen, reqinfo, request) < 0)
+        goto done;
+    if (clixon_debug_isset(CLIXON_DBG_SNMP)){
         if ((cb = cbuf_new()) == NULL){
             clixon_err(OE_UNIX, errno, "cbuf_new");
             goto done;
         }
-        oid_cbuf(cb, oidnext, oidnextlen);
+        oid_cbuf(cb, te->te_oid, te->te_oidlen);
         clixon_debug(CLIXON_DBG_SNMP, "next: %s", cbuf_get(cb));
     }
-    retval = found;
+    retval = 1;
  done:
-    if (xpath)
-        free(xpath);
     if (cb)
         cbuf_free(cb);
-    if (nsc)
-        xml_nsctx_free(nsc);
     return retval;
+ fail:
+    retval = 0;
+    goto done;
 }
 
 /*! SNMP table operation handler
@@ -1440,6 +1604,8 @@ clixon_snmp_table_handler1(netsnmp_mib_handler          *handler,
     case MODE_SET_COMMIT:   // 3
         if ((ret = clicon_rpc_commit(sh->sh_h, 0, 0, 0, NULL, NULL)) < 0)
             goto done;
+        if (clixon_snmp_table_snapshot_invalidate(sh->sh_h) < 0)
+            goto done;
         if (ret == 0){
             clicon_rpc_discard_changes(sh->sh_h);
             netsnmp_request_set_error(request, SNMP_ERR_COMMITFAILED);
@@ -1499,19 +1665,48 @@ clixon_snmp_table_handler(netsnmp_mib_handler          *handler,
     return retval;
 }
 
-/*! Clear cache
+/*! Invalidate all table snapshots, they are rebuilt from the backend on next use
+ *
+ * Called when the backend data may have changed, such as after a commit or when a
+ * notification arrives from the backend
+ * @param[in]  h   Clixon handle
+ * @retval     0   OK
+ */
+int
+clixon_snmp_table_snapshot_invalidate(clixon_handle h)
+{
+    struct snmp_table_snapshot *tslist = NULL;
+    struct snmp_table_snapshot *ts;
+
+    if (clicon_ptr_get(h, "snmp-table-snapshots", (void**)&tslist) == 0 &&
+        (ts = tslist) != NULL){
+        do {
+            ts->ts_valid = 0;
+            ts = NEXTQ(struct snmp_table_snapshot *, ts);
+        } while (ts != tslist);
+    }
+    return 0;
+}
+
+/*! Free all table snapshots
  */
 int
 clixon_snmp_table_exit(clixon_handle h)
 {
-    struct snmp_getnext_cache *sg = NULL;
+    struct snmp_table_snapshot *tslist = NULL;
+    struct snmp_table_snapshot *ts;
 
-    if (clicon_ptr_get(h, "snmp-getnext-cache", (void**)&sg) == 0 && sg){
-        if (sg->sg_xml)
-            xml_free(sg->sg_xml);
-        if (sg->sg_xpath)
-            free(sg->sg_xpath);
-        free(sg);
+    if (clicon_ptr_get(h, "snmp-table-snapshots", (void**)&tslist) == 0){
+        while ((ts = tslist) != NULL){
+            DELQ(ts, tslist, struct snmp_table_snapshot *);
+            snmp_table_snapshot_clear(ts);
+            if (ts->ts_vec)
+                free(ts->ts_vec);
+            if (ts->ts_oids)
+                free(ts->ts_oids);
+            free(ts);
+        }
+        clicon_ptr_del(h, "snmp-table-snapshots");
     }
     return 0;
 }
@@ -52,6 +52,7 @@ int clixon_snmp_scalar_handler(netsnmp_mib_handler          *handler,
                                netsnmp_handler_registration *nhreg,
                                netsnmp_agent_request_info   *reqinfo,
                                netsnmp_request_info         *requests);
+int clixon_snmp_table_snapshot_invalidate(clixon_handle h);
 int clixon_snmp_table_exit(clixon_handle h);
 
 #endif /* _SNMP_HANDLER_H_ */
@@ -54,6 +54,7 @@
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 
 #include "snmp_lib.h"
+#include "snmp_handler.h"
 #include "banned.h"
 
 /* SNMP v2 notification OID
@@ -318,6 +319,9 @@ snmp_stream_cb(int   s,
         clixon_err(OE_XML, EFAULT, "Invalid notification");
         goto done;
     }
+    /* Backend data may have changed, rebuild table snapshots on next use */
+    if (clixon_snmp_table_snapshot_invalidate(h) < 0)
+        goto done;
     /* forward notification(s) as snmp trap */
     ix = 0;
     while ((xncont = xml_child_iter(xtop, &ix, CX_ELMNT)) != NULL) {
@@ -0,0 +1,33 @@
+#!/usr/bin/env bash
+# Compare two machine-readable benchmark runs of clixon_bench -m
+# Prints ns/op, allocs/op and peak RSS of the new run with change in percent relative
+# to the old run, for each shape and operation present in both.
+# Usage: bench_cmp.sh <old.csv> <new.csv>
+# Example:
+#   git checkout main;   make bench; (cd bench; make run > /tmp/old.csv)
+#   git checkout branch; make bench; (cd bench; make run > /tmp/new.csv)
+#   bench/bench_cmp.sh /tmp/old.csv /tmp/new.csv
+
+if [ $# -ne 2 ]; then
+    echo "usage: $0 <old.csv> <new.csv>" >&2
+    exit 1
+fi
+
+awk -F, '
+function pct(o, n) {
+    if (o <= 0)
+        return "-"
+    return sprintf("%+.1f%%", 100.0*(n-o)/o)
+}
+FNR == 1 { next } # header
+NR == FNR {
+    ns[$1","$2] = $5; allocs[$1","$2] = $6; rss[$1","$2] = $7
+    next
+}
+($1","$2) in ns {
+    k = $1","$2
+    if (!hdr++)
+        printf "%-8s %-9s %14s %8s %12s %8s %12s %8s\n", "shape", "op", "ns/op", "", "allocs/op", "", "rss-kB", ""
+    printf "%-8s %-9s %14d %8s %12d %8s %12d %8s\n", $1, $2,
+        $5, pct(ns[k], $5), $6, pct(allocs[k], $6), $7, pct(rss[k], $7)
+}' "$1" "$2"
@@ -0,0 +1,865 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2,
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Microbenchmarks of clixon library hot paths
+ *
+ * Generates a synthetic YANG module and XML configs of a configurable shape:
+ *   wide:    one list with many entries
+ *   deep:    nested lists, width entries per level
+ *   leafref: one list with leafrefs to the keys of another list
+ * and measures each operation in isolation:
+ *   parse:    clixon_xml_parse_string() without YANG binding
+ *   bind:     xml_bind_yang()
+ *   sort:     xml_sort_recurse()
+ *   diff:     xml_diff() against a copy with every 10th value changed
+ *   xpath:    xpath_vec() of a random list entry
+ *   json:     clixon_json2cbuf()
+ *   validate: xml_yang_validate_all()
+ * Setup of each iteration, such as copying the input tree, is not measured.
+ * For each operation ns/op, allocations/op and peak RSS are reported. Allocations
+ * are counted by interposing malloc/calloc/realloc (glibc only). Peak RSS is the
+ * process high-water mark, reset before each operation where the kernel supports it.
+ * Use -m for machine-readable (CSV) output, and bench_cmp.sh to compare two runs.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <syslog.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include <clixon/clixon.h>
+
+/* Command line options passed to getopt(3) */
+#define BENCH_OPTS "hD:s:o:N:d:w:n:mr:"
+
+/* Namespace and prefix of generated YANG */
+#define BENCH_NS     "urn:example:bench"
+#define BENCH_PREFIX "b"
+
+/* Every nth value is changed in the diff tree */
+#define BENCH_DIFF_NTH 10
+
+/* Lookups per iteration of fast operations, such as xpath */
+#define BENCH_REPEAT 1000
+
+/*
+ * Types
+ */
+/* Benchmark context, input data of one shape */
+struct bench_ctx {
+    clixon_handle bc_h;
+    yang_stmt    *bc_yspec;
+    cvec         *bc_nsc;        /* Namespace context for xpath */
+    const char   *bc_shape;      /* wide, deep or leafref */
+    int           bc_nr;         /* Number of list entries (wide, leafref) */
+    int           bc_depth;      /* Number of levels (deep) */
+    int           bc_width;      /* Entries per level (deep) */
+    int           bc_iterations; /* Iterations per operation */
+    int           bc_size;       /* Number of generated list entries */
+    cbuf         *bc_xmlstr;     /* Generated XML */
+    cxobj        *bc_xunbound;   /* Parsed XML, not bound */
+    cxobj        *bc_xunsorted;  /* Parsed and bound XML, not sorted */
+    cxobj        *bc_xt;         /* Parsed, bound and sorted XML */
+    cxobj        *bc_xt1;        /* Copy of bc_xt with every nth value changed */
+};
+typedef struct bench_ctx bench_ctx;
+
+/* Result of one operation */
+struct bench_result {
+    uint64_t br_ops;    /* Number of operations */
+    uint64_t br_ns;     /* Total measured time in ns */
+    uint64_t br_allocs; /* Total allocations in measured time */
+    long     br_rsskb;  /* Peak RSS in KiB */
+};
+typedef struct bench_result bench_result;
+
+/* Benchmark operation */
+struct bench_op {
+    const char *bo_name;
+    int       (*bo_fn)(bench_ctx *bc, bench_result *br);
+};
+
+/*
+ * Variables
+ */
+/* Measurement state, allocations are only counted between bench_start and bench_stop */
+static int             _bench_counting = 0;
+static uint64_t        _bench_allocs = 0;
+static struct timespec _bench_t0;
+
+#if defined(__GLIBC__) && !defined(BENCH_NO_MALLOC_COUNT)
+/* Count allocations by interposing the glibc allocator entry points */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *
+malloc(size_t size)
+{
+    if (_bench_counting)
+        _bench_allocs++;
+    return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb,
+       size_t size)
+{
+    if (_bench_counting)
+        _bench_allocs++;
+    return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void  *ptr,
+        size_t size)
+{
+    if (_bench_counting)
+        _bench_allocs++;
+    return __libc_realloc(ptr, size);
+}
+#define BENCH_ALLOC_COUNT
+#endif /* __GLIBC__ */
+
+/*! Start measurement of one or several operations
+ */
+static void
+bench_start(void)
+{
+    _bench_allocs = 0;
+    _bench_counting = 1;
+    clock_gettime(CLOCK_MONOTONIC, &_bench_t0);
+}
+
+/*! Stop measurement and add to result
+ *
+ * @param[in,out] br   Result
+ * @param[in]     ops  Number of operations measured since bench_start
+ */
+static void
+bench_stop(bench_result *br,
+           uint64_t      ops)
+{
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    _bench_counting = 0;
+    br->br_ns += (uint64_t)(t1.tv_sec - _bench_t0.tv_sec)*1000000000 +
+        (t1.tv_nsec - _bench_t0.tv_nsec);
+    br->br_allocs += _bench_allocs;
+    br->br_ops += ops;
+}
+
+/*! Reset peak RSS of process, supported by Linux >= 4.0
+ */
+static void
+bench_rss_reset(void)
+{
+    FILE *f;
+
+    if ((f = fopen("/proc/self/clear_refs", "w")) != NULL){
+        fputs("5", f);
+        fclose(f);
+    }
+}
+
+/*! Get peak RSS of process in KiB
+ *
+ * @retval  kb  Peak RSS since last reset, or since process start
+ */
+static long
+bench_rss_peak(void)
+{
+    FILE         *f;
+    char          line[128];
+    long          kb = -1;
+    struct rusage ru;
+
+    if ((f = fopen("/proc/self/status", "r")) != NULL){
+        while (fgets(line, sizeof(line), f) != NULL)
+            if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+                break;
+        fclose(f);
+    }
+    if (kb < 0 && getrusage(RUSAGE_SELF, &ru) == 0)
+        kb = ru.ru_maxrss;
+    return kb;
+}
+
+/*! Generate YANG module with all shapes
+ *
+ * @param[in]  cb     CLIgen buffer
+ * @param[in]  depth  Number of nested list levels in deep shape
+ */
+static void
+bench_yang_gen(cbuf *cb,
+               int   depth)
+{
+    int i;
+
+    cprintf(cb, "module clixon-bench{\n");
+    cprintf(cb, "  yang-version 1.1;\n");
+    cprintf(cb, "  namespace \"%s\";\n", BENCH_NS);
+    cprintf(cb, "  prefix %s;\n", BENCH_PREFIX);
+    /* wide */
+    cprintf(cb, "  container wide{\n");
+    cprintf(cb, "    list y{\n");
+    cprintf(cb, "      key k;\n");
+    cprintf(cb, "      leaf k{ type int32; }\n");
+    cprintf(cb, "      leaf v{ type string; }\n");
+    cprintf(cb, "      leaf n{ type uint32; }\n");
+    cprintf(cb, "    }\n");
+    cprintf(cb, "  }\n");
+    /* deep */
+    cprintf(cb, "  container deep{\n");
+    for (i = 1; i <= depth; i++){
+        cprintf(cb, "    list e%d{\n", i);
+        cprintf(cb, "      key k;\n");
+        cprintf(cb, "      leaf k{ type int32; }\n");
+        cprintf(cb, "      leaf v{ type string; }\n");
+    }
+    for (i = 1; i <= depth; i++)
+        cprintf(cb, "    }\n");
+    cprintf(cb, "  }\n");
+    /* leafref */
+    cprintf(cb, "  container leafref{\n");
+    cprintf(cb, "    list y{\n");
+    cprintf(cb, "      key k;\n");
+    cprintf(cb, "      leaf k{ type int32; }\n");
+    cprintf(cb, "    }\n");
+    cprintf(cb, "    list r{\n");
+    cprintf(cb, "      key k;\n");
+    cprintf(cb, "      leaf k{ type int32; }\n");
+    cprintf(cb, "      leaf v{\n");
+    cprintf(cb, "        type leafref{ path \"../../y/k\"; }\n");
+    cprintf(cb, "      }\n");
+    cprintf(cb, "    }\n");
+    cprintf(cb, "  }\n");
+    cprintf(cb, "}\n");
+}
+
+/*! Generate nested list entries of deep shape, keys in descending order
+ */
+static int
+bench_xml_deep(cbuf *cb,
+               int   level,
+               int   depth,
+               int   width)
+{
+    int i;
+    int nr = 0;
+
+    for (i = width-1; i >= 0; i--){
+        cprintf(cb, "<e%d><k>%d</k><v>v%d-%d</v>", level, i, level, i);
+        if (level < depth)
+            nr += bench_xml_deep(cb, level+1, depth, width);
+        cprintf(cb, "</e%d>", level);
+        nr++;
+    }
+    return nr;
+}
+
+/*! Generate XML of shape, list keys in descending order
+ *
+ * @param[in]  bc   Benchmark context
+ * @param[in]  cb   CLIgen buffer
+ */
+static void
+bench_xml_gen(bench_ctx *bc,
+              cbuf      *cb)
+{
+    int i;
+
+    cprintf(cb, "<%s xmlns=\"%s\">", bc->bc_shape, BENCH_NS);
+    if (strcmp(bc->bc_shape, "wide") == 0){
+        for (i = bc->bc_nr-1; i >= 0; i--)
+            cprintf(cb, "<y><k>%d</k><v>value%d</v><n>%d</n></y>", i, i, i);
+        bc->bc_size = bc->bc_nr;
+    }
+    else if (strcmp(bc->bc_shape, "deep") == 0)
+        bc->bc_size = bench_xml_deep(cb, 1, bc->bc_depth, bc->bc_width);
+    else if (strcmp(bc->bc_shape, "leafref") == 0){
+        for (i = bc->bc_nr-1; i >= 0; i--)
+            cprintf(cb, "<y><k>%d</k></y>", i);
+        for (i = bc->bc_nr-1; i >= 0; i--)
+            cprintf(cb, "<r><k>%d</k><v>%d</v></r>", i, (i*7) % bc->bc_nr);
+        bc->bc_size = 2*bc->bc_nr;
+    }
+    cprintf(cb, "</%s>", bc->bc_shape);
+}
+
+/*! Generate xpath of a random list entry of shape
+ */
+static void
+bench_xpath_gen(bench_ctx *bc,
+                cbuf      *cb)
+{
+    int i;
+
+    cprintf(cb, "/%s:%s", BENCH_PREFIX, bc->bc_shape);
+    if (strcmp(bc->bc_shape, "wide") == 0)
+        cprintf(cb, "/%s:y[%s:k='%d']", BENCH_PREFIX, BENCH_PREFIX, rand() % bc->bc_nr);
+    else if (strcmp(bc->bc_shape, "deep") == 0){
+        for (i = 1; i <= bc->bc_depth; i++)
+            cprintf(cb, "/%s:e%d[%s:k='%d']", BENCH_PREFIX, i, BENCH_PREFIX, rand() % bc->bc_width);
+    }
+    else if (strcmp(bc->bc_shape, "leafref") == 0)
+        cprintf(cb, "/%s:r[%s:k='%d']/%s:v", BENCH_PREFIX, BENCH_PREFIX, rand() % bc->bc_nr, BENCH_PREFIX);
+}
+
+/*! Create input trees of context from generated XML
+ *
+ * @param[in]  bc   Benchmark context
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+bench_ctx_setup(bench_ctx *bc)
+{
+    int     retval = -1;
+    cxobj  *xerr = NULL;
+    cxobj **vec = NULL;
+    size_t  veclen;
+    int     i;
+    int     ret;
+
+    if ((bc->bc_xmlstr = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    bench_xml_gen(bc, bc->bc_xmlstr);
+    if (clixon_xml_parse_string(cbuf_get(bc->bc_xmlstr), YB_NONE, NULL, &bc->bc_xunbound, NULL) < 0)
+        goto done;
+    if ((bc->bc_xunsorted = xml_dup(bc->bc_xunbound)) == NULL)
+        goto done;
+    if ((ret = xml_bind_yang(bc->bc_h, bc->bc_xunsorted, YB_MODULE, bc->bc_yspec, 0, &xerr)) < 0)
+        goto done;
+    if (ret == 0){
+        clixon_err(OE_YANG, 0, "Bind failed");
+        goto done;
+    }
+    if ((bc->bc_xt = xml_dup(bc->bc_xunsorted)) == NULL)
+        goto done;
+    if (xml_sort_recurse(bc->bc_xt) < 0)
+        goto done;
+    if ((bc->bc_xt1 = xml_dup(bc->bc_xt)) == NULL)
+        goto done;
+    /* Change every nth value, leafrefs to another existing key */
+    if (xpath_vec(bc->bc_xt1, bc->bc_nsc, "//%s:v", &vec, &veclen, BENCH_PREFIX) < 0)
+        goto done;
+    for (i = 0; i < veclen; i += BENCH_DIFF_NTH){
+        if (xml_body_set(vec[i], strcmp(bc->bc_shape, "leafref") == 0 ? "0" : "changed") < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (vec)
+        free(vec);
+    if (xerr)
+        xml_free(xerr);
+    return retval;
+}
+
+/*! Free input trees of context
+ */
+static void
+bench_ctx_free(bench_ctx *bc)
+{
+    if (bc->bc_xmlstr){
+        cbuf_free(bc->bc_xmlstr);
+        bc->bc_xmlstr = NULL;
+    }
+    if (bc->bc_xunbound){
+        xml_free(bc->bc_xunbound);
+        bc->bc_xunbound = NULL;
+    }
+    if (bc->bc_xunsorted){
+        xml_free(bc->bc_xunsorted);
+        bc->bc_xunsorted = NULL;
+    }
+    if (bc->bc_xt){
+        xml_free(bc->bc_xt);
+        bc->bc_xt = NULL;
+    }
+    if (bc->bc_xt1){
+        xml_free(bc->bc_xt1);
+        bc->bc_xt1 = NULL;
+    }
+}
+
+static int
+bench_parse(bench_ctx    *bc,
+            bench_result *br)
+{
+    cxobj *xt = NULL;
+    int    i;
+
+    for (i = 0; i < bc->bc_iterations; i++){
+        bench_start();
+        if (clixon_xml_parse_string(cbuf_get(bc->bc_xmlstr), YB_NONE, NULL, &xt, NULL) < 0)
+            return -1;
+        bench_stop(br, 1);
+        xml_free(xt);
+        xt = NULL;
+    }
+    return 0;
+}
+
+static int
+bench_bind(bench_ctx    *bc,
+           bench_result *br)
+{
+    cxobj *xt;
+    cxobj *xerr = NULL;
+    int    i;
+    int    ret;
+
+    for (i = 0; i < bc->bc_iterations; i++){
+        if ((xt = xml_dup(bc->bc_xunbound)) == NULL)
+            return -1;
+        bench_start();
+        ret = xml_bind_yang(bc->bc_h, xt, YB_MODULE, bc->bc_yspec, 0, &xerr);
+        bench_stop(br, 1);
+        xml_free(xt);
+        if (xerr)
+            xml_free(xerr);
+        if (ret < 1)
+            return -1;
+    }
+    return 0;
+}
+
+static int
+bench_sort(bench_ctx    *bc,
+           bench_result *br)
+{
+    cxobj *xt;
+    int    i;
+    int    ret;
+
+    for (i = 0; i < bc->bc_iterations; i++){
+        if ((xt = xml_dup(bc->bc_xunsorted)) == NULL)
+            return -1;
+        bench_start();
+        ret = xml_sort_recurse(xt);
+        bench_stop(br, 1);
+        xml_free(xt);
+        if (ret < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int
+bench_diff(bench_ctx    *bc,
+           bench_result *br)
+{
+    cxobj **first = NULL;
+    cxobj **second = NULL;
+    cxobj **changed0 = NULL;
+    cxobj **changed1 = NULL;
+    size_t  firstlen = 0;
+    size_t  secondlen = 0;
+    size_t  changedlen = 0;
+    int     i;
+    int     ret;
+
+    for (i = 0; i < bc->bc_iterations; i++){
+        bench_start();
+        ret = xml_diff(bc->bc_xt, bc->bc_xt1,
+                       &first, &firstlen,
+                       &second, &secondlen,
+                       &changed0, &changed1, &changedlen);
+        bench_stop(br, 1);
+        if (first)
+            free(first);
+        if (second)
+            free(second);
+        if (changed0)
+            free(changed0);
+        if (changed1)
+            free(changed1);
+        first = second = changed0 = changed1 = NULL;
+        firstlen = secondlen = changedlen = 0;
+        if (ret < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int
+bench_xpath(bench_ctx    *bc,
+            bench_result *br)
+{
+    int     retval = -1;
+    cbuf   *cb = NULL;
+    cxobj **vec = NULL;
+    size_t  veclen;
+    int     i;
+    int     j;
+    int     ret;
+
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    for (i = 0; i < bc->bc_iterations; i++){
+        for (j = 0; j < BENCH_REPEAT; j++){
+            cbuf_reset(cb);
+            bench_xpath_gen(bc, cb);
+            bench_start();
+            ret = xpath_vec(bc->bc_xt, bc->bc_nsc, "%s", &vec, &veclen, cbuf_get(cb));
+            bench_stop(br, 1);
+            if (ret < 0)
+                goto done;
+            if (veclen != 1){
+                clixon_err(OE_XML, 0, "%s: expected one match, got %zu", cbuf_get(cb), veclen);
+                goto done;
+            }
+            free(vec);
+            vec = NULL;
+        }
+    }
+    retval = 0;
+ done:
+    if (vec)
+        free(vec);
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+static int
+bench_json(bench_ctx    *bc,
+           bench_result *br)
+{
+    int   retval = -1;
+    cbuf *cb = NULL;
+    int   i;
+    int   ret;
+
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    for (i = 0; i < bc->bc_iterations; i++){
+        cbuf_reset(cb);
+        bench_start();
+        ret = clixon_json2cbuf(cb, bc->bc_xt, 0, 0, 0, 0);
+        bench_stop(br, 1);
+        if (ret < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+static int
+bench_validate(bench_ctx    *bc,
+               bench_result *br)
+{
+    cxobj *xret = NULL;
+    int    i;
+    int    ret;
+
+    for (i = 0; i < bc->bc_iterations; i++){
+        bench_start();
+        ret = xml_yang_validate_all_top(bc->bc_h, bc->bc_xt, &xret);
+        bench_stop(br, 1);
+        if (xret){
+            xml_free(xret);
+            xret = NULL;
+        }
+        if (ret < 0)
+            return -1;
+        if (ret == 0){
+            clixon_err(OE_YANG, 0, "Validation of %s failed", bc->bc_shape);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* All operations, in order of execution */
+static struct bench_op bench_ops[] = {
+    {"parse",    bench_parse},
+    {"bind",     bench_bind},
+    {"sort",     bench_sort},
+    {"diff",     bench_diff},
+    {"xpath",    bench_xpath},
+    {"json",     bench_json},
+    {"validate", bench_validate},
+    {NULL,       NULL}
+};
+
+/* All shapes */
+static const char *bench_shapes[] = {"wide", "deep", "leafref", NULL};
+
+/*! Print header of results
+ */
+static void
+bench_print_header(int machine)
+{
+    if (machine)
+        fprintf(stdout, "shape,op,size,ops,ns_op,allocs_op,peak_rss_kb\n");
+    else
+        fprintf(stdout, "%-8s %-9s %10s %8s %14s %12s %12s\n",
+                "shape", "op", "size", "ops", "ns/op", "allocs/op", "peak-rss-kB");
+}
+
+/*! Print result of one operation
+ */
+static void
+bench_print(bench_ctx    *bc,
+            const char   *op,
+            bench_result *br,
+            int           machine)
+{
+    uint64_t ns = br->br_ops ? br->br_ns / br->br_ops : 0;
+#ifdef BENCH_ALLOC_COUNT
+    int64_t  allocs = br->br_ops ? (int64_t)(br->br_allocs / br->br_ops) : 0;
+#else
+    int64_t  allocs = -1;
+#endif
+
+    if (machine)
+        fprintf(stdout, "%s,%s,%d,%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%ld\n",
+                bc->bc_shape, op, bc->bc_size, br->br_ops, ns, allocs, br->br_rsskb);
+    else
+        fprintf(stdout, "%-8s %-9s %10d %8" PRIu64 " %14" PRIu64 " %12" PRId64 " %12ld\n",
+                bc->bc_shape, op, bc->bc_size, br->br_ops, ns, allocs, br->br_rsskb);
+    fflush(stdout);
+}
+
+/*! Run all selected operations on one shape
+ *
+ * @param[in]  bc       Benchmark context
+ * @param[in]  opname   Operation name, or NULL for all
+ * @param[in]  machine  Machine-readable output
+ * @retval     0        OK
+ * @retval    -1        Error
+ */
+static int
+bench_run(bench_ctx  *bc,
+          const char *opname,
+          int         machine)
+{
+    int              retval = -1;
+    struct bench_op *bo;
+    bench_result     br;
+
+    if (bench_ctx_setup(bc) < 0)
+        goto done;
+    for (bo = &bench_ops[0]; bo->bo_name; bo++){
+        if (opname && strcmp(opname, bo->bo_name) != 0)
+            continue;
+        memset(&br, 0, sizeof(br));
+        bench_rss_reset();
+        if (bo->bo_fn(bc, &br) < 0)
+            goto done;
+        br.br_rsskb = bench_rss_peak();
+        bench_print(bc, bo->bo_name, &br, machine);
+    }
+    retval = 0;
+ done:
+    bench_ctx_free(bc);
+    return retval;
+}
+
+/*! Parse generated YANG via a temporary file to get the full YANG parse pipeline
+ */
+static int
+bench_yang_load(clixon_handle h,
+                yang_stmt    *yspec,
+                int           depth)
+{
+    int   retval = -1;
+    cbuf *cb = NULL;
+    char  filename[64];
+    FILE *f = NULL;
+
+    snprintf(filename, sizeof(filename), "/tmp/clixon-bench-%d.yang", getpid());
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    bench_yang_gen(cb, depth);
+    if ((f = fopen(filename, "w")) == NULL){
+        clixon_err(OE_UNIX, errno, "fopen %s", filename);
+        goto done;
+    }
+    fputs(cbuf_get(cb), f);
+    fclose(f);
+    f = NULL;
+    if (yang_spec_parse_file(h, filename, yspec) < 0)
+        goto done;
+    retval = 0;
+ done:
+    unlink(filename);
+    if (f)
+        fclose(f);
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+static void
+usage(clixon_handle h,
+      char         *argv0)
+{
+    fprintf(stderr, "usage:%s [options]\n"
+            "where options are\n"
+            "\t-h \t\tHelp\n"
+            "\t-D <level> \tDebug\n"
+            "\t-s <shape> \tShape: wide, deep or leafref (default all)\n"
+            "\t-o <op> \tOperation: parse, bind, sort, diff, xpath, json or validate (default all)\n"
+            "\t-N <nr> \tNumber of list entries in wide and leafref shapes (default 10000)\n"
+            "\t-d <depth> \tNumber of nested list levels in deep shape (default 6)\n"
+            "\t-w <width> \tEntries per level in deep shape (default 4)\n"
+            "\t-n <nr> \tIterations per operation, xpath makes %d lookups per iteration (default 10)\n"
+            "\t-r <seed> \tRandom seed (default 0)\n"
+            "\t-m \t\tMachine-readable CSV output\n",
+            argv0, BENCH_REPEAT);
+    exit(0);
+}
+
+int
+main(int    argc,
+     char **argv)
+{
+    int           retval = -1;
+    clixon_handle h;
+    int           c;
+    int           dbg = 0;
+    char         *shape = NULL;
+    char         *opname = NULL;
+    int           machine = 0;
+    unsigned int  seed = 0;
+    bench_ctx     bc = {0,};
+    int           i;
+
+    clixon_log_init(NULL, __PROGRAM__, LOG_INFO, CLIXON_LOG_STDERR);
+    if ((h = clixon_handle_init()) == NULL)
+        goto done;
+    bc.bc_h = h;
+    bc.bc_nr = 10000;
+    bc.bc_depth = 6;
+    bc.bc_width = 4;
+    bc.bc_iterations = 10;
+    optind = 1;
+    opterr = 0;
+    while ((c = getopt(argc, argv, BENCH_OPTS)) != -1)
+        switch (c) {
+        case 'h':
+            usage(h, argv[0]);
+            break;
+        case 'D':
+            if (sscanf(optarg, "%d", &dbg) != 1)
+                usage(h, argv[0]);
+            break;
+        case 's':
+            shape = optarg;
+            break;
+        case 'o':
+            opname = optarg;
+            break;
+        case 'N':
+            bc.bc_nr = atoi(optarg);
+            break;
+        case 'd':
+            bc.bc_depth = atoi(optarg);
+            break;
+        case 'w':
+            bc.bc_width = atoi(optarg);
+            break;
+        case 'n':
+            bc.bc_iterations = atoi(optarg);
+            break;
+        case 'r':
+            seed = atoi(optarg);
+            break;
+        case 'm':
+            machine++;
+            break;
+        default:
+            usage(h, argv[0]);
+            break;
+        }
+    if (bc.bc_nr < 1 || bc.bc_depth < 1 || bc.bc_width < 1 || bc.bc_iterations < 1)
+        usage(h, argv[0]);
+    clixon_debug_init(h, dbg);
+    srand(seed);
+    if (yang_init(h) < 0)
+        goto done;
+    if ((bc.bc_yspec = yspec_new(h, YANG_DATA_TOP)) == NULL)
+        goto done;
+    if (bench_yang_load(h, bc.bc_yspec, bc.bc_depth) < 0)
+        goto done;
+    if ((bc.bc_nsc = xml_nsctx_init(BENCH_PREFIX, BENCH_NS)) == NULL)
+        goto done;
+    bench_print_header(machine);
+    for (i = 0; bench_shapes[i]; i++){
+        if (shape && strcmp(shape, bench_shapes[i]) != 0)
+            continue;
+        bc.bc_shape = bench_shapes[i];
+        if (bench_run(&bc, opname, machine) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (bc.bc_nsc)
+        cvec_free(bc.bc_nsc);
+    if (h){
+        yang_exit(h);
+        clixon_handle_exit(h);
+    }
+    return retval == 0 ? 0 : 1;
+}
@@ -49,6 +49,8 @@
   *  -U  general-purpose upgrade
   *  -t  enable transaction logging (call syslog for every transaction)
   *  -V <xpath> Failing validate and commit if <xpath> is present (synthetic error)
+  *  -P  declare validate and commit callbacks thread-safe (CLIXON_PLUGIN_TRANS_PARALLEL)
+  *  -w <path> Transaction callbacks only see changes in this subtree, eg /ex:x
  * Note example_backend uses -v
  */
 #include <stdio.h>
@@ -73,7 +75,7 @@
 #include <clixon/clixon_backend.h>
 
 /* Command line options to be passed to getopt(3) */
-#define BACKEND_EXAMPLE_OPTS "a:m:M:n:o:O:rsS:x:iuUtV:"
+#define BACKEND_EXAMPLE_OPTS "a:m:M:n:o:O:p:PrsS:T:x:iuUtV:w:"
 
 /* Enabling this improves performance in tests, but there may trigger the "double XPath"
  * problem.
@@ -150,6 +152,18 @@ static char *_state_file = NULL;
  */
 static char *_state_xpath = NULL;
 
+/*! XPath to register the state file callback as a path-scoped state provider
+ *
+ * Instead of ca_statedata, the state file callback is only called for requests
+ * intersecting the xpath
+ * Start backend with -- -sS <file> -p <xpath> [-T <ttl>]
+ */
+static char *_state_provider_xpath = NULL;
+
+/*! Cache time-to-live in milliseconds of path-scoped state provider (requires -p)
+ */
+static uint32_t _state_provider_ttl = 0;
+
 /*! Read state file init on startup instead of on request
  *
  * Primarily for testing: -i
@@ -1627,6 +1641,12 @@ clixon_plugin_init(clixon_handle h)
         case 'O':
             _system_only_file = optarg;
             break;
+        case 'p': /* path-scoped state provider xpath (requires -sS) */
+            _state_provider_xpath = optarg;
+            break;
+        case 'P': /* validate/commit callbacks may run in parallel */
+            api.ca_trans_flags |= CLIXON_PLUGIN_TRANS_PARALLEL;
+            break;
         case 'r':
             _reset = 1;
             break;
@@ -1636,6 +1656,9 @@ clixon_plugin_init(clixon_handle h)
         case 'S': /* state file (requires -s) */
             _state_file = optarg;
             break;
+        case 'T': /* path-scoped state provider cache ttl in ms (requires -p) */
+            _state_provider_ttl = atoi(optarg);
+            break;
         case 'x': /* state xpath (requires -sS) */
             _state_xpath = optarg;
             break;
@@ -1654,13 +1677,27 @@ clixon_plugin_init(clixon_handle h)
         case 'V': /* validate fail */
             _validate_fail_xpath = optarg;
             break;
+        case 'w': /* only see transaction changes in this subtree */
+            if (clixon_plugin_subtree_register(h, api.ca_name, optarg) < 0)
+                goto done;
+            break;
         }
     if ((_mount_yang && !_mount_namespace) || (!_mount_yang && _mount_namespace)){
         clixon_err(OE_PLUGIN, EINVAL, "Both -m and -M must be given for mounts");
         goto done;
     }
     if (_state_file){
-        api.ca_statedata = example_statefile; /* Switch state data callback */
+        if (_state_provider_xpath){
+            /* Path-scoped state callback instead of plugin state callback */
+            api.ca_statedata = NULL;
+            if (clixon_statedata_cb_register(h,
+                                             example_statefile,
+                                             _state_provider_xpath,
+                                             _state_provider_ttl) < 0)
+                goto done;
+        }
+        else
+            api.ca_statedata = example_statefile; /* Switch state data callback */
         if (_state_xpath){
             /* State pagination callbacks */
             if (clixon_pagination_cb_register(h,
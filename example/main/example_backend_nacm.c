@@ -60,7 +60,7 @@
 #include <clixon/clixon_backend.h>
 
 /* Command line options to be passed to getopt(3) */
-#define BACKEND_NACM_OPTS "tv:"
+#define BACKEND_NACM_OPTS "Ptv:"
 
 /*! Variable to control transaction logging (for debug)
  *
@@ -258,6 +258,9 @@ clixon_plugin_init(clixon_handle h)
     optind = 1;
     while ((c = getopt(argc, argv, BACKEND_NACM_OPTS)) != -1)
         switch (c) {
+        case 'P': /* validate/commit callbacks may run in parallel */
+            api.ca_trans_flags |= CLIXON_PLUGIN_TRANS_PARALLEL;
+            break;
         case 't': /* transaction log */
             _transaction_log = 1;
             break;
@@ -63,6 +63,25 @@
  */
 #define XPATH_LIST_OPTIMIZE
 
+/*! Keep typed values of list keys and leaf-list entries cached in the XML tree
+ *
+ * xml_cmp() parses key bodies into cligen variables (x_cv) on first comparison.
+ * If set, key values are pre-resolved when binding YANG, kept when sorting, and copied
+ * by xml_dup/xml_copy. The cache is invalidated when the body is changed.
+ * If not set, the cache is cleared after each sort, which saves one cv per key but
+ * re-parses key bodies in later searches and diffs.
+ */
+#define XML_CV_CACHE_KEYS
+
+/*! Parse XML with a fast hand-written parser first, and the flex/bison parser as fallback
+ *
+ * The fast parser handles elements, attributes, text, entities and comments. On anything
+ * else, such as XML declarations, CDATA, or syntax errors, the partial result is removed and
+ * the bison parser is run, which also gives the error messages.
+ * Applies to all XML parsing, eg datastore loads and internal messages.
+ */
+#define XML_PARSE_FAST
+
 /*! Add explicit search indexes, so that binary search can be made for non-key list indexes
  *
  * This also applies if there are multiple keys and you want to search on only the second for
@@ -73,6 +92,17 @@
  */
 #define XML_EXPLICIT_INDEX
 
+/*! Hash index on the full key tuple of large YANG lists
+ *
+ * A list with at least XML_LIST_KEY_INDEX_MIN siblings gets a hash index from its key
+ * values to list entry on first keyed search, which is then maintained by xml_insert()
+ * and xml_child_rm(). Used by api-path, xpath key predicates and edit-config merges.
+ * Hits in ordered-by user lists are also O(1) instead of linear.
+ * A key changed in place marks the index stale so that it is rebuilt on next search.
+ */
+#define XML_LIST_KEY_INDEX
+#define XML_LIST_KEY_INDEX_MIN 64
+
 /*! Let state data be ordered-by system
  *
  * RFC 7950 is cryptic about this
@@ -100,6 +130,21 @@
  */
 #define HTTP_DATA_INTERNAL_REDIRECT "index.html"
 
+/*! Number of open files and their metadata cached by the HTTP data service
+ *
+ * A cached file is re-used as long as its inode, size and modification time are unchanged,
+ * which avoids opening the file on every request. If not set, files are opened per request.
+ */
+#define HTTP_DATA_FILE_CACHE_SIZE 64
+
+/*! Max number of worker threads for parallel backend plugin transaction callbacks
+ *
+ * Validate and commit callbacks of plugins flagged with CLIXON_PLUGIN_TRANS_PARALLEL are
+ * run in worker threads, at most this many at a time. Requires libpthread.
+ * If not set, all plugin callbacks are run sequentially in the main thread.
+ */
+#define PLUGIN_TRANS_PARALLEL_MAX 8
+
 /*! Enable "remaining" attribute (sub-feature of list pagination)
  *
  * See "remaining" annotation defined in module ietf-list-pagination.yang
@@ -328,3 +373,13 @@
  * Note, only some calls use this since a pre-step is to compute diffs
  */
 #define VALIDATE_INCREMENTAL
+
+/*! Memoize must and when results per anchor ancestor during validation
+ *
+ * A must/when xpath whose relative paths all start with n parent steps, eg
+ * "count(../../entry[type='x']) < 100", has the same result for all context nodes with
+ * the same n:th ancestor. It is then evaluated once per ancestor and validation,
+ * instead of once per context node, which is quadratic for aggregates over lists.
+ * Relies on parse-time XPath anchor analysis, see ys_populate_xpath_anchor
+ */
+#define VALIDATE_XPATH_MEMO
@@ -80,6 +80,7 @@ int      xmldb_cache_status_set(db_elmnt *de, enum xmldb_cache_status status);
 db_elmnt *xmldb_new(clixon_handle h, const char *db);
 db_elmnt *xmldb_find(clixon_handle h, const char *db);
 int xmldb_db2file(clixon_handle h, const char *db, char **filename);
+int xmldb_db2snapshot(clixon_handle h, const char *db, char **filename);
 int xmldb_db2subdir(clixon_handle h, const char *db, char **dir);
 int xmldb_connect(clixon_handle h);
 int xmldb_disconnect(clixon_handle h);
@@ -91,11 +92,16 @@ int xmldb_get0(clixon_handle h, const char *db, int yb,
                cxobj **xret, void *md, cxobj **xerr);
 int xmldb_get_cache(clixon_handle h, const char *db, cxobj **xtp, cxobj **xerr);
 int xmldb_get_cache_from_file(clixon_handle h, db_elmnt *de, cxobj **xtp, cxobj **xerr);
+int xmldb_snapshot_get(clixon_handle h, const char *db, const char *xpath, cvec *nsc, cxobj **xret);
+int xmldb_snapshot_exit(clixon_handle h);
 
 /* in clixon_datastore_write.[ch]: */
 int xmldb_put(clixon_handle h, const char *db, enum operation_type op, cxobj *xt, const char *username, cbuf *cbret);
+int xmldb_put_batch(clixon_handle h, const char *db, enum operation_type *opvec, cxobj **xvec, int xlen, const char *username, cbuf **cbvec);
 int xmldb_dump(clixon_handle h, FILE *f, cxobj *xt, enum format_enum format, int pretty, withdefaults_type wdef, int multi, const char *multidb);
 int xmldb_write_cache2file(clixon_handle h, const char *db);
+int xmldb_snapshot_write(clixon_handle h, const char *db);
+int xmldb_snapshot_delete(clixon_handle h, const char *db);
 
 int xmldb_copy_file(clixon_handle h, const char *from, const char *to);
 int xmldb_copy(clixon_handle h, const char *from, const char *to);
@@ -112,6 +112,7 @@ int   netconf_err2cb(clixon_handle h, cxobj *xerr, cbuf *cberr);
 void *clixon_err_save(void);
 int   clixon_err_restore(void *handle);
 int   clixon_err_cat_reg(enum clixon_err category, void *handle, clixon_cat_log_cb logfn);
+int   clixon_err_thread_exit(void);
 int   clixon_err_exit(void);
 
 /* doesnt work if arg != NULL */
@@ -357,6 +357,18 @@ typedef int (errmsg_t)(clixon_handle h, const char *fn, const int line,
  */
 typedef int (plgversion_t)(clixon_handle, FILE*);
 
+/*! Backend plugin transaction flag: validate and commit callbacks are thread-safe
+ *
+ * The plugin declares that its ca_trans_validate and ca_trans_commit callbacks are independent
+ * of other plugins and only read the transaction trees, so they may run concurrently with
+ * other such plugins in worker threads.
+ * The callbacks must not modify the transaction trees or clixon handle data, and report
+ * errors with clixon_err(), not clixon_plugin_rpc_err().
+ * Results, errors and revert order are the same as if the plugins were called in order.
+ * @see PLUGIN_TRANS_PARALLEL_MAX
+ */
+#define CLIXON_PLUGIN_TRANS_PARALLEL 0x01
+
 /* For 7.3 compatibility */
 #define CLIXON_PLUGIN_USERDEF
 
@@ -436,6 +448,7 @@ struct clixon_plugin_api{
             trans_cb_t       *cb_trans_end;      /* Transaction completed  */
             trans_cb_t       *cb_trans_abort;    /* Transaction aborted */
             datastore_upgrade_t *cb_datastore_upgrade; /* General-purpose datastore upgrade */
+            uint32_t          cb_trans_flags;    /* Transaction flags, see CLIXON_PLUGIN_TRANS_* */
         } cau_backend;
     } u;
 };
@@ -460,6 +473,7 @@ struct clixon_plugin_api{
 #define ca_trans_end      u.cau_backend.cb_trans_end
 #define ca_trans_abort    u.cau_backend.cb_trans_abort
 #define ca_datastore_upgrade  u.cau_backend.cb_datastore_upgrade
+#define ca_trans_flags    u.cau_backend.cb_trans_flags
 
 /*
  * Macros
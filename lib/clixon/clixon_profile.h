@@ -0,0 +1,116 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+ 
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2, 
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Profiling counters and latency histograms
+ * Lightweight instrumentation of hot paths, enabled with CLICON_BACKEND_PROFILE
+ * Latencies are recorded in histograms with log2 microsecond buckets.
+ */
+#ifndef _CLIXON_PROFILE_H_
+#define _CLIXON_PROFILE_H_
+
+/*
+ * Constants
+ */
+/* Number of histogram buckets. Bucket i counts latencies below 2^i us, last bucket the rest */
+#define CLIXON_PROFILE_BUCKETS 24
+
+/*
+ * Types
+ */
+/*! Profiling event counters
+ */
+enum clixon_profile_counter {
+    CLIXON_PROF_XPATH_EVAL,      /* Top-level XPath evaluations, see xpath_vec_ctx */
+    CLIXON_PROF_YANG_FIND,       /* yang_find() calls */
+    CLIXON_PROF_COUNTER_NR       /* Must be last */
+};
+typedef enum clixon_profile_counter clixon_profile_counter;
+
+/*! Profiling latency timers, one histogram each
+ */
+enum clixon_profile_timer {
+    CLIXON_PROF_COMMIT,          /* Total candidate commit */
+    CLIXON_PROF_COMMIT_DIFF,     /* Commit: compute diff between candidate and running */
+    CLIXON_PROF_COMMIT_VALIDATE, /* Commit: generic validation */
+    CLIXON_PROF_COMMIT_PLUGIN,   /* Commit: one sample per plugin transaction callback phase */
+    CLIXON_PROF_DATASTORE_COPY,  /* Datastore: copy of in-memory cache */
+    CLIXON_PROF_DATASTORE_WRITE, /* Datastore: write of datastore file */
+    CLIXON_PROF_EVENT_LAG,       /* Event loop: delay of timer dispatch after expiry */
+    CLIXON_PROF_TIMER_NR         /* Must be last */
+};
+typedef enum clixon_profile_timer clixon_profile_timer;
+
+/*! Latency histogram
+ */
+struct clixon_profile_hist {
+    uint64_t ph_count;                          /* Number of samples */
+    uint64_t ph_sum;                            /* Sum of samples in us */
+    uint64_t ph_max;                            /* Max sample in us */
+    uint64_t ph_bucket[CLIXON_PROFILE_BUCKETS]; /* Log2 us buckets */
+};
+typedef struct clixon_profile_hist clixon_profile_hist;
+
+/*
+ * Variables
+ */
+/* Do not access directly, use clixon_profile_enabled() and clixon_profile_count() */
+extern int      _clixon_profile_enabled;
+extern uint64_t _clixon_profile_counters[CLIXON_PROF_COUNTER_NR];
+
+/*
+ * Macros
+ */
+#define clixon_profile_enabled() (_clixon_profile_enabled)
+
+/*! Increment profiling counter, a single test if disabled */
+#define clixon_profile_count(c) do {                      \
+        if (_clixon_profile_enabled)                      \
+            _clixon_profile_counters[(c)]++;              \
+    } while (0)
+
+/*
+ * Prototypes
+ */
+int      clixon_profile_enable(int enable);
+int      clixon_profile_start(struct timespec *ts);
+int      clixon_profile_stop(clixon_profile_timer timer, struct timespec *ts);
+int      clixon_profile_rpc_stop(const char *name, struct timespec *ts);
+int      clixon_profile_add(clixon_profile_timer timer, uint64_t us);
+int      clixon_profile_lag(struct timeval *t);
+uint64_t clixon_profile_counter_get(clixon_profile_counter counter);
+int      clixon_profile_hist_get(clixon_profile_timer timer, clixon_profile_hist **php);
+int      clixon_profile_reset(void);
+int      clixon_profile_print(cbuf *cb);
+int      clixon_profile_exit(void);
+
+#endif /* _CLIXON_PROFILE_H_ */
@@ -53,6 +53,7 @@ int clicon_rpc_netconf_xml(clixon_handle h, cxobj *xml, cxobj **xret, int *sp);
 int clixon_rpc_get_config1(clixon_handle h, const char *username, const char *db, const char *xpath, cvec *nsc,
                            const char *defaults, yang_bind yb ,cxobj **xret);
 int clicon_rpc_edit_config(clixon_handle h, const char *db, enum operation_type op, const char *xml);
+int clixon_rpc_batch_edit(clixon_handle h, const char *db, enum operation_type *opvec, char **xmlvec, int len, cxobj **xret);
 int clicon_rpc_copy_config(clixon_handle h, const char *db1, const char *db2);
 int clicon_rpc_delete_config(clixon_handle h, const char *db);
 int clicon_rpc_lock(clixon_handle h, const char *db);
@@ -41,6 +41,8 @@
 /*
  * Constants
  */
+/* Backend stream of clixon-lib config-change notifications, see CLICON_CLI_EXPAND_CACHE */
+#define CLIXON_CONFIG_CHANGE_STREAM "CLIXON-CONFIG"
 
 /*
  * Types
@@ -195,6 +195,7 @@ enum format_enum{
     FORMAT_TEXT,
     FORMAT_CLI,
     FORMAT_NETCONF,  /* Last concrete format, used in code */
+    FORMAT_CBOR,     /* Binary, only as datastore format, see clixon_cbor.c */
     FORMAT_DEFAULT,  /* Indirect: actual value in CLICON_CLI_OUTPUT_FORMAT */
     FORMAT_PIPE_XML_DEFAULT /* Meta: If pipe, xml, if not default */
 };
@@ -244,6 +245,8 @@ const char *xml_type2str(enum cxobj_type type);
 xml_stats_enum xml_stats_str2type(const char *str);
 int       xml_stats_global(uint64_t *nr);
 int       xml_stats(cxobj *xt, xml_stats_enum type, uint64_t *nrp, size_t *szp);
+struct clixon_arena *xml_arena_set(struct clixon_arena *ca);
+int       xml_arena_p(cxobj *x);
 char     *xml_name(cxobj *xn);
 int       xml_name_set(cxobj *xn, const char *name);
 char     *xml_prefix(cxobj *xn);
@@ -341,6 +344,11 @@ int       xml_search_child_insert(cxobj *xp, cxobj *x);
 int       xml_search_child_rm(cxobj *xp, cxobj *x);
 cxobj    *xml_child_index_each(cxobj *xparent, const char *name, cxobj *xprev, enum cxobj_type type);
 
+#endif
+#ifdef XML_LIST_KEY_INDEX
+int       xml_key_index_find(cxobj *xp, yang_stmt *y, cxobj *x1, cxobj **xcp);
+int       xml_key_index_readonly(int readonly);
+int       xml_key_index_child_insert(cxobj *xp, cxobj *xc);
 #endif
 
 #endif /* _CLIXON_XML_H */
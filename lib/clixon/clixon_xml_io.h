@@ -43,6 +43,7 @@
 /*
  * Prototypes
  */
+int   xml2output_wdef(cxobj *x, withdefaults_type wdef, int *tag);
 int   clixon_xml2file1(FILE *f, cxobj *xn, int level, int pretty, const char *prefix,
                        clicon_output_cb *fn, int skiptop, int autocliext, withdefaults_type wdef,
                        int multi, int system_only);
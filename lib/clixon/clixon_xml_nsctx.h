@@ -57,6 +57,7 @@ int     xml_nsctx_node(cxobj *x, cvec **ncp);
 int     xml_nsctx_yang(yang_stmt *yn, cvec **ncp);
 int     xml_nsctx_yangspec(yang_stmt *yspec, cvec **ncp);
 int     xml_nsctx_cbuf(cbuf *cb, cvec *nsc);
+int     xml_nscache_readonly(int readonly);
 int     xml2ns(cxobj *x, const char *prefix, char **ns);
 int     xml2ns_recurse(cxobj *x);
 int     xmlns_set(cxobj *x, const char *prefix, const char *ns);
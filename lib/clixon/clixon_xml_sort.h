@@ -41,9 +41,13 @@
 /*
  * Prototypes
  */
+int xml_cv_cache(cxobj *x, cg_var **cvp);
+int xml_cv_cache_readonly(int readonly);
+int xml_cv_cache_key(cxobj *x);
 int xml_cmp(cxobj *x1, cxobj *x2, int same, int skip1, const char *expl);
 int xml_sort(cxobj *x);
 int xml_sort_by(cxobj *x, char *indexvar);
+int xml_sort_if_needed(cxobj *xn);
 int xml_sort_recurse(cxobj *xn);
 int xml_insert(cxobj *xp, cxobj *xc, enum insert_type ins, const char *key_val, cvec *nsckey);
 int xml_sort_verify(cxobj *x, void *arg);
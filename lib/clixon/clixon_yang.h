@@ -363,6 +363,9 @@ int        yang_type_cache_get2(yang_stmt *ytype, yang_stmt **resolved, int *opt
                                 cvec **cvv, cvec *patterns, cvec *regexps, uint8_t *fraction);
 int        yang_type_cache_set2(yang_stmt *ys, yang_stmt *resolved, int options, cvec *cvv,
                                 cvec *patterns, uint8_t fraction, int rxmode, cvec *regexps);
+int        yang_type_cache_ref(yang_stmt *ytype, yang_stmt **resolved, int *options,
+                               cvec **cvv, cvec **regexps, uint8_t *fraction);
+int        yang_type_enum_find(yang_stmt *yrestype, const char *str);
 yang_stmt *yang_anydata_add(yang_stmt *yp, const char *name);
 int        yang_extension_value(yang_stmt *ys, const char *name, const char *ns, int *exist, char **value);
 int        yang_sort_subelements(yang_stmt *ys);
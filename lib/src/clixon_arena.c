@@ -0,0 +1,264 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+ 
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2, 
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Region (arena) memory allocator
+ * Memory is bump-allocated from a list of chunks. There is no way to free individual
+ * objects: all memory is released at once with clixon_arena_reset() or clixon_arena_free().
+ * Allocations larger than a quarter of the chunk size get a dedicated chunk, so that
+ * the remains of the current chunk are not wasted.
+ * Example usage, see xml_arena_set():
+ * @code
+ *   clixon_arena *ca;
+ *
+ *   if ((ca = clixon_arena_new(0)) == NULL)
+ *      err;
+ *   p = clixon_arena_alloc(ca, 32);
+ *   ...
+ *   clixon_arena_reset(ca);  // Release all, keep one chunk for reuse
+ *   ...
+ *   clixon_arena_free(ca);
+ * @endcode
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include "clixon_queue.h"
+#include "clixon_hash.h"
+#include "clixon_handle.h"
+#include "clixon_yang.h"
+#include "clixon_xml.h"
+#include "clixon_err.h"
+#include "clixon_arena.h"
+#include "banned.h"
+
+/*
+ * Constants
+ */
+/* All allocations are aligned to this */
+#define ARENA_ALIGN     8
+#define ARENA_ROUNDUP(n) (((n) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+/*
+ * Types
+ */
+/* A chunk of memory, allocations are made from ac_data */
+struct arena_chunk {
+    struct arena_chunk *ac_next;  /* Next (older) chunk */
+    size_t              ac_size;  /* Size of ac_data */
+    size_t              ac_used;  /* Allocated bytes of ac_data */
+    uint64_t            ac_data[]; /* Flexible array member, 8-byte aligned */
+};
+
+struct clixon_arena {
+    struct arena_chunk *ca_chunks;    /* Current chunk first, then older chunks */
+    size_t              ca_chunksize; /* Size of regular chunks */
+    size_t              ca_size;      /* Total allocated bytes, for statistics */
+};
+
+/*! Create a new arena
+ *
+ * @param[in]  chunksize  Size of each chunk, or 0 for default CLIXON_ARENA_CHUNK_SIZE
+ * @retval     ca         Arena, free with clixon_arena_free
+ * @retval     NULL       Error
+ */
+clixon_arena *
+clixon_arena_new(size_t chunksize)
+{
+    clixon_arena *ca;
+
+    if ((ca = malloc(sizeof(*ca))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        return NULL;
+    }
+    memset(ca, 0, sizeof(*ca));
+    ca->ca_chunksize = chunksize ? ARENA_ROUNDUP(chunksize) : CLIXON_ARENA_CHUNK_SIZE;
+    return ca;
+}
+
+/*! Free an arena and all memory allocated from it
+ *
+ * @param[in]  ca  Arena
+ * @retval     0   OK
+ */
+int
+clixon_arena_free(clixon_arena *ca)
+{
+    struct arena_chunk *ac;
+
+    if (ca == NULL)
+        return 0;
+    while ((ac = ca->ca_chunks) != NULL){
+        ca->ca_chunks = ac->ac_next;
+        free(ac);
+    }
+    free(ca);
+    return 0;
+}
+
+/*! Release all memory allocated from an arena, but keep one regular chunk for reuse
+ *
+ * @param[in]  ca  Arena
+ * @retval     0   OK
+ * @note All objects allocated from the arena are invalid after this call
+ */
+int
+clixon_arena_reset(clixon_arena *ca)
+{
+    struct arena_chunk *ac;
+    struct arena_chunk *keep = NULL;
+
+    if (ca == NULL)
+        return 0;
+    while ((ac = ca->ca_chunks) != NULL){
+        ca->ca_chunks = ac->ac_next;
+        if (keep == NULL && ac->ac_size == ca->ca_chunksize)
+            keep = ac;
+        else
+            free(ac);
+    }
+    if (keep){
+        keep->ac_next = NULL;
+        keep->ac_used = 0;
+        ca->ca_chunks = keep;
+    }
+    ca->ca_size = 0;
+    return 0;
+}
+
+/*! Allocate and link a new chunk
+ *
+ * @param[in]  ca    Arena
+ * @param[in]  size  Size of data in chunk
+ * @param[in]  head  If set, make new chunk current, otherwise insert it after current
+ */
+static struct arena_chunk *
+arena_chunk_new(clixon_arena *ca,
+                size_t        size,
+                int           head)
+{
+    struct arena_chunk *ac;
+
+    if ((ac = malloc(sizeof(*ac) + size)) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        return NULL;
+    }
+    ac->ac_size = size;
+    ac->ac_used = 0;
+    if (head || ca->ca_chunks == NULL){
+        ac->ac_next = ca->ca_chunks;
+        ca->ca_chunks = ac;
+    }
+    else{
+        ac->ac_next = ca->ca_chunks->ac_next;
+        ca->ca_chunks->ac_next = ac;
+    }
+    return ac;
+}
+
+/*! Allocate memory from an arena
+ *
+ * @param[in]  ca   Arena
+ * @param[in]  len  Number of bytes
+ * @retval     p    Pointer to uninitialized memory, 8-byte aligned. Do not free
+ * @retval     NULL Error
+ */
+void *
+clixon_arena_alloc(clixon_arena *ca,
+                   size_t        len)
+{
+    struct arena_chunk *ac;
+    void               *p;
+
+    if (ca == NULL){
+        clixon_err(OE_UNIX, EINVAL, "arena is NULL");
+        return NULL;
+    }
+    len = ARENA_ROUNDUP(len ? len : 1);
+    if (len > ca->ca_chunksize/4){
+        /* Large objects get a dedicated chunk, current chunk is kept */
+        if ((ac = arena_chunk_new(ca, len, 0)) == NULL)
+            return NULL;
+    }
+    else if ((ac = ca->ca_chunks) == NULL || ac->ac_size - ac->ac_used < len){
+        if ((ac = arena_chunk_new(ca, ca->ca_chunksize, 1)) == NULL)
+            return NULL;
+    }
+    p = (char*)ac->ac_data + ac->ac_used;
+    ac->ac_used += len;
+    ca->ca_size += len;
+    return p;
+}
+
+/*! Duplicate a string into an arena
+ *
+ * @param[in]  ca   Arena
+ * @param[in]  str  String to copy
+ * @retval     s    Copy of string. Do not free
+ * @retval     NULL Error
+ */
+char *
+clixon_arena_strdup(clixon_arena *ca,
+                    const char   *str)
+{
+    char  *s;
+    size_t len;
+
+    len = strlen(str) + 1;
+    if ((s = clixon_arena_alloc(ca, len)) == NULL)
+        return NULL;
+    memcpy(s, str, len);
+    return s;
+}
+
+/*! Get number of bytes allocated from an arena since it was created or reset
+ *
+ * @param[in]  ca   Arena
+ * @retval     size Allocated bytes
+ */
+size_t
+clixon_arena_size(clixon_arena *ca)
+{
+    return ca ? ca->ca_size : 0;
+}
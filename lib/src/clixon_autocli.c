@@ -655,6 +655,47 @@ autocli_cache(clixon_handle    h,
     return retval;
 }
 
+/*! Return if container and list bodies are generated lazily
+ *
+ * Lazy generation is set with CLICON_AUTOCLI_LAZY. It requires clispec-cache disabled
+ * since the generated tree references are resolved from the local YANG, and
+ * treeref-state false since state labels are propagated from children to parents.
+ * @param[in]  h     Clixon handle
+ * @param[out] lazy  Lazy generation enabled
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see yang2cli_lazy
+ */
+int
+autocli_lazy(clixon_handle h,
+             int          *lazy)
+{
+    int             retval = -1;
+    autocli_cache_t cache = AUTOCLI_CACHE_DISABLED;
+    int             treeref_state = 0;
+
+    if (lazy == NULL){
+        clixon_err(OE_YANG, EINVAL, "Argument is NULL");
+        goto done;
+    }
+    *lazy = 0;
+    if (!clicon_option_bool(h, "CLICON_AUTOCLI_LAZY"))
+        goto ok;
+    if (autocli_cache(h, &cache, NULL) < 0)
+        goto done;
+    if (cache != AUTOCLI_CACHE_DISABLED)
+        goto ok;
+    if (autocli_treeref_state(h, &treeref_state) < 0)
+        goto done;
+    if (treeref_state)
+        goto ok;
+    *lazy = 1;
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
 /*! Translate to CLI commands in cbuf
  *
  * Howto: join strings and pass them down.
@@ -1290,6 +1290,174 @@ yang2cli_leaf(clixon_handle h,
     return retval;
 }
 
+/*! Generate CLI code for the children of a Yang container statement
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  ys    Yang container statement
+ * @param[in]  level Indentation level of container
+ * @param[out] cb    Buffer where cligen code is written
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+yang2cli_container_body(clixon_handle h,
+                        yang_stmt    *ys,
+                        int           level,
+                        cbuf         *cb)
+{
+    int        retval = -1;
+    yang_stmt *yc;
+    int        inext;
+    int        ret;
+
+    /* Is schema mount-point? */
+    if (clicon_option_bool(h, "CLICON_YANG_SCHEMA_MOUNT")){
+        if ((ret = yang_schema_mount_point(ys)) < 0)
+            goto done;
+        if (ret){
+            cprintf(cb, "%*s%s", (level+1)*3, "", "@mountpoint;\n");
+        }
+    }
+    inext = 0;
+    while ((yc = yn_iter(ys, &inext)) != NULL)
+        if (yang2cli_stmt(h, yc, level+1, cb) < 0)
+            goto done;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Generate CLI code for the non-key children of a Yang list statement
+ *
+ * @param[in]  h     Clixon handle
+ * @param[in]  ys    Yang list statement
+ * @param[in]  level Indentation level of list
+ * @param[out] cb    Buffer where cligen code is written
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+yang2cli_list_body(clixon_handle h,
+                   yang_stmt    *ys,
+                   int           level,
+                   cbuf         *cb)
+{
+    int        retval = -1;
+    yang_stmt *yc;
+    cvec      *cvk;
+    cg_var    *cvi;
+    char      *keyname;
+    int        inext;
+
+    cvk = yang_cvec_get(ys); /* Use Y_LIST cache, see ys_populate_list() */
+    inext = 0;
+    while ((yc = yn_iter(ys, &inext)) != NULL) {
+        /*  cvk is a cvec of strings containing variable names
+            yc is a leaf that may match one of the values of cvk.
+        */
+        cvi = NULL;
+        while ((cvi = cvec_each(cvk, cvi)) != NULL) {
+            keyname = cv_string_get(cvi);
+            if (strcmp(keyname, yang_argument_get(yc)) == 0)
+                break;
+        }
+        if (cvi != NULL)
+            continue;
+        if (yang2cli_stmt(h, yc, level+1, cb) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Get path of child indexes from the (sub)module to a yang statement
+ *
+ * @param[in]  ys    Yang statement
+ * @param[out] cb    Path on the form <i>.<j>...
+ * @param[out] ymod  Yang (sub)module
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see yang2cli_lazy  where the path is resolved
+ */
+static int
+yang2cli_lazy_path(yang_stmt  *ys,
+                   cbuf       *cb,
+                   yang_stmt **ymod)
+{
+    int        retval = -1;
+    yang_stmt *yp;
+    int        i;
+
+    if (yang_keyword_get(ys) == Y_MODULE || yang_keyword_get(ys) == Y_SUBMODULE){
+        *ymod = ys;
+        goto ok;
+    }
+    if ((yp = yang_parent_get(ys)) == NULL){
+        clixon_err(OE_YANG, 0, "%s has no module", yang_argument_get(ys));
+        goto done;
+    }
+    if (yang2cli_lazy_path(yp, cb, ymod) < 0)
+        goto done;
+    for (i = 0; i < yang_len_get(yp); i++)
+        if (yang_child_i(yp, i) == ys)
+            break;
+    cprintf(cb, "%s%d", cbuf_len(cb)?".":"", i);
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Generate tree reference to the lazily generated body of a container or list
+ *
+ * The body is generated when the treeref is first resolved, ie when the user enters
+ * or completes into the container or list.
+ * Format: @<domain>:<spec>:<module>:<revision>:<keyword>:<path>
+ * @param[in]  ys    Yang container or list statement
+ * @param[in]  level Indentation level
+ * @param[out] cb    Buffer where cligen code is written
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see yang2cli_lazy  Generate the body
+ */
+static int
+yang2cli_lazy_treeref(yang_stmt *ys,
+                      int        level,
+                      cbuf      *cb)
+{
+    int        retval = -1;
+    cbuf      *cbpath = NULL;
+    cbuf      *cbtree = NULL;
+    yang_stmt *ymod = NULL;
+    yang_stmt *yrev;
+
+    if ((cbpath = cbuf_new()) == NULL ||
+        (cbtree = cbuf_new()) == NULL){
+        clixon_err(OE_XML, errno, "cbuf_new");
+        goto done;
+    }
+    if (yang2cli_lazy_path(ys, cbpath, &ymod) < 0)
+        goto done;
+    yrev = yang_find(ymod, Y_REVISION, NULL);
+    if (yang2cli_treeref_encode(cbtree, AUTOCLI_CMD_DELIM,
+                                yang_argument_get(ys_domain(ys)),
+                                yang_argument_get(ys_spec(ys)),
+                                yang_argument_get(ymod),
+                                yrev?yang_argument_get(yrev):NULL,
+                                yang_key2str(yang_keyword_get(ys)),
+                                cbuf_get(cbpath)) < 0)
+        goto done;
+    cprintf(cb, "%*s@%s;\n", level*3, "", cbuf_get(cbtree));
+    retval = 0;
+ done:
+    if (cbpath)
+        cbuf_free(cbpath);
+    if (cbtree)
+        cbuf_free(cbtree);
+    return retval;
+}
+
 /*! Generate CLI code for Yang container statement
  *
  * @param[in]  h     Clixon handle
@@ -1306,15 +1474,13 @@ yang2cli_container(clixon_handle h,
                    cbuf         *cb)
 {
     int           retval = -1;
-    yang_stmt    *yc;
     yang_stmt    *yd;
     char         *helptext = NULL;
     char         *s;
     int           compress = 0;
     yang_stmt    *ymod = NULL;
     int           extvalue = 0;
-    int           inext;
-    int           ret;
+    int           lazy = 0;
 
     if (ys_real_module(ys, &ymod) < 0)
         goto done;
@@ -1346,18 +1512,14 @@ yang2cli_container(clixon_handle h,
             cprintf(cb, ", ac-state");
         cprintf(cb, ", act-container;{\n");
     }
-    /* Is schema mount-point? */
-    if (clicon_option_bool(h, "CLICON_YANG_SCHEMA_MOUNT")){
-        if ((ret = yang_schema_mount_point(ys)) < 0)
+    if (autocli_lazy(h, &lazy) < 0)
+        goto done;
+    if (lazy && !compress){
+        if (yang2cli_lazy_treeref(ys, level+1, cb) < 0)
             goto done;
-        if (ret){
-            cprintf(cb, "%*s%s", (level+1)*3, "", "@mountpoint;\n");
-        }
     }
-    inext = 0;
-    while ((yc = yn_iter(ys, &inext)) != NULL)
-        if (yang2cli_stmt(h, yc, level+1, cb) < 0)
-            goto done;
+    else if (yang2cli_container_body(h, ys, level, cb) < 0)
+        goto done;
     if (!compress)
         cprintf(cb, "%*s}\n", level*3, "");
     retval = 0;
@@ -1383,7 +1545,6 @@ yang2cli_list(clixon_handle h,
               cbuf         *cb)
 {
     int           retval = -1;
-    yang_stmt    *yc;
     yang_stmt    *yd;
     yang_stmt    *yleaf;
     cg_var       *cvi;
@@ -1394,7 +1555,7 @@ yang2cli_list(clixon_handle h,
     int           last_key = 0;
     int           exist = 0;
     int           keynr = 0;
-    int           inext;
+    int           lazy = 0;
 
     cprintf(cb, "%*s%s", level*3, "", yang_argument_get(ys));
     if ((yd = yang_find(ys, Y_DESCRIPTION, NULL)) != NULL){
@@ -1445,22 +1606,14 @@ yang2cli_list(clixon_handle h,
         keynr++;
     }
     cprintf(cb, "{\n");
-    inext = 0;
-    while ((yc = yn_iter(ys, &inext)) != NULL) {
-        /*  cvk is a cvec of strings containing variable names
-            yc is a leaf that may match one of the values of cvk.
-        */
-        cvi = NULL;
-        while ((cvi = cvec_each(cvk, cvi)) != NULL) {
-            keyname = cv_string_get(cvi);
-            if (strcmp(keyname, yang_argument_get(yc)) == 0)
-                break;
-        }
-        if (cvi != NULL)
-            continue;
-        if (yang2cli_stmt(h, yc, level+1, cb) < 0)
+    if (autocli_lazy(h, &lazy) < 0)
+        goto done;
+    if (lazy){
+        if (yang2cli_lazy_treeref(ys, level+1, cb) < 0)
             goto done;
     }
+    else if (yang2cli_list_body(h, ys, level, cb) < 0)
+        goto done;
     cprintf(cb, "%*s}\n", level*3, "");
     /* Close with } for each key */
     while (keynr--)
@@ -1656,6 +1809,67 @@ yang2cli_grouping(clixon_handle h,
     goto done;
 }
 
+/*! Generate clispec for the lazily generated body of a container or list
+ *
+ * @param[in]  h         Clixon handle
+ * @param[in]  ymod      Yang module or submodule
+ * @param[in]  keyword   Yang keyword: container or list
+ * @param[in]  argument  Path of child indexes from ymod, see yang2cli_lazy_treeref
+ * @param[out] cb        Buffer where cligen code is written
+ * @retval     1         OK
+ * @retval     0         No such yang node
+ * @retval    -1         Error
+ * @see autocli_lazy
+ */
+int
+yang2cli_lazy(clixon_handle h,
+              yang_stmt    *ymod,
+              const char   *keyword,
+              const char   *argument,
+              cbuf         *cb)
+{
+    int        retval = -1;
+    yang_stmt *ys = ymod;
+    char     **vec = NULL;
+    int        nvec;
+    int        i;
+    char      *ep;
+    long       j;
+
+    if ((vec = clixon_strsep1(argument, ".", &nvec)) == NULL)
+        goto done;
+    for (i = 0; i < nvec; i++){
+        j = strtol(vec[i], &ep, 10);
+        if (*vec[i] == '\0' || *ep != '\0' || j < 0 || j >= yang_len_get(ys))
+            goto fail;
+        if ((ys = yang_child_i(ys, j)) == NULL)
+            goto fail;
+    }
+    if (strcmp(yang_key2str(yang_keyword_get(ys)), keyword) != 0)
+        goto fail;
+    switch (yang_keyword_get(ys)){
+    case Y_CONTAINER:
+        if (yang2cli_container_body(h, ys, 0, cb) < 0)
+            goto done;
+        break;
+    case Y_LIST:
+        if (yang2cli_list_body(h, ys, 0, cb) < 0)
+            goto done;
+        break;
+    default:
+        goto fail;
+        break;
+    }
+    retval = 1;
+ done:
+    if (vec)
+        free(vec);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
 /*! Generate CLI code for Yang statement
  *
  * @param[in]  h     Clixon handle
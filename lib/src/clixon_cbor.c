@@ -0,0 +1,685 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2,
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Binary CBOR encoding of XML trees, used as datastore format (CLICON_XMLDB_FORMAT=cbor)
+ * The XML tree is encoded as is, including namespace declarations and other attributes,
+ * so that a datastore read from CBOR is the same tree as if read from XML:
+ *   file      ::= tag(55799) element
+ *   element   ::= array(1+n) [ qname, item_1, ..., item_n ]
+ *   item      ::= element | body | attribute
+ *   body      ::= text string
+ *   attribute ::= map(1) { qname : text string }
+ *   qname     ::= text string "name" or "prefix:name"
+ * Strings are length-prefixed and not escaped, and the child count of each element is
+ * known before its children are read so that the child vector can be allocated once.
+ * Only definite lengths are used.
+ * @see RFC 8949 Concise Binary Object Representation (CBOR)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include "clixon_queue.h"
+#include "clixon_hash.h"
+#include "clixon_handle.h"
+#include "clixon_yang.h"
+#include "clixon_xml.h"
+#include "clixon_err.h"
+#include "clixon_options.h"
+#include "clixon_netconf_lib.h"
+#include "clixon_xml_nsctx.h"
+#include "clixon_xml_io.h"
+#include "clixon_cbor.h"
+#include "banned.h"
+
+/* CBOR major types, RFC 8949 Sec 3.1 */
+#define CBOR_MAJOR_TEXT  3
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP   5
+
+/* Read buffer start size */
+#define CBOR_BUFLEN      65536
+
+/* Self-described CBOR, tag 55799, RFC 8949 Sec 3.4.6. Also used as file magic */
+static const uint8_t cbor_magic[] = {0xd9, 0xd9, 0xf7};
+
+/* Encoder state
+ */
+struct cbor_enc {
+    FILE             *ce_f;
+    withdefaults_type ce_wdef;
+    int               ce_system_only;
+    uint8_t          *ce_keep;  /* Stack of keep flags, one segment per element level */
+    size_t            ce_len;
+    size_t            ce_max;
+};
+
+/* Decoder state
+ */
+struct cbor_dec {
+    const uint8_t *cd_buf;  /* Input data, not modified, may be read-only mapped */
+    size_t         cd_len;
+    size_t         cd_pos;
+    char          *cd_str;  /* Scratch buffer for NUL-terminated strings */
+    size_t         cd_strmax;
+};
+
+/*! Write bytes to file
+ *
+ * @param[in]  f    Output file
+ * @param[in]  buf  Bytes
+ * @param[in]  len  Number of bytes
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+cbor_write(FILE       *f,
+           const void *buf,
+           size_t      len)
+{
+    if (len && fwrite(buf, 1, len, f) != len){
+        clixon_err(OE_UNIX, errno, "fwrite");
+        return -1;
+    }
+    return 0;
+}
+
+/*! Write CBOR initial byte and argument in shortest form
+ *
+ * @param[in]  f     Output file
+ * @param[in]  major Major type
+ * @param[in]  val   Argument, eg length of string or number of items
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+cbor_head_encode(FILE    *f,
+                 int      major,
+                 uint64_t val)
+{
+    uint8_t buf[9];
+    size_t  len;
+    int     n;
+    int     i;
+
+    if (val < 24){
+        buf[0] = (major << 5) | val;
+        return cbor_write(f, buf, 1);
+    }
+    if (val <= 0xff){
+        buf[0] = (major << 5) | 24;
+        n = 1;
+    }
+    else if (val <= 0xffff){
+        buf[0] = (major << 5) | 25;
+        n = 2;
+    }
+    else if (val <= 0xffffffff){
+        buf[0] = (major << 5) | 26;
+        n = 4;
+    }
+    else {
+        buf[0] = (major << 5) | 27;
+        n = 8;
+    }
+    for (i = 0; i < n; i++)
+        buf[n-i] = (val >> (8*i)) & 0xff;
+    len = n + 1;
+    return cbor_write(f, buf, len);
+}
+
+/*! Write a text string, optionally on the form prefix:name
+ *
+ * @param[in]  f      Output file
+ * @param[in]  prefix Prefix or NULL
+ * @param[in]  str    String
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+static int
+cbor_text_encode(FILE       *f,
+                 const char *prefix,
+                 const char *str)
+{
+    size_t plen = prefix ? strlen(prefix) : 0;
+    size_t slen = strlen(str);
+
+    if (cbor_head_encode(f, CBOR_MAJOR_TEXT, plen ? plen + 1 + slen : slen) < 0)
+        return -1;
+    if (plen){
+        if (cbor_write(f, prefix, plen) < 0 ||
+            cbor_write(f, ":", 1) < 0)
+            return -1;
+    }
+    return cbor_write(f, str, slen);
+}
+
+/*! Check if XML node should be written, see xml2file_recurse
+ *
+ * @param[in]  ce  Encoder state
+ * @param[in]  x   XML node
+ * @retval     1   Keep it
+ * @retval     0   Skip it
+ * @retval    -1   Error
+ */
+static int
+cbor_keep(struct cbor_enc *ce,
+          cxobj           *x)
+{
+    yang_stmt *y;
+    int        exist;
+
+    switch (xml_type(x)){
+    case CX_BODY:
+        return xml_value(x) != NULL;
+    case CX_ATTR:
+        return 1;
+    case CX_ELMNT:
+        break;
+    default:
+        return 0;
+    }
+    if ((y = xml_spec(x)) == NULL)
+        return 1;
+    if (ce->ce_system_only){
+        exist = 0;
+        if (yang_extension_value(y, "system-only-config", CLIXON_LIB_NS, &exist, NULL) < 0)
+            return -1;
+        if (exist)
+            return 0;
+    }
+    return xml2output_wdef(x, ce->ce_wdef, NULL);
+}
+
+/*! Encode an XML element and its kept children recursively
+ *
+ * Keep flags of the children are computed first, since the CBOR array needs the number
+ * of items before the items.
+ * @param[in]  ce  Encoder state
+ * @param[in]  x   XML element
+ * @retval     0   OK
+ * @retval    -1   Error
+ */
+static int
+cbor_elmnt_encode(struct cbor_enc *ce,
+                  cxobj           *x)
+{
+    int      retval = -1;
+    cxobj   *xc;
+    size_t   base;
+    size_t   n;
+    size_t   i;
+    size_t   nitems = 0;
+    size_t   newmax;
+    uint8_t *keep;
+    int      ret;
+
+    base = ce->ce_len;
+    n = xml_child_nr(x);
+    if (base + n > ce->ce_max){
+        newmax = ce->ce_max ? ce->ce_max : 64;
+        while (newmax < base + n)
+            newmax *= 2;
+        if ((keep = realloc(ce->ce_keep, newmax)) == NULL){
+            clixon_err(OE_UNIX, errno, "realloc");
+            goto done;
+        }
+        ce->ce_keep = keep;
+        ce->ce_max = newmax;
+    }
+    ce->ce_len = base + n;
+    for (i = 0; i < n; i++){
+        ret = 0;
+        if ((xc = xml_child_i(x, i)) != NULL &&
+            (ret = cbor_keep(ce, xc)) < 0)
+            goto done;
+        ce->ce_keep[base + i] = ret;
+        nitems += ret;
+    }
+#ifdef OPTMEM_XML_BODY
+    if (xml_flag(x, XML_FLAG_BODY) && xml_body(x) != NULL)
+        nitems++;
+#endif
+    if (cbor_head_encode(ce->ce_f, CBOR_MAJOR_ARRAY, 1 + nitems) < 0)
+        goto done;
+    if (cbor_text_encode(ce->ce_f, xml_prefix(x), xml_name(x)) < 0)
+        goto done;
+#ifdef OPTMEM_XML_BODY
+    if (xml_flag(x, XML_FLAG_BODY) && xml_body(x) != NULL)
+        if (cbor_text_encode(ce->ce_f, NULL, xml_body(x)) < 0)
+            goto done;
+#endif
+    for (i = 0; i < n; i++){
+        if (ce->ce_keep[base + i] == 0)
+            continue;
+        xc = xml_child_i(x, i);
+        switch (xml_type(xc)){
+        case CX_ELMNT:
+            if (cbor_elmnt_encode(ce, xc) < 0)
+                goto done;
+            break;
+        case CX_BODY:
+            if (cbor_text_encode(ce->ce_f, NULL, xml_value(xc)) < 0)
+                goto done;
+            break;
+        case CX_ATTR:
+            if (cbor_head_encode(ce->ce_f, CBOR_MAJOR_MAP, 1) < 0)
+                goto done;
+            if (cbor_text_encode(ce->ce_f, xml_prefix(xc), xml_name(xc)) < 0)
+                goto done;
+            if (cbor_text_encode(ce->ce_f, NULL, xml_value(xc) ? xml_value(xc) : "") < 0)
+                goto done;
+            break;
+        default:
+            break;
+        }
+    }
+    ce->ce_len = base;
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Write an XML tree to file as CBOR
+ *
+ * @param[in]  f           Output file
+ * @param[in]  xn          XML tree, top element is included
+ * @param[in]  wdef        With-defaults parameter, see xml2output_wdef
+ * @param[in]  system_only Enable checks for system-only-config extension
+ * @retval     0           OK
+ * @retval    -1           Error
+ * @see clixon_xml2file1 for the XML variant
+ * @see clixon_cbor_parse_file for the reverse
+ */
+int
+clixon_cbor2file(FILE             *f,
+                 cxobj            *xn,
+                 withdefaults_type wdef,
+                 int               system_only)
+{
+    int             retval = -1;
+    struct cbor_enc ce = {0,};
+
+    ce.ce_f = f;
+    ce.ce_wdef = wdef;
+    ce.ce_system_only = system_only;
+    if (cbor_write(f, cbor_magic, sizeof(cbor_magic)) < 0)
+        goto done;
+    if (cbor_elmnt_encode(&ce, xn) < 0)
+        goto done;
+    retval = 0;
+ done:
+    if (ce.ce_keep)
+        free(ce.ce_keep);
+    return retval;
+}
+
+/*! Decode CBOR initial byte and argument
+ *
+ * @param[in]  cd    Decoder state
+ * @param[out] major Major type
+ * @param[out] val   Argument
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+cbor_head_decode(struct cbor_dec *cd,
+                 int             *major,
+                 uint64_t        *val)
+{
+    uint8_t  b;
+    int      ai;
+    int      n;
+    uint64_t v = 0;
+
+    if (cd->cd_pos >= cd->cd_len){
+        clixon_err(OE_XML, 0, "CBOR: unexpected end of data");
+        return -1;
+    }
+    b = cd->cd_buf[cd->cd_pos++];
+    *major = b >> 5;
+    ai = b & 0x1f;
+    if (ai < 24){
+        *val = ai;
+        return 0;
+    }
+    switch (ai){
+    case 24: n = 1; break;
+    case 25: n = 2; break;
+    case 26: n = 4; break;
+    case 27: n = 8; break;
+    default:
+        clixon_err(OE_XML, 0, "CBOR: unsupported additional information %d at offset %zu",
+                   ai, cd->cd_pos - 1);
+        return -1;
+    }
+    if (cd->cd_len - cd->cd_pos < n){
+        clixon_err(OE_XML, 0, "CBOR: unexpected end of data");
+        return -1;
+    }
+    while (n--)
+        v = (v << 8) | cd->cd_buf[cd->cd_pos++];
+    *val = v;
+    return 0;
+}
+
+/*! Decode a text string into the scratch buffer
+ *
+ * @param[in]  cd    Decoder state
+ * @param[out] str   NUL-terminated string in scratch buffer, valid until next call
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+cbor_text_decode(struct cbor_dec *cd,
+                 char           **str)
+{
+    int      major;
+    uint64_t val;
+    char    *s;
+
+    if (cbor_head_decode(cd, &major, &val) < 0)
+        return -1;
+    if (major != CBOR_MAJOR_TEXT){
+        clixon_err(OE_XML, 0, "CBOR: expected text string at offset %zu", cd->cd_pos);
+        return -1;
+    }
+    if (val > cd->cd_len - cd->cd_pos){
+        clixon_err(OE_XML, 0, "CBOR: text string exceeds data");
+        return -1;
+    }
+    if (val >= cd->cd_strmax){
+        if ((s = realloc(cd->cd_str, val + 1)) == NULL){
+            clixon_err(OE_UNIX, errno, "realloc");
+            return -1;
+        }
+        cd->cd_str = s;
+        cd->cd_strmax = val + 1;
+    }
+    memcpy(cd->cd_str, cd->cd_buf + cd->cd_pos, val);
+    cd->cd_str[val] = '\0';
+    *str = cd->cd_str;
+    cd->cd_pos += val;
+    return 0;
+}
+
+/*! Create XML element or attribute from qname in scratch buffer
+ *
+ * The qname is temporarily split at the colon
+ * @param[in]  str   NUL-terminated string in scratch buffer
+ * @param[in]  xp    XML parent
+ * @param[in]  type  CX_ELMNT or CX_ATTR
+ * @retval     x     Created XML node
+ * @retval     NULL  Error
+ */
+static cxobj *
+cbor_qname_new(char           *str,
+               cxobj          *xp,
+               enum cxobj_type type)
+{
+    cxobj *x;
+    char  *colon;
+
+    if ((colon = strchr(str, ':')) != NULL){
+        *colon = '\0';
+        if ((x = xml_new(colon + 1, xp, type)) != NULL &&
+            xml_prefix_set(x, str) < 0)
+            x = NULL;
+        *colon = ':';
+    }
+    else
+        x = xml_new(str, xp, type);
+    return x;
+}
+
+/*! Decode a CBOR element and its items recursively into an XML element
+ *
+ * @param[in]  cd    Decoder state
+ * @param[in]  xp    XML parent
+ * @retval     0     OK
+ * @retval    -1     Error
+ */
+static int
+cbor_elmnt_decode(struct cbor_dec *cd,
+                  cxobj           *xp)
+{
+    int      retval = -1;
+    int      major;
+    uint64_t n;
+    uint64_t i;
+    uint64_t val;
+    cxobj   *x;
+    cxobj   *xa;
+    char    *str;
+
+    if (cbor_head_decode(cd, &major, &n) < 0)
+        goto done;
+    /* Each item is at least one byte */
+    if (major != CBOR_MAJOR_ARRAY || n == 0 || n > cd->cd_len - cd->cd_pos){
+        clixon_err(OE_XML, 0, "CBOR: invalid element at offset %zu", cd->cd_pos);
+        goto done;
+    }
+    if (cbor_text_decode(cd, &str) < 0)
+        goto done;
+    if ((x = cbor_qname_new(str, xp, CX_ELMNT)) == NULL)
+        goto done;
+    if (n > 1 && xml_childvec_set(x, n - 1) < 0)
+        goto done;
+    for (i = 1; i < n; i++){
+        if (cd->cd_pos >= cd->cd_len){
+            clixon_err(OE_XML, 0, "CBOR: unexpected end of data");
+            goto done;
+        }
+        switch (cd->cd_buf[cd->cd_pos] >> 5){
+        case CBOR_MAJOR_ARRAY:
+            if (cbor_elmnt_decode(cd, x) < 0)
+                goto done;
+            break;
+        case CBOR_MAJOR_TEXT:
+            if (cbor_text_decode(cd, &str) < 0)
+                goto done;
+            if (xml_body_append(x, str) < 0)
+                goto done;
+            break;
+        case CBOR_MAJOR_MAP:
+            if (cbor_head_decode(cd, &major, &val) < 0)
+                goto done;
+            if (val != 1){
+                clixon_err(OE_XML, 0, "CBOR: invalid attribute at offset %zu", cd->cd_pos);
+                goto done;
+            }
+            if (cbor_text_decode(cd, &str) < 0)
+                goto done;
+            if ((xa = cbor_qname_new(str, x, CX_ATTR)) == NULL)
+                goto done;
+            if (cbor_text_decode(cd, &str) < 0)
+                goto done;
+            if (xml_value_set(xa, str) < 0)
+                goto done;
+            break;
+        default:
+            clixon_err(OE_XML, 0, "CBOR: unexpected major type %d at offset %zu",
+                       cd->cd_buf[cd->cd_pos] >> 5, cd->cd_pos);
+            goto done;
+        }
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Detect if a file is CBOR encoded by the magic self-described CBOR tag
+ *
+ * The file position is reset to the start of the file.
+ * @param[in]  fp   Input file, must be seekable
+ * @retval     1    CBOR
+ * @retval     0    Not CBOR, eg XML or an empty file
+ * @retval    -1    Error
+ */
+int
+clixon_cbor_detect(FILE *fp)
+{
+    uint8_t buf[sizeof(cbor_magic)];
+    size_t  len;
+
+    len = fread(buf, 1, sizeof(buf), fp);
+    if (ferror(fp)){
+        clixon_err(OE_UNIX, errno, "fread");
+        return -1;
+    }
+    if (fseek(fp, 0, SEEK_SET) < 0){
+        clixon_err(OE_UNIX, errno, "fseek");
+        return -1;
+    }
+    return len == sizeof(buf) && memcmp(buf, cbor_magic, sizeof(buf)) == 0;
+}
+
+/*! Decode a CBOR encoded XML tree from a memory buffer
+ *
+ * The buffer is not modified and may be a read-only memory mapping.
+ * No yang binding is made, as with YB_NONE in clixon_xml_parse_string
+ * @param[in]     buf  CBOR data including magic, or empty
+ * @param[in]     len  Length of data
+ * @param[in,out] xt   XML top, if NULL on entry it is created with name 'top'
+ * @retval        0    OK
+ * @retval       -1    Error
+ * @see clixon_cbor_parse_file
+ */
+int
+clixon_cbor_parse_buf(const uint8_t *buf,
+                      size_t         len,
+                      cxobj        **xt)
+{
+    int             retval = -1;
+    struct cbor_dec cd = {0,};
+    cxobj          *x;
+
+    if (xt == NULL){
+        clixon_err(OE_XML, EINVAL, "xt is NULL");
+        goto done;
+    }
+    if (*xt == NULL)
+        if ((*xt = xml_new("top", NULL, CX_ELMNT)) == NULL)
+            goto done;
+    if (len == 0)
+        goto ok;
+    if (len < sizeof(cbor_magic) ||
+        memcmp(buf, cbor_magic, sizeof(cbor_magic)) != 0){
+        clixon_err(OE_XML, 0, "CBOR: self-described CBOR tag expected");
+        goto done;
+    }
+    cd.cd_buf = buf;
+    cd.cd_len = len;
+    cd.cd_pos = sizeof(cbor_magic);
+    if (cbor_elmnt_decode(&cd, *xt) < 0)
+        goto done;
+    if (cd.cd_pos != cd.cd_len){
+        clixon_err(OE_XML, 0, "CBOR: trailing data at offset %zu", cd.cd_pos);
+        goto done;
+    }
+    /* Verify namespaces, as after XML parsing */
+    x = xml_child_i(*xt, xml_child_nr(*xt) - 1);
+    if (xml2ns_recurse(x) < 0)
+        goto done;
+ ok:
+    retval = 0;
+ done:
+    if (cd.cd_str)
+        free(cd.cd_str);
+    return retval;
+}
+
+/*! Read a CBOR encoded XML tree from file
+ *
+ * No yang binding is made, as with YB_NONE in clixon_xml_parse_file
+ * @param[in]     fp   Input file
+ * @param[in,out] xt   XML top, if NULL on entry it is created with name 'top'
+ * @retval        0    OK
+ * @retval       -1    Error
+ * @code
+ *  cxobj *xt = NULL;
+ *  if (clixon_cbor_parse_file(fp, &xt) < 0)
+ *    err;
+ *  xml_free(xt);
+ * @endcode
+ * @see clixon_cbor2file
+ */
+int
+clixon_cbor_parse_file(FILE   *fp,
+                       cxobj **xt)
+{
+    int      retval = -1;
+    uint8_t *buf = NULL;
+    uint8_t *b;
+    size_t   len = 0;
+    size_t   max = CBOR_BUFLEN;
+    size_t   sz;
+
+    if ((buf = malloc(max)) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    while ((sz = fread(buf + len, 1, max - len, fp)) > 0){
+        len += sz;
+        if (len == max){
+            max *= 2;
+            if ((b = realloc(buf, max)) == NULL){
+                clixon_err(OE_UNIX, errno, "realloc");
+                goto done;
+            }
+            buf = b;
+        }
+    }
+    if (ferror(fp)){
+        clixon_err(OE_UNIX, errno, "fread");
+        goto done;
+    }
+    if (clixon_cbor_parse_buf(buf, len, xt) < 0)
+        goto done;
+    retval = 0;
+ done:
+    if (buf)
+        free(buf);
+    return retval;
+}
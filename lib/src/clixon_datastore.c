@@ -87,6 +87,7 @@
 #include "clixon_datastore.h"
 #include "clixon_datastore_write.h"
 #include "clixon_datastore_read.h"
+#include "clixon_profile.h"
 #include "banned.h"
 
 /*! XML datastore including cache and and meta-data
@@ -462,6 +463,44 @@ xmldb_db2file(clixon_handle  h,
     return xmldb_db2file1(h, db, clicon_option_bool(h, "CLICON_XMLDB_MULTI"), filename);
 }
 
+/*! Translate from symbolic database name to read-only snapshot filename
+ *
+ * @param[in]   h        Clixon handle
+ * @param[in]   db       Symbolic database name, eg "running"
+ * @param[out]  filename Filename. Unallocate after use with free()
+ * @retval      0        OK
+ * @retval     -1        Error
+ * @see xmldb_snapshot_write
+ */
+int
+xmldb_db2snapshot(clixon_handle  h,
+                  const char    *db,
+                  char         **filename)
+{
+    int   retval = -1;
+    cbuf *cb = NULL;
+    char *dir;
+
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_XML, errno, "cbuf_new");
+        goto done;
+    }
+    if ((dir = clicon_xmldb_dir(h)) == NULL){
+        clixon_err(OE_XML, errno, "CLICON_XMLDB_DIR not set");
+        goto done;
+    }
+    cprintf(cb, "%s/%s.snapshot", dir, db);
+    if ((*filename = strdup4(cbuf_get(cb))) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        goto done;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
 /*! Translate from symbolic database name to sub-directory of configure sub-files, no checks
  *
  * @param[in]   h       Clixon handle
@@ -698,8 +737,10 @@ xmldb_copy_de(clixon_handle h,
     char  *from;
     char  *to;
     int    ret;
+    struct timespec ts = {0,};
 
     /* Copy in-memory cache */
+    clixon_profile_start(&ts);
     /* 1. "to" xml tree in x1 */
     from = xmldb_name_get(de1);
     to = xmldb_name_get(de2);
@@ -755,11 +796,14 @@ xmldb_copy_de(clixon_handle h,
             goto done;
     }
     de2->de_xml = x2;
+    if (clixon_profile_stop(CLIXON_PROF_DATASTORE_COPY, &ts) < 0)
+        goto done;
     /* File handling based on destination cache status:
      * FILE / FILE_INMEM: write to file. INMEM: skip file write.
      * If destination is file-only, also discard the in-mem copy afterwards.
      */
     if (xmldb_cache_status_get(de2) != XMLDB_CACHE_INMEM){
+        clixon_profile_start(&ts);
         if (xmldb_cache_status_get(de1) == XMLDB_CACHE_INMEM){
             if (xmldb_populate(h, to) < 0)
                 goto done;
@@ -768,6 +812,8 @@ xmldb_copy_de(clixon_handle h,
         }
         else if (xmldb_copy_file(h, from, to) < 0)
             goto done;
+        if (clixon_profile_stop(CLIXON_PROF_DATASTORE_WRITE, &ts) < 0)
+            goto done;
         /* FILE-only: discard in-mem cache after writing to disk */
         if (xmldb_cache_status_get(de2) == XMLDB_CACHE_FILE){
             if (de2->de_xml != NULL){
@@ -52,6 +52,8 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 /* cligen */
 #include <cligen/cligen.h>
@@ -83,6 +85,7 @@
 #include "clixon_xml_map.h"
 #include "clixon_xml_default.h"
 #include "clixon_xml_io.h"
+#include "clixon_cbor.h"
 #include "clixon_xml_nsctx.h"
 #include "clixon_datastore.h"
 #include "clixon_datastore_read.h"
@@ -101,6 +104,18 @@ struct xmldb_multi_read_arg {
     cxobj          **mr_xerr;
 };
 
+/* Frontend cache of a decoded datastore snapshot
+ * @see xmldb_snapshot_get
+ */
+struct xmldb_snapshot {
+    char           *sn_db;    /* Datastore name */
+    dev_t           sn_dev;   /* Snapshot file identity when decoded */
+    ino_t           sn_ino;
+    off_t           sn_size;
+    struct timespec sn_mtim;
+    cxobj          *sn_xt;    /* Decoded and yang-bound config tree */
+};
+
 /*! Ensure that xt only has a single sub-element and that is "config"
  *
  * @retval     0     There exists a single "config" sub-element
@@ -651,6 +666,17 @@ xmldb_readfile(clixon_handle     h,
         if (clixon_xml_parse_file(fp, YB_NONE, yspec, &x0, xerr) < 0)
             goto done;
         break;
+    case FORMAT_CBOR:
+        /* An existing XML datastore is read as XML, and is converted when written */
+        if ((ret = clixon_cbor_detect(fp)) < 0)
+            goto done;
+        if (ret == 1){
+            if (clixon_cbor_parse_file(fp, &x0) < 0)
+                goto done;
+        }
+        else if (clixon_xml_parse_file(fp, YB_NONE, yspec, &x0, xerr) < 0)
+            goto done;
+        break;
     default:
         clixon_err(OE_DB, 0, "Format %s not supported", formatstr);
         goto done;
@@ -1275,3 +1301,208 @@ xmldb_get0(clixon_handle     h,
     retval = 0;
     goto done;
 }
+
+/*! Free cached snapshot tree
+ */
+static void
+xmldb_snapshot_free(struct xmldb_snapshot *sn)
+{
+    if (sn->sn_db)
+        free(sn->sn_db);
+    if (sn->sn_xt)
+        xml_free(sn->sn_xt);
+    free(sn);
+}
+
+/*! Map and decode a snapshot file
+ *
+ * @param[in]  h    Clixon handle
+ * @param[in]  fd   Open snapshot file
+ * @param[in]  st   Snapshot file status
+ * @param[out] xtp  Decoded and yang-bound config tree, NULL if invalid
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+xmldb_snapshot_decode(clixon_handle h,
+                      int           fd,
+                      struct stat  *st,
+                      cxobj       **xtp)
+{
+    int        retval = -1;
+    void      *buf = NULL;
+    cxobj     *xt = NULL;
+    cxobj     *x;
+    cxobj     *xerr = NULL;
+    yang_stmt *yspec;
+    int        ret;
+
+    *xtp = NULL;
+    if (st->st_size > 0 &&
+        (buf = mmap(NULL, st->st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED){
+        clixon_err(OE_UNIX, errno, "mmap");
+        buf = NULL;
+        goto done;
+    }
+    if (clixon_cbor_parse_buf(buf, st->st_size, &xt) < 0)
+        goto done;
+    if ((x = xml_find_type(xt, NULL, DATASTORE_TOP_SYMBOL, CX_ELMNT)) == NULL)
+        goto ok;
+    if (xml_rm(x) < 0)
+        goto done;
+    xml_flag_set(x, XML_FLAG_TOP);
+    yspec = clicon_dbspec_yang(h);
+    if ((ret = xml_bind_yang(h, x, YB_MODULE, yspec, 0, &xerr)) < 0){
+        xml_free(x);
+        goto done;
+    }
+    if (ret == 0){
+        clixon_debug(CLIXON_DBG_DATASTORE, "snapshot not bound to yang, ignored");
+        xml_free(x);
+        goto ok;
+    }
+    *xtp = x;
+ ok:
+    retval = 0;
+ done:
+    if (buf)
+        munmap(buf, st->st_size);
+    if (xt)
+        xml_free(xt);
+    if (xerr)
+        xml_free(xerr);
+    return retval;
+}
+
+/*! Get a copy of a datastore from its read-only snapshot, without the backend
+ *
+ * The snapshot file is memory-mapped and decoded once. The decoded tree is cached
+ * in the handle until the backend publishes a new snapshot.
+ * The result is as the backend get-config with explicit defaults. No NACM is made.
+ * @param[in]  h      Clixon handle
+ * @param[in]  db     Name of database, eg "running"
+ * @param[in]  xpath  XPath filter, or NULL
+ * @param[in]  nsc    Namespace context for xpath
+ * @param[out] xret   Copy of config tree with top-level "config". Free with xml_free
+ * @retval     1      OK
+ * @retval     0      No usable snapshot, eg non-existent, not readable or invalid
+ * @retval    -1      Error
+ * @see xmldb_snapshot_write  Publish snapshot in backend
+ */
+int
+xmldb_snapshot_get(clixon_handle h,
+                   const char   *db,
+                   const char   *xpath,
+                   cvec         *nsc,
+                   cxobj       **xret)
+{
+    int                    retval = -1;
+    struct xmldb_snapshot *sn = NULL;
+    char                  *filename = NULL;
+    int                    fd = -1;
+    struct stat            st;
+    cxobj                 *xt = NULL;
+    cxobj                **xvec = NULL;
+    size_t                 xlen;
+    int                    i;
+
+    if (clicon_ptr_get(h, "xmldb-snapshot", (void**)&sn) < 0 ||
+        sn == NULL ||
+        strcmp(sn->sn_db, db) != 0){
+        if (sn){
+            xmldb_snapshot_free(sn);
+            clicon_ptr_del(h, "xmldb-snapshot");
+        }
+        if ((sn = calloc(1, sizeof(*sn))) == NULL){
+            clixon_err(OE_UNIX, errno, "calloc");
+            goto done;
+        }
+        if ((sn->sn_db = strdup(db)) == NULL){
+            clixon_err(OE_UNIX, errno, "strdup");
+            free(sn);
+            goto done;
+        }
+        if (clicon_ptr_set(h, "xmldb-snapshot", sn) < 0){
+            xmldb_snapshot_free(sn);
+            goto done;
+        }
+    }
+    if (xmldb_db2snapshot(h, db, &filename) < 0)
+        goto done;
+    if ((fd = open(filename, O_RDONLY)) < 0){
+        clixon_debug(CLIXON_DBG_DATASTORE, "open(%s): %s", filename, strerror(errno));
+        goto fail;
+    }
+    if (fstat(fd, &st) < 0){
+        clixon_err(OE_UNIX, errno, "fstat(%s)", filename);
+        goto done;
+    }
+    /* A new snapshot is renamed in place, ie has a new inode */
+    if (sn->sn_xt == NULL ||
+        sn->sn_dev != st.st_dev ||
+        sn->sn_ino != st.st_ino ||
+        sn->sn_size != st.st_size ||
+        sn->sn_mtim.tv_sec != st.st_mtim.tv_sec ||
+        sn->sn_mtim.tv_nsec != st.st_mtim.tv_nsec){
+        if (sn->sn_xt){
+            xml_free(sn->sn_xt);
+            sn->sn_xt = NULL;
+        }
+        if (xmldb_snapshot_decode(h, fd, &st, &sn->sn_xt) < 0)
+            goto done;
+        if (sn->sn_xt == NULL)
+            goto fail;
+        sn->sn_dev = st.st_dev;
+        sn->sn_ino = st.st_ino;
+        sn->sn_size = st.st_size;
+        sn->sn_mtim = st.st_mtim;
+    }
+    if ((xt = xml_dup(sn->sn_xt)) == NULL)
+        goto done;
+    if (xpath && strlen(xpath)){
+        if (xpath_vec(xt, nsc, "%s", &xvec, &xlen, xpath) < 0)
+            goto done;
+        for (i=0; i<xlen; i++)
+            xml_flag_set(xvec[i], XML_FLAG_MARK);
+        if (!xml_flag(xt, XML_FLAG_MARK))
+            if (xml_tree_prune_flagged_sub(xt, XML_FLAG_MARK, 1, NULL) < 0)
+                goto done;
+        if (xml_apply(xt, CX_ELMNT, (xml_applyfn_t*)xml_flag_reset, (void*)XML_FLAG_MARK) < 0)
+            goto done;
+    }
+    if (xml_default_nopresence(xt, 2, 0) < 0)
+        goto done;
+    *xret = xt;
+    xt = NULL;
+    retval = 1;
+ done:
+    if (xvec)
+        free(xvec);
+    if (xt)
+        xml_free(xt);
+    if (fd != -1)
+        close(fd);
+    if (filename)
+        free(filename);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Free frontend snapshot cache
+ *
+ * @param[in]  h    Clixon handle
+ * @retval     0    OK
+ */
+int
+xmldb_snapshot_exit(clixon_handle h)
+{
+    struct xmldb_snapshot *sn = NULL;
+
+    if (clicon_ptr_get(h, "xmldb-snapshot", (void**)&sn) == 0 && sn != NULL){
+        xmldb_snapshot_free(sn);
+        clicon_ptr_del(h, "xmldb-snapshot");
+    }
+    return 0;
+}
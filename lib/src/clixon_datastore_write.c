@@ -81,6 +81,7 @@
 #include "clixon_yang_schema_mount.h"
 #include "clixon_xml_nsctx.h"
 #include "clixon_xml_io.h"
+#include "clixon_cbor.h"
 #include "clixon_xml_bind.h"
 #include "clixon_xml_default.h"
 #include "clixon_xml_map.h"
@@ -1384,63 +1385,31 @@ xml_mark_cache_dirty(cxobj *x,
     return 2;
 }
 
-/*! Modify database given an xml tree and an operation
+/*! Get datastore cache tree to modify, read from file or copy from running if needed
  *
- * @param[in]  h      CLICON handle
+ * @param[in]  h      Clixon handle
  * @param[in]  db     running or candidate
- * @param[in]  op     Top-level operation, can be superceded by other op in tree
- * @param[in]  x1     xml-tree. Top-level symbol is dummy
- * @param[in]  username User name for nacm
- * @param[out] cbret  Initialized cligen buffer. On exit contains XML if retval == 0
+ * @param[in]  yspec  Yang spec
+ * @param[out] dep    Datastore element
+ * @param[out] x0p    Cache tree, top-level symbol is "config"
+ * @param[out] xerr   XML error if retval is 0
  * @retval     1      OK
- * @retval     0      Failed, cbret contains error xml message
+ * @retval     0      Failed, xerr set
  * @retval    -1      Error
- * The xml may contain the "operation" attribute which defines the operation.
- * @code
- *   cxobj     *xt;
- *   cxobj     *xret = NULL;
- *   if (clixon_xml_parse_string("<a>17</a>", YB_NONE, NULL, &xt, NULL) < 0)
- *     err;
- *   if ((ret = xmldb_put(h, "running", OP_MERGE, xt, username, cbret)) < 0)
- *     err;
- *   if (ret==0)
- *     cbret contains netconf error message
- * @endcode
- * @note if xret is non-null, it may contain error message
- * @note x1 may change as a side-effect (eg operation attributes are stripped)
  */
-int
-xmldb_put(clixon_handle       h,
-          const char         *db,
-          enum operation_type op,
-          cxobj              *x1,
-          const char         *username,
-          cbuf               *cbret)
+static int
+xmldb_put_cache(clixon_handle h,
+                const char   *db,
+                yang_stmt    *yspec,
+                db_elmnt    **dep,
+                cxobj       **x0p,
+                cxobj       **xerr)
 {
-    int         retval = -1;
-    yang_stmt  *yspec;
-    cxobj      *x0 = NULL;
-    db_elmnt   *de = NULL;
-    cxobj      *xnacm = NULL;
-    int         permit = 0; /* nacm permit all */
-    cvec       *nsc = NULL; /* nacm namespace context */
-    cxobj      *xerr = NULL;
-    int         ret;
+    int       retval = -1;
+    cxobj    *x0 = NULL;
+    db_elmnt *de = NULL;
+    int       ret;
 
-    clixon_debug(CLIXON_DBG_DATASTORE|CLIXON_DBG_DETAIL, "db %s", db);
-    if (cbret == NULL){
-        clixon_err(OE_XML, EINVAL, "cbret is NULL");
-        goto done;
-    }
-    if ((yspec = clicon_dbspec_yang(h)) == NULL){
-        clixon_err(OE_YANG, ENOENT, "No yang spec");
-        goto done;
-    }
-    if (x1 && strcmp(xml_name(x1), NETCONF_INPUT_CONFIG) != 0){
-        clixon_err(OE_XML, 0, "Top-level symbol of modification tree is %s, expected \"%s\"",
-                   xml_name(x1), NETCONF_INPUT_CONFIG);
-        goto done;
-    }
     if ((de = xmldb_find(h, db)) == NULL){
         if ((de = xmldb_new(h, db)) == NULL)
             goto done;
@@ -1461,13 +1430,13 @@ xmldb_put(clixon_handle       h,
         else {
             /* xml looks like: <top><config><x>... where "x" is a top-level symbol
              * in a module */
-            if ((ret = xmldb_get_cache(h, db, &x0, &xerr)) < 0)
+            if ((ret = xmldb_get_cache(h, db, &x0, xerr)) < 0)
                 goto done;
             if (ret == 0)
                 goto fail;
         }
         /* Add default global values (see also xmldb_populate) */
-        if (xml_global_defaults(h, x0, nsc, "/", yspec, 0) < 0)
+        if (xml_global_defaults(h, x0, NULL, "/", yspec, 0) < 0)
             goto done;
         /* Add default recursive values */
         if (xml_default_recurse(x0, 0, 0) < 0)
@@ -1486,21 +1455,36 @@ xmldb_put(clixon_handle       h,
         clixon_err(OE_XML, 0, "Top-level symbol is not flagged with XML_FLAG_TOP");
         goto done;
     }
+    *dep = de;
+    *x0p = x0;
+    retval = 1;
+ done:
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Complete a modified datastore cache tree and write it to file
+ *
+ * Prune, mark changes, add defaults and write to file according to cache status
+ * @param[in]  h      Clixon handle
+ * @param[in]  db     running or candidate
+ * @param[in]  de     Datastore element
+ * @param[in]  x0     Modified cache tree
+ * @param[in]  yspec  Yang spec
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+static int
+xmldb_put_finish(clixon_handle h,
+                 const char   *db,
+                 db_elmnt     *de,
+                 cxobj        *x0,
+                 yang_stmt    *yspec)
+{
+    int retval = -1;
 
-    /* Here x0 looks like: <config>...</config> */
-    xnacm = clicon_nacm_cache(h);
-    permit = (xnacm==NULL);
-    /* Here assume if xnacm is set and !permit do NACM */
-    clicon_data_del(h, "objectexisted");
-    /*
-     * Modify base tree x with modification x1. This is where the
-     * new tree is made.
-     */
-    if ((ret = text_modify_top(h, x0, x1, yspec, op, username, xnacm, permit, cbret)) < 0)
-        goto done;
-    /* If xml return - ie netconf error xml tree, then stop and return OK */
-    if (ret == 0)
-        goto fail;
     /* Remove NONE nodes if all subs recursively are also NONE */
     if (xml_tree_prune_flagged_sub(x0, XML_FLAG_NONE, 0, NULL) <0)
         goto done;
@@ -1516,7 +1500,7 @@ xmldb_put(clixon_handle       h,
         goto done;
     /* Complete defaults
      */
-    if (xml_global_defaults(h, x0, nsc, "/", yspec, 0) < 0)
+    if (xml_global_defaults(h, x0, NULL, "/", yspec, 0) < 0)
         goto done;
     /* Add default recursive values */
     if (xml_default_recurse(x0, 0, XML_FLAG_ADD|XML_FLAG_DEL) < 0)
@@ -1553,13 +1537,181 @@ xmldb_put(clixon_handle       h,
                       (void*)(XML_FLAG_NONE|XML_FLAG_ADD|XML_FLAG_DEL|XML_FLAG_CHANGE)) < 0)
             goto done;
     }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Modify database given an xml tree and an operation
+ *
+ * @param[in]  h      CLICON handle
+ * @param[in]  db     running or candidate
+ * @param[in]  op     Top-level operation, can be superceded by other op in tree
+ * @param[in]  x1     xml-tree. Top-level symbol is dummy
+ * @param[in]  username User name for nacm
+ * @param[out] cbret  Initialized cligen buffer. On exit contains XML if retval == 0
+ * @retval     1      OK
+ * @retval     0      Failed, cbret contains error xml message
+ * @retval    -1      Error
+ * The xml may contain the "operation" attribute which defines the operation.
+ * @code
+ *   cxobj     *xt;
+ *   cxobj     *xret = NULL;
+ *   if (clixon_xml_parse_string("<a>17</a>", YB_NONE, NULL, &xt, NULL) < 0)
+ *     err;
+ *   if ((ret = xmldb_put(h, "running", OP_MERGE, xt, username, cbret)) < 0)
+ *     err;
+ *   if (ret==0)
+ *     cbret contains netconf error message
+ * @endcode
+ * @note if xret is non-null, it may contain error message
+ * @note x1 may change as a side-effect (eg operation attributes are stripped)
+ * @see xmldb_put_batch  for several modifications in one pass
+ */
+int
+xmldb_put(clixon_handle       h,
+          const char         *db,
+          enum operation_type op,
+          cxobj              *x1,
+          const char         *username,
+          cbuf               *cbret)
+{
+    int         retval = -1;
+    yang_stmt  *yspec;
+    cxobj      *x0 = NULL;
+    db_elmnt   *de = NULL;
+    cxobj      *xnacm = NULL;
+    int         permit = 0; /* nacm permit all */
+    cxobj      *xerr = NULL;
+    int         ret;
+
+    clixon_debug(CLIXON_DBG_DATASTORE|CLIXON_DBG_DETAIL, "db %s", db);
+    if (cbret == NULL){
+        clixon_err(OE_XML, EINVAL, "cbret is NULL");
+        goto done;
+    }
+    if ((yspec = clicon_dbspec_yang(h)) == NULL){
+        clixon_err(OE_YANG, ENOENT, "No yang spec");
+        goto done;
+    }
+    if (x1 && strcmp(xml_name(x1), NETCONF_INPUT_CONFIG) != 0){
+        clixon_err(OE_XML, 0, "Top-level symbol of modification tree is %s, expected \"%s\"",
+                   xml_name(x1), NETCONF_INPUT_CONFIG);
+        goto done;
+    }
+    if ((ret = xmldb_put_cache(h, db, yspec, &de, &x0, &xerr)) < 0)
+        goto done;
+    if (ret == 0)
+        goto fail;
+    /* Here x0 looks like: <config>...</config> */
+    xnacm = clicon_nacm_cache(h);
+    permit = (xnacm==NULL);
+    /* Here assume if xnacm is set and !permit do NACM */
+    clicon_data_del(h, "objectexisted");
+    /*
+     * Modify base tree x with modification x1. This is where the
+     * new tree is made.
+     */
+    if ((ret = text_modify_top(h, x0, x1, yspec, op, username, xnacm, permit, cbret)) < 0)
+        goto done;
+    /* If xml return - ie netconf error xml tree, then stop and return OK */
+    if (ret == 0)
+        goto fail;
+    if (xmldb_put_finish(h, db, de, x0, yspec) < 0)
+        goto done;
+    retval = 1;
+ done:
+    clixon_debug(CLIXON_DBG_DATASTORE | CLIXON_DBG_DETAIL, "retval:%d", retval);
+    if (xerr)
+        xml_free(xerr);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Modify database with several xml trees and operations in one pass
+ *
+ * Each modification is applied as with xmldb_put, but the datastore is fetched, the
+ * NACM rules are looked up, defaults are added and the datastore is written to
+ * file only once for all modifications.
+ * Modifications are independent: a failed modification does not stop the others.
+ * @param[in]  h        Clixon handle
+ * @param[in]  db       running or candidate
+ * @param[in]  opvec    Top-level operation per modification
+ * @param[in]  xvec     XML modification trees, top-level symbol is "config"
+ * @param[in]  xlen     Number of modifications
+ * @param[in]  username User name for nacm
+ * @param[out] cbvec    Initialized cbufs, one per modification. Contains XML error if
+ *                      modification failed, is empty if applied
+ * @retval     1        OK, see cbvec for the result of each modification
+ * @retval     0        Failed to get datastore, cbvec[0] contains error xml message
+ * @retval    -1        Error
+ * @note if a modification fails midway, parts of it may already be applied, as with xmldb_put
+ * @see xmldb_put
+ */
+int
+xmldb_put_batch(clixon_handle        h,
+                const char          *db,
+                enum operation_type *opvec,
+                cxobj              **xvec,
+                int                  xlen,
+                const char          *username,
+                cbuf               **cbvec)
+{
+    int        retval = -1;
+    yang_stmt *yspec;
+    cxobj     *x0 = NULL;
+    db_elmnt  *de = NULL;
+    cxobj     *xnacm = NULL;
+    int        permit = 0;
+    cxobj     *xerr = NULL;
+    int        applied = 0;
+    int        i;
+    int        ret;
+
+    clixon_debug(CLIXON_DBG_DATASTORE|CLIXON_DBG_DETAIL, "db %s len %d", db, xlen);
+    if (xlen == 0)
+        goto ok;
+    if ((yspec = clicon_dbspec_yang(h)) == NULL){
+        clixon_err(OE_YANG, ENOENT, "No yang spec");
+        goto done;
+    }
+    for (i=0; i<xlen; i++){
+        if (cbvec[i] == NULL){
+            clixon_err(OE_XML, EINVAL, "cbret is NULL");
+            goto done;
+        }
+        if (strcmp(xml_name(xvec[i]), NETCONF_INPUT_CONFIG) != 0){
+            clixon_err(OE_XML, 0, "Top-level symbol of modification tree is %s, expected \"%s\"",
+                       xml_name(xvec[i]), NETCONF_INPUT_CONFIG);
+            goto done;
+        }
+    }
+    if ((ret = xmldb_put_cache(h, db, yspec, &de, &x0, &xerr)) < 0)
+        goto done;
+    if (ret == 0){
+        if (clixon_xml2cbuf1(cbvec[0], xerr, 0, 0, NULL, -1, 0, 0, WITHDEFAULTS_REPORT_ALL) < 0)
+            goto done;
+        goto fail;
+    }
+    xnacm = clicon_nacm_cache(h);
+    permit = (xnacm==NULL);
+    for (i=0; i<xlen; i++){
+        clicon_data_del(h, "objectexisted");
+        if ((ret = text_modify_top(h, x0, xvec[i], yspec, opvec[i], username, xnacm, permit, cbvec[i])) < 0)
+            goto done;
+        if (ret == 1)
+            applied++;
+    }
+    if (applied && xmldb_put_finish(h, db, de, x0, yspec) < 0)
+        goto done;
+ ok:
     retval = 1;
  done:
     clixon_debug(CLIXON_DBG_DATASTORE | CLIXON_DBG_DETAIL, "retval:%d", retval);
     if (xerr)
         xml_free(xerr);
-    if (nsc)
-        xml_nsctx_free(nsc);
     return retval;
  fail:
     retval = 0;
@@ -1712,6 +1864,15 @@ xmldb_dump(clixon_handle     h,
                              clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")) < 0)
             goto done;
         break;
+    case FORMAT_CBOR:
+        if (multi){
+            clixon_err(OE_CFG, errno, "CBOR+multi not supported");
+            goto done;
+        }
+        if (clixon_cbor2file(f, xt, wdef,
+                             clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")) < 0)
+            goto done;
+        break;
     default:
         clixon_err(OE_XML, 0, "Format %s not supported", format_int2str(format));
         goto done;
@@ -1730,6 +1891,10 @@ xmldb_dump(clixon_handle     h,
 /*! Given datastore, get cache and format, set wdef, add modstate and print to multiple files
  *
  * Also add mod-state if applicable
+ * The datastore is written to a temporary file which is renamed on success, so that an
+ * error while streaming the output does not leave a partial datastore.
+ * If the temporary file cannot be created, eg the directory is not writable after dropping
+ * privileges, the datastore is written in place.
  * @param[in]  h   Clixon handle
  * @param[in]  db  Name of database to search in (filename including dir path
  * @retval     0   OK
@@ -1748,6 +1913,9 @@ xmldb_write_cache2file(clixon_handle h,
     int               multi;
     FILE             *f = NULL;
     char             *dbfile = NULL;
+    cbuf             *cb = NULL;
+    char             *tmpfile = NULL;
+    struct stat       st;
     db_elmnt         *de;
     int               ret;
 
@@ -1767,17 +1935,148 @@ xmldb_write_cache2file(clixon_handle h,
     }
     if (xmldb_db2file(h, db, &dbfile) < 0)
         goto done;
-    if ((f = fopen(dbfile, "w")) == NULL){
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_XML, errno, "cbuf_new");
+        goto done;
+    }
+    cprintf(cb, "%s.tmp", dbfile);
+    if ((f = fopen(cbuf_get(cb), "w")) != NULL){
+        tmpfile = cbuf_get(cb);
+        /* Keep mode of existing datastore */
+        if (stat(dbfile, &st) == 0 && fchmod(fileno(f), st.st_mode & 07777) < 0){
+            clixon_err(OE_UNIX, errno, "fchmod(%s)", tmpfile);
+            goto done;
+        }
+    }
+    else if ((f = fopen(dbfile, "w")) == NULL){
         clixon_err(OE_CFG, errno, "fopen(%s)", dbfile);
         goto done;
     }
     if (xmldb_dump(h, f, xt, format, pretty, wdef, multi, db) < 0)
         goto done;
+    ret = fclose(f);
+    f = NULL;
+    if (ret != 0){
+        clixon_err(OE_UNIX, errno, "fclose(%s)", tmpfile?tmpfile:dbfile);
+        goto done;
+    }
+    if (tmpfile && rename(tmpfile, dbfile) < 0){
+        clixon_err(OE_UNIX, errno, "rename(%s)", dbfile);
+        goto done;
+    }
     retval = 0;
  done:
+    if (f)
+        fclose(f);
+    if (retval < 0 && tmpfile)
+        unlink(tmpfile);
+    if (cb)
+        cbuf_free(cb);
     if (dbfile)
         free(dbfile);
-    if (f)
+    return retval;
+}
+
+/*! Publish a read-only CBOR snapshot of a datastore for frontends
+ *
+ * The snapshot is written to a temporary file which is then renamed, so that
+ * readers always see a complete snapshot.
+ * On error, any previous snapshot is removed so that readers do not see stale data.
+ * Default values are not written (explicit), neither is module-state.
+ * @param[in]  h   Clixon handle
+ * @param[in]  db  Name of database, eg "running"
+ * @retval     0   OK
+ * @retval    -1   Error
+ * @see xmldb_snapshot_get  Read snapshot in frontend
+ * @see CLICON_XMLDB_SNAPSHOT
+ */
+int
+xmldb_snapshot_write(clixon_handle h,
+                     const char   *db)
+{
+    int    retval = -1;
+    cxobj    *xt = NULL;
+    db_elmnt *de = NULL;
+    char     *filename = NULL;
+    cbuf     *cb = NULL;
+    FILE     *f = NULL;
+    int       ret;
+
+    if ((ret = xmldb_get_cache(h, db, &xt, NULL)) < 0)
+        goto done;
+    if (ret == 0){
+        clixon_err(OE_XML, 0, "Error when reading cache");
+        goto done;
+    }
+    de = xmldb_find(h, db);
+    if (xmldb_db2snapshot(h, db, &filename) < 0)
+        goto done;
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_XML, errno, "cbuf_new");
+        goto done;
+    }
+    cprintf(cb, "%s.tmp", filename);
+    if ((f = fopen(cbuf_get(cb), "w")) == NULL){
+        clixon_err(OE_CFG, errno, "fopen(%s)", cbuf_get(cb));
+        goto done;
+    }
+    if (clixon_cbor2file(f, xt, WITHDEFAULTS_EXPLICIT,
+                         clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG")) < 0)
+        goto done;
+    ret = fclose(f);
+    f = NULL;
+    if (ret != 0){
+        clixon_err(OE_UNIX, errno, "fclose(%s)", cbuf_get(cb));
+        goto done;
+    }
+    if (rename(cbuf_get(cb), filename) < 0){
+        clixon_err(OE_UNIX, errno, "rename(%s)", filename);
+        goto done;
+    }
+    retval = 0;
+ done:
+    if (f){
         fclose(f);
+        unlink(cbuf_get(cb));
+    }
+    if (cb)
+        cbuf_free(cb);
+    if (filename){
+        if (retval < 0)
+            unlink(filename);
+        free(filename);
+    }
+    /* FILE datastore: xt was freshly loaded and detached from cache */
+    if (xt && de && xmldb_cache_status_get(de) == XMLDB_CACHE_FILE)
+        xml_free(xt);
+    return retval;
+}
+
+/*! Remove read-only snapshot of a datastore, eg when the backend starts or exits
+ *
+ * Frontends then read the datastore from the backend instead of a stale snapshot
+ * @param[in]  h   Clixon handle
+ * @param[in]  db  Name of database, eg "running"
+ * @retval     0   OK, also if there is no snapshot
+ * @retval    -1   Error
+ * @see xmldb_snapshot_write
+ */
+int
+xmldb_snapshot_delete(clixon_handle h,
+                      const char   *db)
+{
+    int   retval = -1;
+    char *filename = NULL;
+
+    if (xmldb_db2snapshot(h, db, &filename) < 0)
+        goto done;
+    if (unlink(filename) < 0 && errno != ENOENT){
+        clixon_err(OE_UNIX, errno, "unlink(%s)", filename);
+        goto done;
+    }
+    retval = 0;
+ done:
+    if (filename)
+        free(filename);
     return retval;
 }
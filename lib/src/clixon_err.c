@@ -109,14 +109,23 @@ static clixon_handle _err_clixon_h = NULL;
 /* Internal global list of category callbacks */
 static clixon_err_cats *_err_cat_list = NULL;
 
+/* Error state is thread-local if backend plugin callbacks may run in worker threads
+ * @see plugin_transaction_parallel
+ */
+#ifdef HAVE_LIBPTHREAD
+#define ERR_THREAD_LOCAL __thread
+#else
+#define ERR_THREAD_LOCAL
+#endif
+
 /* See enum clixon_err XXX: hide this and change to err_category */
-static int  _err_category         = 0;
+static ERR_THREAD_LOCAL int  _err_category         = 0;
 
 /* Corresponds to errno.h XXX: change to errno */
-static int  _err_subnr      = 0;
+static ERR_THREAD_LOCAL int  _err_subnr      = 0;
 
 /* Clixon error reason */
-static cbuf *_err_reason = NULL;
+static ERR_THREAD_LOCAL cbuf *_err_reason = NULL;
 
 /*
  * Error descriptions. Must stop with NULL element.
@@ -571,6 +580,24 @@ clixon_err_cat_reg(enum clixon_err   category,
     return 0;
 }
 
+/*! Free error state of a worker thread before it exits
+ *
+ * The error state is thread-local, call this in a thread other than the main thread
+ * after its error state has been saved with clixon_err_save
+ * @see clixon_err_exit  for the main thread
+ */
+int
+clixon_err_thread_exit(void)
+{
+    _err_category = 0;
+    _err_subnr = 0;
+    if (_err_reason){
+        cbuf_free(_err_reason);
+        _err_reason = NULL;
+    }
+    return 0;
+}
+
 int
 clixon_err_exit(void)
 {
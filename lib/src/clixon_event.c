@@ -70,6 +70,7 @@
 #include "clixon_options.h"
 #include "clixon_event_select.h"
 #include "clixon_event.h"
+#include "clixon_profile.h"
 #include "banned.h"
 
 /*
@@ -681,6 +682,7 @@ clixon_event_loop(clixon_handle h)
             e = _ee_timers;
             _ee_timers = _ee_timers->e_next;
             clixon_debug(CLIXON_DBG_EVENT | CLIXON_DBG_DETAIL, "timeout: %s", e->e_descr);
+            clixon_profile_lag(&e->e_time);
             if ((*e->e_fn)(0, e->e_arg) < 0) {
                 free(e);
                 goto done;
@@ -69,6 +69,7 @@
 #include "clixon_options.h"
 #include "clixon_event.h"
 #include "clixon_event_select.h"
+#include "clixon_profile.h"
 #include "banned.h"
 
 /*
@@ -423,6 +424,7 @@ clixon_event_select_loop(clixon_handle h)
             e = ee_timers;
             ee_timers = ee_timers->e_next;
             clixon_debug(CLIXON_DBG_EVENT | CLIXON_DBG_DETAIL, "timeout: %s", e->e_string);
+            clixon_profile_lag(&e->e_time);
             if ((*e->e_fn)(0, e->e_arg) < 0){
                 free(e);
                 goto err;
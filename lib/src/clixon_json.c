@@ -91,6 +91,9 @@
 /* Name of xml top object created by parse functions */
 #define JSON_TOP_SYMBOL "top"
 
+/* Flush json output buffer to file when it exceeds this size */
+#define JSON_FLUSH_LEN 65536
+
 enum array_element_type{
     NO_ARRAY=0,
     FIRST_ARRAY,  /* [a, */
@@ -100,6 +103,12 @@ enum array_element_type{
     BODY_ARRAY
 };
 
+/* Output sink for streaming json to file, instead of building the whole document */
+typedef struct {
+    FILE             *js_f;   /* File to print to */
+    clicon_output_cb *js_fn;  /* File print function */
+} json_sink;
+
 enum childtype{
     NULL_CHILD=0, /* eg <a/> no children. Translated to null if in
                    * array or leaf terminal, and to {} if proper object, ie container.
@@ -793,6 +802,23 @@ xml2json_encode_attr(cxobj     *xa,
     return retval;
 }
 
+/*! Flush json output buffer to sink if it exceeds a length
+ *
+ * @param[in]  cb    Cligen buffer
+ * @param[in]  sink  Output sink or NULL, in which case the whole document is kept in cb
+ * @param[in]  len   Flush if cb is at least this long
+ */
+static void
+json_sink_flush(cbuf      *cb,
+                json_sink *sink,
+                size_t     len)
+{
+    if (sink && cbuf_len(cb) > 0 && cbuf_len(cb) >= len){
+        (*sink->js_fn)(sink->js_f, "%s", cbuf_get(cb));
+        cbuf_reset(cb);
+    }
+}
+
 /*! Do the actual work of translating XML to JSON
  *
  * @param[out]  cb        Cligen text buffer containing json on exit
@@ -804,6 +830,7 @@ xml2json_encode_attr(cxobj     *xa,
  * @param[in]   system_only Enable checks for system-only-config extension
  * @param[in]   modname0
  * @param[out]  metacbp   Meta encoding of attribute
+ * @param[in]   sink      If set, flush cb to sink when large
  * @retval      0         OK
  * @retval     -1         Error
  *
@@ -844,7 +871,8 @@ xml2json1_cbuf(cbuf                   *cb,
                int                     flat,
                int                     system_only,
                char                   *modname0,
-               cbuf                   *metacbp)
+               cbuf                   *metacbp,
+               json_sink              *sink)
 {
     int              retval = -1;
     int              i;
@@ -985,12 +1013,13 @@ xml2json1_cbuf(cbuf                   *cb,
                                xc,
                                xc_arraytype,
                                level+1, pretty, 0, system_only, modname0,
-                               metacbc) < 0)
+                               metacbc, sink) < 0)
                 goto done;
             if (commas > 0) {
                 cprintf(cb, ",%s", pretty?"\n":"");
                 --commas;
             }
+            json_sink_flush(cb, sink, JSON_FLUSH_LEN);
         }
     }
 #ifdef OPTMEM_XML_BODY
@@ -1076,6 +1105,7 @@ xml2json1_cbuf(cbuf                   *cb,
  * @param[in]     pretty      Set if output is pretty-printed
  * @param[in]     autocliext  How to handle autocli extensions: 0: ignore 1: follow
  * @param[in]     system_only Enable checks for system-only-config extension
+ * @param[in]     sink        If set, flush cb to sink when large
  * @retval        0           OK
  * @retval       -1           Error
  *
@@ -1083,11 +1113,12 @@ xml2json1_cbuf(cbuf                   *cb,
  * @see xml2json_cbuf_vec   Top symbol is list
  */
 static int
-xml2json_cbuf1(cbuf  *cb,
-               cxobj *x,
-               int    pretty,
-               int    autocliext,
-               int    system_only)
+xml2json_cbuf1(cbuf      *cb,
+               cxobj     *x,
+               int        pretty,
+               int        autocliext,
+               int        system_only,
+               json_sink *sink)
 {
     int                     retval = 1;
     int                     level = 0;
@@ -1125,7 +1156,8 @@ xml2json_cbuf1(cbuf  *cb,
                        0,
                        system_only,
                        NULL, /* ancestor modname / namespace */
-                       NULL) < 0)
+                       NULL,
+                       sink) < 0)
         goto done;
     cprintf(cb, "%s%*s}%s",
             pretty?"\n":"",
@@ -1137,33 +1169,27 @@ xml2json_cbuf1(cbuf  *cb,
     return retval;
 }
 
-/*! Translate an XML tree to JSON in a CLIgen buffer skip top-level object
+/*! Translate an XML tree to JSON in a CLIgen buffer, optionally flushed to a sink
  *
- * XML-style namespace notation in tree, but RFC7951 in output assume yang
- * populated 
  * @param[in,out] cb          Cligen buffer to write to
  * @param[in]     xt          Top-level xml object
  * @param[in]     pretty      Set if output is pretty-printed
  * @param[in]     skiptop     0: Include top object 1: Skip top-object, only children,
  * @param[in]     autocliext  How to handle autocli extensions: 0: ignore 1: follow
  * @param[in]     system_only Enable checks for system-only-config extension
+ * @param[in]     sink        If set, flush cb to sink when large, cb may contain a tail on exit
  * @retval        0           OK
  * @retval       -1           Error
- * @code
- *   cbuf *cb = cbuf_new();
- *   if (xml2json_cbuf(cb, xn, 0, 0, 0) < 0)
- *     goto err;
- *   cbuf_free(cb);
- * @endcode
- * @see xml2json_cbuf where the top level object is included
+ * @see clixon_json2cbuf
  */
-int
-clixon_json2cbuf(cbuf  *cb,
-                 cxobj *xt,
-                 int    pretty,
-                 int    skiptop,
-                 int    autocliext,
-                 int    system_only)
+static int
+json2cbuf_sink(cbuf      *cb,
+               cxobj     *xt,
+               int        pretty,
+               int        skiptop,
+               int        autocliext,
+               int        system_only,
+               json_sink *sink)
 {
     int    retval = -1;
     cxobj *xc;
@@ -1176,12 +1202,12 @@ clixon_json2cbuf(cbuf  *cb,
         while ((xc = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL) {
             if (i++)
                 cprintf(cb, ",");
-            if (xml2json_cbuf1(cb, xc, pretty, autocliext, system_only) < 0)
+            if (xml2json_cbuf1(cb, xc, pretty, autocliext, system_only, sink) < 0)
                 goto done;
         }
     }
     else {
-        if (xml2json_cbuf1(cb, xt, pretty, autocliext, system_only) < 0)
+        if (xml2json_cbuf1(cb, xt, pretty, autocliext, system_only, sink) < 0)
             goto done;
     }
     retval = 0;
@@ -1189,27 +1215,56 @@ clixon_json2cbuf(cbuf  *cb,
     return retval;
 }
 
-/*! Translate a vector of xml objects to JSON Cligen buffer.
+/*! Translate an XML tree to JSON in a CLIgen buffer skip top-level object
+ *
+ * XML-style namespace notation in tree, but RFC7951 in output assume yang
+ * populated 
+ * @param[in,out] cb          Cligen buffer to write to
+ * @param[in]     xt          Top-level xml object
+ * @param[in]     pretty      Set if output is pretty-printed
+ * @param[in]     skiptop     0: Include top object 1: Skip top-object, only children,
+ * @param[in]     autocliext  How to handle autocli extensions: 0: ignore 1: follow
+ * @param[in]     system_only Enable checks for system-only-config extension
+ * @retval        0           OK
+ * @retval       -1           Error
+ * @code
+ *   cbuf *cb = cbuf_new();
+ *   if (xml2json_cbuf(cb, xn, 0, 0, 0) < 0)
+ *     goto err;
+ *   cbuf_free(cb);
+ * @endcode
+ * @see xml2json_cbuf where the top level object is included
+ */
+int
+clixon_json2cbuf(cbuf  *cb,
+                 cxobj *xt,
+                 int    pretty,
+                 int    skiptop,
+                 int    autocliext,
+                 int    system_only)
+{
+    return json2cbuf_sink(cb, xt, pretty, skiptop, autocliext, system_only, NULL);
+}
+
+/*! Translate a vector of xml objects to JSON Cligen buffer, optionally flushed to a sink
  *
- * This is done by adding a top pseudo-object, and add the vector as subs,
- * and then not printing the top pseudo-object using the 'flat' option.
  * @param[out] cb     Cligen buffer to write to
  * @param[in]  vec    Vector of xml objecst
  * @param[in]  veclen Length of vector
  * @param[in]  pretty Set if output is pretty-printed (2 for debug)
  * @param[in]  skiptop 0: Include top object 1: Skip top-object, only children,
+ * @param[in]  sink   If set, flush cb to sink when large, cb may contain a tail on exit
  * @retval     0      OK
  * @retval    -1      Error
- * @note This only works if the vector is uniform, ie same object name.
- * Example: <b/><c/> --> <a><b/><c/></a> --> {"b" : null,"c" : null}
- * @see clixon_json2cbuf
+ * @see xml2json_cbuf_vec
  */
-int
-xml2json_cbuf_vec(cbuf      *cb,
-                  cxobj    **vec,
-                  size_t     veclen,
-                  int        pretty,
-                  int        skiptop)
+static int
+json2cbuf_vec_sink(cbuf      *cb,
+                   cxobj    **vec,
+                   size_t     veclen,
+                   int        pretty,
+                   int        skiptop,
+                   json_sink *sink)
 {
     int    retval = -1;
     int    level = 0;
@@ -1257,7 +1312,7 @@ xml2json_cbuf_vec(cbuf      *cb,
                        NO_ARRAY,
                        level,
                        pretty,
-                       1, 0, NULL, NULL) < 0)
+                       1, 0, NULL, NULL, sink) < 0)
         goto done;
 
     if (0){
@@ -1275,6 +1330,31 @@ xml2json_cbuf_vec(cbuf      *cb,
     return retval;
 }
 
+/*! Translate a vector of xml objects to JSON Cligen buffer.
+ *
+ * This is done by adding a top pseudo-object, and add the vector as subs,
+ * and then not printing the top pseudo-object using the 'flat' option.
+ * @param[out] cb     Cligen buffer to write to
+ * @param[in]  vec    Vector of xml objecst
+ * @param[in]  veclen Length of vector
+ * @param[in]  pretty Set if output is pretty-printed (2 for debug)
+ * @param[in]  skiptop 0: Include top object 1: Skip top-object, only children,
+ * @retval     0      OK
+ * @retval    -1      Error
+ * @note This only works if the vector is uniform, ie same object name.
+ * Example: <b/><c/> --> <a><b/><c/></a> --> {"b" : null,"c" : null}
+ * @see clixon_json2cbuf
+ */
+int
+xml2json_cbuf_vec(cbuf      *cb,
+                  cxobj    **vec,
+                  size_t     veclen,
+                  int        pretty,
+                  int        skiptop)
+{
+    return json2cbuf_vec_sink(cb, vec, veclen, pretty, skiptop, NULL);
+}
+
 /*! Translate from xml tree to JSON and print to file using a callback
  *
  * @param[in]  f           File to print to
@@ -1303,8 +1383,9 @@ clixon_json2file(FILE             *f,
                  int               autocliext,
                  int               system_only)
 {
-    int   retval = 1;
-    cbuf *cb = NULL;
+    int       retval = 1;
+    cbuf     *cb = NULL;
+    json_sink sink;
 
     if (fn == NULL)
         fn = fprintf;
@@ -1312,7 +1393,9 @@ clixon_json2file(FILE             *f,
         clixon_err(OE_XML, errno, "cbuf_new");
         goto done;
     }
-    if (clixon_json2cbuf(cb, xn, pretty, skiptop, autocliext, system_only) < 0)
+    sink.js_f = f;
+    sink.js_fn = fn;
+    if (json2cbuf_sink(cb, xn, pretty, skiptop, autocliext, system_only, &sink) < 0)
         goto done;
     (*fn)(f, "%s", cbuf_get(cb));
     retval = 0;
@@ -1358,14 +1441,17 @@ xml2json_vec(FILE             *f,
              clicon_output_cb *fn,
              int               skiptop)
 {
-    int   retval = 1;
-    cbuf *cb = NULL;
+    int       retval = 1;
+    cbuf     *cb = NULL;
+    json_sink sink;
 
     if ((cb = cbuf_new()) == NULL){
         clixon_err(OE_XML, errno, "cbuf_new");
         goto done;
     }
-    if (xml2json_cbuf_vec(cb, vec, veclen, pretty, skiptop) < 0)
+    sink.js_f = f;
+    sink.js_fn = fn;
+    if (json2cbuf_vec_sink(cb, vec, veclen, pretty, skiptop, &sink) < 0)
         goto done;
     (*fn)(f, "%s\n", cbuf_get(cb));
     retval = 0;
@@ -137,6 +137,7 @@ static const map_str2int _FORMATS[] = {
     {"json",             FORMAT_JSON},
     {"cli",              FORMAT_CLI},
     {"netconf",          FORMAT_NETCONF},
+    {"cbor",             FORMAT_CBOR},
     {"default",          FORMAT_DEFAULT},
     {"pipe-xml-default", FORMAT_PIPE_XML_DEFAULT},
     {NULL,      -1}
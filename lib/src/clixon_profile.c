@@ -0,0 +1,396 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+ 
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2, 
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Profiling counters and latency histograms
+ * Global counters are incremented by clixon_profile_count() in hot paths, such as
+ * XPath evaluation and yang_find. Latencies are measured with a monotonic clock
+ * and recorded in histograms with log2 microsecond buckets: bucket 0 counts samples
+ * below 1us and bucket i counts samples in [2^(i-1), 2^i) us.
+ * There is one histogram per fixed timer (commit phases, event loop lag) and one per
+ * RPC name.
+ * All functions are no-ops if profiling is not enabled, see CLICON_BACKEND_PROFILE
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include "clixon_queue.h"
+#include "clixon_hash.h"
+#include "clixon_handle.h"
+#include "clixon_yang.h"
+#include "clixon_xml.h"
+#include "clixon_err.h"
+#include "clixon_profile.h"
+#include "banned.h"
+
+/*
+ * Variables
+ */
+/* Profiling enabled, see clixon_profile_enable() */
+int      _clixon_profile_enabled = 0;
+
+/* Event counters, see clixon_profile_count() */
+uint64_t _clixon_profile_counters[CLIXON_PROF_COUNTER_NR] = {0,};
+
+/* Histograms of fixed timers */
+static clixon_profile_hist _profile_timers[CLIXON_PROF_TIMER_NR] = {{0,},};
+
+/* Histograms per RPC name, created on first sample */
+static clicon_hash_t *_profile_rpcs = NULL;
+
+/* Names of counters, indexed by clixon_profile_counter, same as YANG leaf names */
+static const char *_profile_counter_names[CLIXON_PROF_COUNTER_NR] = {
+    "xpath-eval",
+    "yang-find"
+};
+
+/* Names of timers, indexed by clixon_profile_timer */
+static const char *_profile_timer_names[CLIXON_PROF_TIMER_NR] = {
+    "commit",
+    "commit-diff",
+    "commit-validate",
+    "commit-plugin",
+    "datastore-copy",
+    "datastore-write",
+    "event-loop-lag"
+};
+
+/*! Enable or disable profiling
+ *
+ * Counters and histograms are kept when disabled, see clixon_profile_reset()
+ * @param[in]  enable  If set, enable profiling
+ * @retval     0       OK
+ */
+int
+clixon_profile_enable(int enable)
+{
+    _clixon_profile_enabled = enable;
+    return 0;
+}
+
+/*! Add a sample to a histogram
+ *
+ * @param[in]  ph   Histogram
+ * @param[in]  us   Sample in microseconds
+ */
+static void
+profile_hist_add(clixon_profile_hist *ph,
+                 uint64_t             us)
+{
+    int i = 0;
+
+    ph->ph_count++;
+    ph->ph_sum += us;
+    if (us > ph->ph_max)
+        ph->ph_max = us;
+    while (us && i < CLIXON_PROFILE_BUCKETS - 1){
+        us >>= 1;
+        i++;
+    }
+    ph->ph_bucket[i]++;
+}
+
+/*! Get microseconds elapsed since start time
+ *
+ * @param[in]  ts   Start time
+ * @retval     us   Elapsed time in microseconds
+ */
+static uint64_t
+profile_elapsed(struct timespec *ts)
+{
+    struct timespec now;
+    int64_t         us;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    us = (int64_t)(now.tv_sec - ts->tv_sec)*1000000 + (now.tv_nsec - ts->tv_nsec)/1000;
+    return us < 0 ? 0 : (uint64_t)us;
+}
+
+/*! Start a latency measurement
+ *
+ * @param[out] ts   Start time, only set if profiling is enabled
+ * @retval     0    OK
+ * @code
+ *   struct timespec ts = {0,};
+ *   clixon_profile_start(&ts);
+ *   ... measured code ...
+ *   clixon_profile_stop(CLIXON_PROF_COMMIT, &ts);
+ * @endcode
+ * @see clixon_profile_stop
+ */
+int
+clixon_profile_start(struct timespec *ts)
+{
+    if (_clixon_profile_enabled)
+        clock_gettime(CLOCK_MONOTONIC, ts);
+    return 0;
+}
+
+/*! Stop a latency measurement and add it to a timer histogram
+ *
+ * No sample is added if the start time was not set, ie if profiling was enabled
+ * in between.
+ * @param[in]  timer  Timer
+ * @param[in]  ts     Start time, set by clixon_profile_start()
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+int
+clixon_profile_stop(clixon_profile_timer timer,
+                    struct timespec     *ts)
+{
+    if (!_clixon_profile_enabled || ts->tv_sec == 0)
+        return 0;
+    return clixon_profile_add(timer, profile_elapsed(ts));
+}
+
+/*! Stop a latency measurement and add it to the histogram of a named RPC
+ *
+ * @param[in]  name   RPC name, eg "edit-config"
+ * @param[in]  ts     Start time, set by clixon_profile_start()
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+int
+clixon_profile_rpc_stop(const char      *name,
+                        struct timespec *ts)
+{
+    int                  retval = -1;
+    clixon_profile_hist *ph;
+    clixon_profile_hist  ph0 = {0,};
+    clicon_hash_t        hn;
+
+    if (!_clixon_profile_enabled || ts->tv_sec == 0 || name == NULL)
+        return 0;
+    if (_profile_rpcs == NULL &&
+        (_profile_rpcs = clicon_hash_init()) == NULL)
+        goto done;
+    if ((ph = clicon_hash_value(_profile_rpcs, name, NULL)) == NULL){
+        if ((hn = clicon_hash_add(_profile_rpcs, name, &ph0, sizeof(ph0))) == NULL)
+            goto done;
+        ph = hn->h_val;
+    }
+    profile_hist_add(ph, profile_elapsed(ts));
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Add a sample to a timer histogram
+ *
+ * Use if the latency is not measured with clixon_profile_start/stop, such as event loop lag
+ * @param[in]  timer  Timer
+ * @param[in]  us     Sample in microseconds
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+int
+clixon_profile_add(clixon_profile_timer timer,
+                   uint64_t             us)
+{
+    if (!_clixon_profile_enabled)
+        return 0;
+    if (timer < 0 || timer >= CLIXON_PROF_TIMER_NR){
+        clixon_err(OE_UNIX, EINVAL, "timer %d out of range", timer);
+        return -1;
+    }
+    profile_hist_add(&_profile_timers[timer], us);
+    return 0;
+}
+
+/*! Add event loop lag sample, ie time elapsed since a timer expired
+ *
+ * @param[in]  t   Expiry time of timer (gettimeofday)
+ * @retval     0   OK
+ * @retval    -1   Error
+ * @see clixon_event_loop
+ */
+int
+clixon_profile_lag(struct timeval *t)
+{
+    struct timeval now;
+    struct timeval td;
+
+    if (!_clixon_profile_enabled)
+        return 0;
+    gettimeofday(&now, NULL);
+    timersub(&now, t, &td);
+    if (td.tv_sec < 0) /* Timer dispatched before expiry, eg poll ms resolution */
+        return clixon_profile_add(CLIXON_PROF_EVENT_LAG, 0);
+    return clixon_profile_add(CLIXON_PROF_EVENT_LAG, (uint64_t)td.tv_sec*1000000 + td.tv_usec);
+}
+
+/*! Get value of profiling counter
+ *
+ * @param[in]  counter  Counter
+ * @retval     nr       Counter value
+ */
+uint64_t
+clixon_profile_counter_get(clixon_profile_counter counter)
+{
+    if (counter < 0 || counter >= CLIXON_PROF_COUNTER_NR)
+        return 0;
+    return _clixon_profile_counters[counter];
+}
+
+/*! Get histogram of a timer
+ *
+ * @param[in]  timer  Timer
+ * @param[out] php    Histogram, points into static memory, do not free
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+int
+clixon_profile_hist_get(clixon_profile_timer  timer,
+                        clixon_profile_hist **php)
+{
+    if (timer < 0 || timer >= CLIXON_PROF_TIMER_NR || php == NULL){
+        clixon_err(OE_UNIX, EINVAL, "timer %d out of range or php is NULL", timer);
+        return -1;
+    }
+    *php = &_profile_timers[timer];
+    return 0;
+}
+
+/*! Reset all profiling counters and histograms
+ *
+ * @retval     0      OK
+ * @retval    -1      Error
+ */
+int
+clixon_profile_reset(void)
+{
+    memset(_clixon_profile_counters, 0, sizeof(_clixon_profile_counters));
+    memset(_profile_timers, 0, sizeof(_profile_timers));
+    return clixon_profile_exit();
+}
+
+/*! Print one histogram as XML
+ *
+ * @param[in]  cb    CLIgen buffer
+ * @param[in]  tag   Element name, eg timer or rpc
+ * @param[in]  name  Key value
+ * @param[in]  ph    Histogram
+ */
+static void
+profile_hist_print(cbuf                *cb,
+                   const char          *tag,
+                   const char          *name,
+                   clixon_profile_hist *ph)
+{
+    int i;
+
+    cprintf(cb, "<%s><name>%s</name>", tag, name);
+    cprintf(cb, "<count>%" PRIu64 "</count>", ph->ph_count);
+    cprintf(cb, "<total-usec>%" PRIu64 "</total-usec>", ph->ph_sum);
+    cprintf(cb, "<max-usec>%" PRIu64 "</max-usec>", ph->ph_max);
+    for (i = 0; i < CLIXON_PROFILE_BUCKETS; i++){
+        if (ph->ph_bucket[i] == 0)
+            continue;
+        cprintf(cb, "<bucket><log2-usec>%d</log2-usec><count>%" PRIu64 "</count></bucket>",
+                i, ph->ph_bucket[i]);
+    }
+    cprintf(cb, "</%s>", tag);
+}
+
+/*! Print profiling counters and histograms as XML
+ *
+ * Only non-empty histograms and buckets are printed.
+ * Prints the content of the clixon-lib stats output profile container, not the container itself
+ * @param[in,out] cb  CLIgen buffer, with XML content appended
+ * @retval        0   OK
+ * @retval       -1   Error
+ */
+int
+clixon_profile_print(cbuf *cb)
+{
+    int                  retval = -1;
+    clixon_profile_hist *ph;
+    char               **keys = NULL;
+    size_t               klen = 0;
+    int                  i;
+
+    if (cb == NULL){
+        clixon_err(OE_UNIX, EINVAL, "cb is NULL");
+        goto done;
+    }
+    for (i = 0; i < CLIXON_PROF_COUNTER_NR; i++)
+        cprintf(cb, "<%s>%" PRIu64 "</%s>",
+                _profile_counter_names[i], _clixon_profile_counters[i], _profile_counter_names[i]);
+    for (i = 0; i < CLIXON_PROF_TIMER_NR; i++){
+        ph = &_profile_timers[i];
+        if (ph->ph_count)
+            profile_hist_print(cb, "timer", _profile_timer_names[i], ph);
+    }
+    if (_profile_rpcs){
+        if (clicon_hash_keys(_profile_rpcs, &keys, &klen) < 0)
+            goto done;
+        for (i = 0; i < klen; i++){
+            if ((ph = clicon_hash_value(_profile_rpcs, keys[i], NULL)) != NULL)
+                profile_hist_print(cb, "rpc", keys[i], ph);
+        }
+    }
+    retval = 0;
+ done:
+    if (keys)
+        free(keys);
+    return retval;
+}
+
+/*! Free profiling RPC histograms
+ *
+ * @retval     0      OK
+ */
+int
+clixon_profile_exit(void)
+{
+    if (_profile_rpcs){
+        clicon_hash_free(_profile_rpcs);
+        _profile_rpcs = NULL;
+    }
+    return 0;
+}
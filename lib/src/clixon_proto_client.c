@@ -84,6 +84,7 @@
 #include "clixon_netconf_lib.h"
 #include "clixon_xml_io.h"
 #include "clixon_nacm.h"
+#include "clixon_datastore.h"
 #include "clixon_proto_client.h"
 #include "banned.h"
 
@@ -554,6 +555,63 @@ clicon_rpc_netconf_xml(clixon_handle  h,
     return retval;
 }
 
+/*! Get running configuration from its read-only snapshot instead of the backend
+ *
+ * Only used if the result would be the same as from the backend: explicit defaults
+ * and no NACM or system-only config
+ * @param[in]  h        Clixon handle
+ * @param[in]  db       Name of database
+ * @param[in]  xpath    XPath (or "")
+ * @param[in]  nsc      Namespace context for filter
+ * @param[in]  defaults Value of the with-defaults mode, rfc6243, or NULL
+ * @param[out] xdp      XML data tree
+ * @retval     1        OK, xdp set
+ * @retval     0        Snapshot not applicable or not available, use backend
+ * @retval    -1        Error
+ * @see CLICON_XMLDB_SNAPSHOT
+ */
+static int
+clixon_rpc_get_config_snapshot(clixon_handle h,
+                               const char   *db,
+                               const char   *xpath,
+                               cvec         *nsc,
+                               const char   *defaults,
+                               cxobj       **xdp)
+{
+    int    retval = -1;
+    cxobj *xd = NULL;
+    char  *mode;
+    int    ret;
+
+    if (!clicon_option_bool(h, "CLICON_XMLDB_SNAPSHOT") ||
+        strcmp(db, "running") != 0 ||
+        (defaults != NULL && strcmp(defaults, "explicit") != 0) ||
+        clicon_option_bool(h, "CLICON_XMLDB_SYSTEM_ONLY_CONFIG"))
+        goto fail;
+    if ((mode = clicon_option_str(h, "CLICON_NACM_MODE")) != NULL &&
+        strcmp(mode, "disabled") != 0)
+        goto fail;
+    if ((ret = xmldb_snapshot_get(h, db, xpath, nsc, &xd)) < 0)
+        goto done;
+    if (ret == 0)
+        goto fail;
+    if (xml_name_set(xd, NETCONF_OUTPUT_DATA) < 0)
+        goto done;
+    xml_flag_reset(xd, XML_FLAG_TOP);
+    if (xml_bind_special(xd, clicon_dbspec_yang(h), "/nc:get-config/output/data") < 0)
+        goto done;
+    *xdp = xd;
+    xd = NULL;
+    retval = 1;
+ done:
+    if (xd)
+        xml_free(xd);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
 /*! Get database configuration
  *
  * Same as clicon_proto_change just with a cvec instead of lvec
@@ -606,6 +664,10 @@ clixon_rpc_get_config1(clixon_handle h,
     char      *groupname;
     int        ret;
 
+    if ((ret = clixon_rpc_get_config_snapshot(h, db, xpath, nsc, defaults, &xd)) < 0)
+        goto done;
+    if (ret == 1)
+        goto ok;
     if (session_id_check(h, &session_id) < 0)
         goto done;
     if ((cb = cbuf_new()) == NULL){
@@ -672,6 +734,7 @@ clixon_rpc_get_config1(clixon_handle h,
             }
         }
     }
+  ok:
     if (xt && xd){
         /* Sync namespaces, ie explicitly set all xmlns attributes to xd */
         if (xml_nsctx_node(xd, &nscd) < 0)
@@ -764,6 +827,92 @@ clicon_rpc_edit_config(clixon_handle       h,
     return retval;
 }
 
+/*! Send several edits of database entries to backend daemon in one request
+ *
+ * The edits are applied independently, the result of each edit is returned in xret
+ * @param[in]  h       Clixon handle
+ * @param[in]  db      Name of database
+ * @param[in]  opvec   Default operation per edit: OP_MERGE, OP_REPLACE, OP_NONE
+ * @param[in]  xmlvec  XML string per edit. Ex: <config><a>..</a><b>...</b></config>
+ * @param[in]  len     Number of edits
+ * @param[out] xret    Reply with one edit element per edit, with <ok/> or <error>. Free with xml_free
+ * @retval     0       OK, see xret for result of each edit
+ * @retval    -1       Error and logged to syslog
+ * @code
+ *   enum operation_type opvec[] = {OP_MERGE, OP_MERGE};
+ *   char *xmlvec[] = {"<config><a xmlns=\"urn:example:clixon\">4</a></config>",
+ *                     "<config><b xmlns=\"urn:example:clixon\">5</b></config>"};
+ *   cxobj *xret = NULL;
+ *   if (clixon_rpc_batch_edit(h, "candidate", opvec, xmlvec, 2, &xret) < 0)
+ *      err;
+ *   if (xpath_first(xret, NULL, "rpc-reply/edit/error") != NULL)
+ *      some edit failed;
+ *   xml_free(xret);
+ * @endcode
+ * @see clicon_rpc_edit_config
+ */
+int
+clixon_rpc_batch_edit(clixon_handle        h,
+                      const char          *db,
+                      enum operation_type *opvec,
+                      char               **xmlvec,
+                      int                  len,
+                      cxobj              **xret)
+{
+    int      retval = -1;
+    cbuf    *cb = NULL;
+    cxobj   *xr = NULL;
+    cxobj   *xerr;
+    char    *username;
+    char    *groupname;
+    uint32_t session_id;
+    int      i;
+
+    if (session_id_check(h, &session_id) < 0)
+        goto done;
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_XML, errno, "cbuf_new");
+        goto done;
+    }
+    cprintf(cb, "<rpc xmlns=\"%s\"", NETCONF_BASE_NAMESPACE);
+    cprintf(cb, " xmlns:%s=\"%s\"", NETCONF_BASE_PREFIX, NETCONF_BASE_NAMESPACE);
+    if ((username = clicon_username_get(h)) != NULL)
+        cprintf(cb, " %s:username=\"%s\"", CLIXON_LIB_PREFIX, username);
+    if ((groupname = clixon_groupname_get(h)) != NULL)
+        cprintf(cb, " %s:groupname=\"%s\"", CLIXON_LIB_PREFIX, groupname);
+    if (username != NULL || groupname != NULL)
+        cprintf(cb, " xmlns:%s=\"%s\"", CLIXON_LIB_PREFIX, CLIXON_LIB_NS);
+    cprintf(cb, " %s", NETCONF_MESSAGE_ID_ATTR); /* XXX: use incrementing sequence */
+    cprintf(cb, "><batch-edit xmlns=\"%s\"><target><%s/></target>", CLIXON_LIB_NS, db);
+    for (i=0; i<len; i++){
+        cprintf(cb, "<edit><id>%d</id>", i);
+        cprintf(cb, "<default-operation>%s</default-operation>",
+                xml_operation2str(opvec[i]));
+        if (xmlvec[i])
+            cprintf(cb, "%s", xmlvec[i]);
+        cprintf(cb, "</edit>");
+    }
+    cprintf(cb, "</batch-edit></rpc>");
+    if (clicon_rpc_msg(h, cb, &xr) < 0)
+        goto done;
+    /* Errors of individual edits are returned in xret */
+    if ((xerr = xpath_first(xr, NULL, "rpc-reply/rpc-error")) != NULL){
+        clixon_err_netconf(h, OE_NETCONF, 0, xerr, "Batch editing configuration");
+        goto done;
+    }
+    if (xret){
+        *xret = xr;
+        xr = NULL;
+    }
+    retval = 0;
+  done:
+    if (xr)
+        xml_free(xr);
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
 /*! Send a request to backend to copy a file from one location to another
  *
  * Note this assumes the backend can access these files and (usually) assumes
@@ -87,18 +87,45 @@
 
 #ifdef LEAFREF_OPTIMIZE
 
+/*! Number of leafref cache entries, replaced round-robin
+ */
+#define LEAFREF_OPT_ENTRIES 8
+
 /* Global cache data only directly used in validate_leafref()
+ * One entry per leafref yang/path, valid during one validation pass
  */
 struct leafref_opt {
-    yang_stmt *lc_cache_yang;  /* YANG of leafref xml node*/
-    cxobj     *lc_cache_x0;    /* leafref xml node */
-    cxobj    **lc_cache_xvec;
-    size_t     lc_cache_xlen;
-    char      *lc_cache_xpath; /* Cached xpath to distinguish union branches */
-    int        lc_bin_search;  /* Result is binary searchable */
-    cxobj     *lc_bin_x0;      /* First object hit, derive y and parent */
+    yang_stmt     *lc_cache_yang;  /* YANG of leafref xml node*/
+    cxobj         *lc_cache_x0;    /* leafref xml node */
+    cxobj        **lc_cache_xvec;
+    size_t         lc_cache_xlen;
+    char          *lc_cache_xpath; /* Cached xpath to distinguish union branches */
+    int            lc_bin_search;  /* Result is binary searchable */
+    cxobj         *lc_bin_x0;      /* First object hit, derive y and parent */
+    char         **lc_index;       /* Sorted target values, built on first cache hit */
+    size_t         lc_index_len;   /* Length of lc_index */
 };
-struct leafref_opt leafref_opt = {0,};
+static struct leafref_opt leafref_opt[LEAFREF_OPT_ENTRIES] = {{0,},};
+static int leafref_opt_next = 0;   /* Next entry to replace */
+
+#endif
+
+#ifdef VALIDATE_XPATH_MEMO
+
+/*! Number of must/when memo entries
+ */
+#define XPATH_MEMO_ENTRIES 16
+
+/* Global memo of must/when results, valid during one validation pass
+ * One entry per must/when yang statement, with the result for one anchor ancestor
+ */
+struct xpath_memo {
+    yang_stmt *xm_yang;    /* Y_MUST or Y_WHEN statement */
+    cxobj     *xm_anchor;  /* Anchor ancestor of the context node */
+    int        xm_result;  /* XPath boolean result */
+};
+static struct xpath_memo xpath_memo[XPATH_MEMO_ENTRIES] = {{0,},};
+static int xpath_memo_next = 0;    /* Next entry to replace */
 
 #endif
 
@@ -218,6 +245,7 @@ validate_leafref_err(char      *xpath,
  *
  * Find common ancestor, ie the parent of xp and xpc is the same object
  * recursively IF they are reachable by an initial "../" xpath.
+ * An absolute path without current() or deref() has the same targets in any context.
  * @param[in]  xp    XML to check
  * @param[in]  xpc   XML cache element
  * @param[in]  xpath XPath
@@ -238,12 +266,16 @@ leafref_opt_cache_check(cxobj *xp,
                                        xml_parent(xpc),
                                        xpath+strlen("../"),
                                        1);
+    else if (!check && *xpath == '/' &&
+             strstr(xpath, "current(") == NULL &&
+             strstr(xpath, "deref(") == NULL)
+        return 1;
     return 0;
 }
 
-/*! Free and zero all data in cache
+/*! Free and zero all data in cache entry
  */
-int
+static int
 leafref_opt_free(struct leafref_opt *lc)
 {
     lc->lc_cache_yang = NULL;
@@ -255,34 +287,135 @@ leafref_opt_free(struct leafref_opt *lc)
     lc->lc_cache_xpath = NULL;
     lc->lc_bin_search = 0;
     lc->lc_bin_x0 = NULL;
+    if (lc->lc_index)
+        free(lc->lc_index);
+    lc->lc_index = NULL;
+    lc->lc_index_len = 0;
+    return 0;
+}
+
+/*! Find cache entry for leafref yang/path in the context of an XML node
+ *
+ * @param[in]  ys    YANG node of leafref
+ * @param[in]  xt    XML leafref node
+ * @param[in]  xpath Leafref path
+ * @param[out] lcp   Cache entry, if found
+ * @retval     1     Cache hit
+ * @retval     0     No cache hit
+ */
+static int
+leafref_opt_cache_find(yang_stmt           *ys,
+                       cxobj               *xt,
+                       char                *xpath,
+                       struct leafref_opt **lcp)
+{
+    struct leafref_opt *lc;
+    int                 i;
+
+    for (i = 0; i < LEAFREF_OPT_ENTRIES; i++){
+        lc = &leafref_opt[i];
+        if (ys == lc->lc_cache_yang &&
+            lc->lc_cache_x0 &&
+            lc->lc_cache_xpath &&
+            strcmp(xpath, lc->lc_cache_xpath) == 0 &&
+            leafref_opt_cache_check(xt, lc->lc_cache_x0, xpath, 0) == 1){
+            *lcp = lc;
+            return 1;
+        }
+    }
     return 0;
 }
 
-/*! Re-instate cache, after leafref yang/path change
+/*! Re-instate cache entry, after leafref yang/path change
  *
+ * Replace an entry of the same yang/path if any, since it is for another context,
+ * otherwise replace entries round-robin.
  * @param[in]  ys    Cached YANG node
  * @param[in]  xt    Cached XML node
  * @param[in]  xpath Cached xpath string (pointer, not copied)
- * @param[in]  xvec  Vector of matching XML values
+ * @param[in]  xvec  Vector of matching XML values, consumed by the cache
  * @param[in]  xlen  Length of xvec
+ * @param[out] lcp   New cache entry
  * @retval     0     OK
  */
 static int
-leafref_opt_cache_new(yang_stmt *ys,
-                      cxobj     *xt,
-                      char      *xpath,
-                      cxobj    **xvec,
-                      size_t     xlen)
+leafref_opt_cache_new(yang_stmt           *ys,
+                      cxobj               *xt,
+                      char                *xpath,
+                      cxobj              **xvec,
+                      size_t               xlen,
+                      struct leafref_opt **lcp)
 {
-    leafref_opt_free(&leafref_opt);
-    leafref_opt.lc_cache_yang = ys;
-    leafref_opt.lc_cache_x0 = xt;
-    leafref_opt.lc_cache_xpath = xpath;
-    leafref_opt.lc_cache_xvec = xvec;
-    leafref_opt.lc_cache_xlen = xlen;
+    struct leafref_opt *lc = NULL;
+    int                 i;
+
+    for (i = 0; i < LEAFREF_OPT_ENTRIES; i++){
+        if (leafref_opt[i].lc_cache_yang == ys &&
+            leafref_opt[i].lc_cache_xpath &&
+            strcmp(xpath, leafref_opt[i].lc_cache_xpath) == 0){
+            lc = &leafref_opt[i];
+            break;
+        }
+    }
+    if (lc == NULL){
+        lc = &leafref_opt[leafref_opt_next];
+        leafref_opt_next = (leafref_opt_next + 1) % LEAFREF_OPT_ENTRIES;
+    }
+    leafref_opt_free(lc);
+    lc->lc_cache_yang = ys;
+    lc->lc_cache_x0 = xt;
+    lc->lc_cache_xpath = xpath;
+    lc->lc_cache_xvec = xvec;
+    lc->lc_cache_xlen = xlen;
+    *lcp = lc;
     return 0;
 }
 
+/*! Compare two strings given by reference, for qsort and bsearch of leafref value index
+ */
+static int
+leafref_opt_index_cmp(const void *arg1,
+                      const void *arg2)
+{
+    return strcmp(*(char * const *)arg1, *(char * const *)arg2);
+}
+
+/*! Look up leafref value in the value index of a cache entry
+ *
+ * The index is a sorted vector of target values, built from the cached target vector on
+ * first use, ie when a second leafref of the same yang/path and context is validated.
+ * @param[in]  lc    Cache entry
+ * @param[in]  body  Leafref value
+ * @retval     1     Value found
+ * @retval     0     Value not found
+ * @retval    -1     Error
+ */
+static int
+leafref_opt_index_find(struct leafref_opt *lc,
+                       char               *body)
+{
+    int    retval = -1;
+    char  *b;
+    size_t i;
+
+    if (lc->lc_index == NULL){
+        if ((lc->lc_index = calloc(lc->lc_cache_xlen + 1, sizeof(char *))) == NULL){
+            clixon_err(OE_UNIX, errno, "calloc");
+            goto done;
+        }
+        for (i = 0; i < lc->lc_cache_xlen; i++){
+            if ((b = xml_body(lc->lc_cache_xvec[i])) == NULL)
+                continue;
+            lc->lc_index[lc->lc_index_len++] = b;
+        }
+        qsort(lc->lc_index, lc->lc_index_len, sizeof(char *), leafref_opt_index_cmp);
+    }
+    retval = bsearch(&body, lc->lc_index, lc->lc_index_len, sizeof(char *),
+                     leafref_opt_index_cmp) != NULL;
+ done:
+    return retval;
+}
+
 /*! Detect if binary search can be used
  *
  * If xlen is very large, this takes time
@@ -547,12 +680,111 @@ leafref_opt_init(clixon_handle h)
 int
 leafref_opt_exit(clixon_handle h)
 {
-    leafref_opt_free(&leafref_opt);
+    int i;
+
+    for (i = 0; i < LEAFREF_OPT_ENTRIES; i++)
+        leafref_opt_free(&leafref_opt[i]);
+    leafref_opt_next = 0;
     return 0;
 }
 
 #endif /* LEAFREF_OPTIMIZE */
 
+#ifdef VALIDATE_XPATH_MEMO
+/*! Get anchor ancestor of a must/when context node, if its result may be memoized
+ *
+ * @param[in]  ys    Y_MUST or Y_WHEN statement
+ * @param[in]  xt    XML context node
+ * @retval     xanc  Anchor ancestor, the result of ys is the same for all its descendants
+ * @retval     NULL  Result depends on the context node, do not memoize
+ * @see ys_populate_xpath_anchor  where the anchor depth is computed
+ */
+static cxobj *
+xpath_memo_anchor(yang_stmt *ys,
+                  cxobj     *xt)
+{
+    cvec   *cvv;
+    cg_var *cv;
+    int32_t depth;
+    cxobj  *xanc;
+
+    if ((cvv = yang_cvec_get(ys)) == NULL ||
+        (cv = cvec_find(cvv, "anchor")) == NULL ||
+        (depth = cv_int32_get(cv)) < 1)
+        return NULL;
+    xanc = xt;
+    while (depth-- > 0 && xanc != NULL)
+        xanc = xml_parent(xanc);
+    return xanc;
+}
+
+/*! Find memoized must/when result
+ *
+ * @param[in]  ys      Y_MUST or Y_WHEN statement
+ * @param[in]  xanc    Anchor ancestor
+ * @param[out] result  XPath boolean result
+ * @retval     1       Found
+ * @retval     0       Not found
+ */
+static int
+xpath_memo_get(yang_stmt *ys,
+               cxobj     *xanc,
+               int       *result)
+{
+    struct xpath_memo *xm;
+    int                i;
+
+    for (i = 0; i < XPATH_MEMO_ENTRIES; i++){
+        xm = &xpath_memo[i];
+        if (xm->xm_yang == ys && xm->xm_anchor == xanc){
+            *result = xm->xm_result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*! Memoize must/when result
+ *
+ * Replace the entry of the same yang statement if any, since it is for another anchor,
+ * otherwise replace entries round-robin.
+ * @param[in]  ys      Y_MUST or Y_WHEN statement
+ * @param[in]  xanc    Anchor ancestor
+ * @param[in]  result  XPath boolean result
+ */
+static void
+xpath_memo_set(yang_stmt *ys,
+               cxobj     *xanc,
+               int        result)
+{
+    struct xpath_memo *xm = NULL;
+    int                i;
+
+    for (i = 0; i < XPATH_MEMO_ENTRIES; i++){
+        if (xpath_memo[i].xm_yang == ys){
+            xm = &xpath_memo[i];
+            break;
+        }
+    }
+    if (xm == NULL){
+        xm = &xpath_memo[xpath_memo_next];
+        xpath_memo_next = (xpath_memo_next + 1) % XPATH_MEMO_ENTRIES;
+    }
+    xm->xm_yang = ys;
+    xm->xm_anchor = xanc;
+    xm->xm_result = result;
+}
+
+/*! Clear must/when memo, call after each validation pass since the tree may change
+ */
+static void
+xpath_memo_exit(void)
+{
+    memset(xpath_memo, 0, sizeof(xpath_memo));
+    xpath_memo_next = 0;
+}
+#endif /* VALIDATE_XPATH_MEMO */
+
 /*! Validate xml node of type leafref, ensure the value is one of that path's reference
  *
  * @param[in]  xt    XML leaf node of type leafref
@@ -605,8 +837,9 @@ validate_leafref(cxobj     *xt,
     cg_var    *cv;
     int        require_instance = 1;
 #ifdef LEAFREF_OPTIMIZE
-    int        ret;
-    int        cachehit = 0;
+    int                 ret;
+    int                 cachehit = 0;
+    struct leafref_opt *lc = NULL;
 #endif
 
     /* require instance */
@@ -636,20 +869,10 @@ validate_leafref(cxobj     *xt,
     if (xml_nsctx_yang(yt, &nsc) < 0)
         goto done;
 #ifdef LEAFREF_OPTIMIZE
-    if (yt == leafref_opt.lc_cache_yang &&
-        leafref_opt.lc_cache_x0 &&
-        leafref_opt.lc_cache_xpath &&
-        strcmp(xpath, leafref_opt.lc_cache_xpath) == 0){
-        if ((ret = leafref_opt_cache_check(xt, leafref_opt.lc_cache_x0, xpath, 0)) < 0)
-            goto done;
-        if (ret == 1){
-            xvec = leafref_opt.lc_cache_xvec;
-            xlen = leafref_opt.lc_cache_xlen;
-            cachehit = 1;
-        }
-    }
+    if ((cachehit = leafref_opt_cache_find(yt, xt, xpath, &lc)) == 1)
+        xvec = lc->lc_cache_xvec;
+    else
 #endif /* LEAFREF_OPTIMIZE */
-    if (xvec == NULL)
         if (xpath_vec(xt, nsc, "%s", &xvec, &xlen, xpath) < 0)
             goto done;
 #ifdef LEAFREF_OPTIMIZE
@@ -658,17 +881,25 @@ validate_leafref(cxobj     *xt,
      * another list entry, see https://github.com/clicon/clixon/issues/683
      */
     if (!cachehit){
-        if (leafref_opt_cache_new(yt, xt, xpath, xvec, xlen) < 0)
+        if (leafref_opt_cache_new(yt, xt, xpath, xvec, xlen, &lc) < 0)
             goto done;
-        leafref_opt.lc_bin_search = 0;
-        leafref_opt.lc_bin_x0 = NULL;
         if (leafref_opt_search_detect(xvec, xlen,
-                                      &leafref_opt.lc_bin_search,
-                                      &leafref_opt.lc_bin_x0) < 0)
+                                      &lc->lc_bin_search,
+                                      &lc->lc_bin_x0) < 0)
             goto done;
     }
-    if (leafref_opt.lc_bin_search){
-        if ((ret = leafref_opt_search(xpath, xt, leafref_opt.lc_bin_x0, ytype, xret)) < 0)
+    if (cachehit){
+        /* Repeated use of the same targets: look up value in index */
+        if ((ret = leafref_opt_index_find(lc, leafrefbody)) < 0)
+            goto done;
+        if (ret == 0){
+            if (validate_leafref_err(xpath, xt, yt, ytype, xret) < 0)
+                goto done;
+            goto fail;
+        }
+    }
+    else if (lc->lc_bin_search){
+        if ((ret = leafref_opt_search(xpath, xt, lc->lc_bin_x0, ytype, xret)) < 0)
             goto done;
         if (ret == 0)
             goto fail;
@@ -695,7 +926,7 @@ validate_leafref(cxobj     *xt,
     if (nsc)
         xml_nsctx_free(nsc);
 #ifdef LEAFREF_OPTIMIZE
-    if (xvec != leafref_opt.lc_cache_xvec)
+    if (lc == NULL && xvec)  /* Not consumed by cache */
         free(xvec);
 #else
     if (xvec)
@@ -1920,13 +2151,18 @@ validate_when1(clixon_handle h,
     char      *xpath1 = NULL;
     cbuf      *cb     = NULL;
     int        ret;
-#ifdef VALIDATE_INCREMENTAL
+#if defined(VALIDATE_INCREMENTAL) || defined(VALIDATE_XPATH_MEMO)
     yang_stmt *ywhen;
+#endif
+#ifdef VALIDATE_INCREMENTAL
     cg_var    *whencv;
     int32_t    whendepth;
     cxobj     *xanc;
     int        wdepth;
 #endif
+#ifdef VALIDATE_XPATH_MEMO
+    cxobj     *xmemo = NULL;
+#endif
 
 #ifdef VALIDATE_INCREMENTAL
     /* Direct Y_WHEN child: if its cached depth shows the ancestor at that
@@ -1951,10 +2187,31 @@ validate_when1(clixon_handle h,
         }
     }
 #endif /* VALIDATE_INCREMENTAL */
-    ret = yang_check_when_xpath(xt, xml_parent(xt), yt, &hit, &nr, &xpath1);
-    clixon_debug(CLIXON_DBG_XPATH|CLIXON_DBG_DETAIL, "nr:%d xpath:%s return:%d", nr, xpath1, ret);
-    if (ret < 0)
-        goto done;
+#ifdef VALIDATE_XPATH_MEMO
+    /* Direct Y_WHEN child only: the result is shared by all nodes under the same anchor */
+    if ((ywhen = yang_find(yt, Y_WHEN, NULL)) != NULL &&
+        yang_when_get(h, yt) == NULL &&
+        (xmemo = xpath_memo_anchor(ywhen, xt)) != NULL &&
+        xpath_memo_get(ywhen, xmemo, &nr) == 1){
+        clixon_debug(CLIXON_DBG_VALIDATE, "%s: memo when: %s", __func__, yang_argument_get(ywhen));
+        hit = 1;
+        if ((xpath1 = strdup(yang_argument_get(ywhen))) == NULL){
+            clixon_err(OE_UNIX, errno, "strdup");
+            goto done;
+        }
+    }
+    else
+#endif
+    {
+        ret = yang_check_when_xpath(xt, xml_parent(xt), yt, &hit, &nr, &xpath1);
+        clixon_debug(CLIXON_DBG_XPATH|CLIXON_DBG_DETAIL, "nr:%d xpath:%s return:%d", nr, xpath1, ret);
+        if (ret < 0)
+            goto done;
+#ifdef VALIDATE_XPATH_MEMO
+        if (xmemo && hit)
+            xpath_memo_set(ywhen, xmemo, nr);
+#endif
+    }
     if (hit && nr == 0){
         if ((cb = cbuf_new()) == NULL){
             clixon_err(OE_UNIX, errno, "cbuf_new");
@@ -2266,12 +2523,16 @@ validate_musts1(clixon_handle h,
     int        nr;
     int        saw_node = 0;
     int        inext;
+    int        memo;
 #ifdef VALIDATE_INCREMENTAL
     cg_var    *mustcv;
     int32_t    mustdepth;
     cxobj     *xanc;
     int        mustd;
 #endif
+#ifdef VALIDATE_XPATH_MEMO
+    cxobj     *xmemo;
+#endif
 
     inext = 0;
     while ((yc = yn_iter(yt, &inext)) != NULL){
@@ -2304,19 +2565,32 @@ validate_musts1(clixon_handle h,
             }
         }
 #endif /* VALIDATE_INCREMENTAL */
-        if (!saw_node)
-            clixon_debug_xml(CLIXON_DBG_XPATH, xt, "");
-        saw_node = 1;
-        clixon_debug(CLIXON_DBG_VALIDATE, "%s: check must: %s", __func__, xpath);
-        /* the context node is the node in the accessible tree for which the
-         * "must" statement is defined; namespace declarations are from imports */
-        if (xml_nsctx_yang(yc, &nsc) < 0)
-            goto done;
-        clixon_debug(CLIXON_DBG_XPATH, "namespace '%s'", xml_nsctx_get(nsc, NULL));
-        nr = xpath_vec_bool(xt, nsc, "%s", xpath);
-        clixon_debug(CLIXON_DBG_XPATH, "result %s", (nr < 0 ? "error" : (nr != 0 ? "true" : "false")));
-        if (nr < 0)
-            goto done;
+        memo = 0;
+#ifdef VALIDATE_XPATH_MEMO
+        /* Same result for all nodes under the anchor, eg sibling list entries */
+        if ((xmemo = xpath_memo_anchor(yc, xt)) != NULL &&
+            (memo = xpath_memo_get(yc, xmemo, &nr)) == 1)
+            clixon_debug(CLIXON_DBG_VALIDATE, "%s: memo must: %s", __func__, xpath);
+#endif
+        if (!memo){
+            if (!saw_node)
+                clixon_debug_xml(CLIXON_DBG_XPATH, xt, "");
+            saw_node = 1;
+            clixon_debug(CLIXON_DBG_VALIDATE, "%s: check must: %s", __func__, xpath);
+            /* the context node is the node in the accessible tree for which the
+             * "must" statement is defined; namespace declarations are from imports */
+            if (xml_nsctx_yang(yc, &nsc) < 0)
+                goto done;
+            clixon_debug(CLIXON_DBG_XPATH, "namespace '%s'", xml_nsctx_get(nsc, NULL));
+            nr = xpath_vec_bool(xt, nsc, "%s", xpath);
+            clixon_debug(CLIXON_DBG_XPATH, "result %s", (nr < 0 ? "error" : (nr != 0 ? "true" : "false")));
+            if (nr < 0)
+                goto done;
+#ifdef VALIDATE_XPATH_MEMO
+            if (xmemo)
+                xpath_memo_set(yc, xmemo, nr);
+#endif
+        }
         if (!nr){
             ye = yang_find(yc, Y_ERROR_MESSAGE, NULL);
             if ((cb = cbuf_new()) == NULL){
@@ -2543,6 +2817,9 @@ xml_yang_validate_all(clixon_handle h,
     leafref_opt_exit(h);
 #else
     retval = xml_yang_validate_all1(h, xt, state, 0, xret);
+#endif
+#ifdef VALIDATE_XPATH_MEMO
+    xpath_memo_exit();
 #endif
     return retval;
 }
@@ -2568,17 +2845,35 @@ xml_yang_validate_all_state(clixon_handle h,
     yang_stmt *y;
     int        ix;
     int        ret;
+    int        retval = -1;
 
     ix = 0;
     while ((x = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL) {
         if (!state && (y = xml_spec(x)) != NULL && yang_config(y) == 0)
             continue; /* skip if non-config */
-        if ((ret = xml_yang_validate_all(h, x, state, xret)) < 1)
-            return ret;
+#ifdef LEAFREF_OPTIMIZE
+        leafref_opt_init(h);
+        ret = xml_yang_validate_all1(h, x, state, 0, xret);
+        leafref_opt_exit(h);
+#else
+        ret = xml_yang_validate_all1(h, x, state, 0, xret);
+#endif
+        if (ret < 1){
+            retval = ret;
+            goto done;
+        }
+    }
+    if ((ret = xml_yang_validate_minmax(xt, 0, xret)) < 1){
+        retval = ret;
+        goto done;
     }
-    if ((ret = xml_yang_validate_minmax(xt, 0, xret)) < 1)
-        return ret;
-    return 1;
+    retval = 1;
+ done:
+#ifdef VALIDATE_XPATH_MEMO
+    /* Memo is kept across top-level children, eg entries of a top-level list */
+    xpath_memo_exit();
+#endif
+    return retval;
 }
 
 /*! Transaction-aware variant of xml_yang_validate_all_state
@@ -2624,12 +2919,21 @@ xml_yang_validate_all_state_td(clixon_handle h,
 #else
         ret = xml_yang_validate_all1(h, x, state, incrml, xret);
 #endif
-        if (ret < 1)
-            return ret;
+        if (ret < 1){
+            retval = ret;
+            goto done;
+        }
+    }
+    if ((ret = xml_yang_validate_minmax(xt, 0, xret)) < 1){
+        retval = ret;
+        goto done;
     }
-    if ((ret = xml_yang_validate_minmax(xt, 0, xret)) < 1)
-        return ret;
     retval = 1;
+ done:
+#ifdef VALIDATE_XPATH_MEMO
+    /* Memo is kept across top-level children, eg entries of a top-level list */
+    xpath_memo_exit();
+#endif
     return retval;
 }
 
@@ -2640,6 +2944,9 @@ xml_yang_validate_exit(clixon_handle h)
 {
 #ifdef LEAFREF_OPTIMIZE
     leafref_opt_exit(h);
+#endif
+#ifdef VALIDATE_XPATH_MEMO
+    xpath_memo_exit();
 #endif
     return 0;
 }
@@ -100,31 +100,42 @@ struct vec_order {
 static int vec_free(struct vec_order *vec, size_t vlen);
 static int cmp_list_qsort(const void *arg1, const void *arg2);
 
-/*! New element last in list, check if already exists if so return -1
+/*! Value of a unique descendant node of a list entry
+ */
+struct unique_val {
+    char  *uv_str;   /* Body of descendant node */
+    cxobj *uv_x;     /* List entry */
+    int    uv_ord;   /* Order of list entry */
+};
+
+/*! Collect unique values of one list entry given by xpath
  *
- * @param[in]  vec   Vector of existing entries (new is last)
- * @param[in]  i1    The new entry is placed at vec[i1]
- * @param[in]  vlen  Length of entry
- * @param[in]  sorted Sorted by system, ie sorted by key, otherwise no assumption
- * @retval     1     Validation OK
- * @retval     0     Validation failed (cbret set)
- * @retval    -1     Error
- * @note This is currently quadratic complexity. It could be improved by inserting new element sorted and binary search.
+ * @param[in]     x     List entry
+ * @param[in]     ord   Order of list entry
+ * @param[in]     xpath Canonical xpath of unique descendant node
+ * @param[in]     nsc   Namespace context of xpath
+ * @param[in,out] uvec  Vector of values, values of x are appended
+ * @param[in,out] ulen  Length of uvec
+ * @param[in,out] umax  Allocated length of uvec
+ * @retval        0     OK
+ * @retval       -1     Error
  */
 static int
-unique_search_xpath(cxobj  *x,
-                    char   *xpath,
-                    cvec   *nsc,
-                    char ***svec,
-                    size_t *slen)
+unique_search_xpath(cxobj              *x,
+                    int                 ord,
+                    char               *xpath,
+                    cvec               *nsc,
+                    struct unique_val **uvec,
+                    size_t             *ulen,
+                    size_t             *umax)
 {
-    int     retval = -1;
-    cxobj **xvec = NULL;
-    size_t  xveclen;
-    int     i;
-    int     s;
-    cxobj  *xi;
-    char   *bi;
+    int                retval = -1;
+    cxobj            **xvec = NULL;
+    size_t             xveclen;
+    int                i;
+    cxobj             *xi;
+    char              *bi;
+    struct unique_val *uv;
 
     /* Collect tuples */
     if (xpath_vec(x, nsc, "%s", &xvec, &xveclen, xpath) < 0)
@@ -133,29 +144,39 @@ unique_search_xpath(cxobj  *x,
         xi = xvec[i];
         if ((bi = xml_body(xi)) == NULL)
             break;
-        /* Check if bi is duplicate?
-         * XXX: sort svec?
-         */
-        for (s=0; s<(*slen); s++){
-            if (strcmp(bi, (*svec)[s]) == 0){
-                goto fail;
+        if (*ulen == *umax){
+            *umax = *umax ? 2*(*umax) : 64;
+            if ((uv = realloc(*uvec, (*umax)*sizeof(struct unique_val))) == NULL){
+                clixon_err(OE_UNIX, errno, "realloc");
+                goto done;
             }
+            *uvec = uv;
         }
-        (*slen) ++;
-        if (((*svec) = realloc((*svec), (*slen)*sizeof(char*))) == NULL){
-            clixon_err(OE_UNIX, errno, "realloc");
-            goto done;
-        }
-        (*svec)[(*slen)-1] = bi;
+        uv = &(*uvec)[(*ulen)++];
+        uv->uv_str = bi;
+        uv->uv_x = x;
+        uv->uv_ord = ord;
     } /* i search results */
-    retval = 1;
+    retval = 0;
  done:
     if (xvec)
         free(xvec);
     return retval;
- fail:
-    retval = 0;
-    goto done;
+}
+
+/*! Sort unique values on value, then on order of list entry
+ */
+static int
+unique_val_cmp(const void *arg1,
+               const void *arg2)
+{
+    const struct unique_val *uv1 = arg1;
+    const struct unique_val *uv2 = arg2;
+    int                      eq;
+
+    if ((eq = strcmp(uv1->uv_str, uv2->uv_str)) != 0)
+        return eq;
+    return uv1->uv_ord - uv2->uv_ord;
 }
 
 /*! New element last in list, return error if already exists
@@ -471,17 +492,21 @@ check_unique_list(cxobj     *x,
                   yang_stmt *yu,
                   cxobj    **xret)
 {
-    int     retval = -1;
-    cg_var *cvi; /* unique node name */
-    char  **svec = NULL; /* vector of search results */
-    size_t  slen = 0;
-    char   *xpath0 = NULL;
-    char   *xpath1 = NULL;
-    cvec   *cvk;
-    cvec   *nsc0 = NULL;
-    cvec   *nsc1 = NULL;
-    int     ret;
-    int     ix;
+    int                retval = -1;
+    cg_var            *cvi; /* unique node name */
+    struct unique_val *uvec = NULL; /* values of all list entries */
+    size_t             ulen = 0;
+    size_t             umax = 0;
+    struct unique_val *uvdup = NULL;
+    size_t             i;
+    int                ord = 0;
+    char              *xpath0 = NULL;
+    char          *xpath1 = NULL;
+    cvec          *cvk;
+    cvec          *nsc0 = NULL;
+    cvec          *nsc1 = NULL;
+    int            ret;
+    int            ix;
 
     /* Check if multiple direct children */
     cvk = yang_cvec_get(yu);
@@ -510,17 +535,29 @@ check_unique_list(cxobj     *x,
     ix = ix0;
     do {
         /* Collect search results from one */
-        if ((ret = unique_search_xpath(x, xpath1, nsc1, &svec, &slen)) < 0)
+        if (unique_search_xpath(x, ord++, xpath1, nsc1, &uvec, &ulen, &umax) < 0)
             goto done;
-        if (ret == 0){
-            if (xret && netconf_data_not_unique_xml(xret, x, cvk) < 0)
-                goto done;
-            goto fail;
-        }
         x = xml_child_iter(xt, &ix, CX_ELMNT);
     } while (x && y == xml_spec(x));  /* stop if list ends, others may follow */
-    // ok:
-    /* It would be possible to cache vec here as an optimization */
+    /* Sort and compare neighbours, report the first entry in list order with a value
+     * already seen in an earlier (or the same) entry */
+    if (ulen > 1){
+        qsort(uvec, ulen, sizeof(struct unique_val), unique_val_cmp);
+        for (i=1; i<ulen; i++){
+            if (strcmp(uvec[i-1].uv_str, uvec[i].uv_str) != 0)
+                continue;
+            if (uvdup == NULL || uvec[i].uv_ord < uvdup->uv_ord)
+                uvdup = &uvec[i];
+            /* Skip rest of equal values, they are later in list order */
+            while (i+1 < ulen && strcmp(uvec[i].uv_str, uvec[i+1].uv_str) == 0)
+                i++;
+        }
+    }
+    if (uvdup != NULL){
+        if (xret && netconf_data_not_unique_xml(xret, uvdup->uv_x, cvk) < 0)
+            goto done;
+        goto fail;
+    }
     retval = 1;
  done:
     if (nsc0)
@@ -529,8 +566,8 @@ check_unique_list(cxobj     *x,
         cvec_free(nsc1);
     if (xpath1)
         free(xpath1);
-    if (svec)
-        free(svec);
+    if (uvec)
+        free(uvec);
     return retval;
  fail:
     retval = 0;
@@ -76,6 +76,7 @@
 #include "clixon_xml_io.h"
 #include "clixon_xml_parse.h"
 #include "clixon_xml_nsctx.h"
+#include "clixon_arena.h"
 #include "banned.h"
 
 /*
@@ -96,6 +97,15 @@
 #define is_element(x) (xml_type(x)==CX_ELMNT)
 #define is_bodyattr(x) (xml_type(x)==CX_BODY || xml_type(x)==CX_ATTR)
 
+/* Bits of x_arena: parts of a node allocated from an arena, and that are not freed
+ * individually, see xml_arena_set
+ */
+#define XML_ARENA_NODE    0x01 /* The node itself */
+#define XML_ARENA_NAME    0x02 /* x_name including prefix */
+#define XML_ARENA_VALUE   0x04 /* x_value of body and attribute nodes */
+#define XML_ARENA_VEC     0x08 /* x_childvec */
+#define XML_ARENA_BODYVAL 0x10 /* x_bodyval */
+
 /*
  * Types
  */
@@ -143,6 +153,61 @@ xml_search_index_head(cxobj *x)
 
 #endif
 
+#ifdef XML_LIST_KEY_INDEX
+static int xml_key_index_free(cxobj *x);
+static int xml_key_index_child_rm(cxobj *xp, cxobj *xc);
+static void xml_key_index_dirty(cxobj *xk);
+
+/* An entry of a list key index: the key tuple of a list entry
+ */
+struct key_entry{
+    struct key_entry *ke_next; /* Next entry in hash bucket */
+    uint32_t          ke_hash; /* Hash value of ke_key */
+    char             *ke_key;  /* Key tuple, see xml_key_index_str */
+    cxobj            *ke_x;    /* First list entry with this key tuple */
+    int               ke_nr;   /* Number of list entries with this key tuple (>1 if invalid) */
+};
+
+/* A hash index of the entries of one YANG list under a parent XML node
+ *
+ *                  key_index(y)
+ *               +-----+-----+-----+-----+
+ * ki_bucket:    |     |  o  |     |  o  |
+ *               +-----+--|--+-----+--|--+
+ *                        v           v
+ *                   "a/1;1/1;"  "b/1;2/1;"    key tuple of k1,k2
+ *                        |           |
+ * x_childvec:   |  x  | y[a,1] |  y[b,2] |
+ */
+struct key_index{
+    struct key_index  *ki_next;    /* Next index of same parent, ie another list */
+    yang_stmt         *ki_yang;    /* Yang spec of list */
+    struct key_entry **ki_bucket;  /* Hash buckets, number is a power of two */
+    size_t             ki_size;    /* Number of buckets */
+    size_t             ki_len;     /* Number of entries */
+    int                ki_noindex; /* Number of list entries without complete keys */
+    int                ki_childnr; /* Number of children of parent node when in sync, -1 if stale */
+};
+
+/* External map from parent cxobj* -> key_index* */
+static map_ptr2ptr *_key_index_map = NULL;
+static size_t       _key_index_map_len = 0;
+
+/* If set, indexes are used but not built or dropped, eg when read by several threads */
+static int          _key_index_readonly = 0;
+
+/*! Get key_index list for an XML parent node from the external map
+ */
+static struct key_index *
+xml_key_index_head(cxobj *x)
+{
+    if (_key_index_map_len == 0)
+        return NULL;
+    return (struct key_index *)clixon_ptr2ptr(_key_index_map, _key_index_map_len, x);
+}
+
+#endif /* XML_LIST_KEY_INDEX */
+
 /*! xml tree node, with name, type, parent, children, etc 
  *
  * Note that this is a private type not visible from externally, use
@@ -203,6 +268,7 @@ struct xml{
     uint16_t          x_flags;      /* Flags according to XML_FLAG_* */
     int8_t            x_type;       /* type of node: element, attribute, body */
     uint8_t           x_prefix_len; /* length of prefix, 0 if no prefix */
+    uint8_t           x_arena;      /* Parts allocated from arena, see XML_ARENA_* */
 
     /*----- up to here is common to all next is element only */
     char             *x_name;       /* name of node, prefix\0name\0 if prefix set */
@@ -238,6 +304,7 @@ struct xmlbody{
     uint16_t          xb_flags;      /* Flags according to XML_FLAG_* */
     int8_t            xb_type;       /* type of node: element, attribute, body */
     uint8_t           xb_prefix_len; /* length of prefix, 0 if no prefix  (NB used for body bit dont rm due to alignment) */
+    uint8_t           xb_arena;      /* Parts allocated from arena, see XML_ARENA_* */
 };
 
 /*
@@ -304,6 +371,9 @@ static uint64_t _stats_xml_nr = 0;
 static map_ptr2ptr *_candidate_parent_map = NULL;
 static size_t       _candidate_parent_len = 0;
 
+/* Arena for new XML nodes, or NULL for regular malloc, see xml_arena_set */
+static clixon_arena *_xml_arena = NULL;
+
 /*! Translate from xml stats type string keyword to enum form
  */
 enum xml_stats_enum
@@ -490,6 +560,148 @@ xml_stats(cxobj          *xt,
     return retval;
 }
 
+/*! Set arena for allocation of new XML nodes
+ *
+ * While an arena is set, xml_new() allocates nodes, names, values and child vectors from
+ * it instead of from the heap. Such nodes are bump-allocated, and xml_free() does not free
+ * their arena parts individually: they are released all at once by clixon_arena_reset().
+ * Other nodes, and later changes of arena nodes, use the heap as usual.
+ * Intended for short-lived trees, such as a parsed request:
+ * @code
+ *   old = xml_arena_set(ca);
+ *   ret = clixon_xml_parse_string(str, YB_NONE, NULL, &xt, NULL);
+ *   xml_arena_set(old);
+ *   ...
+ *   xml_free(xt);
+ *   clixon_arena_reset(ca);
+ * @endcode
+ * @param[in]  ca   Arena, or NULL for regular heap allocation
+ * @retval     old  Previous arena, or NULL
+ * @note Arena nodes must be freed or copied (not moved) before the arena is reset
+ */
+clixon_arena *
+xml_arena_set(clixon_arena *ca)
+{
+    clixon_arena *old = _xml_arena;
+
+    _xml_arena = ca;
+    return old;
+}
+
+/*! Check if XML node is allocated from an arena
+ *
+ * @param[in]  x  XML node
+ * @retval     1  Node is allocated from an arena
+ * @retval     0  Node is allocated from the heap
+ */
+int
+xml_arena_p(cxobj *x)
+{
+    return (x->x_arena & XML_ARENA_NODE) != 0;
+}
+
+/*! Allocate memory for a part of an XML node
+ *
+ * From current arena if both arena is set and node is an arena node, otherwise malloc
+ * @param[in]  x    XML node
+ * @param[in]  len  Length in bytes
+ * @param[in]  part Node part, one of XML_ARENA_*
+ * @retval     p    Allocated memory, release with xml_part_free
+ * @retval     NULL Error
+ */
+static void *
+xml_part_alloc(cxobj  *x,
+               size_t  len,
+               uint8_t part)
+{
+    void *p;
+
+    if (_xml_arena && (x->x_arena & XML_ARENA_NODE)){
+        if ((p = clixon_arena_alloc(_xml_arena, len)) == NULL)
+            return NULL;
+        x->x_arena |= part;
+    }
+    else {
+        if ((p = malloc(len)) == NULL){
+            clixon_err(OE_XML, errno, "malloc");
+            return NULL;
+        }
+        x->x_arena &= ~part;
+    }
+    return p;
+}
+
+/*! Free memory of a part of an XML node, unless allocated from an arena
+ *
+ * @param[in]  x    XML node
+ * @param[in]  p    Memory to free
+ * @param[in]  part Node part, one of XML_ARENA_*
+ */
+static void
+xml_part_free(cxobj  *x,
+              void   *p,
+              uint8_t part)
+{
+    if ((x->x_arena & part) == 0)
+        free(p);
+    x->x_arena &= ~part;
+}
+
+/*! Reallocate memory of a part of an XML node
+ *
+ * Arena memory cannot be resized, instead it is copied to new memory
+ * @param[in]  x      XML node
+ * @param[in]  p      Memory to resize
+ * @param[in]  oldlen Number of bytes to keep (arena only)
+ * @param[in]  len    New length in bytes
+ * @param[in]  part   Node part, one of XML_ARENA_*
+ * @retval     p      Reallocated memory
+ * @retval     NULL   Error
+ */
+static void *
+xml_part_realloc(cxobj  *x,
+                 void   *p,
+                 size_t  oldlen,
+                 size_t  len,
+                 uint8_t part)
+{
+    void *p1;
+
+    if (x->x_arena & part){
+        if ((p1 = xml_part_alloc(x, len, part)) == NULL)
+            return NULL;
+        memcpy(p1, p, oldlen);
+    }
+    else if ((p1 = realloc(p, len)) == NULL){
+        clixon_err(OE_XML, errno, "realloc");
+        return NULL;
+    }
+    return p1;
+}
+
+/*! Duplicate a string as a part of an XML node
+ *
+ * @param[in]  x    XML node
+ * @param[in]  str  String to copy
+ * @param[in]  part Node part, one of XML_ARENA_*
+ * @retval     s    Copy of string, release with xml_part_free
+ * @retval     NULL Error
+ */
+static char *
+xml_part_strdup(cxobj      *x,
+                const char *str,
+                uint8_t     part)
+{
+    char  *s;
+    size_t len;
+
+    len = strlen(str) + 1;
+    if ((s = xml_part_alloc(x, len, part)) == NULL)
+        return NULL;
+    memcpy(s, str, len);
+    return s;
+}
+
 /*
  * Access functions
  */
@@ -537,7 +749,7 @@ xml_name_set(cxobj      *xn,
     }
     /* Free combined allocation */
     if (xn->x_name)
-        free(xn->x_name - (xn->x_prefix_len ? xn->x_prefix_len + 1 : 0));
+        xml_part_free(xn, xn->x_name - (xn->x_prefix_len ? xn->x_prefix_len + 1 : 0), XML_ARENA_NAME);
     xn->x_name = NULL;
     xn->x_prefix_len = 0;
     if (name){
@@ -548,20 +760,16 @@ xml_name_set(cxobj      *xn,
                 clixon_err(OE_XML, EINVAL, "xml prefix too long: %zu", prefixlen);
                 goto done;
             }
-            if ((alloc = malloc(prefixlen + 1 + namelen + 1)) == NULL){
-                clixon_err(OE_XML, errno, "malloc");
+            if ((alloc = xml_part_alloc(xn, prefixlen + 1 + namelen + 1, XML_ARENA_NAME)) == NULL)
                 goto done;
-            }
             memcpy(alloc, prefix_copy, prefixlen + 1);
             memcpy(alloc + prefixlen + 1, name, namelen + 1);
             xn->x_name = alloc + prefixlen + 1;
             xn->x_prefix_len = (uint8_t)prefixlen;
         }
         else{
-            if ((xn->x_name = strdup(name)) == NULL){
-                clixon_err(OE_XML, errno, "strdup");
+            if ((xn->x_name = xml_part_strdup(xn, name, XML_ARENA_NAME)) == NULL)
                 goto done;
-            }
         }
     }
     retval = 0;
@@ -606,7 +814,7 @@ xml_prefix_set(cxobj      *xn,
     }
     /* Free combined allocation */
     if (xn->x_name)
-        free(xn->x_name - (xn->x_prefix_len ? xn->x_prefix_len + 1 : 0));
+        xml_part_free(xn, xn->x_name - (xn->x_prefix_len ? xn->x_prefix_len + 1 : 0), XML_ARENA_NAME);
     xn->x_name = NULL;
     xn->x_prefix_len = 0;
     if (name_copy){
@@ -617,20 +825,16 @@ xml_prefix_set(cxobj      *xn,
                 clixon_err(OE_XML, EINVAL, "xml prefix too long: %zu", prefixlen);
                 goto done;
             }
-            if ((alloc = malloc(prefixlen + 1 + namelen + 1)) == NULL){
-                clixon_err(OE_XML, errno, "malloc");
+            if ((alloc = xml_part_alloc(xn, prefixlen + 1 + namelen + 1, XML_ARENA_NAME)) == NULL)
                 goto done;
-            }
             memcpy(alloc, prefix, prefixlen + 1);
             memcpy(alloc + prefixlen + 1, name_copy, namelen + 1);
             xn->x_name = alloc + prefixlen + 1;
             xn->x_prefix_len = (uint8_t)prefixlen;
         }
         else{
-            if ((xn->x_name = strdup(name_copy)) == NULL){
-                clixon_err(OE_XML, errno, "strdup");
+            if ((xn->x_name = xml_part_strdup(xn, name_copy, XML_ARENA_NAME)) == NULL)
                 goto done;
-            }
         }
     }
     retval = 0;
@@ -892,6 +1096,28 @@ xml_value(cxobj *xn)
     return xn->x_value;
 }
 
+/*! Invalidate cached cv value of an element when its body changes
+ *
+ * Also marks the list key index of a list entry stale if the element is one of its keys
+ * @param[in]  xn  Element node, or body node whose parent cache is invalidated
+ * @see xml_cv_set
+ */
+static void
+xml_cv_invalidate(cxobj *xn)
+{
+    if (xml_type(xn) == CX_BODY)
+        xn = xml_parent(xn);
+    if (xn == NULL || !is_element(xn))
+        return;
+#ifdef XML_LIST_KEY_INDEX
+    xml_key_index_dirty(xn);
+#endif
+    if (xn->x_cv == NULL)
+        return;
+    cv_free(xn->x_cv);
+    xn->x_cv = NULL;
+}
+
 /*! Set value of xml node, value is copied
  *
  * @param[in]  xn    xml node
@@ -911,12 +1137,11 @@ xml_value_set(cxobj      *xn,
             clixon_err(OE_XML, EINVAL, "value is NULL");
             goto done;
         }
+        xml_cv_invalidate(xn);
         if (xn->x_bodyval)
-            free(xn->x_bodyval);
-        if ((xn->x_bodyval = strdup(val)) == NULL){
-            clixon_err(OE_XML, errno, "strdup");
+            xml_part_free(xn, xn->x_bodyval, XML_ARENA_BODYVAL);
+        if ((xn->x_bodyval = xml_part_strdup(xn, val, XML_ARENA_BODYVAL)) == NULL)
             goto done;
-        }
         xml_flag_set(xn, XML_FLAG_BODY);
         retval = 0;
         goto done;
@@ -928,12 +1153,11 @@ xml_value_set(cxobj      *xn,
         clixon_err(OE_XML, EINVAL, "value is NULL");
         goto done;
     }
+    xml_cv_invalidate(xn);
     if (xn->x_value)
-        free(xn->x_value);
-    if ((xn->x_value = strdup(val)) == NULL){
-        clixon_err(OE_XML, errno, "strdup");
+        xml_part_free(xn, xn->x_value, XML_ARENA_VALUE);
+    if ((xn->x_value = xml_part_strdup(xn, val, XML_ARENA_VALUE)) == NULL)
         goto done;
-    }
     retval = 0;
  done:
     return retval;
@@ -962,19 +1186,16 @@ xml_value_append(cxobj      *xn,
             clixon_err(OE_XML, EINVAL, "value is NULL");
             goto done;
         }
+        xml_cv_invalidate(xn);
         sz = strlen(val)+1;
         if (xn->x_bodyval == NULL){
-            if ((xn->x_bodyval = strdup(val)) == NULL){
-                clixon_err(OE_XML, errno, "strdup");
+            if ((xn->x_bodyval = xml_part_strdup(xn, val, XML_ARENA_BODYVAL)) == NULL)
                 goto done;
-            }
         }
         else{
             oldlen = strlen(xn->x_bodyval);
-            if ((newval = realloc(xn->x_bodyval, oldlen + sz)) == NULL){
-                clixon_err(OE_XML, errno, "realloc");
+            if ((newval = xml_part_realloc(xn, xn->x_bodyval, oldlen, oldlen + sz, XML_ARENA_BODYVAL)) == NULL)
                 goto done;
-            }
             memcpy(newval + oldlen, val, sz);
             xn->x_bodyval = newval;
         }
@@ -989,19 +1210,16 @@ xml_value_append(cxobj      *xn,
         clixon_err(OE_XML, EINVAL, "value is NULL");
         goto done;
     }
+    xml_cv_invalidate(xn);
     sz = strlen(val)+1;
     if (xn->x_value == NULL){
-        if ((xn->x_value = strdup(val)) == NULL){
-            clixon_err(OE_XML, errno, "strdup");
+        if ((xn->x_value = xml_part_strdup(xn, val, XML_ARENA_VALUE)) == NULL)
             goto done;
-        }
     }
     else{
         oldlen = strlen(xn->x_value);
-        if ((newval = realloc(xn->x_value, oldlen + sz)) == NULL){
-            clixon_err(OE_XML, errno, "realloc");
+        if ((newval = xml_part_realloc(xn, xn->x_value, oldlen, oldlen + sz, XML_ARENA_VALUE)) == NULL)
             goto done;
-        }
         memcpy(newval + oldlen, val, sz);
         xn->x_value = newval;
     }
@@ -1399,10 +1617,9 @@ xml_child_append(cxobj *xp,
         start = XML_CHILDVEC_SIZE_START_ELMNT;
     xv = xp->x_childvec;
     if (xv == NULL){
-        if ((xv = calloc(1, sizeof(struct xmlvec) + start * sizeof(cxobj*))) == NULL){
-            clixon_err(OE_XML, errno, "calloc");
+        if ((xv = xml_part_alloc(xp, sizeof(struct xmlvec) + start * sizeof(cxobj*), XML_ARENA_VEC)) == NULL)
             return -1;
-        }
+        memset(xv, 0, sizeof(struct xmlvec) + start * sizeof(cxobj*));
         xv->xv_max = start;
         xp->x_childvec = xv;
     }
@@ -1416,10 +1633,11 @@ xml_child_append(cxobj *xp,
             clixon_err(OE_XML, ERANGE, "xml child vector overflow");
             return -1;
         }
-        if ((xv = realloc(xv, sizeof(struct xmlvec) + newmax * sizeof(cxobj*))) == NULL){
-            clixon_err(OE_XML, errno, "realloc");
+        if ((xv = xml_part_realloc(xp, xv,
+                                   sizeof(struct xmlvec) + xv->xv_max * sizeof(cxobj*),
+                                   sizeof(struct xmlvec) + newmax * sizeof(cxobj*),
+                                   XML_ARENA_VEC)) == NULL)
             return -1;
-        }
         xv->xv_max = newmax;
         xp->x_childvec = xv;
     }
@@ -1450,10 +1668,9 @@ xml_child_insert_pos(cxobj *xp,
         return 0;
     xv = xp->x_childvec;
     if (xv == NULL){
-        if ((xv = calloc(1, sizeof(struct xmlvec) + XML_CHILDVEC_SIZE_START * sizeof(cxobj*))) == NULL){
-            clixon_err(OE_XML, errno, "calloc");
+        if ((xv = xml_part_alloc(xp, sizeof(struct xmlvec) + XML_CHILDVEC_SIZE_START * sizeof(cxobj*), XML_ARENA_VEC)) == NULL)
             return -1;
-        }
+        memset(xv, 0, sizeof(struct xmlvec) + XML_CHILDVEC_SIZE_START * sizeof(cxobj*));
         xv->xv_max = XML_CHILDVEC_SIZE_START;
         xp->x_childvec = xv;
     }
@@ -1467,10 +1684,11 @@ xml_child_insert_pos(cxobj *xp,
             clixon_err(OE_XML, ERANGE, "xml child vector overflow");
             return -1;
         }
-        if ((xv = realloc(xv, sizeof(struct xmlvec) + newmax * sizeof(cxobj*))) == NULL){
-            clixon_err(OE_XML, errno, "realloc");
+        if ((xv = xml_part_realloc(xp, xv,
+                                   sizeof(struct xmlvec) + xv->xv_max * sizeof(cxobj*),
+                                   sizeof(struct xmlvec) + newmax * sizeof(cxobj*),
+                                   XML_ARENA_VEC)) == NULL)
             return -1;
-        }
         xv->xv_max = newmax;
         xp->x_childvec = xv;
     }
@@ -1497,12 +1715,14 @@ xml_childvec_set(cxobj *x,
 
     if (!is_element(x))
         return 0;
+#ifdef XML_LIST_KEY_INDEX
+    xml_key_index_free(x); /* Children are replaced */
+#endif
     if (x->x_childvec)
-        free(x->x_childvec);
-    if ((xv = calloc(1, sizeof(struct xmlvec) + len * sizeof(cxobj*))) == NULL){
-        clixon_err(OE_XML, errno, "calloc");
+        xml_part_free(x, x->x_childvec, XML_ARENA_VEC);
+    if ((xv = xml_part_alloc(x, sizeof(struct xmlvec) + len * sizeof(cxobj*), XML_ARENA_VEC)) == NULL)
         return -1;
-    }
+    memset(xv, 0, sizeof(struct xmlvec) + len * sizeof(cxobj*));
     xv->xv_max = len;
     x->x_childvec = xv;
     return 0;
@@ -1584,11 +1804,19 @@ xml_new(const char     *name,
         return NULL;
         break;
     }
-    if ((x = malloc(sz)) == NULL){
-        clixon_err(OE_XML, errno, "malloc");
-        return NULL;
+    if (_xml_arena){
+        if ((x = clixon_arena_alloc(_xml_arena, sz)) == NULL)
+            return NULL;
+        memset(x, 0, sz);
+        x->x_arena = XML_ARENA_NODE;
+    }
+    else {
+        if ((x = malloc(sz)) == NULL){
+            clixon_err(OE_XML, errno, "malloc");
+            return NULL;
+        }
+        memset(x, 0, sz);
     }
-    memset(x, 0, sz);
     xml_type_set(x, type);
     if (type != CX_BODY && name && (xml_name_set(x, name)) < 0)
         return NULL;
@@ -1652,6 +1880,8 @@ xml_spec_set(cxobj     *x,
 {
     if (!is_element(x))
         return 0;
+    if (x->x_spec != spec)
+        xml_cv_invalidate(x); /* Type may differ */
     x->x_spec = spec;
     return 0;
 }
@@ -1912,7 +2142,7 @@ xml_child_rm(cxobj *xp,
         memmove(&xv_vec(xp)[i], &xv_vec(xp)[i+1], (xv_len(xp)-i)*sizeof(cxobj*));
     /* Free childvec when last child is removed to reclaim memory */
     if (xv_len(xp) == 0){
-        free(xp->x_childvec);
+        xml_part_free(xp, xp->x_childvec, XML_ARENA_VEC);
         xp->x_childvec = NULL;
     }
 #ifdef XML_EXPLICIT_INDEX
@@ -1920,6 +2150,10 @@ xml_child_rm(cxobj *xp,
         if (xml_search_index_p(xc))
             xml_search_child_rm(xp, xc);
     }
+#endif
+#ifdef XML_LIST_KEY_INDEX
+    if (xml_key_index_child_rm(xp, xc) < 0)
+        goto done;
 #endif
     retval = 0;
  done:
@@ -2209,13 +2443,12 @@ xml_body_set(cxobj      *xn,
 #ifdef OPTMEM_XML_BODY
     if (!is_element(xn))
         return 0;
+    xml_cv_invalidate(xn);
     if (xn->x_bodyval)
-        free(xn->x_bodyval);
+        xml_part_free(xn, xn->x_bodyval, XML_ARENA_BODYVAL);
     xn->x_bodyval = NULL;
-    if (val != NULL && (xn->x_bodyval = strdup(val)) == NULL){
-        clixon_err(OE_XML, errno, "strdup");
+    if (val != NULL && (xn->x_bodyval = xml_part_strdup(xn, val, XML_ARENA_BODYVAL)) == NULL)
         return -1;
-    }
     xml_flag_set(xn, XML_FLAG_BODY);
     return 0;
 #else
@@ -2276,11 +2509,12 @@ xml_body_append(cxobj      *xn,
 int
 xml_body_reset(cxobj *xn)
 {
+    xml_cv_invalidate(xn);
 #ifdef OPTMEM_XML_BODY
     if (!is_element(xn))
         return 0;
     if (xn->x_bodyval){
-        free(xn->x_bodyval);
+        xml_part_free(xn, xn->x_bodyval, XML_ARENA_BODYVAL);
         xn->x_bodyval = NULL;
     }
     xml_flag_reset(xn, XML_FLAG_BODY);
@@ -2500,9 +2734,10 @@ xml_find_body_obj(cxobj      *xt,
 int
 xml_free0(cxobj *x)
 {
-    int    i;
-    cxobj *xc;
-    size_t sz = 0;
+    int     i;
+    cxobj  *xc;
+    size_t  sz = 0;
+    uint8_t arena;
 
     if (x == NULL)
         return 0;
@@ -2515,11 +2750,11 @@ xml_free0(cxobj *x)
                     xv_vec(x)[i] = NULL;
                 }
             }
-            free(x->x_childvec);
+            xml_part_free(x, x->x_childvec, XML_ARENA_VEC);
             x->x_childvec = NULL;
         }
         if (x->x_name)
-            free(x->x_name - (x->x_prefix_len ? x->x_prefix_len + 1 : 0));
+            xml_part_free(x, x->x_name - (x->x_prefix_len ? x->x_prefix_len + 1 : 0), XML_ARENA_NAME);
         sz = sizeof(struct xml);
         if (x->x_cv)
             cv_free(x->x_cv);
@@ -2527,29 +2762,35 @@ xml_free0(cxobj *x)
             xml_nsctx_free(x->x_ns_cache);
 #ifdef OPTMEM_XML_BODY
         if (x->x_bodyval)
-            free(x->x_bodyval);
+            xml_part_free(x, x->x_bodyval, XML_ARENA_BODYVAL);
 #endif
 #ifdef XML_EXPLICIT_INDEX
         xml_search_index_free(x);
+#endif
+#ifdef XML_LIST_KEY_INDEX
+        xml_key_index_free(x);
 #endif
         break;
     case CX_ATTR:
         if (x->x_name)
-            free(x->x_name - (x->x_prefix_len ? x->x_prefix_len + 1 : 0));
+            xml_part_free(x, x->x_name - (x->x_prefix_len ? x->x_prefix_len + 1 : 0), XML_ARENA_NAME);
         sz = sizeof(struct xml);
         if (x->x_value)
-            free(x->x_value);
+            xml_part_free(x, x->x_value, XML_ARENA_VALUE);
         break;
     case CX_BODY:
         sz = sizeof(struct xmlbody);
         if (x->x_value)
-            free(x->x_value);
+            xml_part_free(x, x->x_value, XML_ARENA_VALUE);
         break;
     default:
         break;
     }
-    if (sz)
+    if (sz){
+        arena = x->x_arena & XML_ARENA_NODE; /* Node itself is freed by xml_free */
         memset(x, 0, sz);
+        x->x_arena = arena;
+    }
     return 0;
 }
 
@@ -2564,7 +2805,8 @@ xml_free(cxobj *x)
     if (x == NULL)
         return 0;
     xml_free0(x);
-    free(x);
+    if ((x->x_arena & XML_ARENA_NODE) == 0)
+        free(x);
     _stats_xml_nr--;
     return 0;
 }
@@ -2600,10 +2842,8 @@ xml_copy_one(cxobj *x0,
 #ifdef OPTMEM_XML_BODY
         if (xml_flag(x0, XML_FLAG_BODY)){
             if (x0->x_bodyval != NULL){
-                if ((x1->x_bodyval = strdup(x0->x_bodyval)) == NULL){
-                    clixon_err(OE_XML, errno, "strdup");
+                if ((x1->x_bodyval = xml_part_strdup(x1, x0->x_bodyval, XML_ARENA_BODYVAL)) == NULL)
                     goto done;
-                }
             }
             xml_flag_set(x1, XML_FLAG_BODY);
         }
@@ -2660,6 +2900,14 @@ xml_copy(cxobj *x0,
         if (xml_copy(x, xcopy) < 0) /* recursion */
             goto done;
     }
+#ifdef XML_CV_CACHE_KEYS
+    /* Copy cached key value after the body, since setting the body invalidates it */
+    if (xml_type(x0) == CX_ELMNT && x0->x_cv != NULL && x1->x_cv == NULL &&
+        (x1->x_cv = cv_dup(x0->x_cv)) == NULL){
+        clixon_err(OE_XML, errno, "cv_dup");
+        goto done;
+    }
+#endif
     retval = 0;
   done:
     return retval;
@@ -3404,3 +3652,523 @@ xml_child_index_each(cxobj          *xparent,
 }
 
 #endif /* XML_EXPLICIT_INDEX */
+
+#ifdef XML_LIST_KEY_INDEX
+/*! Hash function of a key tuple (FNV-1a)
+ */
+static uint32_t
+xml_key_index_hash(const char *str)
+{
+    uint32_t h = 2166136261U;
+
+    while (*str){
+        h ^= (uint8_t)*str++;
+        h *= 16777619U;
+    }
+    return h;
+}
+
+/*! Make key tuple string of a list entry
+ *
+ * The key tuple consists of the canonical typed value of each key, in yang key order, each
+ * followed by its length, eg "a/1;42/2;". The typed value is used so that key values that
+ * are equal according to xml_cmp, eg "01" and "1" of an integer key, have the same tuple.
+ * @param[in]  x    XML list entry
+ * @param[in]  y    Yang spec of x
+ * @param[out] cb   Key tuple
+ * @retval     1    OK, key tuple in cb
+ * @retval     0    Not all keys are present or typed, x cannot be indexed
+ * @retval    -1    Error
+ */
+static int
+xml_key_index_str(cxobj     *x,
+                  yang_stmt *y,
+                  cbuf      *cb)
+{
+    cg_var *cvi = NULL;
+    cxobj  *xk;
+    cg_var *cv;
+    size_t  len;
+
+    cbuf_reset(cb);
+    while ((cvi = cvec_each(yang_cvec_get(y), cvi)) != NULL){
+        if ((xk = xml_find(x, cv_string_get(cvi))) == NULL ||
+            xml_body(xk) == NULL)
+            return 0;
+        if (xml_cv_cache_key(xk) < 0)
+            return -1;
+        if ((cv = xml_cv(xk)) == NULL)
+            return 0;
+        len = cbuf_len(cb);
+        cv2cbuf(cv, cb);
+        cprintf(cb, "/%zu;", cbuf_len(cb) - len);
+    }
+    return 1;
+}
+
+/*! Find entry of key tuple in list key index
+ */
+static struct key_entry *
+xml_key_index_lookup(struct key_index *ki,
+                     const char       *key,
+                     uint32_t          hash)
+{
+    struct key_entry *ke;
+
+    for (ke = ki->ki_bucket[hash & (ki->ki_size - 1)]; ke != NULL; ke = ke->ke_next)
+        if (ke->ke_hash == hash && strcmp(ke->ke_key, key) == 0)
+            return ke;
+    return NULL;
+}
+
+/*! Double the number of hash buckets of a list key index
+ *
+ * @param[in]  ki   List key index
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+xml_key_index_grow(struct key_index *ki)
+{
+    struct key_entry **bucket;
+    struct key_entry  *ke;
+    size_t             size;
+    size_t             i;
+
+    size = ki->ki_size * 2;
+    if ((bucket = calloc(size, sizeof(*bucket))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        return -1;
+    }
+    for (i = 0; i < ki->ki_size; i++){
+        while ((ke = ki->ki_bucket[i]) != NULL){
+            ki->ki_bucket[i] = ke->ke_next;
+            ke->ke_next = bucket[ke->ke_hash & (size - 1)];
+            bucket[ke->ke_hash & (size - 1)] = ke;
+        }
+    }
+    free(ki->ki_bucket);
+    ki->ki_bucket = bucket;
+    ki->ki_size = size;
+    return 0;
+}
+
+/*! Add a list entry to a list key index
+ *
+ * @param[in]  ki   List key index
+ * @param[in]  xc   XML list entry
+ * @param[in]  cb   Work buffer
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+xml_key_index_entry_add(struct key_index *ki,
+                        cxobj            *xc,
+                        cbuf             *cb)
+{
+    int               retval = -1;
+    struct key_entry *ke;
+    uint32_t          hash;
+    int               ret;
+
+    if ((ret = xml_key_index_str(xc, ki->ki_yang, cb)) < 0)
+        goto done;
+    if (ret == 0){
+        ki->ki_noindex++;
+        goto ok;
+    }
+    hash = xml_key_index_hash(cbuf_get(cb));
+    if ((ke = xml_key_index_lookup(ki, cbuf_get(cb), hash)) != NULL){
+        ke->ke_nr++; /* Duplicate key */
+        goto ok;
+    }
+    if (ki->ki_len >= ki->ki_size &&
+        xml_key_index_grow(ki) < 0)
+        goto done;
+    if ((ke = malloc(sizeof(*ke))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto done;
+    }
+    memset(ke, 0, sizeof(*ke));
+    if ((ke->ke_key = strdup(cbuf_get(cb))) == NULL){
+        clixon_err(OE_UNIX, errno, "strdup");
+        free(ke);
+        goto done;
+    }
+    ke->ke_hash = hash;
+    ke->ke_x = xc;
+    ke->ke_nr = 1;
+    ke->ke_next = ki->ki_bucket[hash & (ki->ki_size - 1)];
+    ki->ki_bucket[hash & (ki->ki_size - 1)] = ke;
+    ki->ki_len++;
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Free a single list key index
+ */
+static void
+xml_key_index_free1(struct key_index *ki)
+{
+    struct key_entry *ke;
+    size_t            i;
+
+    for (i = 0; i < ki->ki_size; i++){
+        while ((ke = ki->ki_bucket[i]) != NULL){
+            ki->ki_bucket[i] = ke->ke_next;
+            free(ke->ke_key);
+            free(ke);
+        }
+    }
+    free(ki->ki_bucket);
+    free(ki);
+}
+
+/*! Set the list key indexes of a parent node in the external map
+ *
+ * @param[in]  x     XML parent node
+ * @param[in]  head  List of key indexes, or NULL to remove
+ * @retval     0     OK
+ * @retval    -1    Error
+ */
+static int
+xml_key_index_head_set(cxobj            *x,
+                       struct key_index *head)
+{
+    clixon_ptr2ptr_del(&_key_index_map, &_key_index_map_len, x);
+    if (head != NULL &&
+        clixon_ptr2ptr_add(&_key_index_map, &_key_index_map_len, x, head) < 0)
+        return -1;
+    return 0;
+}
+
+/*! Free all list key indexes of an XML parent node
+ *
+ * @param[in]  x    XML node
+ * @retval     0    OK
+ */
+static int
+xml_key_index_free(cxobj *x)
+{
+    struct key_index *head;
+    struct key_index *ki;
+
+    if ((head = xml_key_index_head(x)) == NULL)
+        return 0;
+    while ((ki = head) != NULL){
+        head = ki->ki_next;
+        xml_key_index_free1(ki);
+    }
+    clixon_ptr2ptr_del(&_key_index_map, &_key_index_map_len, x);
+    return 0;
+}
+
+/*! Remove a single list key index from a parent node
+ *
+ * @param[in]  xp   XML parent node
+ * @param[in]  ki0  List key index to remove
+ * @retval     0    OK
+ * @retval    -1    Error
+ */
+static int
+xml_key_index_drop(cxobj            *xp,
+                   struct key_index *ki0)
+{
+    struct key_index *head;
+    struct key_index **kip;
+
+    head = xml_key_index_head(xp);
+    for (kip = &head; *kip != NULL; kip = &(*kip)->ki_next)
+        if (*kip == ki0){
+            *kip = ki0->ki_next;
+            break;
+        }
+    xml_key_index_free1(ki0);
+    return xml_key_index_head_set(xp, head);
+}
+
+/*! Mark list key index stale if a key leaf of one of its list entries changes
+ *
+ * The index is then rebuilt on next search, or not used in read-only mode
+ * @param[in]  xk   Element node, possibly a key leaf of an indexed list entry
+ * @see xml_cv_invalidate
+ */
+static void
+xml_key_index_dirty(cxobj *xk)
+{
+    cxobj            *x;
+    cxobj            *xp;
+    struct key_index *ki;
+    cg_var           *cvi = NULL;
+
+    if (_key_index_map_len == 0 ||
+        (x = xml_parent(xk)) == NULL ||
+        (xp = xml_parent(x)) == NULL)
+        return;
+    for (ki = xml_key_index_head(xp); ki != NULL; ki = ki->ki_next)
+        if (ki->ki_yang == xml_spec(x))
+            break;
+    if (ki == NULL)
+        return;
+    while ((cvi = cvec_each(yang_cvec_get(ki->ki_yang), cvi)) != NULL)
+        if (strcmp(xml_name(xk), cv_string_get(cvi)) == 0){
+            ki->ki_childnr = -1;
+            break;
+        }
+}
+
+/*! Build list key index of all entries of a YANG list under a parent node
+ *
+ * @param[in]  xp   XML parent node
+ * @param[in]  y    Yang spec of list
+ * @param[in]  cb   Work buffer
+ * @retval     ki   List key index
+ * @retval     NULL Error
+ */
+static struct key_index *
+xml_key_index_build(cxobj     *xp,
+                    yang_stmt *y,
+                    cbuf      *cb)
+{
+    struct key_index *ki = NULL;
+    cxobj            *xc;
+    int               ix;
+
+    if ((ki = malloc(sizeof(*ki))) == NULL){
+        clixon_err(OE_UNIX, errno, "malloc");
+        goto err;
+    }
+    memset(ki, 0, sizeof(*ki));
+    ki->ki_yang = y;
+    ki->ki_size = 64;
+    while (ki->ki_size < (size_t)xml_child_nr(xp))
+        ki->ki_size *= 2;
+    if ((ki->ki_bucket = calloc(ki->ki_size, sizeof(*ki->ki_bucket))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        goto err;
+    }
+    ix = 0;
+    while ((xc = xml_child_iter(xp, &ix, CX_ELMNT)) != NULL){
+        if (xml_spec(xc) != y)
+            continue;
+        if (xml_key_index_entry_add(ki, xc, cb) < 0)
+            goto err;
+    }
+    ki->ki_childnr = xml_child_nr(xp);
+    ki->ki_next = xml_key_index_head(xp);
+    if (xml_key_index_head_set(xp, ki) < 0){
+        ki->ki_next = NULL;
+        goto err;
+    }
+    return ki;
+ err:
+    if (ki){
+        if (ki->ki_bucket)
+            xml_key_index_free1(ki);
+        else
+            free(ki);
+    }
+    return NULL;
+}
+
+/*! Find list entry using the list key index of its parent, build index if needed
+ *
+ * The index is only used for lists with at least XML_LIST_KEY_INDEX_MIN siblings, and if
+ * all entries and x1 have complete typed keys.
+ * @param[in]  xp   XML parent node
+ * @param[in]  y    Yang spec of list
+ * @param[in]  x1   XML search object with all keys of y
+ * @param[out] xcp  Matching list entry, or NULL if no entry matches
+ * @retval     1    Index used, see xcp
+ * @retval     0    Index not applicable, use another search method
+ * @retval    -1    Error
+ * @see xml_search_yang
+ */
+int
+xml_key_index_find(cxobj     *xp,
+                   yang_stmt *y,
+                   cxobj     *x1,
+                   cxobj    **xcp)
+{
+    int               retval = -1;
+    struct key_index *ki;
+    struct key_entry *ke;
+    cbuf             *cb = NULL;
+    int               ret;
+
+    *xcp = NULL;
+    if (xml_child_nr(xp) < XML_LIST_KEY_INDEX_MIN ||
+        cvec_len(yang_cvec_get(y)) == 0){
+        retval = 0;
+        goto done;
+    }
+    if ((cb = cbuf_new()) == NULL){
+        clixon_err(OE_UNIX, errno, "cbuf_new");
+        goto done;
+    }
+    for (ki = xml_key_index_head(xp); ki != NULL; ki = ki->ki_next)
+        if (ki->ki_yang == y)
+            break;
+    if (_key_index_readonly &&
+        (ki == NULL || ki->ki_childnr != xml_child_nr(xp))){
+        retval = 0;
+        goto done;
+    }
+    /* Children changed without xml_insert or xml_child_rm, eg xml_addsub, or a key changed */
+    if (ki != NULL && ki->ki_childnr != xml_child_nr(xp)){
+        if (xml_key_index_drop(xp, ki) < 0)
+            goto done;
+        ki = NULL;
+    }
+    if (ki == NULL &&
+        (ki = xml_key_index_build(xp, y, cb)) == NULL)
+        goto done;
+    if (ki->ki_noindex){
+        retval = 0;
+        goto done;
+    }
+    if ((ret = xml_key_index_str(x1, y, cb)) < 0)
+        goto done;
+    if (ret == 0){
+        retval = 0;
+        goto done;
+    }
+    if ((ke = xml_key_index_lookup(ki, cbuf_get(cb), xml_key_index_hash(cbuf_get(cb)))) != NULL){
+        if (ke->ke_nr != 1){
+            retval = 0;
+            goto done;
+        }
+        *xcp = ke->ke_x;
+    }
+    retval = 1;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Use existing list key indexes read-only
+ *
+ * In read-only mode searches do not build or drop indexes, so that XML trees may be
+ * searched concurrently by several threads.
+ * @param[in]  readonly  1: read-only, 0: build indexes on search
+ * @retval     old       Previous mode
+ */
+int
+xml_key_index_readonly(int readonly)
+{
+    int old = _key_index_readonly;
+
+    _key_index_readonly = readonly;
+    return old;
+}
+
+/*! Update list key indexes of a parent node after a child is inserted
+ *
+ * @param[in]  xp   XML parent node
+ * @param[in]  xc   Inserted child
+ * @retval     0    OK
+ * @retval    -1    Error
+ * @see xml_insert
+ */
+int
+xml_key_index_child_insert(cxobj *xp,
+                           cxobj *xc)
+{
+    int               retval = -1;
+    struct key_index *ki;
+    struct key_index *kinext;
+    cbuf             *cb = NULL;
+
+    for (ki = xml_key_index_head(xp); ki != NULL; ki = kinext){
+        kinext = ki->ki_next;
+        if (ki->ki_childnr + 1 != xml_child_nr(xp)){ /* Out of sync */
+            if (xml_key_index_drop(xp, ki) < 0)
+                goto done;
+            continue;
+        }
+        ki->ki_childnr++;
+        if (xml_spec(xc) != ki->ki_yang)
+            continue;
+        if (cb == NULL && (cb = cbuf_new()) == NULL){
+            clixon_err(OE_UNIX, errno, "cbuf_new");
+            goto done;
+        }
+        if (xml_key_index_entry_add(ki, xc, cb) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+
+/*! Update list key indexes of a parent node after a child is removed
+ *
+ * An index that cannot be updated exactly, eg duplicate keys, is dropped and rebuilt on
+ * next search.
+ * @param[in]  xp   XML parent node
+ * @param[in]  xc   Removed child
+ * @retval     0    OK
+ * @retval    -1    Error
+ * @see xml_child_rm
+ */
+static int
+xml_key_index_child_rm(cxobj *xp,
+                       cxobj *xc)
+{
+    int               retval = -1;
+    struct key_index *ki;
+    struct key_index *kinext;
+    struct key_entry *ke;
+    struct key_entry **kep;
+    cbuf             *cb = NULL;
+    uint32_t          hash;
+    int               ret;
+
+    for (ki = xml_key_index_head(xp); ki != NULL; ki = kinext){
+        kinext = ki->ki_next;
+        if (ki->ki_childnr - 1 != xml_child_nr(xp))
+            goto drop;
+        ki->ki_childnr--;
+        if (xml_type(xc) != CX_ELMNT || xml_spec(xc) != ki->ki_yang)
+            continue;
+        if (cb == NULL && (cb = cbuf_new()) == NULL){
+            clixon_err(OE_UNIX, errno, "cbuf_new");
+            goto done;
+        }
+        if ((ret = xml_key_index_str(xc, ki->ki_yang, cb)) < 0)
+            goto done;
+        if (ret == 0){
+            if (ki->ki_noindex > 0){
+                ki->ki_noindex--;
+                continue;
+            }
+            goto drop;
+        }
+        hash = xml_key_index_hash(cbuf_get(cb));
+        kep = &ki->ki_bucket[hash & (ki->ki_size - 1)];
+        for (; (ke = *kep) != NULL; kep = &ke->ke_next)
+            if (ke->ke_hash == hash && strcmp(ke->ke_key, cbuf_get(cb)) == 0)
+                break;
+        if (ke == NULL || ke->ke_x != xc || ke->ke_nr != 1)
+            goto drop;
+        *kep = ke->ke_next;
+        free(ke->ke_key);
+        free(ke);
+        ki->ki_len--;
+        continue;
+    drop:
+        if (xml_key_index_drop(xp, ki) < 0)
+            goto done;
+    }
+    retval = 0;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+}
+#endif /* XML_LIST_KEY_INDEX */
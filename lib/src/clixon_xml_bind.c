@@ -79,6 +79,7 @@
 #include "clixon_xml_sort.h"
 #include "clixon_yang_type.h"
 #include "clixon_xml_map.h"
+#include "clixon_xml_default.h"
 #include "clixon_xml_bind.h"
 #include "banned.h"
 
@@ -537,6 +538,55 @@ xml_bind_yang_mnt(clixon_handle h,
     goto done;
 }
 
+/*! Complete a bound node in bulk mode: check state data, sort and add defaults
+ *
+ * Called when all children of the node are bound, ie on element close in a post-order
+ * traversal. Replaces separate xml_non_config_data, xml_sort_recurse and
+ * xml_default_recurse passes over the whole tree.
+ * @param[in]   xt     XML node, bound to yang
+ * @param[in]   xdefer Nodes with when-dependent defaults, completed by caller
+ * @param[out]  xerr   Reason for failure, or NULL, in which case state data is marked
+ * @retval      1      OK
+ * @retval      0      State data node found and xerr set
+ * @retval     -1      Error
+ * @see xml_non_config_data
+ */
+static int
+xml_bind_bulk_close(cxobj       *xt,
+                    clixon_xvec *xdefer,
+                    cxobj      **xerr)
+{
+    int        retval = -1;
+    yang_stmt *y;
+    cbuf      *cb = NULL;
+
+    if ((y = xml_spec(xt)) != NULL && !yang_config(y)){ /* config == false means state data */
+        if (xerr){
+            if ((cb = cbuf_new()) == NULL){
+                clixon_err(OE_UNIX, errno, "cbuf_new");
+                goto done;
+            }
+            cprintf(cb, "module %s: state data node unexpected", yang_argument_get(ys_module(y)));
+            if (netconf_bad_element_xml(xerr, "application", yang_argument_get(y), cbuf_get(cb)) < 0)
+                goto done;
+            goto fail;
+        }
+        xml_flag_set(xt, XML_FLAG_MARK);
+    }
+    if (xml_sort_if_needed(xt) < 0)
+        goto done;
+    if (xml_default_node(xt, 0, xdefer) < 0)
+        goto done;
+    retval = 1;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
 /*! Bind yang opt
  *
  * @param[in]   h      Clixon handle (sometimes NULL)
@@ -546,10 +596,12 @@ xml_bind_yang_mnt(clixon_handle h,
  * @param[in]   xsibling
  * @param[in]   jsonenc JSON encoding according to RFC7951, prefixes are module-names
  * @param[in]   skip_mnt If set, do not proceed binding across mount-points
+ * @param[in]   xdefer If set, bulk mode: also check, sort and default each node
  * @param[out]  xerr   Reason for failure, or NULL
  * @retval      1      OK yang assignment made
  * @retval      0      Partial or no yang assigment made (at least one failed) and xerr set
  * @retval     -1      Error
+ * @see xml_bind_bulk_close
  */
 static int
 xml_bind_yang0_opt(clixon_handle h,
@@ -559,6 +611,7 @@ xml_bind_yang0_opt(clixon_handle h,
                    cxobj        *xsibling,
                    int           jsonenc,
                    int           skip_mnt,
+                   clixon_xvec  *xdefer,
                    cxobj       **xerr)
 {
     int        retval = -1;
@@ -602,6 +655,10 @@ xml_bind_yang0_opt(clixon_handle h,
     else if (ret == 2)     /* ret=2 for anyxml from parent^ */
         goto ok;
     strip_body_objects(xt);
+#ifdef XML_CV_CACHE_KEYS
+    if (xml_cv_cache_key(xt) < 0)
+        goto done;
+#endif
     ybc = YB_PARENT;
     if (h && clicon_option_bool(h, "CLICON_YANG_SCHEMA_MOUNT") &&
         xml_schema_mount_point(xt)){
@@ -620,7 +677,7 @@ xml_bind_yang0_opt(clixon_handle h,
         if (yc0 != NULL &&
             clicon_strcmp(name0, name) == 0 &&
             clicon_strcmp(prefix0, prefix) == 0){
-            if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, xc0, jsonenc, skip_mnt, xerr)) < 0)
+            if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, xc0, jsonenc, skip_mnt, xdefer, xerr)) < 0)
                 goto done;
         }
         else if (xsibling) {
@@ -629,13 +686,13 @@ xml_bind_yang0_opt(clixon_handle h,
             if (xml2ns(xc, prefix, &ns) < 0)
                 goto done;
             if ((xs = xml_find_type_ns(xsibling, name, ns)) != NULL){
-                if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, xs, jsonenc, skip_mnt, xerr)) < 0)
+                if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, xs, jsonenc, skip_mnt, xdefer, xerr)) < 0)
                     goto done;
             }
-            else if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, NULL, jsonenc, skip_mnt, xerr)) < 0)
+            else if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, NULL, jsonenc, skip_mnt, xdefer, xerr)) < 0)
                 goto done;
         }
-        else if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, NULL, jsonenc, skip_mnt, xerr)) < 0)
+        else if ((ret = xml_bind_yang0_opt(h, xc, ybc, yspec, NULL, jsonenc, skip_mnt, xdefer, xerr)) < 0)
             goto done;
         if (ret == 0)
             goto fail;
@@ -645,6 +702,12 @@ xml_bind_yang0_opt(clixon_handle h,
         prefix0 = xml_prefix(xc);
     }
  ok:
+    if (xdefer){
+        if ((ret = xml_bind_bulk_close(xt, xdefer, xerr)) < 0)
+            goto done;
+        if (ret == 0)
+            goto fail;
+    }
     retval = 1;
  done:
     return retval;
@@ -653,7 +716,7 @@ xml_bind_yang0_opt(clixon_handle h,
     goto done;
 }
 
-/*! Find yang spec association of tree of XML nodes
+/*! Find yang spec association of tree of XML nodes, optionally in bulk mode
  *
  * @param[in]   h      Clixon handle (sometimes NULL)
  * @param[in]   xt     XML tree node
@@ -661,20 +724,22 @@ xml_bind_yang0_opt(clixon_handle h,
  * @param[in]   yspec  Yang spec
  * @param[in]   jsonenc JSON encoding according to RFC7951, prefixes are module-names
  * @param[in]   skip_mnt If set, do not proceed binding across mount-points
+ * @param[in]   xdefer If set, bulk mode, see xml_bind_yang_bulk
  * @param[out]  xerr   Reason for failure, or NULL (call xml_free() after use)
  * @retval      1      OK yang assignment made
  * @retval      0      Partial or no yang assigment made (at least one failed) and xerr set
  * @retval     -1      Error
  * Populate xt as top-level node
- * @see xml_bind_yang  If only children of xt should be populated, not xt itself
+ * @see xml_bind_yang0
  */
-int
-xml_bind_yang0(clixon_handle h,
+static int
+xml_bind_yang1(clixon_handle h,
                cxobj        *xt,
                yang_bind     yb,
                yang_stmt    *yspec,
                int           jsonenc,
                int           skip_mnt,
+               clixon_xvec  *xdefer,
                cxobj       **xerr)
 {
     int        retval = -1;
@@ -712,6 +777,10 @@ xml_bind_yang0(clixon_handle h,
     else if (ret == 2)     /* ret=2 for anyxml from parent^ */
         goto ok;
     strip_body_objects(xt);
+#ifdef XML_CV_CACHE_KEYS
+    if (xml_cv_cache_key(xt) < 0)
+        goto done;
+#endif
     if (h && clicon_option_bool(h, "CLICON_YANG_SCHEMA_MOUNT")&&
         xml_schema_mount_point(xt)){
         if ((ret = yang_schema_mount_yspec(h, xt, skip_mnt,
@@ -725,12 +794,116 @@ xml_bind_yang0(clixon_handle h,
     }
     ix = 0;
     while ((xc = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL) {
-        if ((ret = xml_bind_yang0_opt(h, xc, YB_PARENT, yspec, NULL, jsonenc, skip_mnt, xerr)) < 0)
+        if ((ret = xml_bind_yang0_opt(h, xc, YB_PARENT, yspec, NULL, jsonenc, skip_mnt, xdefer, xerr)) < 0)
             goto done;
         if (ret == 0)
             goto fail;
     }
  ok:
+    if (xdefer){
+        if ((ret = xml_bind_bulk_close(xt, xdefer, xerr)) < 0)
+            goto done;
+        if (ret == 0)
+            goto fail;
+    }
+    retval = 1;
+ done:
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
+
+/*! Find yang spec association of tree of XML nodes
+ *
+ * @param[in]   h      Clixon handle (sometimes NULL)
+ * @param[in]   xt     XML tree node
+ * @param[in]   yb     How to bind yang to XML top-level when parsing
+ * @param[in]   yspec  Yang spec
+ * @param[in]   jsonenc JSON encoding according to RFC7951, prefixes are module-names
+ * @param[in]   skip_mnt If set, do not proceed binding across mount-points
+ * @param[out]  xerr   Reason for failure, or NULL (call xml_free() after use)
+ * @retval      1      OK yang assignment made
+ * @retval      0      Partial or no yang assigment made (at least one failed) and xerr set
+ * @retval     -1      Error
+ * Populate xt as top-level node
+ * @see xml_bind_yang  If only children of xt should be populated, not xt itself
+ */
+int
+xml_bind_yang0(clixon_handle h,
+               cxobj        *xt,
+               yang_bind     yb,
+               yang_stmt    *yspec,
+               int           jsonenc,
+               int           skip_mnt,
+               cxobj       **xerr)
+{
+    return xml_bind_yang1(h, xt, yb, yspec, jsonenc, skip_mnt, NULL, xerr);
+}
+
+/*! Single-pass bulk load of a parsed XML tree: bind yang, check, sort and add defaults
+ *
+ * Equivalent to xml_bind_yang(YB_MODULE) followed by xml_non_config_data(),
+ * xml_sort_recurse() and xml_default_recurse(), but in one traversal of the tree.
+ * Each node is bound to yang when opened, and checked for state data, sorted and given
+ * default values when closed, ie when all its children are complete.
+ * Sorting is skipped with a linear check if the children are already sorted, which is the
+ * common case for a datastore written by clixon.
+ * Default values depending on a when statement are not created here, since the when
+ * xpath may refer to parts of the tree not yet complete. Such nodes are instead added to
+ * xdefer. Complete them in reverse order when the tree is done, ie parents before
+ * children, as follows:
+ * @code
+ *   clixon_xvec *xdefer = clixon_xvec_new();
+ *   if ((ret = xml_bind_yang_bulk(h, xt, yspec, xdefer, &xerr)) < 0)
+ *     err;
+ *   if (ret == 0)
+ *     invalid;
+ *   for (i=clixon_xvec_len(xdefer)-1; i>=0; i--)
+ *     if (xml_default_node(clixon_xvec_i(xdefer, i), 0, NULL) < 0)
+ *       err;
+ *   clixon_xvec_free(xdefer);
+ * @endcode
+ * @param[in]   h      Clixon handle
+ * @param[in]   xt     XML tree, top-level symbol, eg as read from a datastore with YB_NONE
+ * @param[in]   yspec  Yang spec
+ * @param[in]   xdefer Vector of nodes with deferred when-dependent default values
+ * @param[out]  xerr   Reason for failure, or NULL (call xml_free() after use)
+ * @retval      1      OK
+ * @retval      0      Bind failed or state data found, xerr set
+ * @retval     -1      Error
+ * @note global defaults are not added, see xml_global_defaults
+ */
+int
+xml_bind_yang_bulk(clixon_handle h,
+                   cxobj        *xt,
+                   yang_stmt    *yspec,
+                   clixon_xvec  *xdefer,
+                   cxobj       **xerr)
+{
+    int    retval = -1;
+    cxobj *xc;
+    int    ix;
+    int    ret;
+
+    if (xdefer == NULL){
+        clixon_err(OE_XML, EINVAL, "xdefer is NULL");
+        goto done;
+    }
+    strip_body_objects(xt);
+    ix = 0;
+    while ((xc = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL) {
+        if ((ret = xml_bind_yang1(h, xc, YB_MODULE, yspec, 0, 0, xdefer, xerr)) < 0)
+            goto done;
+        if (ret == 0){
+            clixon_debug(CLIXON_DBG_YANG, "Bind failed: %s", xml_name(xc));
+            goto fail;
+        }
+    }
+    if ((ret = xml_bind_bulk_close(xt, xdefer, xerr)) < 0)
+        goto done;
+    if (ret == 0)
+        goto fail;
     retval = 1;
  done:
     return retval;
@@ -62,6 +62,7 @@
 #include "clixon_handle.h"
 #include "clixon_yang.h"
 #include "clixon_xml.h"
+#include "clixon_xml_vec.h"
 #include "clixon_err.h"
 #include "clixon_log.h"
 #include "clixon_debug.h"
@@ -79,7 +80,7 @@
 #include "banned.h"
 
 /* Forward */
-static int xml_default(yang_stmt *yt, cxobj *xt, int state);
+static int xml_default(yang_stmt *yt, cxobj *xt, int state, clixon_xvec *xdefer);
 
 /*!
  */
@@ -203,9 +204,10 @@ xml_default_create_cv(yang_stmt *y,
  *   is present 
  */
 static int
-xml_default_choice(yang_stmt *yc,
-                   cxobj     *xt,
-                   int        state)
+xml_default_choice(yang_stmt   *yc,
+                   cxobj       *xt,
+                   int          state,
+                   clixon_xvec *xdefer)
 {
     int        retval = -1;
     cxobj     *x = NULL;
@@ -238,7 +240,7 @@ xml_default_choice(yang_stmt *yc,
             yca = NULL;
     }
     if (yca)
-        if (xml_default(yca, xt, state) < 0)
+        if (xml_default(yca, xt, state, xdefer) < 0)
             goto done;
     retval = 0;
  done:
@@ -319,22 +321,62 @@ xml_nopresence_try(yang_stmt *yt,
     return retval;
 }
 
+/*! Check if a when statement is associated with a yang node, without evaluating it
+ *
+ * @param[in]   y       Yang node
+ * @retval      1       Yes, there is a when statement, directly or via augment/uses
+ * @retval      0       No
+ * @see yang_check_when_xpath  which also evaluates the when statement
+ */
+static int
+xml_default_when_exists(yang_stmt *y)
+{
+    return yang_when_get(NULL, y) != NULL || yang_find(y, Y_WHEN, NULL) != NULL;
+}
+
+/*! Defer default values of an xml node to a later pass
+ *
+ * @param[in]   xt      XML node
+ * @param[in]   xdefer  Vector of deferred nodes
+ * @retval      0       OK
+ * @retval     -1       Error
+ */
+static int
+xml_default_defer(cxobj       *xt,
+                  clixon_xvec *xdefer)
+{
+    int len;
+
+    /* Choice cases defer the same node as their parent */
+    if ((len = clixon_xvec_len(xdefer)) > 0 &&
+        clixon_xvec_i(xdefer, len-1) == xt)
+        return 0;
+    return clixon_xvec_append(xdefer, xt);
+}
+
 /*! Ensure default values are set on (children of) one single xml node
  *
  * Not recursive, except in one case with one or several non-presence containers, in which case
  * XML containers may be created to host default values. That code may be a little too recursive.
+ * Children are sorted once after all defaults of the node are created, or before a when
+ * statement is evaluated, not after each created default.
+ * If xdefer is set, defaults depending on a when statement are not created, since the
+ * when xpath may refer to nodes not yet bound or defaulted. Instead the node is added to
+ * xdefer, and the caller should call this function again on the node later.
  * @param[in]   yt      Yang spec, usually spec of xt but always (eg Y_CASE)
  * @param[in]   xt      XML tree (with yt as spec of xt, informally)
  * @param[in]   state   Set if global state, otherwise config
+ * @param[in]   xdefer  If set, defer when-dependent defaults and add xt to this vector
  * @retval      0       OK
  * @retval     -1       Error
  * XXX If state, should not add config defaults
  *      if (state && yang_config(yc)) 
  */
 static int
-xml_default(yang_stmt *yt,
-            cxobj     *xt,
-            int        state)
+xml_default(yang_stmt   *yt,
+            cxobj       *xt,
+            int          state,
+            clixon_xvec *xdefer)
 {
     int        retval = -1;
     yang_stmt *yc;
@@ -346,6 +388,9 @@ xml_default(yang_stmt *yt,
     int        create = 0;
     int        nr = 0;
     int        hit = 0;
+    int        sort = 0; /* Children added, sort at end or before when */
+    int        defer = 0;
+    int        deferlen = 0;
     cg_var    *cv;
     cvec      *cvv;
     int        inext;
@@ -380,6 +425,16 @@ xml_default(yang_stmt *yt,
                     goto done;
                 }
                 if (!cv_flag(cv, V_UNSET)){  /* Default value exists */
+                    if (xml_default_when_exists(yc)){
+                        if (xdefer){
+                            defer++;
+                            break;
+                        }
+                        if (sort){ /* when xpath may refer to siblings */
+                            xml_sort(xt);
+                            sort = 0;
+                        }
+                    }
                     /* Check when condition */
                     if (yang_check_when_xpath(NULL, xt, yc, &hit, &nr, NULL) < 0)
                         goto done;
@@ -389,7 +444,7 @@ xml_default(yang_stmt *yt,
                         /* No such child exist, create this leaf */
                         if (xml_default_create(yc, xt, top) < 0)
                             goto done;
-                        xml_sort(xt);
+                        sort++;
                     }
                 }
                 break;
@@ -397,6 +452,16 @@ xml_default(yang_stmt *yt,
                 /* RFC 7950 Sec 7.7.2: defaults used when no instances exist in tree */
                 if ((cvv = yang_cvec_get(yc)) != NULL &&
                     xml_find_type(xt, NULL, yang_argument_get(yc), CX_ELMNT) == NULL){
+                    if (xml_default_when_exists(yc)){
+                        if (xdefer){
+                            defer++;
+                            break;
+                        }
+                        if (sort){ /* when xpath may refer to siblings */
+                            xml_sort(xt);
+                            sort = 0;
+                        }
+                    }
                     /* Check when condition */
                     if (yang_check_when_xpath(NULL, xt, yc, &hit, &nr, NULL) < 0)
                         goto done;
@@ -407,11 +472,21 @@ xml_default(yang_stmt *yt,
                         if (xml_default_create_cv(yc, xt, cv) < 0)
                             goto done;
                     }
-                    xml_sort(xt);
+                    sort++;
                 }
                 break;
             case Y_CONTAINER:
                 if (yang_find(yc, Y_PRESENCE, NULL) == NULL){
+                    if (xml_default_when_exists(yc)){
+                        if (xdefer){
+                            defer++;
+                            break;
+                        }
+                        if (sort){ /* when xpath may refer to siblings */
+                            xml_sort(xt);
+                            sort = 0;
+                        }
+                    }
                     /* Check when condition */
                     if (yang_check_when_xpath(NULL, xt, yc, &hit, &nr, NULL) < 0)
                         goto done;
@@ -430,7 +505,7 @@ xml_default(yang_stmt *yt,
                                 goto done;
                             if (xml_addsub(xt, xc1) < 0)
                                 goto done;
-                            xml_sort(xt);
+                            sort++;
                         }
                         else
 #endif
@@ -444,14 +519,20 @@ xml_default(yang_stmt *yt,
                                     if (xml_default_create1(yc, xt, &xc) < 0)
                                         goto done;
                                     xml_sort(xt);
+                                    sort = 0;
                                     /* Then call it recursively */
-                                    if (xml_default(yc, xc, state) < 0)
+                                    if (xdefer)
+                                        deferlen = clixon_xvec_len(xdefer);
+                                    if (xml_default(yc, xc, state, xdefer) < 0)
                                         goto done;
 #ifdef OPTIMIZE_NO_PRESENCE_CONTAINER
-                                    if ((xc1 = xml_dup(xc)) == NULL)
-                                        goto done;
-                                    if (yang_nopresence_cache_set(yc, xc1) < 0)
-                                        goto done;
+                                    /* Do not cache a partial container */
+                                    if (xdefer == NULL || clixon_xvec_len(xdefer) == deferlen){
+                                        if ((xc1 = xml_dup(xc)) == NULL)
+                                            goto done;
+                                        if (yang_nopresence_cache_set(yc, xc1) < 0)
+                                            goto done;
+                                    }
 #endif
                                 }
                             }
@@ -459,7 +540,11 @@ xml_default(yang_stmt *yt,
                 }
                 break;
             case Y_CHOICE:{
-                if (xml_default_choice(yc, xt, state) < 0)
+                if (sort){
+                    xml_sort(xt);
+                    sort = 0;
+                }
+                if (xml_default_choice(yc, xt, state, xdefer) < 0)
                     goto done;
                 break;
             }
@@ -467,6 +552,10 @@ xml_default(yang_stmt *yt,
                 break;
             }
         }
+        if (sort)
+            xml_sort(xt);
+        if (defer && xml_default_defer(xt, xdefer) < 0)
+            goto done;
         break;
     default:
         break;
@@ -476,6 +565,40 @@ xml_default(yang_stmt *yt,
     return retval;
 }
 
+/*! Fill in default values of the children of one xml node, not recursive
+ *
+ * Used by single-pass loaders that add defaults when a node is complete, ie all its
+ * children are bound and sorted.
+ * @param[in]   xn      XML node, bound to yang
+ * @param[in]   state   If set expand defaults also for state data, otherwise only config
+ * @param[in]   xdefer  If set, defaults depending on when statements are not created, but
+ *                      xn is added to this vector. Call again with xdefer=NULL in reverse
+ *                      vector order when the whole tree is complete.
+ * @retval      0       OK
+ * @retval     -1       Error
+ * @see xml_default_recurse
+ * @see xml_bind_yang_bulk
+ */
+int
+xml_default_node(cxobj       *xn,
+                 int          state,
+                 clixon_xvec *xdefer)
+{
+    int        retval = -1;
+    yang_stmt *yn;
+
+    if ((yn = xml_spec(xn)) != NULL){
+        if (!state && !yang_config(yn))
+            goto ok;
+        if (xml_default(yn, xn, state, xdefer) < 0)
+            goto done;
+    }
+ ok:
+    retval = 0;
+ done:
+    return retval;
+}
+
 /*! Selectively recursively fill in default values in an XML tree using flags
  *
  * Skip nodes that are not either CHANGE or "flag" (typically ADD|DEL)
@@ -509,7 +632,7 @@ xml_default_recurse(cxobj *xn,
             goto skip;
     }
     if ((yn = (yang_stmt*)xml_spec(xn)) != NULL){
-        if (xml_default(yn, xn, state) < 0)
+        if (xml_default(yn, xn, state, NULL) < 0)
             goto done;
     }
     ix = 0;
@@ -551,7 +674,7 @@ xml_global_defaults_create(cxobj     *xt,
     }
     inext = 0;
     while ((ymod = yn_iter(yspec, &inext)) != NULL)
-        if (xml_default(ymod, xt, state) < 0)
+        if (xml_default(ymod, xt, state, NULL) < 0)
             goto done;
     retval = 0;
  done:
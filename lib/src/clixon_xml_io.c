@@ -109,7 +109,7 @@ static int xml_diff2cbuf(cbuf *cb, cxobj *x0, cxobj *x1, int level, int skiptop)
  * @retval      0    Remove it
  * @retval     -1    Error
  */
-static int
+int
 xml2output_wdef(cxobj            *x,
                 withdefaults_type wdef,
                 int              *tag)
@@ -978,10 +978,26 @@ _xml_parse(clixon_handle h,
     }
     xy.xy_xtop = xt;
     xy.xy_xparent = xt;
-    if (clixon_xml_parsel_init(&xy) < 0)
-        goto done;
-    if (clixon_xml_parseparse(&xy, xy.xy_scanner) != 0)  /* yacc returns 1 on error */
+#ifdef XML_PARSE_FAST
+    if ((ret = clixon_xml_parse_fast(xy.xy_parse_string, xt, &xy.xy_xvec, &xy.xy_xlen)) < 0)
         goto done;
+    if (ret == 0){
+        /* Not handled by fast parser: remove partial result and restore string */
+        for (i = 0; i < xy.xy_xlen; i++)
+            if (xml_purge(xy.xy_xvec[i]) < 0)
+                goto done;
+        xy.xy_xlen = 0;
+        memcpy(xy.xy_parse_string, str, strlen(str) + 1);
+    }
+#else
+    ret = 0;
+#endif
+    if (ret == 0){
+        if (clixon_xml_parsel_init(&xy) < 0)
+            goto done;
+        if (clixon_xml_parseparse(&xy, xy.xy_scanner) != 0)  /* yacc returns 1 on error */
+            goto done;
+    }
     /* Purge all top-level body objects */
     x = NULL;
     while ((x = xml_find_type(xt, NULL, "body", CX_BODY)) != NULL)
@@ -1042,7 +1058,8 @@ _xml_parse(clixon_handle h,
     retval = 1;
  done:
     clixon_debug(CLIXON_DBG_PARSE | CLIXON_DBG_DETAIL, "retval:%d", retval);
-    clixon_xml_parsel_exit(&xy);
+    if (xy.xy_scanner)
+        clixon_xml_parsel_exit(&xy);
     if (xy.xy_parse_string != NULL)
         free(xy.xy_parse_string);
     if (xy.xy_xvec)
@@ -1086,17 +1103,14 @@ clixon_xml_parse_file(FILE      *fp,
                       cxobj    **xt,
                       cxobj    **xerr)
 {
-    int   retval = -1;
-    int   len = 0;
-    char  ch;
-    char *xmlbuf = NULL;
-    char *ptr;
-    int   xmlbuflen = BUFLEN; /* start size */
-    int   oldxmlbuflen;
-    int   failed = 0;
-    int   xtempty; /* empty on entry */
+    int    retval = -1;
+    size_t len = 0;
+    char  *xmlbuf = NULL;
+    size_t xmlbuflen = BUFLEN; /* start size */
+    int    failed = 0;
+    int    xtempty; /* empty on entry */
     size_t sz;
-    int   ret;
+    int    ret;
 
     if (xt == NULL || fp == NULL){
         clixon_err(OE_XML, EINVAL, "arg is NULL");
@@ -1111,37 +1125,34 @@ clixon_xml_parse_file(FILE      *fp,
         clixon_err(OE_XML, errno, "malloc");
         goto done;
     }
-    memset(xmlbuf, 0, xmlbuflen);
-    ptr = xmlbuf;
+    /* Read whole file in blocks, then parse */
     while (1){
-        sz = fread(&ch, 1, 1, fp);
-        if (sz == 1){
-            xmlbuf[len++] = ch;
+        if (len >= xmlbuflen-1){ /* Space: one for the null character */
+            xmlbuflen *= 2;
+            if ((xmlbuf = realloc(xmlbuf, xmlbuflen)) == NULL){
+                clixon_err(OE_XML, errno, "realloc");
+                goto done;
+            }
         }
-        else if (sz == 0 && feof(fp)) {
+        sz = fread(xmlbuf+len, 1, xmlbuflen-1-len, fp);
+        len += sz;
+        if (sz > 0)
+            continue;
+        if (feof(fp)) {
+            xmlbuf[len] = '\0';
             if (*xt == NULL)
                 if ((*xt = xml_new(XML_TOP_SYMBOL, NULL, CX_ELMNT)) == NULL)
                     goto done;
-            if ((ret = _xml_parse(NULL, ptr, yb, yspec, *xt, xerr)) < 0)
+            if ((ret = _xml_parse(NULL, xmlbuf, yb, yspec, *xt, xerr)) < 0)
                 goto done;
             if (ret == 0)
                 failed++;
             break;
         }
         else {
-            clixon_err(OE_XML, 0, "fread %lu", sz);
+            clixon_err(OE_XML, errno, "fread");
             goto done;
         }
-        if (len >= xmlbuflen-1){ /* Space: one for the null character */
-            oldxmlbuflen = xmlbuflen;
-            xmlbuflen *= 2;
-            if ((xmlbuf = realloc(xmlbuf, xmlbuflen)) == NULL){
-                clixon_err(OE_XML, errno, "realloc");
-                goto done;
-            }
-            memset(xmlbuf+oldxmlbuflen, 0, xmlbuflen-oldxmlbuflen);
-            ptr = xmlbuf;
-        }
     } /* while */
     retval = (failed==0) ? 1 : 0;
  done:
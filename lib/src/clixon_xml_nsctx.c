@@ -115,6 +115,11 @@ nsctx_add_import_cb(yang_stmt *yimport,
  */
 static int _USE_NAMESPACE_NETCONF_DEFAULT = 0;
 
+/* If set, namespace lookups do not set the namespace cache of XML nodes
+ * @see xml_nscache_readonly
+ */
+static int _nscache_readonly = 0;
+
 /*! Set if use internal default namespace mechanism or not
  *
  * This function shouldnt really be here, it sets a local variable from the value of the
@@ -500,6 +505,23 @@ xml_nsctx_cbuf(cbuf *cb,
     return 0;
 }
 
+/*! Use the namespace cache of XML nodes read-only in namespace lookups
+ *
+ * In read-only mode xml2ns and xml2prefix do not set the namespace cache, so that XML
+ * trees may be searched concurrently by several threads.
+ * @param[in]  readonly  1: read-only, 0: set cache on lookup
+ * @retval     old       Previous mode
+ * @see xml_cv_cache_readonly
+ */
+int
+xml_nscache_readonly(int readonly)
+{
+    int old = _nscache_readonly;
+
+    _nscache_readonly = readonly;
+    return old;
+}
+
 /*! Given an xml tree return URI namespace recursively : default or localname given
  *
  * Given an XML tree and a prefix (or NULL) return URI namespace.
@@ -550,6 +572,7 @@ xml2ns(cxobj      *x,
      * If not, this is devastating when populating deep yang structures
      */
     if (ns &&
+        !_nscache_readonly &&
         xml_child_nr(x) > 1 &&  /* Dont set cache if few children: if 1 child typically a body */
         nscache_set(x, prefix, ns) < 0)
         goto done;
@@ -703,7 +726,7 @@ xml2prefix(cxobj      *xn,
         /* xmlns=namespace */
         if (strcmp("xmlns", xml_name(xa)) == 0){
             if (strcmp(xml_value(xa), namespace) == 0){
-                if (nscache_set(xn, NULL, namespace) < 0)
+                if (!_nscache_readonly && nscache_set(xn, NULL, namespace) < 0)
                     goto done;
                 prefix = NULL; /* Maybe should set all caches in ns:s children? */
                 goto found;
@@ -714,7 +737,7 @@ xml2prefix(cxobj      *xn,
                  strcmp("xmlns", xaprefix) == 0){
             if (strcmp(xml_value(xa), namespace) == 0){
                 prefix = xml_name(xa);
-                if (nscache_set(xn, prefix, namespace) < 0)
+                if (!_nscache_readonly && nscache_set(xn, prefix, namespace) < 0)
                     goto done;
                 goto found;
             }
@@ -724,7 +747,7 @@ xml2prefix(cxobj      *xn,
         if ((ret = xml2prefix(xp, namespace, &prefix)) < 0)
             goto done;
         if (ret == 1){
-            if (nscache_set(xn, prefix, namespace) < 0)
+            if (!_nscache_readonly && nscache_set(xn, prefix, namespace) < 0)
                 goto done;
             goto found;
         }
@@ -73,5 +73,6 @@ int   clixon_xml_parsel_exit(clixon_xml_yacc *ya);
 char *clixon_xml_parseget_text(yyscan_t yyscanner); /* Forward declaration: reentrant flex accessor */
 int   clixon_xml_parselex(union YYSTYPE *yylval, yyscan_t yyscanner);
 int   clixon_xml_parseparse(void *, yyscan_t);
+int   clixon_xml_parse_fast(char *str, cxobj *xt, cxobj ***xvec, size_t *xlen);
 
 #endif  /* _CLIXON_XML_PARSE_H_ */
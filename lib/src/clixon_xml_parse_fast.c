@@ -0,0 +1,441 @@
+/*
+ *
+  ***** BEGIN LICENSE BLOCK *****
+ 
+  Copyright (C) 2026 Olof Hagsand and Rubicon Communications, LLC(Netgate)
+
+  This file is part of CLIXON.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  Alternatively, the contents of this file may be used under the terms of
+  the GNU General Public License Version 3 or later (the "GPL"),
+  in which case the provisions of the GPL are applicable instead
+  of those above. If you wish to allow use of your version of this file only
+  under the terms of the GPL, and not to allow others to
+  use your version of this file under the terms of Apache License version 2, 
+  indicate your decision by deleting the provisions above and replace them with
+  the  notice and other provisions required by the GPL. If you do not delete
+  the provisions above, a recipient may use your version of this file under
+  the terms of any one of the Apache License version 2 or the GPL.
+
+  ***** END LICENSE BLOCK *****
+
+ * Fast XML parser for the common subset of XML used in datastores and internal messages
+ * A hand-written scanner that creates XML nodes directly, without lexer tokens and
+ * without accumulating body text in a cbuf. Tag and text boundaries are found with
+ * strchr/memchr, which are vectorized in most C libraries. Text is decoded in place.
+ * It produces the same tree as the flex/bison parser in clixon_xml_parse.[ly] for the
+ * following subset:
+ *   - Elements and attributes with optional prefixes
+ *   - Text with the predefined entities, numeric character references are kept encoded
+ *   - Comments
+ * Anything else, such as XML declarations, processing instructions, CDATA, DOCTYPE,
+ * unknown entities and all syntax errors, makes it give up. The caller then removes the
+ * partial result and runs the bison parser, which is thus kept for strict checking and
+ * error messages.
+ * @see _xml_parse
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "clixon_config.h" /* generated by config & autoconf */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+/* cligen */
+#include <cligen/cligen.h>
+
+/* clixon */
+#include "clixon_queue.h"
+#include "clixon_hash.h"
+#include "clixon_handle.h"
+#include "clixon_yang.h"
+#include "clixon_xml.h"
+#include "clixon_err.h"
+#include "clixon_string.h"
+#include "clixon_xml_parse.h"
+#include "banned.h"
+
+/* NCName characters, see clixon_xml_parse.l */
+#define fast_namestart(c) (((c)>='A'&&(c)<='Z') || ((c)>='a'&&(c)<='z') || (c)=='_')
+#define fast_namechar(c)  (fast_namestart(c) || ((c)>='0'&&(c)<='9') || (c)=='-' || (c)=='.')
+#define fast_space(c)     ((c)==' ' || (c)=='\t' || (c)=='\n' || (c)=='\r')
+
+/*! Skip whitespace inside a tag
+ */
+static char *
+fast_skip_space(char *p)
+{
+    while (fast_space(*p))
+        p++;
+    return p;
+}
+
+/*! Scan a qualified name: NCName or NCName:NCName
+ *
+ * @param[in]  p       Start of name
+ * @param[out] prefix  Start of prefix, or NULL if no prefix
+ * @param[out] name    Start of local name
+ * @param[out] nameend End of local name (character after)
+ * @retval     p       Position after name
+ * @retval     NULL    Not a qualified name
+ * @note prefix is terminated by ':' and name by *nameend, caller must NUL-terminate
+ */
+static char *
+fast_qname(char  *p,
+           char **prefix,
+           char **name,
+           char **nameend)
+{
+    char *s = p;
+
+    *prefix = NULL;
+    if (!fast_namestart(*p))
+        return NULL;
+    while (fast_namechar(*p))
+        p++;
+    if (*p == ':'){
+        *prefix = s;
+        s = ++p;
+        if (!fast_namestart(*p))
+            return NULL;
+        while (fast_namechar(*p))
+            p++;
+    }
+    *name = s;
+    *nameend = p;
+    return p;
+}
+
+/*! Decode text between tags in place
+ *
+ * The predefined entities are decoded, numeric character references are kept as is,
+ * and CR and CRLF are translated to LF, as done by clixon_xml_parse.l
+ * @param[in]  s     Start of text
+ * @param[in]  end   End of text (not NUL-terminated)
+ * @param[out] len   Length of decoded text, starting at s
+ * @retval     1     OK
+ * @retval     0     Unsupported or invalid entity
+ */
+static int
+fast_decode(char   *s,
+            char   *end,
+            size_t *len)
+{
+    char  *r = s;
+    char  *w = s;
+    char  *q;
+    size_t n = end - s;
+
+    /* Common case: nothing to decode */
+    if (memchr(s, '&', n) == NULL && memchr(s, '\r', n) == NULL){
+        *len = n;
+        return 1;
+    }
+    while (r < end){
+        if (*r == '&'){
+            n = end - r;
+            if (n >= 5 && strncmp(r, "&amp;", 5) == 0){
+                *w++ = '&'; r += 5;
+            }
+            else if (n >= 4 && strncmp(r, "&lt;", 4) == 0){
+                *w++ = '<'; r += 4;
+            }
+            else if (n >= 4 && strncmp(r, "&gt;", 4) == 0){
+                *w++ = '>'; r += 4;
+            }
+            else if (n >= 6 && strncmp(r, "&apos;", 6) == 0){
+                *w++ = '\''; r += 6;
+            }
+            else if (n >= 6 && strncmp(r, "&quot;", 6) == 0){
+                *w++ = '"'; r += 6;
+            }
+            else if (n >= 2 && r[1] == '#'){ /* Keep encoded: &#N; or &#xN; */
+                q = r + 2;
+                if (q < end && *q == 'x'){
+                    q++;
+                    while (q < end && ((*q>='0' && *q<='9') || (*q>='a' && *q<='f') || (*q>='A' && *q<='F')))
+                        q++;
+                    if (q == r + 3)
+                        return 0;
+                }
+                else{
+                    while (q < end && *q>='0' && *q<='9')
+                        q++;
+                    if (q == r + 2)
+                        return 0;
+                }
+                if (q == end || *q != ';')
+                    return 0;
+                q++;
+                while (r < q)
+                    *w++ = *r++;
+            }
+            else
+                return 0;
+        }
+        else if (*r == '\r'){
+            *w++ = '\n';
+            if (++r < end && *r == '\n')
+                r++;
+        }
+        else
+            *w++ = *r++;
+    }
+    *len = w - s;
+    return 1;
+}
+
+/*! Parse attributes and end of a start tag
+ *
+ * @param[in]  pp     Position after element name, updated to after start tag
+ * @param[in]  x      Element
+ * @param[out] empty  Set if empty element tag: <x/>
+ * @retval     1      OK
+ * @retval     0      Unsupported or invalid
+ * @retval    -1      Error
+ */
+static int
+fast_attrs(char  **pp,
+           cxobj  *x,
+           int    *empty)
+{
+    char  *p = *pp;
+    char  *prefix;
+    char  *name;
+    char  *nameend;
+    char  *val;
+    char  *valend;
+    char   c;
+    cxobj *xa;
+
+    while (1){
+        p = fast_skip_space(p);
+        if (*p == '>'){
+            *empty = 0;
+            p++;
+            break;
+        }
+        if (p[0] == '/' && p[1] == '>'){
+            *empty = 1;
+            p += 2;
+            break;
+        }
+        if ((p = fast_qname(p, &prefix, &name, &nameend)) == NULL)
+            return 0;
+        p = fast_skip_space(p);
+        if (*p++ != '=')
+            return 0;
+        p = fast_skip_space(p);
+        if (*p != '"' && *p != '\'')
+            return 0;
+        val = p + 1;
+        /* Attribute values are not decoded, see STRDQ and STRSQ in clixon_xml_parse.l */
+        if ((valend = strchr(val, *p)) == NULL)
+            return 0;
+        p = valend + 1;
+        c = *nameend;
+        *nameend = '\0';
+        if (prefix)
+            name[-1] = '\0';
+        *valend = '\0';
+        /* Duplicates are replaced, as in xml_parse_attr */
+        if ((xa = xml_find_type(x, prefix, name, CX_ATTR)) == NULL){
+            if ((xa = xml_new(name, x, CX_ATTR)) == NULL)
+                return -1;
+            if (prefix && xml_prefix_set(xa, prefix) < 0)
+                return -1;
+        }
+        if (xml_value_set(xa, val) < 0)
+            return -1;
+        *nameend = c;
+        if (prefix)
+            name[-1] = ':';
+        *valend = val[-1];
+    }
+    *pp = p;
+    return 1;
+}
+
+/*! Fast XML parser of a string into an existing XML tree
+ *
+ * Text is only kept in elements without element children, and text at top-level is
+ * skipped, which is the result of the bison parser after stripping pretty-print.
+ * @param[in]     str   XML string. Modified: text is decoded in place
+ * @param[in]     xt    XML top, new elements are added as children
+ * @param[in,out] xvec  Vector of created top-level elements
+ * @param[in,out] xlen  Length of xvec
+ * @retval        1     OK
+ * @retval        0     Unsupported or invalid XML, xvec contains partial result
+ * @retval       -1     Error
+ * @note str is modified also if 0 is returned, the caller needs to restore it
+ */
+int
+clixon_xml_parse_fast(char     *str,
+                      cxobj    *xt,
+                      cxobj  ***xvec,
+                      size_t   *xlen)
+{
+    int    retval = -1;
+    char  *p = str;
+    char  *end;
+    char  *prefix;
+    char  *name;
+    char  *nameend;
+    char  *seg = NULL;  /* Decoded text of current element, in place */
+    size_t seglen = 0;
+    size_t len;
+    cbuf  *cb = NULL;   /* Text of current element if split, eg by comments */
+    cxobj *xp = xt;     /* Current element */
+    cxobj *x;
+    int    haselem = 1; /* Current element has element children, skip text */
+    int    intag = 1;   /* Only whitespace allowed: at start and after comments */
+    int    depth = 0;
+    int    empty;
+    char   c;
+    int    ret;
+
+    while (*p != '\0'){
+        if (*p != '<'){ /* Text */
+            if ((end = strchr(p, '<')) == NULL)
+                end = p + strlen(p);
+            if (intag){
+                /* The bison lexer is in START state and only skips whitespace */
+                while (p < end && fast_space(*p))
+                    p++;
+                if (p < end)
+                    goto fail;
+                continue;
+            }
+            /* Decode also if skipped, to reject unknown entities */
+            if (fast_decode(p, end, &len) == 0)
+                goto fail;
+            if (!haselem){
+                if (len && seg == NULL && (cb == NULL || cbuf_len(cb) == 0)){
+                    seg = p;
+                    seglen = len;
+                }
+                else if (len){
+                    if (cb == NULL && (cb = cbuf_new()) == NULL){
+                        clixon_err(OE_XML, errno, "cbuf_new");
+                        goto done;
+                    }
+                    if (seg){
+                        cbuf_append_buf(cb, seg, seglen);
+                        seg = NULL;
+                    }
+                    cbuf_append_buf(cb, p, len);
+                }
+            }
+            p = end;
+        }
+        else if (p[1] == '/'){ /* End tag */
+            if (depth == 0)
+                goto fail;
+            p = fast_skip_space(p + 2);
+            if ((p = fast_qname(p, &prefix, &name, &nameend)) == NULL)
+                goto fail;
+            p = fast_skip_space(p);
+            if (*p++ != '>')
+                goto fail;
+            c = *nameend;
+            *nameend = '\0';
+            if (prefix)
+                name[-1] = '\0';
+            ret = clicon_strcmp(xml_name(xp), name) == 0 &&
+                clicon_strcmp(xml_prefix(xp), prefix) == 0;
+            *nameend = c;
+            if (prefix)
+                name[-1] = ':';
+            if (!ret)
+                goto fail;
+            if (!haselem){
+                if (cb && cbuf_len(cb)){
+                    if (xml_body_append(xp, cbuf_get(cb)) < 0)
+                        goto done;
+                    cbuf_reset(cb);
+                }
+                else if (seg){
+                    c = seg[seglen];
+                    seg[seglen] = '\0';
+                    ret = xml_body_append(xp, seg);
+                    seg[seglen] = c;
+                    if (ret < 0)
+                        goto done;
+                }
+            }
+            seg = NULL;
+            xp = xml_parent(xp);
+            depth--;
+            haselem = 1;
+            intag = 0;
+        }
+        else if (strncmp(p, "<!--", 4) == 0){ /* Comment */
+            if ((end = strstr(p + 4, "-->")) == NULL)
+                goto fail;
+            p = end + 3;
+            intag = 1;
+        }
+        else if (p[1] == '?' || p[1] == '!') /* PI, XML declaration, CDATA, DOCTYPE */
+            goto fail;
+        else { /* Start tag */
+            p = fast_skip_space(p + 1);
+            if ((p = fast_qname(p, &prefix, &name, &nameend)) == NULL)
+                goto fail;
+            c = *nameend;
+            *nameend = '\0';
+            if (prefix)
+                name[-1] = '\0';
+            x = xml_new(name, xp, CX_ELMNT);
+            if (x != NULL && prefix && xml_prefix_set(x, prefix) < 0)
+                x = NULL;
+            *nameend = c;
+            if (prefix)
+                name[-1] = ':';
+            if (x == NULL)
+                goto done;
+            if (xp == xt && cxvec_append(x, xvec, xlen) < 0)
+                goto done;
+            /* Parent has an element child: its text is stripped */
+            haselem = 1;
+            seg = NULL;
+            if (cb)
+                cbuf_reset(cb);
+            if ((ret = fast_attrs(&p, x, &empty)) < 0)
+                goto done;
+            if (ret == 0)
+                goto fail;
+            intag = 0;
+            if (!empty){
+                xp = x;
+                depth++;
+                haselem = 0;
+            }
+        }
+    }
+    if (depth != 0)
+        goto fail;
+    retval = 1;
+ done:
+    if (cb)
+        cbuf_free(cb);
+    return retval;
+ fail:
+    retval = 0;
+    goto done;
+}
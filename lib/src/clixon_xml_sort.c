@@ -77,20 +77,26 @@
 #include "clixon_xml_sort.h"
 #include "banned.h"
 
-/*! Get xml body value as cligen variable
+/* If set, xml_cmp does not set the cv cache of XML nodes
+ * @see xml_cv_cache_readonly
+ */
+static int _cv_cache_readonly = 0;
+
+/*! Get xml body value as cligen variable, internal variant
  *
- * @param[in]  x   XML node (body and leaf/leaf-list)
- * @param[out] cvp Pointer to cligen variable containing value of x body
- * @retval     0   OK, cvp contains cv or NULL
- * @retval    -1   Error
- * @note only applicable if x is body and has yang-spec and is leaf or leaf-list
- * Move to clixon_xml.c?
- * As a side-effect sets the cache.
- * Clear cache with xml_cv_set(x, NULL)
+ * @param[in]  x      XML node (body and leaf/leaf-list)
+ * @param[in]  strict If set, a body that does not parse as its type is an error
+ * @param[in]  store  If set, store value in cache of x, otherwise a non-cached value is
+ *                    returned as a new cv which the caller frees
+ * @param[out] cvp    Pointer to cligen variable containing value of x body
+ * @retval     0      OK, cvp contains cv or NULL (only if not strict)
+ * @retval    -1      Error
  */
 static int
-xml_cv_cache(cxobj   *x,
-             cg_var **cvp)
+xml_cv_cache1(cxobj   *x,
+              int      strict,
+              int      store,
+              cg_var **cvp)
 {
     int          retval = -1;
     cg_var      *cv = NULL;
@@ -130,10 +136,15 @@ xml_cv_cache(cxobj   *x,
         goto done;
     }
     if (ret == 0){
-        clixon_err(OE_YANG, EINVAL, "cv parse error: %s\n", reason);
-        goto done;
+        if (strict){
+            clixon_err(OE_YANG, EINVAL, "cv parse error: %s\n", reason);
+            goto done;
+        }
+        cv_free(cv); /* Not cached, leave it to validation to report */
+        cv = NULL;
+        goto ok;
     }
-    if (xml_cv_set(x, cv) < 0)
+    if (store && xml_cv_set(x, cv) < 0)
         goto done;
  ok:
     *cvp = cv;
@@ -147,6 +158,142 @@ xml_cv_cache(cxobj   *x,
     return retval;
 }
 
+/*! Get xml body value as cligen variable
+ *
+ * @param[in]  x   XML node (body and leaf/leaf-list)
+ * @param[out] cvp Pointer to cligen variable containing value of x body
+ * @retval     0   OK, cvp contains cv or NULL
+ * @retval    -1   Error
+ * @note only applicable if x is body and has yang-spec and is leaf or leaf-list
+ * As a side-effect sets the cache.
+ * Clear cache with xml_cv_set(x, NULL)
+ * @see xml_cv_cache_key  Pre-resolve cache of keys
+ */
+int
+xml_cv_cache(cxobj   *x,
+             cg_var **cvp)
+{
+    return xml_cv_cache1(x, 1, 1, cvp);
+}
+
+/*! Use the cv cache of XML nodes read-only when comparing, sorting and searching
+ *
+ * In read-only mode xml_cmp uses temporary values for nodes without cached value, and
+ * xml_cv_cache_key does nothing, so that XML trees may be searched concurrently by
+ * several threads.
+ * @param[in]  readonly  1: read-only, 0: set cache on comparison
+ * @retval     old       Previous mode
+ * @see xml_key_index_readonly
+ */
+int
+xml_cv_cache_readonly(int readonly)
+{
+    int old = _cv_cache_readonly;
+
+    _cv_cache_readonly = readonly;
+    return old;
+}
+
+/*! Check if the cv cache of an XML node with this yang spec should be kept
+ *
+ * This applies to list keys, leaf-list entries and explicit indexes, ie the nodes
+ * that xml_cmp compares when sorting and searching.
+ * @param[in]  y   Yang spec of XML node
+ * @retval     1   Yes, keep cache
+ * @retval     0   No
+ */
+static int
+xml_cv_cache_key_p(yang_stmt *y)
+{
+    yang_stmt *yp;
+    cg_var    *cvi = NULL;
+    char      *name;
+
+    if (y == NULL)
+        return 0;
+    switch (yang_keyword_get(y)){
+    case Y_LEAF_LIST:
+        return 1;
+    case Y_LEAF:
+        if (yang_flag_get(y, YANG_FLAG_INDEX))
+            return 1;
+        if ((yp = yang_parent_get(y)) == NULL ||
+            yang_keyword_get(yp) != Y_LIST)
+            return 0;
+        name = yang_argument_get(y);
+        while ((cvi = cvec_each(yang_cvec_get(yp), cvi)) != NULL)
+            if (strcmp(name, cv_string_get(cvi)) == 0)
+                return 1;
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/*! Pre-resolve the typed value of a list key, leaf-list entry or index leaf
+ *
+ * Typically called when binding yang so that sorting, binary search and diffs do not
+ * re-parse the key body on every comparison.
+ * Unlike xml_cv_cache, a body that does not parse as its type is not an error, instead
+ * the cache is left empty and validation reports the error.
+ * @param[in]  x   XML node bound to yang
+ * @retval     0   OK, cache set if applicable
+ * @retval    -1   Error
+ * @see xml_cv_cache
+ */
+int
+xml_cv_cache_key(cxobj *x)
+{
+    cg_var *cv = NULL;
+
+    if (_cv_cache_readonly || xml_cv(x) != NULL || !xml_cv_cache_key_p(xml_spec(x)))
+        return 0;
+    return xml_cv_cache1(x, 0, 1, &cv);
+}
+
+/*! Pre-resolve the typed key values of a list entry or leaf-list entry
+ *
+ * @param[in]  x   XML list or leaf-list node
+ * @param[in]  y   Yang spec of x
+ * @retval     0   OK
+ * @retval    -1   Error
+ */
+static int
+xml_cv_cache_keys(cxobj     *x,
+                  yang_stmt *y)
+{
+    int     retval = -1;
+    cg_var *cvi = NULL;
+    cxobj  *xk;
+
+    switch (yang_keyword_get(y)){
+    case Y_LEAF_LIST:
+        if (xml_cv_cache_key(x) < 0)
+            goto done;
+        break;
+    case Y_LIST:
+        while ((cvi = cvec_each(yang_cvec_get(y), cvi)) != NULL){
+            if ((xk = xml_find(x, cv_string_get(cvi))) != NULL &&
+                xml_cv_cache_key(xk) < 0)
+                goto done;
+        }
+        break;
+    default:
+        break;
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Clear cv cache of children of an XML node
+ *
+ * If XML_CV_CACHE_KEYS is set, the cache of list keys and leaf-list entries is kept
+ * @param[in]  xt  XML parent node
+ * @retval     0   OK
+ * @retval    -1   Error
+ */
 static int
 xml_cv_cache_clear(cxobj *xt)
 {
@@ -155,11 +302,61 @@ xml_cv_cache_clear(cxobj *xt)
     int    ix;
 
     ix = 0;
-    while ((x = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL)
+    while ((x = xml_child_iter(xt, &ix, CX_ELMNT)) != NULL){
+        if (xml_cv(x) == NULL)
+            continue;
+#ifdef XML_CV_CACHE_KEYS
+        if (xml_cv_cache_key_p(xml_spec(x)))
+            continue;
+#endif
         if (xml_cv_set(x, NULL) < 0)
             goto done;
+    }
+    retval = 0;
+ done:
+    return retval;
+}
+
+/*! Compare typed body values of two XML nodes
+ *
+ * Use cached values if any. In read-only mode, values not in the cache are parsed to
+ * temporary values that are freed after comparison.
+ * @param[in]  x1    XML node 1 with body
+ * @param[in]  x2    XML node 2 with body
+ * @param[out] eq    <0 if x1 is less than x2, 0 if equal, >0 if greater
+ * @retval     0     OK
+ * @retval    -1     Error
+ * @see xml_cv_cache_readonly
+ */
+static int
+xml_cmp_cv(cxobj *x1,
+           cxobj *x2,
+           int   *eq)
+{
+    int     retval = -1;
+    cg_var *cv1 = NULL;
+    cg_var *cv2 = NULL;
+    int     store = !_cv_cache_readonly;
+
+    if (xml_cv_cache1(x1, 1, store, &cv1) < 0) /* error case */
+        goto done;
+    if (xml_cv_cache1(x2, 1, store, &cv2) < 0) /* error case */
+        goto done;
+    if (cv1 != NULL && cv2 != NULL)
+        *eq = cv_cmp(cv1, cv2);
+    else if (cv1 == NULL && cv2 == NULL)
+        *eq = 0;
+    else if (cv1 == NULL)
+        *eq = -1;
+    else
+        *eq = 1;
     retval = 0;
  done:
+    /* Not stored and not previously cached: temporary values */
+    if (cv1 && cv1 != xml_cv(x1))
+        cv_free(cv1);
+    if (cv2 && cv2 != xml_cv(x2))
+        cv_free(cv2);
     return retval;
 }
 
@@ -219,8 +416,6 @@ xml_cmp(cxobj      *x1,
     char       *b1;
     char       *b2;
     char       *keyname;
-    cg_var     *cv1 = NULL;
-    cg_var     *cv2 = NULL;
     int         nr1 = 0;
     int         nr2 = 0;
     cxobj      *x1b;
@@ -325,20 +520,8 @@ xml_cmp(cxobj      *x1,
             equal = -1;
         else if (b2 == NULL)
             equal = 1;
-        else{
-            if (xml_cv_cache(x1, &cv1) < 0) /* error case */
-                goto done;
-            if (xml_cv_cache(x2, &cv2) < 0) /* error case */
-                goto done;
-            if (cv1 != NULL && cv2 != NULL)
-                equal = cv_cmp(cv1, cv2);
-            else if (cv1 == NULL && cv2 == NULL)
-                equal = 0;
-            else if (cv1 == NULL)
-                equal = -1;
-            else
-                equal = 1;
-        }
+        else if (xml_cmp_cv(x1, x2, &equal) < 0) /* error case */
+            goto done;
         break;
     case Y_LIST: /* Match with key values  */
         if (indexvar != NULL){
@@ -360,13 +543,8 @@ xml_cmp(cxobj      *x1,
                     equal = -1;
                 else if (b2 == NULL)
                     equal = 1;
-                else{
-                    if (xml_cv_cache(x1b, &cv1) < 0) /* error case */
-                        goto done;
-                    if (xml_cv_cache(x2b, &cv2) < 0) /* error case */
-                        goto done;
-                    equal = cv_cmp(cv1, cv2);
-                }
+                else if (xml_cmp_cv(x1b, x2b, &equal) < 0) /* error case */
+                    goto done;
             }
             if (equal)
                 break;
@@ -403,13 +581,8 @@ xml_cmp(cxobj      *x1,
                         equal = -1;
                     else if (b2 == NULL)
                         equal = 1;
-                    else{
-                        if (xml_cv_cache(x1b, &cv1) < 0) /* error case */
-                            goto done;
-                        if (xml_cv_cache(x2b, &cv2) < 0) /* error case */
-                            goto done;
-                        equal = cv_cmp(cv1, cv2);
-                    }
+                    else if (xml_cmp_cv(x1b, x2b, &equal) < 0) /* error case */
+                        goto done;
                 }
                 if (equal)
                     break;
@@ -488,6 +661,41 @@ xml_sort(cxobj *x)
     return 0;
 }
 
+/*! Sort children of an XML node only if they are not already sorted
+ *
+ * Already sorted input, such as a datastore written by clixon, is detected with a
+ * linear check, which avoids the qsort
+ * @param[in]  xn      XML node
+ * @retval     1       Not sortable, eg state data
+ * @retval     0       OK, sorted
+ * @retval    -1       Error
+ * @see xml_sort_recurse
+ */
+int
+xml_sort_if_needed(cxobj *xn)
+{
+    int retval = -1;
+    int ret;
+
+    ret = xml_sort_verify(xn, NULL);
+    if (ret == 1) /* This node is not sortable */
+        goto notsortable;
+    if (ret == -1){ /* not sorted */
+        if ((ret = xml_sort(xn)) < 0)
+            goto done;
+        if (ret == 1) /* This node is not sortable */
+            goto notsortable;
+    }
+    if (xml_cv_cache_clear(xn) < 0)
+        goto done;
+    retval = 0;
+ done:
+    return retval;
+ notsortable:
+    retval = 1;
+    goto done;
+}
+
 /*! Recursively sort a tree 
  *
  * Alt to use xml_apply
@@ -503,17 +711,10 @@ xml_sort_recurse(cxobj *xn)
     int    ix;
     int    ret;
 
-    ret = xml_sort_verify(xn, NULL);
+    if ((ret = xml_sort_if_needed(xn)) < 0)
+        goto done;
     if (ret == 1) /* This node is not sortable */
         goto ok;
-    if (ret == -1){ /* not sorted */
-        if ((ret = xml_sort(xn)) < 0)
-            goto done;
-        if (ret == 1) /* This node is not sortable */
-            goto ok;
-    }
-    if (xml_cv_cache_clear(xn) < 0)
-        goto done;
     ix = 0;
     while ((x = xml_child_iter(xn, &ix, CX_ELMNT)) != NULL) {
         if (xml_sort_recurse(x) < 0)
@@ -901,11 +1102,28 @@ xml_search_yang(cxobj       *xp,
     int    upper = xml_child_nr(xp);
     int    sorted = 1;
     int    yangi;
+#ifdef XML_LIST_KEY_INDEX
+    cxobj *xc;
+    int    ret;
+#endif
 
     if (xp == NULL){
         clixon_err(OE_XML, EINVAL, "xp is NULL");
         goto done;
     }
+#ifdef XML_LIST_KEY_INDEX
+    /* Hash lookup on the full key tuple, also for ordered-by user lists */
+    if (indexvar == NULL && yang_keyword_get(yc) == Y_LIST){
+        if ((ret = xml_key_index_find(xp, yc, x1, &xc)) < 0)
+            goto done;
+        /* Changed keys mark the index stale, so a miss is authoritative */
+        if (ret == 1){
+            if (xc != NULL && clixon_xvec_append(xvec, xc) < 0)
+                goto done;
+            goto ok;
+        }
+    }
+#endif
     upper = xml_child_nr(xp);
     /* Assume if there are any attributes, they are first in the list, mask
        them by raising low to skip them */
@@ -922,8 +1140,15 @@ xml_search_yang(cxobj       *xp,
             sorted = (yang_find(yc, Y_ORDERED_BY, "user") == NULL);
     if ((yangi = yang_order(yc)) < -1)
         goto done;
+    /* Resolve the search keys once instead of at every probe of the binary search */
+    if (indexvar == NULL &&
+        xml_cv_cache_keys(x1, yc) < 0)
+        goto done;
     if (xml_search_binary(xp, x1, sorted, yangi, low, upper, skip1, indexvar, xvec) < 0)
         goto done;
+#ifdef XML_LIST_KEY_INDEX
+ ok:
+#endif
     retval = 0;
  done:
     return retval;
@@ -1178,6 +1403,10 @@ xml_insert(cxobj           *xp,
     xml_parent_set(xi, xp);
     /* clear namespace context cache of child */
     nscache_clear(xi);
+#ifdef XML_LIST_KEY_INDEX
+    if (xml_key_index_child_insert(xp, xi) < 0)
+        goto done;
+#endif
 
     retval = 0;
  done:
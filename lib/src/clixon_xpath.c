@@ -104,6 +104,7 @@
 #include "clixon_xpath.h"
 #include "clixon_xpath_parse.h"
 #include "clixon_xpath_eval.h"
+#include "clixon_profile.h"
 #include "banned.h"
 
 /* Use apostrophe(') in XPath literals, eg a/[x='foo'], not double-quotes(")
@@ -651,6 +652,7 @@ xpath_vec_ctx(cxobj      *xcur,
     xp_ctx      xc = {0,};
 
     clixon_debug(CLIXON_DBG_XPATH | CLIXON_DBG_DETAIL, "%s", xpath);
+    clixon_profile_count(CLIXON_PROF_XPATH_EVAL);
     if (xpath_parse(xpath, &xptree) < 0)
         goto done;
     xc.xc_type = XT_NODESET;
@@ -50,6 +50,9 @@
 #include <syslog.h>
 #include <fcntl.h>
 #include <math.h> /* NaN */
+#ifdef HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
 
 /* cligen */
 #include <cligen/cligen.h>
@@ -77,7 +80,13 @@ static xpath_tree *_xmtop = NULL; /* pattern match tree top */
 static xpath_tree *_xm = NULL;
 static xpath_tree *_xe = NULL;
 static int _optimize_enable = 1;
+/* Hits are counted atomically since xpaths may be evaluated by backend plugin worker threads
+ * @see plugin_transaction_batch
+ */
 static int _optimize_hits = 0;
+#ifdef HAVE_LIBPTHREAD
+static pthread_once_t _optimize_once = PTHREAD_ONCE_INIT;
+#endif
 #endif /* XPATH_LIST_OPTIMIZE */
 
 /* XXX development in clixon_xpath_eval */
@@ -85,8 +94,12 @@ int
 xpath_list_optimize_stats(int *hits)
 {
 #ifdef XPATH_LIST_OPTIMIZE
+#ifdef HAVE_LIBPTHREAD
+    *hits = __atomic_exchange_n(&_optimize_hits, 0, __ATOMIC_RELAXED);
+#else
     *hits = _optimize_hits;
     _optimize_hits = 0;
+#endif
 #endif
     return 0;
 }
@@ -114,45 +127,69 @@ xpath_optimize_exit(void)
 }
 
 #ifdef XPATH_LIST_OPTIMIZE
+/*! Create pattern match trees, once
+ */
+static void
+xpath_optimize_init1(void)
+{
+    xpath_tree *xm;
+    xpath_tree *xe;
+    xpath_tree *xs;
+
+    /* Initialize xpath-tree */
+    if (xpath_parse("_x[_y='_z']", &_xmtop) < 0)
+        return;
+    /* Go down two steps */
+    if ((xm = xpath_tree_traverse(_xmtop, 0, 0, -1)) == NULL)
+        return;
+    /* get nodetest tree (_x) */
+    if ((xs = xpath_tree_traverse(xm, 0, -1)) == NULL)
+        return;
+    xs->xs_match++;
+    /* get predicates [_y=_z][z=2] */
+    if ((xs = xpath_tree_traverse(xm, 1, -1)) == NULL)
+        return;
+    xs->xs_match++;
+    /* get expression [_y=_z] */
+    if ((xe = xpath_tree_traverse(xs, 1, -1)) == NULL)
+        return;
+    /* get keyname (_y) */
+    if ((xs = xpath_tree_traverse(xe, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1)) == NULL)
+        return;
+    xs->xs_match++; /* in loop_preds get name in xs_s1 XXX: leaf-list is different */
+    /* get keyval (_z) */
+    if ((xs = xpath_tree_traverse(xe, 0, 0, 1, 0, 0, 0, 0, -1)) == NULL)
+        return;
+    xs->xs_match++; /* in loop_preds get value in xs_s0 or xs_strnr */
+    /* Set when complete */
+    _xe = xe;
+    _xm = xm;
+}
+
 /*! Initialize xpath module
  *
  * XXX move to clixon_xpath.c 
+ * The pattern match trees are created once, also if called by several threads
+ * @param[out] xm  Pattern match tree
+ * @param[out] xe  Pattern match expression
+ * @retval     0   OK
+ * @retval    -1   Error
  * @see loop_preds
  */
 int
 xpath_optimize_init(xpath_tree **xm,
                     xpath_tree **xe)
 {
-    int         retval = -1;
-    xpath_tree *xs;
+    int retval = -1;
 
-    if (_xm == NULL){
-        /* Initialize xpath-tree */
-        if (xpath_parse("_x[_y='_z']", &_xmtop) < 0)
-            goto done;
-        /* Go down two steps */
-        if ((_xm = xpath_tree_traverse(_xmtop, 0, 0, -1)) == NULL)
-            goto done;
-        /* get nodetest tree (_x) */
-        if ((xs = xpath_tree_traverse(_xm, 0, -1)) == NULL)
-            goto done;
-        xs->xs_match++;
-        /* get predicates [_y=_z][z=2] */
-        if ((xs = xpath_tree_traverse(_xm, 1, -1)) == NULL)
-            goto done;
-        xs->xs_match++;
-        /* get expression [_y=_z] */
-        if ((_xe = xpath_tree_traverse(xs, 1, -1)) == NULL)
-            goto done;
-        /* get keyname (_y) */
-        if ((xs = xpath_tree_traverse(_xe, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1)) == NULL)
-            goto done;
-        xs->xs_match++; /* in loop_preds get name in xs_s1 XXX: leaf-list is different */
-        /* get keyval (_z) */
-        if ((xs = xpath_tree_traverse(_xe, 0, 0, 1, 0, 0, 0, 0, -1)) == NULL)
-            goto done;
-        xs->xs_match++; /* in loop_preds get value in xs_s0 or xs_strnr */
-    }
+#ifdef HAVE_LIBPTHREAD
+    pthread_once(&_optimize_once, xpath_optimize_init1);
+#else
+    if (_xm == NULL)
+        xpath_optimize_init1();
+#endif
+    if (_xm == NULL)
+        goto done;
     *xm = _xm;
     *xe = _xe;
     retval = 0;
@@ -267,7 +304,8 @@ xpath_list_optimize_fn(xpath_tree  *xt,
      * That is, ONLY check optimize cases of this type:_x[_y='_z']
      * Should we extend this simple example and have more cases (all cases?)
      */
-    xpath_optimize_init(&xm, &xem);
+    if (xpath_optimize_init(&xm, &xem) < 0)
+        goto ok;
     /* Here is where pattern is checked for equality and where variable binding is made (if
      * equal) */
     if ((ret = xpath_tree_eq(xm, xt, &vec, &veclen)) < 0)
@@ -380,7 +418,11 @@ xpath_optimize_check(xpath_tree *xs,
         if (clixon_xvec_extract(xvec, xvec0, xlen0, NULL) < 0){
             goto done;
         }
+#ifdef HAVE_LIBPTHREAD
+        __atomic_fetch_add(&_optimize_hits, 1, __ATOMIC_RELAXED);
+#else
         _optimize_hits++;
+#endif
         retval = 1; /* Optimized */
         goto done;
     }
@@ -80,6 +80,7 @@
 #include "clixon_xpath_ctx.h"
 #include "clixon_xpath.h"
 #include "clixon_xpath_parse.h"
+#include "clixon_xpath_function.h"
 #include "clixon_yang_module.h"
 #include "clixon_plugin.h"
 #include "clixon_data.h"
@@ -90,6 +91,7 @@
 #include "clixon_yang_cardinality.h"
 #include "clixon_yang_type.h"
 #include "clixon_yang_schema_mount.h"
+#include "clixon_profile.h"
 #include "clixon_yang_internal.h" /* internal included by this file only, not API */
 #include "banned.h"
 
@@ -823,6 +825,7 @@ yang_stats_one(yang_stmt *ys,
                  sz += cvec_size(yc->yc_patterns);
              if (yc->yc_regexps)
                  sz += cvec_size(yc->yc_regexps);
+             sz += yc->yc_enumlen*sizeof(char*);
          }
          break;
     case Y_MODULE:
@@ -1321,6 +1324,14 @@ ys_cp_one(yang_stmt *ynew,
         if (yang_typecache_get(yold)) /* Dont copy type cache, use only original */
             yang_typecache_set(ynew, NULL);
         break;
+    case Y_MODULE:
+    case Y_SUBMODULE:
+        if (yold->ys_filename)
+            if ((ynew->ys_filename = strdup(yold->ys_filename)) == NULL){
+                clixon_err(OE_YANG, errno, "strdup");
+                goto done;
+            }
+        break;
 #ifdef OPTIMIZE_NO_PRESENCE_CONTAINER
     case Y_CONTAINER:
         yold->ys_nopres_cache = NULL;
@@ -1559,6 +1570,7 @@ yang_find(yang_stmt  *yn,
     yang_stmt *yorig;
     char      *arg;
 
+    clixon_profile_count(CLIXON_PROF_YANG_FIND);
     /* Recursion check */
     if (yang_flag_get(yn, YANG_FLAG_FIND) != 0x0)
         return NULL;
@@ -3780,6 +3792,161 @@ must_depth_walk(xpath_tree *xs,
     }
 }
 
+#ifdef VALIDATE_XPATH_MEMO
+/*! Walk xpath AST and mark expressions depending on current()
+ *
+ * Used for predicates, where relative paths are evaluated in the context of the
+ * predicate step, not the original context node. current() is still the context node.
+ * @param[in]     xs      XPath tree node
+ * @param[in,out] ctxdep  Set to 1 if the expression depends on the context node
+ */
+static void
+xpath_anchor_pred_walk(xpath_tree *xs,
+                       int        *ctxdep)
+{
+    if (xs == NULL)
+        return;
+    if (xs->xs_type == XP_PRIME_FN && xs->xs_int == XPATHFN_CURRENT)
+        *ctxdep = 1;
+    xpath_anchor_pred_walk(xs->xs_c0, ctxdep);
+    xpath_anchor_pred_walk(xs->xs_c1, ctxdep);
+}
+
+/*! Count leading parent steps of a relative location path
+ *
+ * XP_RELLOCPATH is left-recursive: RELLOCPATH(c0=prev_path, c1=latest_step).
+ * @param[in]     xs      XP_RELLOCPATH or XP_STEP tree node
+ * @param[out]    allpar  Set to 1 if all steps of xs are parent steps
+ * @param[in,out] ctxdep  Set to 1 if a predicate depends on the context node
+ * @retval        n       Number of leading parent steps
+ */
+static int
+xpath_anchor_leading(xpath_tree *xs,
+                     int        *allpar,
+                     int        *ctxdep)
+{
+    int n;
+    int allpar0 = 0;
+
+    *allpar = 0;
+    if (xs == NULL)
+        return 0;
+    switch (xs->xs_type){
+    case XP_RELLOCPATH:
+        n = xpath_anchor_leading(xs->xs_c0, &allpar0, ctxdep);
+        if (xs->xs_c1 == NULL){
+            *allpar = allpar0;
+            return n;
+        }
+        if (allpar0 && xs->xs_int != A_DESCENDANT_OR_SELF){
+            n += xpath_anchor_leading(xs->xs_c1, allpar, ctxdep);
+            return n;
+        }
+        xpath_anchor_leading(xs->xs_c1, &allpar0, ctxdep);
+        return n;
+    case XP_STEP:
+        xpath_anchor_pred_walk(xs->xs_c1, ctxdep);
+        if (xs->xs_int == A_PARENT){
+            *allpar = 1;
+            return 1;
+        }
+        return 0;
+    default:
+        xpath_anchor_pred_walk(xs, ctxdep);
+        return 0;
+    }
+}
+
+/*! Walk xpath AST to compute the anchor depth of an expression
+ *
+ * The anchor depth is the smallest number of leading parent steps of all relative
+ * location paths that are evaluated in the original context node, ie not in predicates.
+ * An expression with anchor depth n > 0 gives the same result for all context nodes
+ * with the same n:th ancestor, eg "count(../../entry[type='x']) < 100" evaluated in any
+ * leaf of an entry. Absolute paths do not restrict the anchor depth.
+ * An expression is context-dependent, ie cannot be anchored, if it has a relative path
+ * without leading parent steps, uses current(), or calls a function without arguments,
+ * such as position() or name(), which use the context node.
+ * @param[in]     xs      XPath tree node
+ * @param[in,out] anchor  Smallest anchor depth found so far
+ * @param[in,out] ctxdep  Set to 1 if the expression depends on the context node
+ */
+static void
+xpath_anchor_walk(xpath_tree *xs,
+                  int        *anchor,
+                  int        *ctxdep)
+{
+    int n;
+    int allpar;
+
+    if (xs == NULL)
+        return;
+    switch (xs->xs_type){
+    case XP_ABSPATH:
+        /* Same result in any context, but current() in predicates */
+        xpath_anchor_pred_walk(xs->xs_c0, ctxdep);
+        break;
+    case XP_RELLOCPATH:
+        if ((n = xpath_anchor_leading(xs, &allpar, ctxdep)) == 0)
+            *ctxdep = 1;
+        else if (n < *anchor)
+            *anchor = n;
+        break;
+    case XP_PATHEXPR:
+        /* filterexpr / rellocpath: the path is relative to the filter expression */
+        xpath_anchor_walk(xs->xs_c0, anchor, ctxdep);
+        xpath_anchor_pred_walk(xs->xs_c1, ctxdep);
+        break;
+    case XP_PRIME_FN:
+        if (xs->xs_int == XPATHFN_CURRENT)
+            *ctxdep = 1;
+        else if (xs->xs_c0 == NULL &&
+                 xs->xs_int != XPATHFN_TRUE &&
+                 xs->xs_int != XPATHFN_FALSE)
+            *ctxdep = 1;
+        xpath_anchor_walk(xs->xs_c0, anchor, ctxdep);
+        break;
+    default:
+        xpath_anchor_walk(xs->xs_c0, anchor, ctxdep);
+        xpath_anchor_walk(xs->xs_c1, anchor, ctxdep);
+        break;
+    }
+}
+
+/*! Cache anchor depth of a must/when xpath in ys_cvec as "anchor"
+ *
+ * Stores an int32 cv named "anchor" on the yang_stmt:
+ * - -1  : expression depends on its context node
+ * - >= 1: result is the same for all context nodes with the same ancestor at this depth
+ * @param[in]  ys      Y_MUST or Y_WHEN yang statement
+ * @param[in]  xptree  Parsed XPath of ys
+ * @retval     0       OK
+ * @retval    -1       Error
+ * @see xpath_memo_anchor  in clixon_validate.c
+ */
+static int
+ys_populate_xpath_anchor(yang_stmt  *ys,
+                         xpath_tree *xptree)
+{
+    int     anchor = INT_MAX;
+    int     ctxdep = 0;
+    cvec   *cvv;
+    cg_var *cv;
+
+    xpath_anchor_walk(xptree, &anchor, &ctxdep);
+    /* No relative path at all: anchor to top-level, not supported */
+    if (ctxdep || anchor == INT_MAX)
+        anchor = -1;
+    if ((cvv = yang_cvec_get(ys)) == NULL ||
+        (cv = cvec_find(cvv, "anchor")) == NULL){
+        if ((cv = yang_cvec_add(ys, CGV_INT32, "anchor")) == NULL)
+            return -1;
+    }
+    cv_int32_set(cv, anchor);
+    return 0;
+}
+#endif /* VALIDATE_XPATH_MEMO */
+
 /*! Parse an XPath string and cache ancestor depth on ys_cv
  *
  * Shared helper used by both Y_MUST and Y_PATH (leafref) to store the
@@ -3788,6 +3955,7 @@ must_depth_walk(xpath_tree *xs,
  * Stores an int32 cv on the yang_stmt:
  * - -1  : expression contains an absolute path — cannot skip
  * - >= 0: maximum ancestor depth of the relative expression
+ * For must and when, also the anchor depth, see ys_populate_xpath_anchor
  * @param[in]  ys   Y_MUST or Y_PATH yang statement
  * @retval     0    OK
  * @retval    -1    Error
@@ -3810,6 +3978,11 @@ ys_populate_xpath_depth(yang_stmt *ys)
         goto done;
     must_depth_walk(xptree, 0, &maxdepth, &abspath);
     stored = abspath ? -1 : (int32_t)maxdepth;
+#ifdef VALIDATE_XPATH_MEMO
+    if ((ys->ys_keyword == Y_MUST || ys->ys_keyword == Y_WHEN) &&
+        ys_populate_xpath_anchor(ys, xptree) < 0)
+        goto done;
+#endif
     if ((cv = cv_new(CGV_INT32)) == NULL){
         clixon_err(OE_UNIX, errno, "cv_new");
         goto done;
@@ -3891,8 +4064,8 @@ ys_populate(yang_stmt    *ys,
 #endif
         break;
     case Y_WHEN:
-#ifdef VALIDATE_INCREMENTAL
-        /* Cache when xpath depth for incremental skip; see validate_when1 */
+#if defined(VALIDATE_INCREMENTAL) || defined(VALIDATE_XPATH_MEMO)
+        /* Cache when xpath depth for incremental skip and memo; see validate_when1 */
         if (ys_populate_xpath_depth(ys) < 0)
             goto done;
 #endif
@@ -4534,6 +4707,48 @@ yang_key_match(yang_stmt  *yn,
     return retval;
 }
 
+/*! qsort and bsearch "compar" of enum names
+ */
+static int
+yang_enum_cmp(const void *arg1,
+              const void *arg2)
+{
+    return strcmp(*(char * const *)arg1, *(char * const *)arg2);
+}
+
+/*! Collect and sort enum names of an enumeration type into its type cache
+ *
+ * @param[in]  ytype   Enumeration type statement
+ * @param[in]  ycache  Type cache of ytype
+ * @retval     0       OK
+ * @retval    -1       Error
+ */
+static int
+yang_type_cache_enums(yang_stmt       *ytype,
+                      yang_type_cache *ycache)
+{
+    yang_stmt *yi;
+    int        inext;
+    uint32_t   len = 0;
+
+    inext = 0;
+    while ((yi = yn_iter(ytype, &inext)) != NULL)
+        if (yang_keyword_get(yi) == Y_ENUM)
+            len++;
+    if (len == 0)
+        return 0;
+    if ((ycache->yc_enums = calloc(len, sizeof(char*))) == NULL){
+        clixon_err(OE_UNIX, errno, "calloc");
+        return -1;
+    }
+    inext = 0;
+    while ((yi = yn_iter(ytype, &inext)) != NULL)
+        if (yang_keyword_get(yi) == Y_ENUM)
+            ycache->yc_enums[ycache->yc_enumlen++] = yang_argument_get(yi);
+    qsort(ycache->yc_enums, ycache->yc_enumlen, sizeof(char*), yang_enum_cmp);
+    return 0;
+}
+
 /*! Set type cache for yang type
  *
  * @param[in] rxmode  Which regexp engine to use, see enum regexp_mode
@@ -4583,11 +4798,84 @@ yang_type_cache_set2(yang_stmt *ys,
             goto done;
         }
     }
+    if (resolved == ys &&
+        strcmp(yang_argument_get(ys), "enumeration") == 0){
+        if (yang_type_cache_enums(ys, ycache) < 0)
+            goto done;
+    }
     retval = 0;
  done:
     return retval;
 }
 
+/*! Get fields by reference from yang type cache
+ *
+ * As yang_type_cache_get2 but without copying patterns and regexps
+ * @param[in]  ytype    Yang type statement
+ * @param[out] resolved Resolved type
+ * @param[out] options  Flags field of optional values, see YANG_OPTIONS_*
+ * @param[out] cvv      Cvec with min/max range or length, do not free
+ * @param[out] regexps  Cvec of compiled regexps or NULL, do not free
+ * @param[out] fraction For decimal64, how many digits after period
+ * @retval     1        OK
+ * @retval     0        No cache
+ * @see yang_type_cache_get2
+ */
+int
+yang_type_cache_ref(yang_stmt  *ytype,
+                    yang_stmt **resolved,
+                    int        *options,
+                    cvec      **cvv,
+                    cvec      **regexps,
+                    uint8_t    *fraction)
+{
+    yang_type_cache *ycache;
+
+    if ((ycache = yang_typecache_get(ytype)) == NULL)
+        return 0;
+    if (resolved)
+        *resolved = ycache->yc_resolved;
+    if (options)
+        *options  = ycache->yc_options;
+    if (cvv)
+        *cvv    = ycache->yc_cvv;
+    if (regexps)
+        *regexps = ycache->yc_regexps;
+    if (fraction)
+        *fraction = ycache->yc_fraction;
+    return 1;
+}
+
+/*! Find enum name in a resolved enumeration type
+ *
+ * Use the sorted enum names of the type cache if present, otherwise search children
+ * @param[in]  yrestype  Resolved enumeration type statement
+ * @param[in]  str       Enum name
+ * @retval     1         Found
+ * @retval     0         Not found
+ */
+int
+yang_type_enum_find(yang_stmt  *yrestype,
+                    const char *str)
+{
+    yang_type_cache *ycache;
+    yang_stmt       *yi;
+    int              inext;
+
+    if ((ycache = yang_typecache_get(yrestype)) != NULL &&
+        ycache->yc_enums != NULL)
+        return bsearch(&str, ycache->yc_enums, ycache->yc_enumlen,
+                       sizeof(char*), yang_enum_cmp) != NULL;
+    inext = 0;
+    while ((yi = yn_iter(yrestype, &inext)) != NULL){
+        if (yang_keyword_get(yi) != Y_ENUM)
+            continue;
+        if (strcmp(yang_argument_get(yi), str) == 0)
+            return 1;
+    }
+    return 0;
+}
+
 /*! Get individual fields (direct/destructively) from yang type cache.
  *
  * @param[out] patterns Initialized cvec of regexp patterns strings
@@ -4675,6 +4963,8 @@ yang_type_cache_free(yang_type_cache *ycache)
         }
         cvec_free(ycache->yc_regexps);
     }
+    if (ycache->yc_enums)
+        free(ycache->yc_enums);
     free(ycache);
     return 0;
 }
@@ -5045,6 +5335,7 @@ int
 yang_exit(clixon_handle h)
 {
     yang_stmt *ymounts;
+    yang_stmt *ypool = NULL;
 
     if (_yang_when_map != NULL) {
         free(_yang_when_map);
@@ -5058,5 +5349,9 @@ yang_exit(clixon_handle h)
         ys_free(ymounts);
     }
     clixon_yang_mounts_set(h, NULL);
+    if (clicon_ptr_get(h, YANG_MODULE_POOL, (void**)&ypool) == 0 && ypool != NULL){
+        ys_free(ypool);
+        clicon_ptr_del(h, YANG_MODULE_POOL);
+    }
     return 0;
 }
@@ -41,6 +41,11 @@
 #ifndef _CLIXON_YANG_INTERNAL_H_
 #define _CLIXON_YANG_INTERNAL_H_
 
+/* Handle data name of process-wide pool of parsed (sub)modules
+ * @see CLICON_YANG_SCHEMA_MOUNT_POOL
+ */
+#define YANG_MODULE_POOL "yang-module-pool"
+
 /*! Yang type cache. Yang type statements can cache all typedef info here
  *
  * @note unions not cached
@@ -57,6 +62,9 @@ struct yang_type_cache{
     cvec      *yc_patterns; /* List of regexp, if cvec_len() > 0 */
     cvec      *yc_regexps;  /* List of _compiled_ regexp, if cvec_len() > 0 */
     yang_stmt *yc_resolved; /* Resolved type object, can be NULL - note direct ptr */
+    char     **yc_enums;    /* Sorted enum names if resolved type is enumeration
+                             * Note direct ptrs to enum arguments */
+    uint32_t   yc_enumlen;  /* Length of yc_enums */
 };
 typedef struct yang_type_cache yang_type_cache;
 
@@ -106,11 +114,13 @@ struct yang_stmt {
                                         Y_IDENTITY: store all derived types as <module>:<id> list
                                         Y_LENGTH: length_min, length_max
                                         Y_LIST: vector of keys
+                                        Y_MUST: anchor depth of xpath memo
                                         Y_RANGE: range_min, range_max
                                         Y_SPEC: shared mount-point xpaths
                                         Y_TYPE: store all derived types as <module>:<id> list
                                         Y_UNIQUE: vector of descendant schema node ids
                                         Y_UNKNOWN: app-dep: yang-mount-points
+                                        Y_WHEN: anchor depth of xpath memo
                                      */
     yang_stmt         *ys_orig;      /* Pointer to original (for uses/augment copies) */
     union {                          /* Depends on ys_keyword */
@@ -625,28 +625,29 @@ yang_expand_uses_node(clixon_handle h,
         ys_free(ygrouping2);
         goto done;
     }
+    /* Only replace data/schemanodes and unknowns:
+     * Copy only such nodes, typedefs, nested groupings etc are not instantiated, and
+     * extend the child vector with that number below
+     */
+    ygrouping2->ys_len = 0; /* Cant do with get access function */
     {
         yang_stmt *ycn; /* new child */
         yang_stmt *yco; /* old child */
         int        i;
 
-        for (i=0; i<ygrouping2->ys_len; i++){
+        for (i=0; i<yang_len_get(ygrouping); i++){
             yco = ygrouping->ys_stmt[i];
-            if ((ycn = ys_dup(yco, clicon_option_bool(h, "CLICON_YANG_USE_ORIGINAL"), 1)) == NULL)
+            if (!yang_schemanode(yco) && yang_keyword_get(yco) != Y_UNKNOWN)
+                continue;
+            if ((ycn = ys_dup(yco, clicon_option_bool(h, "CLICON_YANG_USE_ORIGINAL"), 1)) == NULL){
+                ys_free(ygrouping2);
                 goto done;
-            ygrouping2->ys_stmt[i] = ycn;
+            }
+            ygrouping2->ys_stmt[ygrouping2->ys_len++] = ycn;
             ycn->ys_parent = ygrouping2;
         }
     }
-    /* Only replace data/schemanodes and unknowns:
-     * Compute the number of such nodes, and extend the child vector with that below
-     */
-    glen = 0;
-    inext = 0;
-    while ((yg = yn_iter(ygrouping2, &inext)) != NULL) {
-        if (yang_schemanode(yg) || yang_keyword_get(yg) == Y_UNKNOWN)
-            glen++;
-    }
+    glen = yang_len_get(ygrouping2);
     ygp = yang_parent_get(ygrouping);
     /*
      * yn is parent: the children of ygrouping replaces ys.
@@ -669,17 +670,23 @@ yang_expand_uses_node(clixon_handle h,
         if (size)
             memmove(&yn->ys_stmt[ysi+glen+1], &yn->ys_stmt[ysi+1], size);
     }
+    /* Unrefined uses (the common case) need not be inserted in the tree */
+    inext = 0;
+    while ((yr = yn_iter(ys, &inext)) != NULL) {
+        if (yang_keyword_get(yr) == Y_REFINE)
+            break;
+    }
     /* Note: yang_desc_schema_nodeid() requires ygrouping2 to be in yspec tree,
      * due to correct module prefixes etc.
      * cannot be dangling, insert into tree here and then prune immediately after while loop
      */
-    if (yn_insert(ygp, ygrouping2) < 0)
+    if (yr != NULL && yn_insert(ygp, ygrouping2) < 0)
         goto done;
     /* Iterate through refinements and modify grouping copy
      * See RFC 7950 7.13.2 yrt is the refine target node
      */
     inext = 0;
-    while ((yr = yn_iter(ys, &inext)) != NULL) {
+    while (yr != NULL && (yr = yn_iter(ys, &inext)) != NULL) {
         yang_stmt *yrt; /* refine target node */
         if (yang_keyword_get(yr) != Y_REFINE)
             continue;
@@ -705,11 +712,6 @@ yang_expand_uses_node(clixon_handle h,
     k=0;
     for (j=0; j<yang_len_get(ygrouping2); j++){
         yg = ygrouping2->ys_stmt[j]; /* Child of refined copy */
-        /* Only replace data/schemanodes */
-        if (!yang_schemanode(yg) && yang_keyword_get(yg) != Y_UNKNOWN){
-            ys_free(yg);
-            continue;
-        }
         /* If there is an associated when statement, add a special when struct to the yang
          * see xml_yang_validate_all
          */
@@ -1194,6 +1196,111 @@ yang_parse_filename(clixon_handle h,
     return ymod; /* top-level (sub)module */
 }
 
+/*! Reset original back-pointer of a module copy, yang_apply callback
+ *
+ * A module copied from the module pool is not a grouping/augment instance and should
+ * not refer to the (unpopulated) pool module
+ */
+static int
+ys_orig_reset(yang_stmt *ys,
+              void      *arg)
+{
+    ys->ys_orig = NULL;
+    return 0;
+}
+
+/*! Copy a parsed (sub)module to/from the module pool
+ *
+ * @param[in] ymod0  Yang (sub)module
+ * @retval    ymod   Stand-alone copy, free with ys_free
+ * @retval    NULL   Error
+ */
+static yang_stmt *
+yang_module_pool_dup(yang_stmt *ymod0)
+{
+    yang_stmt *ymod;
+
+    if ((ymod = ys_dup(ymod0, 0, 0)) == NULL)
+        return NULL;
+    if (yang_apply(ymod, -1, ys_orig_reset, 0, NULL) < 0){
+        ys_free(ymod);
+        return NULL;
+    }
+    return ymod;
+}
+
+/*! Parse a yang file via the process-wide pool of parsed (sub)modules
+ *
+ * Mount-points with different yang-libraries typically share most of their modules.
+ * The first parse of a file is made as usual and a copy saved in the pool, later
+ * parses of the same file copy the pool module instead of reading and parsing the file.
+ * Since modules are saved before features, deviations and grouping expansion are applied,
+ * the file is a complete key.
+ * Modules are saved after the yang-patch plugin callback, which is not called again on copies
+ * @param[in] h        Clixon handle
+ * @param[in] filename Name of file
+ * @param[in] yspec    Yang specification
+ * @retval    ymod     Top-level yang (sub)module
+ * @retval    NULL     Error encountered
+ * @see CLICON_YANG_SCHEMA_MOUNT_POOL
+ * @note Yang files are assumed to not change during the lifetime of the process
+ */
+static yang_stmt *
+yang_parse_filename_pool(clixon_handle h,
+                         const char   *filename,
+                         yang_stmt    *yspec)
+{
+    yang_stmt *ypool = NULL;
+    yang_stmt *ymod0 = NULL;
+    yang_stmt *ymod = NULL;
+    yang_stmt *ym;
+    int        inext;
+
+    if (clicon_ptr_get(h, YANG_MODULE_POOL, (void**)&ypool) < 0 || ypool == NULL){
+        if ((ypool = ys_new(Y_SPEC)) == NULL)
+            goto done;
+        if (clicon_ptr_set(h, YANG_MODULE_POOL, ypool) < 0){
+            ys_free(ypool);
+            goto done;
+        }
+    }
+    inext = 0;
+    while ((ym = yn_iter(ypool, &inext)) != NULL) {
+        if (strcmp(yang_filename_get(ym), filename) == 0){
+            ymod0 = ym;
+            break;
+        }
+    }
+    if (ymod0 == NULL){
+        if ((ymod = yang_parse_filename(h, filename, yspec)) == NULL)
+            goto done;
+        if ((ymod0 = yang_module_pool_dup(ymod)) == NULL){
+            ymod = NULL;
+            goto done;
+        }
+        if (yn_insert(ypool, ymod0) < 0){
+            ys_free(ymod0);
+            ymod = NULL;
+            goto done;
+        }
+    }
+    else {
+        clixon_debug(CLIXON_DBG_YANG, "%s from pool", filename);
+        if ((ym = yang_module_pool_dup(ymod0)) == NULL)
+            goto done;
+        if (yn_insert(yspec, ym) < 0){
+            ys_free(ym);
+            goto done;
+        }
+        ymod = ym;
+#ifdef OPTIMIZE_YSPEC_NAMESPACE
+        yspec_nscache_clear(yspec);
+#endif
+    }
+ done:
+    return ymod;
+}
+
 /*! Given a (sub)module, parse all (sub)modules in turn recursively
  *
  * Find a yang module file, and then recursively parse all its imported modules.
@@ -1248,7 +1355,12 @@ yang_parse_module(clixon_handle h,
         goto done;
     }
     filename = cbuf_get(fbuf);
-    if ((ymod = yang_parse_filename(h, filename, yspec)) == NULL)
+    if (domain != NULL && h != NULL &&
+        clicon_option_bool(h, "CLICON_YANG_SCHEMA_MOUNT_POOL")){
+        if ((ymod = yang_parse_filename_pool(h, filename, yspec)) == NULL)
+            goto done;
+    }
+    else if ((ymod = yang_parse_filename(h, filename, yspec)) == NULL)
         goto done;
     /* Sanity check that requested module name matches loaded module
      * If this does not match, the filename and containing module do not match
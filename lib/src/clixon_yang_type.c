@@ -706,18 +706,8 @@ cv_validate1(clixon_handle h,
         if (restype){
             if (strcmp(restype, "enumeration") == 0){
                 found = 0;
-                if (str != NULL) {
-                    //              str = clixon_trim2(str, " \t\n"); /* May be misplaced, strip earlier? */
-                    inext = 0;
-                    while ((yi = yn_iter(yrestype, &inext)) != NULL){
-                        if (yang_keyword_get(yi) != Y_ENUM)
-                            continue;
-                        if (strcmp(yang_argument_get(yi), str) == 0){
-                            found++;
-                            break;
-                        }
-                    }
-                }
+                if (str != NULL)
+                    found = yang_type_enum_find(yrestype, str);
                 if (!found){
                     if (reason)
                         *reason = cligen_reason("'%s' does not match enumeration", str);
@@ -883,6 +873,7 @@ ys_cv_validate_union_one(clixon_handle h,
     int          options = 0;
     cvec        *cvv = NULL;
     cvec        *regexps = NULL;
+    cvec        *regexps0 = NULL; /* Allocated if no type cache */
     cvec        *patterns = NULL;
     uint8_t      fraction = 0;
     char        *restype;
@@ -890,17 +881,21 @@ ys_cv_validate_union_one(clixon_handle h,
     cg_var      *cvt=NULL;
     yang_stmt   *ysubt = NULL;
 
-    if ((regexps = cvec_new(0)) == NULL){
-        clixon_err(OE_UNIX, errno, "cvec_new");
-        goto done;
-    }
-    if ((patterns = cvec_new(0)) == NULL){
-        clixon_err(OE_UNIX, errno, "cvec_new");
-        goto done;
+    /* Fast path: resolved member type from cache, by reference */
+    if (yang_type_cache_ref(yt, &yrestype, &options, &cvv, &regexps, &fraction) == 0){
+        if ((regexps0 = cvec_new(0)) == NULL){
+            clixon_err(OE_UNIX, errno, "cvec_new");
+            goto done;
+        }
+        if ((patterns = cvec_new(0)) == NULL){
+            clixon_err(OE_UNIX, errno, "cvec_new");
+            goto done;
+        }
+        if (yang_type_resolve(ys, ys, yt, &yrestype, &options, &cvv, patterns, regexps0,
+                              &fraction) < 0)
+            goto done;
+        regexps = regexps0;
     }
-    if (yang_type_resolve(ys, ys, yt, &yrestype, &options, &cvv, patterns, regexps,
-                          &fraction) < 0)
-        goto done;
     if (yrestype == NULL){
         clixon_err(OE_YANG, 0, "result-type should not be NULL");
         goto done;
@@ -942,8 +937,8 @@ ys_cv_validate_union_one(clixon_handle h,
  done:
     if (patterns)
         cvec_free(patterns);
-    if (regexps)
-        cvec_free(regexps);
+    if (regexps0)
+        cvec_free(regexps0);
     if (cvt)
         cv_free(cvt);
     return retval;
@@ -1009,6 +1004,27 @@ ys_cv_validate_union(clixon_handle h,
     return retval;
 }
 
+/*! Get type statement of a leaf or leaf-list used for type resolution
+ *
+ * The original type is used unless refined
+ * @param[in]  ys     Leaf or leaf-list
+ * @retval     ytype  Type statement
+ * @retval     NULL   Not found
+ * @see yang_type_get
+ */
+static yang_stmt *
+ys_type_stmt(yang_stmt *ys)
+{
+    yang_stmt *ytype;
+    yang_stmt *yorig;
+
+    if ((ytype = yang_find(ys, Y_TYPE, NULL)) == NULL)
+        return NULL;
+    if ((yorig = yang_orig_get(ys)) != NULL && yang_flag_get(ytype, YANG_FLAG_REFINE) == 0)
+        ytype = yang_find(yorig, Y_TYPE, NULL);
+    return ytype;
+}
+
 /*! Validate cligen variable cv using yang statement as spec
  *
  * @param[in]  h       Clixon handle     
@@ -1036,8 +1052,11 @@ ys_cv_validate(clixon_handle h,
     cvec           *cvv = NULL;
     cvec           *patterns = NULL;
     cvec           *regexps = NULL;
+    cvec           *regexps0 = NULL; /* Allocated if no type cache */
     enum cv_type    cvtype;
     char           *origtype = NULL;  /* orig type */
+    char           *origtype0 = NULL; /* Allocated if no type cache */
+    yang_stmt      *ytype;
     yang_stmt      *yrestype = NULL; /* resolved type */
     char           *restype;
     uint8_t         fraction = 0;
@@ -1052,20 +1071,33 @@ ys_cv_validate(clixon_handle h,
         goto done;
     }
     ycv = yang_cv_get(ys);
-    if ((patterns = cvec_new(0)) == NULL){
-        clixon_err(OE_UNIX, errno, "cvec_new");
-        goto done;
+    /* Fast path: the type cache of the leaf holds the flattened resolved type with
+     * ranges, lengths and compiled patterns. Use it by reference */
+    if ((ytype = ys_type_stmt(ys)) != NULL &&
+        yang_type_cache_ref(ytype, &yrestype, &options, &cvv, &regexps, &fraction) == 1){
+        if ((origtype = index(yang_argument_get(ytype), ':')) != NULL)
+            origtype++;
+        else
+            origtype = yang_argument_get(ytype);
     }
-    if ((regexps = cvec_new(0)) == NULL){
-        clixon_err(OE_UNIX, errno, "cvec_new");
-        goto done;
+    else {
+        if ((patterns = cvec_new(0)) == NULL){
+            clixon_err(OE_UNIX, errno, "cvec_new");
+            goto done;
+        }
+        if ((regexps0 = cvec_new(0)) == NULL){
+            clixon_err(OE_UNIX, errno, "cvec_new");
+            goto done;
+        }
+        if (yang_type_get(ys, &origtype0, &yrestype,
+                          &options, &cvv,
+                          patterns,
+                          regexps0,
+                          &fraction) < 0)
+            goto done;
+        origtype = origtype0;
+        regexps = regexps0;
     }
-    if (yang_type_get(ys, &origtype, &yrestype,
-                      &options, &cvv,
-                      patterns,
-                      regexps,
-                      &fraction) < 0)
-        goto done;
     restype = yrestype?yang_argument_get(yrestype):NULL;
     if (clicon_type2cv(origtype, restype, ys, &cvtype) < 0)
         goto done;
@@ -1124,10 +1156,10 @@ ys_cv_validate(clixon_handle h,
             *ysub = ys;
     }
   done:
-    if (origtype)
-        free(origtype);
-    if (regexps)
-        cvec_free(regexps);
+    if (origtype0)
+        free(origtype0);
+    if (regexps0)
+        cvec_free(regexps0);
     if (patterns)
         cvec_free(patterns);
     if (cvt)
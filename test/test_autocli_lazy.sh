@@ -0,0 +1,137 @@
+#!/usr/bin/env bash
+# Lazy autocli generation of container and list bodies with CLICON_AUTOCLI_LAZY
+# 1. Generated top-level clispec contains tree references instead of bodies
+# 2. Set, complete, edit and show through lazily generated trees
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/example.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_DIR>$dir</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_BACKEND_DIR>/usr/local/lib/$APPNAME/backend</CLICON_BACKEND_DIR>
+  <CLICON_CLISPEC_DIR>$dir</CLICON_CLISPEC_DIR>
+  <CLICON_CLI_DIR>/usr/local/lib/$APPNAME/cli</CLICON_CLI_DIR>
+  <CLICON_CLI_MODE>$APPNAME</CLICON_CLI_MODE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_YANG_LIBRARY>false</CLICON_YANG_LIBRARY>
+  <CLICON_AUTOCLI_LAZY>true</CLICON_AUTOCLI_LAZY>
+  <autocli>
+    <module-default>false</module-default>
+    <list-keyword-default>kw-nokey</list-keyword-default>
+    <rule>
+      <name>include ${APPNAME}</name>
+      <operation>enable</operation>
+      <module-name>${APPNAME}*</module-name>
+    </rule>
+  </autocli>
+</clixon-config>
+EOF
+
+cat <<EOF > $dir/example.cli
+CLICON_MODE="example";
+CLICON_PROMPT="%U@%H %W> ";
+
+# Autocli syntax tree operations
+edit @datamodel, cli_auto_edit("datamodel");
+up, cli_auto_up("datamodel");
+top, cli_auto_top("datamodel");
+set @datamodel, cli_auto_set();
+delete("Delete a configuration item") {
+      @datamodel, @add:leafref-no-refer, cli_auto_del();
+      all("Delete whole candidate configuration"), delete_all("candidate");
+}
+show("Show a particular state of the system"){
+    configuration("Show configuration"), cli_show_auto_mode("candidate", "xml", false, false);
+}
+EOF
+
+cat <<EOF > $fyang
+module example {
+  namespace "urn:example:clixon";
+  prefix ex;
+  container table{
+    list parameter{
+      key name;
+      leaf name{
+        type string;
+      }
+      leaf value{
+        type string;
+      }
+      container sub{
+        leaf x{
+          type string;
+        }
+      }
+    }
+  }
+  leaf top{
+    type string;
+  }
+}
+EOF
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -z -f $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. Generated clispec has treeref to container body but not the body"
+expectpart "$($clixon_cli -f $cfg -G -1 2>&1)" 0 "@top:data:example::container:" "top" --not-- "parameter"
+
+new "2. set top-level leaf"
+expectpart "$($clixon_cli -f $cfg -1 set top 1)" 0 "^$"
+
+new "set list leaf in lazy body"
+expectpart "$($clixon_cli -f $cfg -1 set table parameter x value 2)" 0 "^$"
+
+new "set leaf in nested lazy body"
+expectpart "$($clixon_cli -f $cfg -1 set table parameter x sub x 3)" 0 "^$"
+
+new "show config"
+expectpart "$($clixon_cli -f $cfg -1 show config)" 0 "<table xmlns=\"urn:example:clixon\"><parameter><name>x</name><value>2</value><sub><x>3</x></sub></parameter></table><top xmlns=\"urn:example:clixon\">1</top>"
+
+new "complete into lazy body"
+expectpart "$(echo "set table parameter x ?" | $clixon_cli -f $cfg 2>&1)" 0 "value" "sub"
+
+new "edit mode in lazy body"
+expectpart "$(printf "edit table parameter x\nset value 4\ntop\nshow config\n" | $clixon_cli -f $cfg 2>&1)" 0 "<value>4</value>"
+
+new "invalid lazy command"
+expectpart "$($clixon_cli -f $cfg -1 set table parameter x nonexist 5 2>&1)" 255 "Unknown command"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
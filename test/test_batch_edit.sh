@@ -0,0 +1,124 @@
+#!/usr/bin/env bash
+# Batch edit: several edit-config operations in one clixon-lib batch-edit request
+# 1. All edits applied, per-edit results
+# 2. A failed edit does not stop the other edits
+# 3. Replace and delete operations
+# 4. Autocommit to running
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/example.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>$dir</CLICON_YANG_DIR>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module example{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container x {
+    list y {
+      key "a";
+      leaf a {
+        type int32;
+      }
+      leaf b {
+        type string;
+      }
+    }
+  }
+}
+EOF
+
+# Args:
+# 1: datastore
+# 2: expected config
+function checkdb()
+{
+    new "netconf get-config $1"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><$1/></source></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data>$2</data></rpc-reply>"
+}
+
+# Args:
+# 1: edit id
+# 2: config
+function edit()
+{
+    echo "<edit><id>$1</id><config>$2</config></edit>"
+}
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+E1=$(edit 1 "<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y></x>")
+E2=$(edit 2 "<x xmlns=\"urn:example:clixon\"><y><a>2</a><b>two</b></y></x>")
+E3=$(edit 3 "<x xmlns=\"urn:example:clixon\"><y><a>3</a><b>three</b></y></x>")
+
+new "1. batch-edit three edits"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><batch-edit $LIBNS><target><candidate/></target>$E1$E2$E3</batch-edit></rpc>" "" "<rpc-reply $DEFAULTNS><edit $LIBNS><id>1</id><ok/></edit><edit $LIBNS><id>2</id><ok/></edit><edit $LIBNS><id>3</id><ok/></edit></rpc-reply>"
+
+checkdb candidate "<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y><y><a>2</a><b>two</b></y><y><a>3</a><b>three</b></y></x>"
+
+new "netconf discard-changes"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><discard-changes/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+EBAD=$(edit 2 "<x xmlns=\"urn:example:clixon\"><y><a>2</a><c>bad</c></y></x>")
+
+new "2. batch-edit with invalid edit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><batch-edit $LIBNS><target><candidate/></target>$E1$EBAD$E3</batch-edit></rpc>" "" "<rpc-reply $DEFAULTNS><edit $LIBNS><id>1</id><ok/></edit><edit $LIBNS><id>2</id><error><rpc-error $DEFAULTONLY><error-type>application</error-type><error-tag>unknown-element</error-tag>" "<edit $LIBNS><id>3</id><ok/></edit></rpc-reply>"
+
+checkdb candidate "<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y><y><a>3</a><b>three</b></y></x>"
+
+EDEL="<edit><id>1</id><default-operation>none</default-operation><config><x xmlns=\"urn:example:clixon\"><y nc:operation=\"delete\" xmlns:nc=\"urn:ietf:params:xml:ns:netconf:base:1.0\"><a>1</a></y></x></config></edit>"
+EREP="<edit><id>2</id><default-operation>replace</default-operation><config><x xmlns=\"urn:example:clixon\"><y><a>4</a><b>four</b></y></x></config></edit>"
+
+new "3. batch-edit delete then replace"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><batch-edit $LIBNS><target><candidate/></target>$EDEL$EREP</batch-edit></rpc>" "" "<rpc-reply $DEFAULTNS><edit $LIBNS><id>1</id><ok/></edit><edit $LIBNS><id>2</id><ok/></edit></rpc-reply>"
+
+checkdb candidate "<x xmlns=\"urn:example:clixon\"><y><a>4</a><b>four</b></y></x>"
+
+new "4. batch-edit with autocommit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><batch-edit $LIBNS $LIBNS1 cl:autocommit=\"true\"><target><candidate/></target>$E1</batch-edit></rpc>" "" "<rpc-reply $DEFAULTNS><edit $LIBNS><id>1</id><ok/></edit></rpc-reply>"
+
+checkdb running "<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y><y><a>4</a><b>four</b></y></x>"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
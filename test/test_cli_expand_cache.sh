@@ -0,0 +1,113 @@
+#!/usr/bin/env bash
+# CLI expand cache with CLICON_CLI_EXPAND_CACHE
+# Repeated completions in one CLI session are served from a local cache that is cleared
+# by config-change notifications from the backend
+# 1. Changes in the same CLI session are seen in completion
+# 2. Changes by other sessions are seen in completion
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/clixon-example.yang
+clidir=$dir/clidir
+
+if [ ! -d $clidir ]; then
+    mkdir $clidir
+fi
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_BACKEND_DIR>/usr/local/lib/$APPNAME/backend</CLICON_BACKEND_DIR>
+  <CLICON_CLISPEC_DIR>$clidir</CLICON_CLISPEC_DIR>
+  <CLICON_CLI_DIR>/usr/local/lib/$APPNAME/cli</CLICON_CLI_DIR>
+  <CLICON_CLI_MODE>$APPNAME</CLICON_CLI_MODE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>/usr/local/var/$APPNAME</CLICON_XMLDB_DIR>
+  <CLICON_STREAM_DISCOVERY_RFC5277>true</CLICON_STREAM_DISCOVERY_RFC5277>
+  <CLICON_CLI_EXPAND_CACHE>true</CLICON_CLI_EXPAND_CACHE>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module clixon-example{
+  yang-version 1.1;
+  namespace "urn:example:clixon";
+  prefix ex;
+  list list1{
+      key  "key1";
+      leaf key1{
+         type string;
+      }
+   }
+}
+EOF
+
+cat <<EOF > $clidir/cli1.cli
+CLICON_MODE="example";
+CLICON_PROMPT="%U@%H %W> ";
+
+set @datamodel, cli_auto_set();
+delete("Delete a configuration item") {
+      @datamodel, @add:leafref-no-refer, cli_auto_del();
+      all("Delete whole candidate configuration"), delete_all("candidate");
+}
+commit("Commit the changes"), cli_commit();
+discard("Discard edits (rollback 0)"), discard_changes();
+EOF
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -z -f $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "netconf CLIXON-CONFIG stream exists"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get><filter type=\"xpath\" select=\"/nc:netconf/nc:streams\" xmlns:nc=\"urn:ietf:params:xml:ns:netmod:notification\"/></get></rpc>" "" "<stream><name>CLIXON-CONFIG</name>"
+
+new "Add entry a"
+expectpart "$($clixon_cli -1 -f $cfg set list1 a)" 0 "^$"
+
+new "1. Expand after edit in same session"
+expectpart "$(printf "delete list1 ?\nset list1 b\ndelete list1 ?\n" | $clixon_cli -f $cfg 2>&1)" 0 "a" "b"
+
+new "Expand after delete in same session"
+expectpart "$(printf "delete list1 ?\ndelete list1 b\ndelete list1 ?\n" | $clixon_cli -f $cfg 2>&1)" 0 "a" "b" --not-- "expand cache disabled"
+
+new "2. Expand after edit in other session"
+ret=$( (printf "delete list1 ?\n"; sleep 1; $clixon_cli -1 -f $cfg set list1 c > /dev/null; printf "delete list1 ?\n") | $clixon_cli -f $cfg 2>&1)
+expectpart "$ret" 0 "a" "c"
+
+new "Expand after discard in other session"
+ret=$( (printf "delete list1 ?\n"; sleep 1; $clixon_cli -1 -f $cfg discard > /dev/null; printf "set list1 d\ndelete list1 ?\n") | $clixon_cli -f $cfg 2>&1)
+expectpart "$ret" 0 "d"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -0,0 +1,165 @@
+#!/usr/bin/env bash
+# Commit history with CLICON_COMMIT_HISTORY: inverse diffs of the latest commits
+# 1. Commits with comment, list history
+# 2. Get configuration at history points
+# 3. Rollback into candidate and commit
+# 4. History is limited to CLICON_COMMIT_HISTORY entries
+# 5. Confirmed-commit rollback using history
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/example.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_FEATURE>ietf-netconf:confirmed-commit</CLICON_FEATURE>
+  <CLICON_YANG_DIR>$dir</CLICON_YANG_DIR>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_COMMIT_HISTORY>3</CLICON_COMMIT_HISTORY>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module example{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container x {
+    list y {
+      key "a";
+      leaf a {
+        type int32;
+      }
+      leaf b {
+        type string;
+      }
+    }
+    leaf-list z {
+      ordered-by user;
+      type string;
+    }
+  }
+}
+EOF
+
+# Args:
+# 1: edit-config content
+# 2: commit comment
+function editcommit()
+{
+    new "netconf edit-config"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config>$1</config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    new "netconf commit $2"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit xmlns:cl=\"http://clicon.org/lib\" cl:comment=\"$2\"/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+}
+
+# Args:
+# 1: datastore
+# 2: expected config
+function checkdb()
+{
+    new "netconf get-config $1"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><$1/></source></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data>$2</data></rpc-reply>"
+}
+
+X1="<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y><y><a>2</a><b>two</b></y><z>p</z><z>q</z></x>"
+X2="<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>ONE</b></y><y><a>2</a><b>two</b></y><y><a>3</a><b>three</b></y><z>p</z><z>q</z></x>"
+X3="<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>ONE</b></y><y><a>3</a><b>three</b></y><z>q</z><z>p</z></x>"
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. Commits with comment"
+editcommit "$X1" "first"
+editcommit "<x xmlns=\"urn:example:clixon\"><y><a>1</a><b>ONE</b></y><y><a>3</a><b>three</b></y></x>" "second"
+editcommit "<x xmlns=\"urn:example:clixon\" xmlns:nc=\"urn:ietf:params:xml:ns:netconf:base:1.0\" nc:operation=\"replace\"><y><a>1</a><b>ONE</b></y><y><a>3</a><b>three</b></y><z>q</z><z>p</z></x>" "third"
+
+checkdb running "$X3"
+
+new "netconf commit-history"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit-history xmlns=\"http://clicon.org/lib\"/></rpc>" "" "<comment>third</comment></commit><commit xmlns=\"http://clicon.org/lib\"><index>2</index><id>2</id>"
+
+new "2. netconf commit-history config index 1"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit-history xmlns=\"http://clicon.org/lib\"><index>1</index></commit-history></rpc>" "" "<config xmlns=\"http://clicon.org/lib\">$X2</config></rpc-reply>"
+
+new "netconf commit-history config index 2"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit-history xmlns=\"http://clicon.org/lib\"><index>2</index></commit-history></rpc>" "" "<config xmlns=\"http://clicon.org/lib\">$X1</config></rpc-reply>"
+
+new "netconf commit-history index out of range"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit-history xmlns=\"http://clicon.org/lib\"><index>4</index></commit-history></rpc>" "" "<rpc-reply $DEFAULTNS><rpc-error><error-type>application</error-type><error-tag>invalid-value</error-tag>"
+
+new "3. netconf rollback 2"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><rollback xmlns=\"http://clicon.org/lib\"><index>2</index></rollback></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkdb candidate "$X1"
+
+new "netconf commit rollback"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkdb running "$X1"
+
+new "netconf rollback 1: before rollback commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><rollback xmlns=\"http://clicon.org/lib\"><index>1</index></rollback></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkdb candidate "$X3"
+
+new "netconf discard-changes"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><discard-changes/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "4. History limited to 3 entries"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><rollback xmlns=\"http://clicon.org/lib\"><index>4</index></rollback></rpc>" "" "<rpc-reply $DEFAULTNS><rpc-error><error-type>application</error-type><error-tag>invalid-value</error-tag>"
+
+new "5. Confirmed-commit"
+new "netconf edit-config"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><y><a>4</a><b>four</b></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "netconf persistent confirmed-commit with timeout"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit><confirmed/><confirm-timeout>2</confirm-timeout><persist>a</persist></commit></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "netconf edit-config in confirm window"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><y><a>5</a><b>five</b></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "netconf second confirmed-commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit><confirmed/><confirm-timeout>2</confirm-timeout><persist>b</persist><persist-id>a</persist-id></commit></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "Wait for rollback"
+sleep 3
+
+checkdb running "$X1"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -3,6 +3,7 @@
 # - XML and JSON
 # - save and load config files
 # Pretty and not
+# - Large JSON datastore, larger than the JSON output buffer so it is flushed to file
 
 # Magic line must be first in script (see README.md)
 s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
@@ -195,6 +196,60 @@ for format in xml json; do
     done
 done
 
+# Large JSON datastore: the output is flushed to file several times while written
+nr=3000
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -z -f $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg -o CLICON_XMLDB_FORMAT=json -o CLICON_XMLDB_PRETTY=false"
+    start_backend -s init -f $cfg -o CLICON_XMLDB_FORMAT=json -o CLICON_XMLDB_PRETTY=false
+fi
+
+new "wait backend"
+wait_backend
+
+echo -n "<${DATASTORE_TOP}><table xmlns=\"urn:example:clixon\">" > $dir/myconfig
+echo -n "{\"$DATASTORE_TOP\":{\"clixon-example:table\":{\"parameter\":[" > $dir/expect
+for (( i=0; i<$nr; i++ )); do
+    name=$(printf "p%05d" $i)
+    echo -n "<parameter><name>$name</name><value>value-of-parameter-$i</value></parameter>" >> $dir/myconfig
+    if [ $i -gt 0 ]; then
+        echo -n "," >> $dir/expect
+    fi
+    echo -n "{\"name\":\"$name\",\"value\":\"value-of-parameter-$i\"}" >> $dir/expect
+done
+echo "</table></${DATASTORE_TOP}>" >> $dir/myconfig
+echo "]}}}" >> $dir/expect
+
+new "load $nr parameters"
+expectpart "$($clixon_cli -1 -f $cfg load $dir/myconfig xml)" 0 "^$"
+
+new "Check large xmldb json format"
+sudo chmod 666 $dir/candidate_db
+ret=$(diff -w $dir/candidate_db $dir/expect)
+if [ $? -ne 0 ]; then
+    err "$(head -c 200 $dir/expect)" "$(head -c 200 $dir/candidate_db)"
+fi
+
+new "Check no temporary datastore file is left"
+if [ -f $dir/candidate_db.tmp ]; then
+    err "no $dir/candidate_db.tmp" "$dir/candidate_db.tmp"
+fi
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
 # Negative test, load yang-invalid xml
 if [ $BE -ne 0 ]; then
     new "kill old backend"
@@ -0,0 +1,148 @@
+#!/usr/bin/env bash
+# Binary CBOR datastore format with CLICON_XMLDB_FORMAT=cbor
+# 1. Datastore files are written as CBOR and read back on restart
+# 2. An XML startup datastore is read and converted to CBOR
+# 3. Print CBOR startup datastore as XML with backend -q
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/clixon-example.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_XMLDB_FORMAT>cbor</CLICON_XMLDB_FORMAT>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module clixon-example{
+    yang-version 1.1;
+    namespace "urn:example:clixon";
+    prefix ex;
+    container table{
+        list parameter{
+            key name;
+            leaf name{
+                type string;
+            }
+            leaf value{
+                type string;
+            }
+        }
+    }
+}
+EOF
+
+X1="<table xmlns=\"urn:example:clixon\"><parameter><name>a</name><value>42</value></parameter><parameter><name>b</name><value>x&amp;y</value></parameter></table>"
+X2="<table xmlns=\"urn:example:clixon\"><parameter><name>c</name><value>99</value></parameter></table>"
+
+# Args:
+# 1: datastore
+# 2: expected config
+function checkdb()
+{
+    new "netconf get-config $1"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><$1/></source></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data>$2</data></rpc-reply>"
+}
+
+# Args:
+# 1: datastore file
+function checkcbor()
+{
+    new "check $1 is CBOR"
+    magic=$(sudo od -An -tx1 -N3 $dir/$1 | tr -d ' ')
+    if [ "$magic" != "d9d9f7" ]; then
+        err "d9d9f7" "$magic"
+    fi
+}
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. netconf edit-config"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config>$X1</config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "netconf commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkcbor running_db
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    stop_backend -f $cfg
+    new "start backend -s running -f $cfg"
+    start_backend -s running -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+checkdb running "$X1"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    stop_backend -f $cfg
+fi
+
+new "2. XML startup datastore"
+sudo rm -f $dir/startup_db
+cat <<EOF > $dir/startup_db
+<${DATASTORE_TOP}>$X2</${DATASTORE_TOP}>
+EOF
+
+if [ $BE -ne 0 ]; then
+    new "start backend -s startup -f $cfg"
+    start_backend -s startup -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+checkdb running "$X2"
+
+checkcbor running_db
+
+new "netconf copy-config running to startup"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><copy-config><target><startup/></target><source><running/></source></copy-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkcbor startup_db
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+new "3. Print CBOR startup as XML"
+expectpart "$(sudo $clixon_backend -s startup -f $cfg -q -l e 2>&1)" 0 "<parameter>" "<name>c</name>" "<value>99</value>"
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -0,0 +1,139 @@
+#!/usr/bin/env bash
+# Read-only running snapshot for frontends with CLICON_XMLDB_SNAPSHOT
+# 1. Backend publishes a CBOR snapshot of running at startup and after commit
+# 2. CLI show of running is served from the snapshot
+# 3. CLI falls back to the backend if there is no snapshot
+# 4. Backend removes the snapshot when it exits
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/clixon-example.yang
+clidir=$dir/clidir
+
+if [ ! -d $clidir ]; then
+    mkdir $clidir
+fi
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_CLISPEC_DIR>$clidir</CLICON_CLISPEC_DIR>
+  <CLICON_CLI_DIR>/usr/local/lib/$APPNAME/cli</CLICON_CLI_DIR>
+  <CLICON_CLI_MODE>$APPNAME</CLICON_CLI_MODE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_XMLDB_SNAPSHOT>true</CLICON_XMLDB_SNAPSHOT>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module clixon-example{
+    yang-version 1.1;
+    namespace "urn:example:clixon";
+    prefix ex;
+    container table{
+        list parameter{
+            key name;
+            leaf name{
+                type string;
+            }
+            leaf value{
+                type string;
+            }
+        }
+    }
+}
+EOF
+
+cat <<EOF > $clidir/cli1.cli
+CLICON_MODE="example";
+CLICON_PROMPT="%U@%H %W> ";
+
+set @datamodel, cli_auto_set();
+commit("Commit the changes"), cli_commit();
+show("Show a particular state of the system"){
+    configuration("Show configuration"), cli_show_config("running", "xml", "/");
+}
+EOF
+
+function checksnapshot()
+{
+    new "check snapshot is CBOR"
+    magic=$(sudo od -An -tx1 -N3 $dir/running.snapshot | tr -d ' ')
+    if [ "$magic" != "d9d9f7" ]; then
+        err "d9d9f7" "$magic"
+    fi
+}
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    sudo rm -f $dir/running.snapshot
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. Snapshot published at startup"
+checksnapshot
+
+new "set and commit a"
+expectpart "$($clixon_cli -1 -f $cfg set table parameter a value 1)" 0 "^$"
+expectpart "$($clixon_cli -1 -f $cfg commit)" 0 "^$"
+
+checksnapshot
+
+new "2. show running from snapshot"
+expectpart "$($clixon_cli -1 -f $cfg show configuration)" 0 "<name>a</name>" "<value>1</value>"
+
+sudo cp $dir/running.snapshot $dir/old.snapshot
+
+new "set and commit b"
+expectpart "$($clixon_cli -1 -f $cfg set table parameter b value 2)" 0 "^$"
+expectpart "$($clixon_cli -1 -f $cfg commit)" 0 "^$"
+
+new "show running has b"
+expectpart "$($clixon_cli -1 -f $cfg show configuration)" 0 "<name>a</name>" "<name>b</name>"
+
+new "Restore old snapshot, show running is served from it"
+sudo mv $dir/old.snapshot $dir/running.snapshot
+expectpart "$($clixon_cli -1 -f $cfg show configuration)" 0 "<name>a</name>" --not-- "<name>b</name>"
+
+new "3. Remove snapshot, show running from backend"
+sudo rm -f $dir/running.snapshot
+expectpart "$($clixon_cli -1 -f $cfg show configuration)" 0 "<name>a</name>" "<name>b</name>"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+
+    new "4. Snapshot removed at backend exit"
+    sleep $DEMSLEEP
+    if sudo test -f $dir/running.snapshot; then
+        err "no snapshot" "running.snapshot exists"
+    fi
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -3,6 +3,7 @@
 # Create an html and css file
 # Get them via http and https
 # Send options and head request
+# Conditional (ETag, If-None-Match) and range requests
 # Errors: not found, post, 
 # See RFC 7230
 
@@ -265,6 +266,34 @@ TP/$HVER 200" "Content-Type: text/html" "<title>Welcome to Clixon!</title>"
             err1 "$dir/foo.png $dir/www/data/example.css should be equal" "Not equal"
         fi
 
+        new "WWW binary bitmap range"
+        curl $CURLOPTS2 -X GET -H 'Range: bytes=100-' $proto://localhost/data/clixon.png -o $dir/foo.png
+        tail -c +101 $dir/www/data/clixon.png > $dir/bar.png
+        cmp $dir/foo.png $dir/bar.png
+        if [ $? -ne 0 ]; then
+            err1 "$dir/foo.png $dir/bar.png should be equal" "Not equal"
+        fi
+
+        new "WWW get etag and last-modified"
+        ret=$(curl $CURLOPTS -X GET -H 'Accept: text/html' $proto://localhost/data/index.html)
+        expectpart "$ret" 0 "HTTP/$HVER 200" "ETag: \"" "Last-Modified: " "Accept-Ranges: bytes"
+        etag=$(echo "$ret" | grep -i "^etag:" | awk '{print $2}' | tr -d '\r')
+
+        new "WWW get if-none-match"
+        expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/html' -H "If-None-Match: $etag" $proto://localhost/data/index.html)" 0 "HTTP/$HVER 304" "ETag: $etag" --not-- "<title>Welcome to Clixon!</title>"
+
+        new "WWW get if-none-match other etag"
+        expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/html' -H 'If-None-Match: "0-0-0"' $proto://localhost/data/index.html)" 0 "HTTP/$HVER 200" "<title>Welcome to Clixon!</title>"
+
+        new "WWW get range"
+        expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/css' -H 'Range: bytes=0-4' $proto://localhost/data/example.css)" 0 "HTTP/$HVER 206" "Content-Range: bytes 0-4/" "Content-Length: 5" --not-- "display: inline;"
+
+        new "WWW get range not satisfiable"
+        expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/css' -H 'Range: bytes=100000-' $proto://localhost/data/example.css)" 0 "HTTP/$HVER 416" "Content-Range: bytes \*/"
+
+        new "WWW get range with other if-range"
+        expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/css' -H 'Range: bytes=0-4' -H 'If-Range: "0-0-0"' $proto://localhost/data/example.css)" 0 "HTTP/$HVER 200" "display: inline;"
+
         # negative errors
         new "WWW get http not found"
         expectpart "$(curl $CURLOPTS -X GET -H 'Accept: text/html' $proto://localhost/data/notfound.html)" 0 "HTTP/$HVER 404" "Content-Type: text/html" "<title>404 Not Found</title>"
@@ -0,0 +1,148 @@
+#!/usr/bin/env bash
+# List key hash index with XML_LIST_KEY_INDEX
+# A list with many entries is searched using a hash index on its key tuple, which is
+# maintained when entries are inserted and removed.
+# Both an ordered-by system and an ordered-by user list with two keys are tested
+# 1. XPath key predicates find entries, also with non-canonical integer key
+# 2. Merge of an existing entry does not create a duplicate
+# 3. Delete and re-create an entry
+# 4. Insert first in ordered-by user list
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/example.yang
+
+# Number of list entries, more than XML_LIST_KEY_INDEX_MIN
+: ${nr:=200}
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module example{
+  yang-version 1.1;
+  namespace "urn:example:clixon";
+  prefix ex;
+  container x {
+    list s {
+      key "k1 k2";
+      leaf k1 {
+        type int32;
+      }
+      leaf k2 {
+        type string;
+      }
+      leaf v {
+        type string;
+      }
+    }
+    list u {
+      ordered-by user;
+      key "k1 k2";
+      leaf k1 {
+        type int32;
+      }
+      leaf k2 {
+        type string;
+      }
+      leaf v {
+        type string;
+      }
+    }
+  }
+}
+EOF
+
+# Get-config with xpath filter
+# arg1: list name
+# arg2: xpath predicates
+# arg3: expected data
+function getlist(){
+    new "get-config $1$2"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><candidate/></source><filter type=\"xpath\" select=\"/ex:x/ex:$1$2\" xmlns:ex=\"urn:example:clixon\"/></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data>$3</data></rpc-reply>"
+}
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "generate config with $nr entries in each list"
+cfgs=""
+cfgu=""
+for (( i=1; i<=$nr; i++ )); do
+    cfgs+="<s><k1>$i</k1><k2>b$i</k2><v>$i</v></s>"
+    cfgu+="<u><k1>$i</k1><k2>b$i</k2><v>$i</v></u>"
+done
+
+new "edit-config"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\">$cfgs$cfgu</x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+for l in s u; do
+    new "1. XPath key predicates list $l"
+    getlist $l "[ex:k1='50'][ex:k2='b50']" "<x xmlns=\"urn:example:clixon\"><$l><k1>50</k1><k2>b50</k2><v>50</v></$l></x>"
+
+    getlist $l "[ex:k1='050'][ex:k2='b50']" "<x xmlns=\"urn:example:clixon\"><$l><k1>50</k1><k2>b50</k2><v>50</v></$l></x>"
+
+    getlist $l "[ex:k1='50'][ex:k2='b51']" ""
+
+    new "2. Merge existing entry list $l"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><$l><k1>60</k1><k2>b60</k2><v>new</v></$l></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    getlist $l "[ex:k1='60']" "<x xmlns=\"urn:example:clixon\"><$l><k1>60</k1><k2>b60</k2><v>new</v></$l></x>"
+
+    new "3. Delete entry list $l"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><$l nc:operation=\"delete\" xmlns:nc=\"urn:ietf:params:xml:ns:netconf:base:1.0\"><k1>70</k1><k2>b70</k2></$l></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    getlist $l "[ex:k1='70'][ex:k2='b70']" ""
+
+    new "Re-create entry list $l"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><$l><k1>70</k1><k2>b70</k2><v>again</v></$l></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    getlist $l "[ex:k1='70'][ex:k2='b70']" "<x xmlns=\"urn:example:clixon\"><$l><k1>70</k1><k2>b70</k2><v>again</v></$l></x>"
+done
+
+new "4. Insert first in ordered-by user list"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><u yang:insert=\"first\" xmlns:yang=\"urn:ietf:params:xml:ns:yang:1\"><k1>0</k1><k2>b0</k2><v>first</v></u></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+getlist u "[ex:k1='0'][ex:k2='b0']" "<x xmlns=\"urn:example:clixon\"><u><k1>0</k1><k2>b0</k2><v>first</v></u></x>"
+
+new "validate"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><validate><source><candidate/></source></validate></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
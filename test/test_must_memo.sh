@@ -0,0 +1,131 @@
+#!/usr/bin/env bash
+# Memoized must expressions with VALIDATE_XPATH_MEMO
+# A must whose result only depends on an ancestor is evaluated once per ancestor,
+# check that the memoized result is correct and not shared between different ancestors
+# 1. List-wide must: count of entries of a type, anchored at the list parent
+# 2. Entry-wide must on a leaf, anchored at the list entry (no context node reference)
+# 3. Same lists in two containers, anchored at different parents
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/test.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module $APPNAME{
+  yang-version 1.1;
+  namespace "urn:example:clixon";
+  prefix ex;
+  grouping entries {
+    list entry {
+      key name;
+      must "count(../entry[type='x']) <= 2" {
+        error-message "Too many x entries";
+      }
+      leaf name {
+        type string;
+      }
+      leaf type {
+        type string;
+      }
+      leaf value {
+        must "../type != 'y' or ../value > 0" {
+          error-message "y entries must have positive value";
+        }
+        type int32;
+      }
+    }
+  }
+  container a {
+    uses entries;
+  }
+  container b {
+    uses entries;
+  }
+}
+EOF
+
+# Edit, validate and discard
+# arg1: config
+# arg2: expected error-message, or empty for ok
+function editvalidate(){
+    new "edit-config $1"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config>$1</config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    new "validate"
+    if [ -z "$2" ]; then
+        expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><validate><source><candidate/></source></validate></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+    else
+        expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><validate><source><candidate/></source></validate></rpc>" "" "<rpc-reply $DEFAULTNS><rpc-error><error-type>application</error-type><error-tag>operation-failed</error-tag><error-severity>error</error-severity><error-message>" "$2"
+    fi
+
+    new "discard-changes"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><discard-changes/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+}
+
+# Entry
+# arg1: name
+# arg2: type
+# arg3: value
+function entry(){
+    echo "<entry><name>$1</name><type>$2</type><value>$3</value></entry>"
+}
+
+new "test params: -f $cfg"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg"
+    start_backend -s init -f $cfg
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. List-wide must"
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)$(entry e3 z 1)</a>" ""
+
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)$(entry e3 x 1)</a>" "Too many x entries"
+
+new "2. Entry-wide must"
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 y 1)$(entry e2 z 0)$(entry e3 y 2)</a>" ""
+
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 y 1)$(entry e2 y 0)$(entry e3 y 2)</a>" "y entries must have positive value"
+
+new "3. Two ancestors"
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)</a><b xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)</b>" ""
+
+editvalidate "<a xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)</a><b xmlns='urn:example:clixon'>$(entry e1 x 1)$(entry e2 x 1)$(entry e3 x 1)</b>" "Too many x entries"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
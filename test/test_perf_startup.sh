@@ -2,6 +2,8 @@
 # Startup performance tests for different formats and startup modes.
 # Generate file in different formats:
 # xml, xml pretty-printed, xml with prefixes, json
+# and xml with list entries in reverse order, which needs sorting.
+# Print total time and per-phase time from backend debug log
 
 # Magic line must be first in script (see README.md)
 s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
@@ -18,6 +20,8 @@ sx=$dir/sx.xml
 sxpp=$dir/sxpp.xml
 sxpre=$dir/sxpre.xml
 sj=$dir/sj.xml
+sxrev=$dir/sxrev.xml
+flog=$dir/startup.log
 
 # NOTE, added a deep yang structure (x0,x1,x2) to expose performance due to turned off caching.
 cat <<EOF > $fyang
@@ -95,6 +99,13 @@ for (( i=0; i<$perfnr; i++ )); do
 done
 echo "</ex:x></ex:x2></ex:x1></ex:x0></config>" >> $sxpre
     
+new "generate reverse-ordered xml startup config ($sxrev) with $perfnr entries"
+echo -n "<config><x0 xmlns=\"urn:example:clixon\"><x1><x2><name>ip</name><x>" > $sxrev
+for (( i=$perfnr-1; i>=0; i-- )); do
+    echo -n "<y><a>$i</a><b>$i</b></y>" >> $sxrev
+done
+echo "</x></x2></x1></x0></config>" >> $sxrev
+
 new "generate pretty-printed xml startup config ($sxpp) with $perfnr entries"
 cat<<EOF >  $sxpp
 <config>
@@ -136,11 +147,14 @@ fi
 mode=startup # running
 format=xml
 sdb=$dir/${mode}_db
-for variant in prefix plain pretty; do
+for variant in prefix plain pretty reverse; do
     case $variant in
         plain)
             f=$sx
             ;;
+        reverse)
+            f=$sxrev
+            ;;
         pretty)
             f=$sxpp
             ;;
@@ -156,7 +170,10 @@ for variant in prefix plain pretty; do
     cp $f $sdb
     new "Startup $format $variant"
     # Cannot use start_backend here due to expected error case
-    { time -p sudo $clixon_backend -F1 -D $DBG -s $mode -f $cfg -y $fyang -o CLICON_XMLDB_FORMAT=$format 2> /dev/null; } 2>&1 | awk '/real/ {print $2}'
+    sudo rm -f $flog
+    { time -p sudo $clixon_backend -F1 -D $DBG -D backend -l f$flog -s $mode -f $cfg -y $fyang -o CLICON_XMLDB_FORMAT=$format 2> /dev/null; } 2>&1 | awk '/real/ {print $2}'
+    # Per-phase timing, eg "read+upgrade 0.123456s"
+    sudo grep -o "Startup phase .*" $flog | sed 's/Startup phase //'
 done
 
 rm -rf $dir
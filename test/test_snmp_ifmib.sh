@@ -20,6 +20,8 @@ fstate=$dir/state.xml
 # AgentX unix socket
 SOCK=/var/run/snmp.sock
 
+snmpbulkwalk="$(type -p snmpbulkwalk) -c public -v2c localhost "
+
 # Relies on example_backend.so for $fstate file handling
 
 cat <<EOF > $cfg
@@ -490,6 +492,13 @@ expectpart "$($snmpwalk IF-MIB::ifXTable)" 0 "IF-MIB::ifName.1 = STRING: ifname1
 expectpart "$($snmpwalk $OID30)" 0 "IF-MIB::ifName.1 = STRING: ifname1" \
            "IF-MIB::ifName.2 = STRING: ifname2"
 
+new "Bulk walk ifTable, one request for the whole table"
+expectpart "$($snmpbulkwalk -Cr100 IF-MIB::ifTable)" 0 "IF-MIB::ifIndex.1 = INTEGER: 1" \
+           "IF-MIB::ifIndex.2 = INTEGER: 2" \
+           "IF-MIB::ifDescr.2 = STRING: Test 2" \
+           "IF-MIB::ifMtu.2 = INTEGER: 1400" \
+           "IF-MIB::ifInDiscards.2 = Counter32: 444"
+
 testexit
 rm -rf $dir
 
@@ -0,0 +1,130 @@
+#!/usr/bin/env bash
+# Path-scoped state data providers registered with clixon_statedata_cb_register()
+# Using the -sS <file> state capability of the main example with -p <xpath> to register
+# the state file callback as a provider of one subtree only, and -T <ttl> for caching.
+# 1. Provider is called for requests intersecting its xpath, not for others
+# 2. Without ttl, changes in the state file are seen directly
+# 3. With ttl, state is served from the cache until the ttl expires
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fstate=$dir/state.xml
+fyang=$dir/example.yang
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>$dir</CLICON_YANG_DIR>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_BACKEND_DIR>/usr/local/lib/$APPNAME/backend</CLICON_BACKEND_DIR>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_YANG_LIBRARY>false</CLICON_YANG_LIBRARY>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_STREAM_DISCOVERY_RFC8040>false</CLICON_STREAM_DISCOVERY_RFC8040>
+  <CLICON_NETCONF_MONITORING>false</CLICON_NETCONF_MONITORING>
+</clixon-config>
+EOF
+
+cat <<EOF > $fyang
+module example{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container sa {
+      config false;
+      list c {
+         key "name";
+         leaf name {
+            type string;
+         }
+         leaf count {
+            type uint32;
+         }
+      }
+   }
+   container sb {
+      config false;
+      leaf count {
+         type uint32;
+      }
+   }
+}
+EOF
+
+# Args:
+# 1: count value in state file
+function writestate()
+{
+    count=$1
+    cat <<EOF > $fstate
+<sa xmlns="urn:example:clixon"><c><name>a</name><count>$count</count></c></sa>
+<sb xmlns="urn:example:clixon"><count>$count</count></sb>
+EOF
+}
+
+# Args:
+# 1: ttl in ms, 0: no cache
+# 2: expected count after state file change
+function testrun()
+{
+    ttl=$1
+    count=$2
+
+    writestate 1
+
+    new "test params: -f $cfg -- -sS $fstate -p /ex:sa -T $ttl"
+    if [ $BE -ne 0 ]; then
+        new "kill old backend"
+        sudo clixon_backend -zf $cfg
+        if [ $? -ne 0 ]; then
+            err
+        fi
+        new "start backend -s init -f $cfg -- -sS $fstate -p /ex:sa -T $ttl"
+        start_backend -s init -f $cfg -- -sS $fstate -p /ex:sa -T $ttl
+    fi
+
+    new "wait backend"
+    wait_backend
+
+    new "netconf get provider subtree"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get><filter type=\"xpath\" select=\"/ex:sa\" xmlns:ex=\"urn:example:clixon\"/></get></rpc>" "" "<rpc-reply $DEFAULTNS><data><sa xmlns=\"urn:example:clixon\"><c><name>a</name><count>1</count></c></sa></data></rpc-reply>"
+
+    new "netconf get other subtree, provider not called"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get><filter type=\"xpath\" select=\"/ex:sb\" xmlns:ex=\"urn:example:clixon\"/></get></rpc>" "" "<rpc-reply $DEFAULTNS><data/></rpc-reply>"
+
+    writestate 2
+
+    new "netconf get descendant with other prefix"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get><filter type=\"xpath\" select=\"/y:sa/y:c[y:name='a']/y:count\" xmlns:y=\"urn:example:clixon\"/></get></rpc>" "" "<rpc-reply $DEFAULTNS><data><sa xmlns=\"urn:example:clixon\"><c><name>a</name><count>$count</count></c></sa></data></rpc-reply>"
+
+    new "netconf get all"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get/></rpc>" "" "<rpc-reply $DEFAULTNS><data><sa xmlns=\"urn:example:clixon\"><c><name>a</name><count>$count</count></c></sa></data></rpc-reply>"
+
+    if [ $BE -ne 0 ]; then
+        new "Kill backend"
+        # Check if premature kill
+        pid=$(pgrep -u root -f clixon_backend)
+        if [ -z "$pid" ]; then
+            err "backend already dead"
+        fi
+        # kill backend
+        stop_backend -f $cfg
+    fi
+}
+
+new "Provider without cache"
+testrun 0 2
+
+new "Provider with cache"
+testrun 600000 1
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -0,0 +1,113 @@
+#!/usr/bin/env bash
+# Backend profiling counters and latency histograms in the clixon-lib stats RPC
+# 1. Profiling disabled: no profile container in stats
+# 2. Profiling enabled with CLICON_BACKEND_PROFILE: counters, commit timers and per-RPC
+#    histograms after an edit-config and commit
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/example.yang
+
+cat <<EOF > $fyang
+module example{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container x {
+    list y {
+      key "a";
+      leaf a {
+        type int32;
+      }
+      leaf b {
+        type string;
+      }
+    }
+  }
+}
+EOF
+
+# Args:
+# 1: profile: true or false
+function testrun()
+{
+    profile=$1
+
+    cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>$dir</CLICON_YANG_DIR>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_SOCK>/usr/local/var/run/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+  <CLICON_BACKEND_PROFILE>$profile</CLICON_BACKEND_PROFILE>
+</clixon-config>
+EOF
+
+    new "test params: -f $cfg"
+    if [ $BE -ne 0 ]; then
+        new "kill old backend"
+        sudo clixon_backend -zf $cfg
+        if [ $? -ne 0 ]; then
+            err
+        fi
+        new "start backend -s init -f $cfg"
+        start_backend -s init -f $cfg
+    fi
+
+    new "wait backend"
+    wait_backend
+
+    new "netconf edit-config"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns=\"urn:example:clixon\"><y><a>1</a><b>one</b></y><y><a>2</a><b>two</b></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    new "netconf commit"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    if $profile; then
+        new "netconf stats with profile counters"
+        expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><stats $LIBNS/></rpc>" "" "<profile $LIBNS><xpath-eval>[0-9]*</xpath-eval><yang-find>[0-9]*</yang-find>"
+
+        new "netconf stats with commit timers"
+        expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><stats $LIBNS/></rpc>" "" "<timer><name>commit</name><count>1</count><total-usec>[0-9]*</total-usec><max-usec>[0-9]*</max-usec><bucket><log2-usec>[0-9]*</log2-usec><count>1</count></bucket></timer><timer><name>commit-diff</name><count>1</count>"
+
+        new "netconf stats with rpc histograms"
+        expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><stats $LIBNS/></rpc>" "" "<rpc><name>edit-config</name><count>1</count>"
+    else
+        new "netconf stats without profile"
+        rpc=$(chunked_framing "<rpc $DEFAULTNS><stats $LIBNS/></rpc>")
+        ret=$(echo "$DEFAULTHELLO$rpc" | $clixon_netconf -qf $cfg)
+        match=$(echo "$ret" | grep --null -Eo "<profile") || true
+        if [ -n "$match" ]; then
+            err "No profile" "$ret"
+        fi
+    fi
+
+    if [ $BE -ne 0 ]; then
+        new "Kill backend"
+        # Check if premature kill
+        pid=$(pgrep -u root -f clixon_backend)
+        if [ -z "$pid" ]; then
+            err "backend already dead"
+        fi
+        # kill backend
+        stop_backend -f $cfg
+    fi
+}
+
+new "Profiling disabled"
+testrun false
+
+new "Profiling enabled"
+testrun true
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -0,0 +1,177 @@
+#!/usr/bin/env bash
+# Parallel validate and commit callbacks of plugins flagged CLIXON_PLUGIN_TRANS_PARALLEL
+# The two example backend plugins (main and nacm) are started with -- -P which flags
+# them as thread-safe, and -t which logs all transaction callbacks to a file.
+# The nacm plugin fails on validate and then on commit with the -v trigger.
+# Since the callbacks run concurrently, the log is checked for occurrences, not line order
+# 1. Commit transaction, both plugins validate and commit
+# 2. Validate user-error in nacm plugin
+# 3. Commit user-error in nacm plugin, main plugin is reverted
+# 4. Both plugins search the same transaction trees with XPath in parallel
+# Note: requires the backend to be built with libpthread, else plugins run sequentially
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/trans.yang
+flog=$dir/backend.log
+touch $flog
+
+# Used as a trigger for user-validation errors, eg <a>$errnr</a> = <a>42</a> is invalid
+errnr=42
+# Never present in config, makes both plugins search the whole list without failing
+nomatch=-1
+# Number of list entries, more than the list key index threshold
+perfnr=200
+
+cat <<EOF > $fyang
+module trans{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container x {
+    list y {
+      key "a";
+      leaf a {
+        type int32;
+      }
+      leaf b {
+        type int32;
+      }
+    }
+  }
+}
+EOF
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_BACKEND_DIR>/usr/local/lib/$APPNAME/backend</CLICON_BACKEND_DIR>
+  <CLICON_SOCK>$dir/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+</clixon-config>
+EOF
+
+# Check number of occurrences of a statement in log
+# arg1: a statement to look for
+# arg2: expected number of occurrences
+function checkcount(){
+    new "Check $1 in log $2 times"
+    n=$(grep -c "$1" $flog)
+    if [ $n -ne $2 ]; then
+        err "$2 x $1" "$n"
+    fi
+}
+
+new "test params: -f $cfg -l f$flog -- -t -P -v /x/y[a=$errnr]"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg -l f$flog -- -t -P -v \"/x/y[a='$errnr']\""
+    start_backend -s init -f $cfg -l f$flog -- -t -P -v "/x/y[a='$errnr']"
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. Commit transaction config"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns='urn:example:clixon'><y><a>1</a></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "Commit transaction: commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+for op in validate commit commit_done; do
+    checkcount "main_$op add: <y><a>1</a></y>" 1
+    checkcount "nacm_$op add: <y><a>1</a></y>" 1
+done
+
+new "2. Validate user-error config ($errnr is invalid)"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns='urn:example:clixon'><y><a>$errnr</a></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "Validate user-error validate (should fail)"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><validate><source><candidate/></source></validate></rpc>" "" "<rpc-reply $DEFAULTNS><rpc-error><error-type>application</error-type><error-tag>operation-failed</error-tag><error-severity>error</error-severity><error-message>User error</error-message></rpc-error></rpc-reply>"
+
+checkcount "main_validate add: <y><a>$errnr</a></y>" 1
+checkcount "nacm_validate add: <y><a>$errnr</a></y>" 1
+checkcount "main_abort add: <y><a>$errnr</a></y>" 1
+
+new "3. Commit user-error commit (should fail)"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><rpc-error><error-type>application</error-type><error-tag>operation-failed</error-tag><error-severity>error</error-severity><error-message>User error</error-message></rpc-error></rpc-reply>"
+
+checkcount "main_commit add: <y><a>$errnr</a></y>" 1
+checkcount "nacm_commit add: <y><a>$errnr</a></y>" 1
+checkcount "main_revert add: <y><a>$errnr</a></y>" 1
+checkcount "nacm_revert add: <y><a>$errnr</a></y>" 0
+
+new "Running is unchanged"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><running/></source></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data><x xmlns=\"urn:example:clixon\"><y><a>1</a></y></x></data></rpc-reply>"
+
+new "Commit user-error discard-changes"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><discard-changes/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+new "4. Parallel XPath: test params: -f $cfg -- -P -V /x/y[a=$nomatch] -v /x/y[a=$nomatch]"
+if [ $BE -ne 0 ]; then
+    new "start backend -s init -f $cfg -- -P -V \"/x/y[a='$nomatch']\" -v \"/x/y[a='$nomatch']\""
+    start_backend -s init -f $cfg -- -P -V "/x/y[a='$nomatch']" -v "/x/y[a='$nomatch']"
+fi
+
+new "wait backend"
+wait_backend
+
+new "Parallel XPath: edit $perfnr entries"
+rpc="<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns='urn:example:clixon'>"
+for (( i=0; i<$perfnr; i++ )); do
+    rpc+="<y><a>$i</a><b>$i</b></y>"
+done
+rpc+="</x></config></edit-config></rpc>"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "$rpc" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "Parallel XPath: commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+for (( i=1; i<=10; i++ )); do
+    new "Parallel XPath: change entry $i"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><x xmlns='urn:example:clixon'><y><a>$i</a><b>0</b></y></x></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    new "Parallel XPath: commit $i"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+done
+
+new "Parallel XPath: get last entry"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><get-config><source><running/></source><filter type=\"xpath\" select=\"/ex:x/ex:y[ex:a='10']\" xmlns:ex=\"urn:example:clixon\"/></get-config></rpc>" "" "<rpc-reply $DEFAULTNS><data><x xmlns=\"urn:example:clixon\"><y><a>10</a><b>0</b></y></x></data></rpc-reply>"
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -0,0 +1,132 @@
+#!/usr/bin/env bash
+# Plugin subtree registration: a plugin only sees its slice of a transaction
+# The main example plugin registers /ex:a with -- -w, the nacm example plugin sees all changes.
+# Both plugins log transaction callbacks to a file with -- -t
+# 1. Change only outside the main subtree: main plugin is not called
+# 2. Change only inside the main subtree: both plugins are called
+# 3. Mixed change: main plugin only sees its subtree
+# 4. Delete of an ancestor of the main subtree
+
+# Magic line must be first in script (see README.md)
+s="$_" ; . ./lib.sh || if [ "$s" = $0 ]; then exit 0; else return 0; fi
+
+APPNAME=example
+
+cfg=$dir/conf_yang.xml
+fyang=$dir/trans.yang
+flog=$dir/backend.log
+touch $flog
+
+cat <<EOF > $fyang
+module trans{
+   yang-version 1.1;
+   namespace "urn:example:clixon";
+   prefix ex;
+   container top {
+     container a {
+       leaf x {
+         type int32;
+       }
+     }
+     container b {
+       leaf y {
+         type int32;
+       }
+     }
+   }
+}
+EOF
+
+cat <<EOF > $cfg
+<clixon-config xmlns="http://clicon.org/config">
+  <CLICON_CONFIGFILE>$cfg</CLICON_CONFIGFILE>
+  <CLICON_YANG_DIR>${YANG_INSTALLDIR}</CLICON_YANG_DIR>
+  <CLICON_YANG_MAIN_FILE>$fyang</CLICON_YANG_MAIN_FILE>
+  <CLICON_BACKEND_DIR>/usr/local/lib/$APPNAME/backend</CLICON_BACKEND_DIR>
+  <CLICON_SOCK>$dir/$APPNAME.sock</CLICON_SOCK>
+  <CLICON_BACKEND_PIDFILE>/usr/local/var/run/$APPNAME.pidfile</CLICON_BACKEND_PIDFILE>
+  <CLICON_XMLDB_DIR>$dir</CLICON_XMLDB_DIR>
+</clixon-config>
+EOF
+
+# Check number of occurrences of a statement in log
+# arg1: a statement to look for
+# arg2: expected number of occurrences
+function checkcount(){
+    new "Check $1 in log $2 times"
+    n=$(grep -c "$1" $flog)
+    if [ $n -ne $2 ]; then
+        err "$2 x $1" "$n"
+    fi
+}
+
+# Edit and commit
+# arg1: config
+function commit(){
+    new "edit-config $1"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config>$1</config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+    new "commit"
+    expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+}
+
+new "test params: -f $cfg -l f$flog -- -t -w /ex:top/ex:a"
+if [ $BE -ne 0 ]; then
+    new "kill old backend"
+    sudo clixon_backend -zf $cfg
+    if [ $? -ne 0 ]; then
+        err
+    fi
+    new "start backend -s init -f $cfg -l f$flog -- -t -w /ex:top/ex:a"
+    start_backend -s init -f $cfg -l f$flog -- -t -w /ex:top/ex:a
+fi
+
+new "wait backend"
+wait_backend
+
+new "1. Change outside main subtree"
+commit "<top xmlns='urn:example:clixon'><b><y>1</y></b></top>"
+
+checkcount "nacm_commit add: <top><b><y>1</y></b></top>" 1
+checkcount "main_begin" 0
+checkcount "main_commit" 0
+checkcount "main_end" 0
+
+new "2. Change inside main subtree"
+commit "<top xmlns='urn:example:clixon'><a><x>1</x></a></top>"
+
+checkcount "nacm_commit add: <a><x>1</x></a>" 1
+checkcount "main_begin add: <a><x>1</x></a>" 1
+checkcount "main_commit add: <a><x>1</x></a>" 1
+checkcount "main_end add: <a><x>1</x></a>" 1
+
+new "3. Mixed change"
+commit "<top xmlns='urn:example:clixon'><a><x>2</x></a><b><y>2</y></b></top>"
+
+checkcount "nacm_commit change: <x>1</x><x>2</x><y>1</y><y>2</y>" 1
+checkcount "main_commit change: <x>1</x><x>2</x>$" 1
+
+new "4. Delete ancestor of main subtree"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><edit-config><target><candidate/></target><config><top xmlns='urn:example:clixon' nc:operation='delete' xmlns:nc='urn:ietf:params:xml:ns:netconf:base:1.0'/></config></edit-config></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+new "commit"
+expecteof_netconf "$clixon_netconf -qf $cfg" 0 "$DEFAULTHELLO" "<rpc $DEFAULTNS><commit/></rpc>" "" "<rpc-reply $DEFAULTNS><ok/></rpc-reply>"
+
+checkcount "nacm_commit del: <top>" 1
+checkcount "main_commit del: <top>" 1
+
+if [ $BE -ne 0 ]; then
+    new "Kill backend"
+    # Check if premature kill
+    pid=$(pgrep -u root -f clixon_backend)
+    if [ -z "$pid" ]; then
+        err "backend already dead"
+    fi
+    # kill backend
+    stop_backend -f $cfg
+fi
+
+rm -rf $dir
+
+new "endtest"
+endtest
@@ -237,6 +237,31 @@ EOF
 new "utf-8 string"
 expecteof "$clixon_util_xml -o" 0 "$XML" "^ruled over the shores of the Hreiðsea$"
 
+# Fast parser (XML_PARSE_FAST) and bison parser fallback should give same result
+new "xml fast parse comment in text"
+expecteof "$clixon_util_xml -o" 0 "<a>x<!-- c -->  </a>" "^<a>x</a>$"
+
+new "xml fast parse text after comment error"
+expecteof "$clixon_util_xml -o" 255 "<a>x<!-- c -->y</a>" ""
+
+new "xml fast parse entities"
+expecteof "$clixon_util_xml -o" 0 '<a>&lt;&amp;&quot;</a>' '^<a>&lt;&amp;"</a>$'
+
+new "xml fast parse duplicate attribute"
+expecteof "$clixon_util_xml -o" 0 "<a x='1' x='2'/>" '^<a x="2"/>$'
+
+new "xml fast parse mismatched end tag error"
+expecteof "$clixon_util_xml -o" 255 "<a><b></a></b>" ""
+
+new "xml fast parse unterminated error"
+expecteof "$clixon_util_xml -o" 255 "<a><b>" ""
+
+new "xml fast parse CR LF -> LF, CR->LF with entity"
+ret=$(echo "<x>a&amp;b${LF}c</x>" | $clixon_util_xml -o)
+if [ "$ret" != "<x>a&amp;${LF}b${LF}c</x>" ]; then
+     err "<x>a&amp;${LF}b${LF}c</x>" "$ret"
+fi
+
 rm -rf $dir
 
 new "endtest"